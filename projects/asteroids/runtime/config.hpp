@@ -33,7 +33,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define AUDIO_BUS_COUNT ( 8 )
-#define AUDIO_VOICE_COUNT ( 32 )
+#define AUDIO_VOICE_COUNT ( 1024 )
+#define AUDIO_VOICE_REAL_COUNT ( 32 )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
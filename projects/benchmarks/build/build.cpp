@@ -0,0 +1,15 @@
+#include <build.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char **argv )
+{
+	Builder builder;
+	builder.build( argc, argv );
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Override BuilderCore functions here for project-specific needs
+// ...
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <build/build.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Builder : public BuilderCore
+{
+_PUBLIC:
+	// Override BuilderCore functions here for project-specific needs
+	// ...
+};
\ No newline at end of file
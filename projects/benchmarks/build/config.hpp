@@ -0,0 +1,24 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define OFFICIAL_HEADERS ( 0 )
+#define COMPILE_DEBUG ( 1 )
+#define MEMORY_ASSERTS ( 1 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define USING_IMAGES ( 1 )
+#define USING_SOUNDS ( 1 )
+#define USING_SPRITES ( 1 )
+#define USING_FONTS ( 1 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define AUDIO_OFFLINE ( 1 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <manta.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
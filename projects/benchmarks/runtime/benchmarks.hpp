@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks (runtime/benchmarks/*.cpp)
+extern void benchmark_spatial();
+extern void benchmark_jobs();
+extern void benchmark_queues();
+extern void benchmark_commands();
+extern void benchmark_compaction();
+extern void benchmark_snapshot();
+extern void benchmark_mixer();
+extern void benchmark_effects();
+extern void benchmark_streaming();
+extern void benchmark_adpcm();
+extern void benchmark_automation();
+extern void benchmark_voices();
+extern void benchmark_offline();
+extern void benchmark_resampler();
+extern void benchmark_parallel();
+extern void benchmark_gfx();
+extern void benchmark_arenas();
+extern void benchmark_quads();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Helpers (runtime/main.cpp)
+extern void benchmark_header( const char *name, const char *columns );
+extern void benchmark_row( const char *format, ... );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
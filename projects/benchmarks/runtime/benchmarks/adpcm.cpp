@@ -0,0 +1,168 @@
+#include <benchmarks.hpp>
+
+#include <core/adpcm.hpp>
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/math.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// IMA-ADPCM (core/adpcm.hpp): size & error of a synthetic mix (tones + noise), block decode throughput as real-time
+// voices per core, then SysAudio::audio_mixer with PCM vs. ADPCM voices. ADPCM voices are checked against PCM voices
+// playing the decoded samples (at unit pitch)
+
+static constexpr u32 SOURCE_FRAMES = 44100 * 4;
+static constexpr u32 FRAMES = 1024; // device period
+static constexpr u32 DECODE_ITERATIONS = 20;
+static constexpr u32 PERIODS = 500;
+static constexpr u32 VOICES = 32;
+
+
+static void source_fill( i16 *samples, const int channels, RandomContext &rng )
+{
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ )
+	{
+		for( int c = 0; c < channels; c++ )
+		{
+			const float t = static_cast<float>( i ) / 44100.0f;
+			const float tone = 0.45f * sinf( t * 2.0f * PI * ( 220.0f + c * 110.0f ) ) + 0.2f * sinf( t * 2.0f * PI * 3150.0f );
+			const float noise = rng.random<float>( -0.05f, 0.05f );
+			samples[i * channels + c] = static_cast<i16>( ( tone + noise ) * 32767.0f );
+		}
+	}
+}
+
+
+static void decode_all( i16 *output, const byte *encoded, const int channels )
+{
+	const usize blockBytes = adpcm_block_bytes( channels );
+	for( u32 first = 0, block = 0; first < SOURCE_FRAMES; first += ADPCM_BLOCK_FRAMES, block++ )
+	{
+		const u32 frames = SOURCE_FRAMES - first < ADPCM_BLOCK_FRAMES ? SOURCE_FRAMES - first : ADPCM_BLOCK_FRAMES;
+		adpcm_decode_block( &output[first * channels], &encoded[block * blockBytes], frames, channels );
+	}
+}
+
+
+static double mixer_period_us( const i16 *samples, const int channels, const AudioFormat format, i16 *output )
+{
+	SoundHandle handles[VOICES];
+	double elapsedMs = 0.0;
+	for( u32 period = 0; period < PERIODS; period++ )
+	{
+		// Restart voices as they finish
+		for( u32 v = 0; v < VOICES; v++ )
+		{
+			if( handles[v].is_playing() ) { continue; }
+			AudioEffects effects;
+			effects.set_gain( 1.0f / VOICES );
+			effects.set_pitch( 0.5f + 0.05f * static_cast<float>( v % 20 ) );
+			handles[v] = SysAudio::play_sound( 0, samples, SOURCE_FRAMES * channels, channels, effects, "bench", format );
+		}
+
+		Timer timer;
+		SysAudio::audio_mixer( output, FRAMES );
+		timer.stop();
+		elapsedMs += timer.elapsed_ms();
+	}
+
+	for( SoundHandle &handle : handles ) { handle.stop(); }
+	SysAudio::audio_mixer( output, 0 );
+	return elapsedMs * 1000.0 / PERIODS;
+}
+
+
+static u32 mix_until_finished( const i16 *samples, const int channels, const AudioFormat format, i16 *output,
+	const u32 capacity )
+{
+	// Returns the samples written to 'output' (unit pitch: interpolation is exact, so the outputs must match)
+	SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES * channels, channels, { }, "bench", format );
+
+	u32 written = 0;
+	while( handle.is_playing() )
+	{
+		ErrorIf( written + FRAMES * 2 > capacity, "ADPCM: output overflow" );
+		SysAudio::audio_mixer( &output[written], FRAMES );
+		written += FRAMES * 2;
+	}
+	return written;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_adpcm()
+{
+	RandomContext rng { 1234 };
+	const u32 capacity = ( SOURCE_FRAMES / FRAMES + 2 ) * FRAMES * 2;
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( capacity * sizeof( i16 ) ) );
+	i16 *outputReference = reinterpret_cast<i16 *>( memory_alloc( capacity * sizeof( i16 ) ) );
+
+	benchmark_header( "IMA-ADPCM (4 s synthetic mix)",
+		"channels |  pcm bytes | adpcm bytes | ratio | encode ms | rms err | peak err | decode ns/frame | rt voices" );
+
+	for( int channels = 1; channels <= 2; channels++ )
+	{
+		i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * channels * sizeof( i16 ) ) );
+		i16 *decoded = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * channels * sizeof( i16 ) ) );
+		source_fill( samples, channels, rng );
+
+		// Encode
+		const usize bytesPcm = SOURCE_FRAMES * channels * sizeof( i16 );
+		const usize bytesAdpcm = adpcm_encoded_bytes( SOURCE_FRAMES, channels );
+		byte *encoded = reinterpret_cast<byte *>( memory_alloc( bytesAdpcm ) );
+		Timer timerEncode;
+		adpcm_encode( encoded, samples, SOURCE_FRAMES, channels );
+		timerEncode.stop();
+
+		// Decode
+		Timer timerDecode;
+		for( u32 i = 0; i < DECODE_ITERATIONS; i++ ) { decode_all( decoded, encoded, channels ); }
+		timerDecode.stop();
+		const double decodeNs = timerDecode.elapsed_ms() * 1000000.0 / ( static_cast<double>( DECODE_ITERATIONS ) * SOURCE_FRAMES );
+
+		// Error
+		double errorSquared = 0.0;
+		u32 errorPeak = 0;
+		for( u32 i = 0; i < SOURCE_FRAMES * channels; i++ )
+		{
+			const int error = samples[i] - decoded[i];
+			const u32 errorAbs = static_cast<u32>( error < 0 ? -error : error );
+			errorSquared += static_cast<double>( error ) * error;
+			errorPeak = errorAbs > errorPeak ? errorAbs : errorPeak;
+		}
+
+		benchmark_row( "%8d | %10llu | %11llu | %4.2f:1 | %9.3f | %7.1f | %8u | %15.3f | %9.0f", channels,
+			static_cast<u64>( bytesPcm ), static_cast<u64>( bytesAdpcm ), static_cast<double>( bytesPcm ) / bytesAdpcm,
+			timerEncode.elapsed_ms(), sqrtf( static_cast<float>( errorSquared / ( SOURCE_FRAMES * channels ) ) ), errorPeak,
+			decodeNs, 1000000000.0 / ( decodeNs * 44100.0 ) );
+
+		// ADPCM voices must play the decoded samples
+		const u32 countReference = mix_until_finished( decoded, channels, AudioFormat_PCM16, outputReference, capacity );
+		const u32 count = mix_until_finished( reinterpret_cast<const i16 *>( encoded ), channels, AudioFormat_ADPCM,
+			output, capacity );
+		u32 mismatches = 0;
+		for( u32 i = 0; i < count && i < countReference; i++ ) { mismatches += output[i] != outputReference[i]; }
+		ErrorIf( count != countReference || mismatches != 0, "ADPCM: voice differs from decoded PCM (%u samples)",
+			mismatches );
+
+		// Mixer cost
+		const double periodPcm = mixer_period_us( decoded, channels, AudioFormat_PCM16, output );
+		const double periodAdpcm = mixer_period_us( reinterpret_cast<const i16 *>( encoded ), channels, AudioFormat_ADPCM,
+			output );
+		benchmark_row( "         | mixer: %u voices, %.3f us pcm, %.3f us adpcm per 1024 frame period", VOICES,
+			periodPcm, periodAdpcm );
+
+		memory_free( encoded );
+		memory_free( decoded );
+		memory_free( samples );
+	}
+
+	memory_free( outputReference );
+	memory_free( output );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,203 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/draw.hpp>
+#include <manta/gfx.hpp>
+#include <manta/random.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quad arenas (build with -gfx=none): 100k sprites recorded by 1, 4 & 8 jobs into per-thread GfxQuadArenas, then
+// stitched into the quad batch by the main thread, both immediate & inside a deferred quad batch. Compared against
+// draw_sprite() on the main thread, and checked to log the same command stream. The stitch copy is overhead: arenas
+// only win when recording runs on otherwise idle cores ('scaling' above 1x)
+
+static constexpr u32 SPRITES = 100000;
+static constexpr u32 BLOCK = 12500; // Sprites per shader range
+static constexpr u32 FRAMES = 16;
+static constexpr u32 RECORDERS[] = { 1, 4, 8 };
+static constexpr float WIDTH = 1280.0f;
+static constexpr float HEIGHT = 720.0f;
+
+struct ArenaSprite
+{
+	float x, y;
+	Color color;
+};
+
+struct ArenaRecorder
+{
+	GfxQuadArena *arena;
+	const ArenaSprite *sprites;
+	u32 start;
+	u32 end;
+};
+
+
+static u32 block_shader( const u32 sprite )
+{
+	return ( sprite / BLOCK ) % 2 == 0 ? SHADER_DEFAULT : SHADER_DEFAULT_RGB;
+}
+
+
+static void frame_begin()
+{
+	Gfx::frame_begin();
+	Gfx::clear_color( { 20, 20, 40 } );
+	Gfx::set_matrix_mvp_2d_orthographic( 0.0f, 0.0f, 1.0f, 0.0f, WIDTH, HEIGHT );
+}
+
+
+static void record_immediate( const ArenaSprite *sprites )
+{
+	for( u32 i = 0; i < SPRITES; i++ )
+	{
+		if( i % BLOCK == 0 ) { Gfx::shader_bind( block_shader( i ) ); }
+		draw_sprite( SPRITE_DEFAULT, 0, sprites[i].x, sprites[i].y, 1.0f, 1.0f, sprites[i].color );
+	}
+	Gfx::shader_release();
+}
+
+
+static void record_arena( void *userdata )
+{
+	// Same quads as draw_sprite(), without touching Gfx state
+	const ArenaRecorder &recorder = *reinterpret_cast<ArenaRecorder *>( userdata );
+	const DiskSprite &dSprite = Assets::sprites[SPRITE_DEFAULT];
+	const DiskGlyph &dGlyph = Assets::glyphs[dSprite.glyph];
+	const GfxTexture2D *const texture = &GfxCore::textures[dSprite.texture];
+
+	GfxQuadArena &arena = *recorder.arena;
+	arena.clear();
+	for( u32 i = recorder.start; i < recorder.end; i++ )
+	{
+		if( i % BLOCK == 0 || i == recorder.start ) { arena.shader_bind( block_shader( i ) ); }
+		const float x = recorder.sprites[i].x - dSprite.xorigin;
+		const float y = recorder.sprites[i].y - dSprite.yorigin;
+		arena.write( x, y, x + dSprite.width, y + dSprite.height,
+			dGlyph.u1, dGlyph.v1, dGlyph.u2, dGlyph.v2, recorder.sprites[i].color, texture );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_arenas()
+{
+#if RENDER_NONE
+	ErrorIf( !SysGfx::init(), "Arenas: failed to initialize the headless backend" );
+
+	ArenaSprite *sprites = reinterpret_cast<ArenaSprite *>( memory_alloc( SPRITES * sizeof( ArenaSprite ) ) );
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < SPRITES; i++ )
+	{
+		sprites[i] = { rng.random<float>( 0.0f, WIDTH ), rng.random<float>( 0.0f, HEIGHT ),
+			Color { static_cast<u8>( i ), 255, 255, 255 } };
+	}
+
+	GfxQuadArena arenas[8];
+	for( GfxQuadArena &arena : arenas ) { arena.init( SPRITES / 8 ); }
+
+	// 'scaling' is the record time of 1 recorder over N recorders: it only exceeds 1x with N free job threads
+	benchmark_header( "100k sprite submission (CPU per frame)",
+		"mode                  | record us | scaling |  stitch us |  frame us | speedup | draws | ranges | same stream" );
+
+	for( u32 deferred = 0; deferred < 2; deferred++ )
+	{
+		// Main thread, draw_sprite()
+		GfxHeadlessFrame reference;
+		double usImmediate = 0.0;
+		for( u32 frame = 0; frame < FRAMES; frame++ )
+		{
+			Timer timer;
+			frame_begin();
+			if( deferred ) { Gfx::quad_batch_deferred_begin(); }
+			record_immediate( sprites );
+			if( deferred ) { Gfx::quad_batch_deferred_end(); }
+			Gfx::frame_end();
+			timer.stop();
+
+			if( frame == 0 ) { continue; }
+			reference = Gfx::headless_frame();
+			usImmediate += timer.elapsed_us();
+		}
+		usImmediate /= FRAMES - 1;
+
+		char mode[32];
+		snprintf( mode, sizeof( mode ), "immediate%s", deferred ? "/deferred" : "" );
+		benchmark_row( "%-21s | %9.1f | %7s | %10s | %9.1f | %6.2fx | %5u | %6s | %11s", mode, usImmediate, "-", "-",
+			usImmediate, 1.0, reference.drawCalls, "-", "-" );
+
+		// Jobs recording into arenas, main thread stitching
+		double usRecordSingle = 0.0;
+		for( const u32 recorders : RECORDERS )
+		{
+			ArenaRecorder jobs[8];
+			for( u32 i = 0; i < recorders; i++ )
+			{
+				jobs[i] = { &arenas[i], sprites, SPRITES * i / recorders, SPRITES * ( i + 1 ) / recorders };
+			}
+
+			double usRecord = 0.0;
+			double usStitch = 0.0;
+			double usFrame = 0.0;
+			u32 ranges = 0;
+			bool same = true;
+			GfxHeadlessFrame log;
+			for( u32 frame = 0; frame < FRAMES; frame++ )
+			{
+				Timer timerFrame;
+				frame_begin();
+				if( deferred ) { Gfx::quad_batch_deferred_begin(); }
+
+				Timer timerRecord;
+				JobCounter counter;
+				for( u32 i = 0; i < recorders; i++ ) { Jobs::submit( record_arena, &jobs[i], &counter ); }
+				Jobs::wait( counter );
+				timerRecord.stop();
+
+				Timer timerStitch;
+				for( u32 i = 0; i < recorders; i++ ) { Gfx::quad_arena_submit( arenas[i] ); }
+				timerStitch.stop();
+
+				if( deferred ) { Gfx::quad_batch_deferred_end(); }
+				Gfx::frame_end();
+				timerFrame.stop();
+
+				if( frame == 0 ) { continue; }
+				log = Gfx::headless_frame();
+				same &= log.checksum == reference.checksum && log.count == reference.count;
+				usRecord += timerRecord.elapsed_us();
+				usStitch += timerStitch.elapsed_us();
+				usFrame += timerFrame.elapsed_us();
+			}
+
+			for( u32 i = 0; i < recorders; i++ ) { ranges += arenas[i].rangesCount; }
+			usRecord /= FRAMES - 1;
+			usStitch /= FRAMES - 1;
+			usFrame /= FRAMES - 1;
+			if( recorders == 1 ) { usRecordSingle = usRecord; }
+
+			snprintf( mode, sizeof( mode ), "%u recorder%s%s", recorders, recorders == 1 ? "" : "s",
+				deferred ? "/deferred" : "" );
+			benchmark_row( "%-21s | %9.1f | %6.2fx | %10.1f | %9.1f | %6.2fx | %5u | %6u | %11s", mode, usRecord,
+				usRecordSingle / usRecord, usStitch, usFrame, usImmediate / usFrame, log.drawCalls, ranges,
+				same ? "yes" : "no" );
+			ErrorIf( !same, "Arenas: %s logged a different command stream than draw_sprite()", mode );
+		}
+	}
+
+	benchmark_row( "(job threads: %u)", Jobs::thread_count() );
+
+	for( GfxQuadArena &arena : arenas ) { arena.free(); }
+	memory_free( sprites );
+	SysGfx::free();
+#else
+	benchmark_header( "Quad arenas", "skipped: build the benchmarks with -gfx=none" );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
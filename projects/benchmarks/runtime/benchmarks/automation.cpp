@@ -0,0 +1,104 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Effect DSP cost with parameter automation: VOICES voices on bus 0 run an effect chain with every parameter either
+// held or ramping for the whole run (SysAudio::audio_mixer, 1024 frame periods). Reports ns per frame per voice
+
+static constexpr u32 SOURCE_FRAMES = 44100 * 4;
+static constexpr u32 FRAMES = 1024; // device period
+static constexpr u32 PERIODS = 200;
+static constexpr u32 VOICES = 32;
+static constexpr usize RAMP_MS = 60000;
+
+
+struct AutomationChain
+{
+	const char *name;
+	u32 voices;
+	bool lowpass;
+	bool reverb;
+};
+
+static constexpr AutomationChain CHAINS[] =
+{
+	{ "core", VOICES, false, false },
+	{ "core + lowpass", VOICES, true, false },
+	{ "core + lowpass + reverb", AUDIO_EFFECT_REVERB_POOL_SIZE, true, true },
+};
+
+
+static SoundHandle play( const i16 *samples, const AutomationChain &chain, const bool automated, const u32 voice )
+{
+	const float offset = static_cast<float>( voice ) / VOICES;
+	AudioEffects effects;
+	if( automated ) { effects.set_gain( 0.2f + offset * 0.1f, 0.9f, RAMP_MS ); }
+	else { effects.set_gain( 0.5f ); }
+
+	if( chain.lowpass )
+	{
+		if( automated ) { effects.set_lowpass_cutoff( 400.0f + offset * 100.0f, 16000.0f, RAMP_MS ); }
+		else { effects.set_lowpass_cutoff( 8000.0f ); }
+	}
+
+	if( chain.reverb )
+	{
+		if( automated )
+		{
+			effects.set_reverb_wet( 0.1f, 0.8f, RAMP_MS );
+			effects.set_reverb_size( 0.2f, 0.9f, RAMP_MS );
+		}
+		else
+		{
+			effects.set_reverb_wet( 0.5f );
+			effects.set_reverb_size( 0.5f );
+		}
+	}
+
+	return SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, effects, "bench" );
+}
+
+
+void benchmark_automation()
+{
+	RandomContext rng { 1234 };
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ ) { samples[i] = static_cast<i16>( rng.random<int>( -8192, 8191 ) ); }
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( FRAMES * 2 * sizeof( i16 ) ) );
+
+	benchmark_header( "Effect automation (1024 frame period, voices on bus 0)",
+		"chain                   | automated | voices |   period us | ns/frame/voice" );
+
+	for( const AutomationChain &chain : CHAINS )
+	{
+		for( int automated = 0; automated <= 1; automated++ )
+		{
+			SoundHandle handles[VOICES];
+			for( u32 v = 0; v < chain.voices; v++ ) { handles[v] = play( samples, chain, automated != 0, v ); }
+			SysAudio::audio_mixer( output, 0 );
+
+			Timer timer;
+			for( u32 period = 0; period < PERIODS; period++ ) { SysAudio::audio_mixer( output, FRAMES ); }
+			timer.stop();
+
+			const double periodUs = timer.elapsed_ms() * 1000.0 / PERIODS;
+			benchmark_row( "%-23s | %9s | %6u | %11.3f | %14.3f", chain.name, automated ? "yes" : "no", chain.voices,
+				periodUs, periodUs * 1000.0 / ( static_cast<double>( FRAMES ) * chain.voices ) );
+
+			for( u32 v = 0; v < chain.voices; v++ ) { handles[v].stop(); }
+			SysAudio::audio_mixer( output, 0 );
+		}
+	}
+
+	memory_free( output );
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
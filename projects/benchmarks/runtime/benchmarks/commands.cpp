@@ -0,0 +1,107 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/objects.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+#include <scene.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ObjectContext::Commands vs. immediate mutation: POPULATION bench_spatial instances, then CHURN scattered instances are
+// destroyed & CHURN new ones created, either one at a time on the context or recorded into a Commands buffer and
+// applied by flush(). Reports the measured time of both (averaged over REPEATS fresh contexts), the flush alone & with
+// recording, and checks that both leave the same instances behind
+
+static constexpr u32 POPULATION = 50000;
+static constexpr u32 CHURN[] = { 1000, 10000, 25000 };
+static constexpr u32 REPEATS = 8;
+
+
+static void populate( Object *handles )
+{
+	RandomContext rng { 1234 };
+	Scene::objects.init();
+	for( u32 i = 0; i < POPULATION; i++ )
+	{
+		handles[i] = Scene::objects.create<bench_spatial>( static_cast<float>( i ), rng.random<float>( 1024.0f ),
+			0.0f, 0.0f );
+	}
+}
+
+
+static double checksum()
+{
+	double sum = 0.0;
+	foreach_object( Scene::objects, bench_spatial, h ) { sum += h->x; }
+	return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_commands()
+{
+	benchmark_header( "ObjectContext::Commands flush vs. immediate create/destroy (50000 instances)",
+		"    churn | immediate ms | record ms | flush ms | flush speedup | total speedup | buckets | same result" );
+
+	Object *handles = reinterpret_cast<Object *>( memory_alloc( POPULATION * sizeof( Object ) ) );
+	ObjectContext::Commands commands;
+	commands.init();
+
+	for( const u32 churn : CHURN )
+	{
+		const u32 stride = POPULATION / churn;
+		double msImmediate = 0.0;
+		double msRecord = 0.0;
+		double msFlush = 0.0;
+		u32 buckets = 0;
+		bool same = true;
+
+		for( u32 repeat = 0; repeat < REPEATS; repeat++ )
+		{
+			// Immediate
+			populate( handles );
+			Timer timerImmediate;
+			for( u32 i = 0; i < POPULATION; i += stride ) { Scene::objects.destroy( handles[i] ); }
+			for( u32 i = 0; i < churn; i++ ) { Scene::objects.create<bench_spatial>( -1.0f, 0.0f, 0.0f, 0.0f ); }
+			timerImmediate.stop();
+			msImmediate += timerImmediate.elapsed_ms();
+			const u32 countImmediate = Scene::objects.count( bench_spatial );
+			const double sumImmediate = checksum();
+			Scene::objects.free();
+
+			// Deferred
+			populate( handles );
+			Timer timerRecord;
+			for( u32 i = 0; i < POPULATION; i += stride ) { commands.destroy( handles[i] ); }
+			for( u32 i = 0; i < churn; i++ ) { commands.create<bench_spatial>( -1.0f, 0.0f, 0.0f, 0.0f ); }
+			timerRecord.stop();
+			msRecord += timerRecord.elapsed_ms();
+
+			Timer timerFlush;
+			commands.flush( Scene::objects );
+			timerFlush.stop();
+			msFlush += timerFlush.elapsed_ms();
+			buckets = commands.statistics().buckets;
+
+			same &= Scene::objects.count( bench_spatial ) == countImmediate && checksum() == sumImmediate;
+			Scene::objects.free();
+		}
+
+		msImmediate /= REPEATS;
+		msRecord /= REPEATS;
+		msFlush /= REPEATS;
+		benchmark_row( "%9u | %12.3f | %9.3f | %8.3f | %12.2fx | %12.2fx | %7u | %11s", churn, msImmediate, msRecord,
+			msFlush, msImmediate / ( msFlush > 0.0 ? msFlush : 1e-9 ), msImmediate / ( msRecord + msFlush ), buckets,
+			same ? "yes" : "no" );
+		ErrorIf( !same, "Commands: flush() of %u destroys & creates differs from immediate mutation", churn );
+	}
+
+	commands.free();
+	memory_free( handles );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,121 @@
+#include <benchmarks.hpp>
+
+#include <core/debug.hpp>
+
+#include <manta/objects.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+#include <scene.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ObjectContext::compact() after a population spike: SPIKE bench_spatial instances are created, all but SURVIVORS
+// (scattered) are destroyed, then compact() runs with BUDGET moves per pass until nothing is left to move. Reports
+// resident memory & full-iteration cost before, after, and once relocation records expire, and checks that
+// pre-compaction handles still resolve (and never resolve to instances respawned into recycled buckets)
+
+static constexpr u32 SPIKE = 50000;
+static constexpr u32 SURVIVORS[] = { 500, 2500, 10000 };
+static constexpr u32 BUDGET = 1024;
+static constexpr u32 ITERATIONS = 200;
+
+
+static double iterate_ms()
+{
+	float sum = 0.0f;
+	Timer timer;
+	for( u32 i = 0; i < ITERATIONS; i++ )
+	{
+		foreach_object( Scene::objects, bench_spatial, h ) { sum += h->x; }
+	}
+	timer.stop();
+	ErrorIf( sum < 0.0f, "Compaction: invalid sum" );
+	return timer.elapsed_ms() / ITERATIONS;
+}
+
+
+static void compaction_row( const char *label, const u32 survivors, const ObjectContext::MemoryStatistics &stats,
+	const double iterationMs )
+{
+	benchmark_row( "%9u | %-6s | %7u | %8u | %10.1f | %9u | %10.4f", survivors, label, stats.buckets,
+		stats.bucketsResident, KB( stats.residentBytes ), stats.slotsSpanned, iterationMs );
+}
+
+
+void benchmark_compaction()
+{
+	benchmark_header( "ObjectContext::compact() after a 50000 instance spike",
+		"survivors | state  | buckets | resident |  memory KB |     slots | iterate ms" );
+
+	Object *handles = reinterpret_cast<Object *>( memory_alloc( SPIKE * sizeof( Object ) ) );
+	for( const u32 survivors : SURVIVORS )
+	{
+		RandomContext rng { 1234 };
+		Scene::objects.init();
+
+		// Spike
+		for( u32 i = 0; i < SPIKE; i++ )
+		{
+			handles[i] = Scene::objects.create<bench_spatial>( static_cast<float>( i ), rng.random<float>( 1024.0f ),
+				0.0f, 0.0f );
+		}
+		Scene::objects.spatial_update();
+
+		// Die off: keep every (SPIKE / survivors)th instance
+		const u32 stride = SPIKE / survivors;
+		for( u32 i = 0; i < SPIKE; i++ )
+		{
+			if( i % stride != 0 ) { Scene::objects.destroy( handles[i] ); }
+		}
+		compaction_row( "before", survivors, Scene::objects.memory_statistics(), iterate_ms() );
+
+		// Compact until stable
+		u32 passes = 0;
+		double compactMs = 0.0;
+		do
+		{
+			Scene::objects.compact( BUDGET );
+			compactMs += Scene::objects.compact_statistics().compactMs;
+			passes++;
+		}
+		while( Scene::objects.compact_statistics().moved > 0 || Scene::objects.compact_statistics().retired > 0 );
+		compaction_row( "after", survivors, Scene::objects.memory_statistics(), iterate_ms() );
+
+		// Old handles resolve to the moved instances (x holds the spawn index)
+		u32 resolved = 0;
+		for( u32 i = 0; i < SPIKE; i += stride )
+		{
+			auto h = Scene::objects.handle<bench_spatial>( handles[i] );
+			ErrorIf( !h || h->x != static_cast<float>( i ), "Compaction: handle %u did not resolve", i );
+			resolved++;
+		}
+
+		// SPATIAL index follows moved instances
+		u32 hits = 0;
+		for( auto h : Scene::objects.query_aabb<bench_spatial>( -1.0f, -1.0f, SPIKE + 1.0f, 1025.0f ) ) { hits += h->x >= 0.0f; }
+		ErrorIf( hits != Scene::objects.count( bench_spatial ), "Compaction: SPATIAL mismatch (%u of %u)",
+			hits, Scene::objects.count( bench_spatial ) );
+
+		const u32 moved = Scene::objects.compact_statistics().movedTotal;
+
+		// Relocation records expire & retired buckets become reusable
+		for( u32 i = 0; i < OBJECT_COMPACT_RELOCATION_PASSES; i++ ) { Scene::objects.compact( BUDGET ); }
+		compaction_row( "expire", survivors, Scene::objects.memory_statistics(), iterate_ms() );
+
+		// Respawn into the recycled buckets: stale handles must not match the new instances (x < 0)
+		for( u32 i = 0; i < SPIKE - survivors; i++ ) { Scene::objects.create<bench_spatial>( -1.0f, 0.0f, 0.0f, 0.0f ); }
+		for( u32 i = 0; i < SPIKE; i++ )
+		{
+			auto h = Scene::objects.handle<bench_spatial>( handles[i] );
+			ErrorIf( h && h->x != static_cast<float>( i ), "Compaction: stale handle %u resolved to a new instance", i );
+		}
+
+		benchmark_row( "          | %u passes, %u moved, %.3f ms, %u handles resolved", passes, moved, compactMs, resolved );
+
+		Scene::objects.free();
+	}
+	memory_free( handles );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
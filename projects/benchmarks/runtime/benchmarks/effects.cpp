@@ -0,0 +1,96 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Audio effect chains: static footprint of SysAudio::voices/buses and SysAudio::play_sound throughput (each call builds
+// an AudioEffects chain, plays it, and stops it). A reverb voice is then mixed to check its pooled state
+
+static constexpr u32 CALLS = 200000;
+static constexpr u32 SAMPLES = 44100;
+static constexpr u32 FRAMES = 1024;
+
+
+static u32 reverbs_active()
+{
+	u32 count = 0;
+	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
+	{
+		for( int j = 0; j < SysAudio::EFFECTTYPE_COUNT; j++ )
+		{
+			const SysAudio::Effect &effect = SysAudio::voices[i].effects[j];
+			count += SysAudio::voices[i].bus >= 0 && effect.type == SysAudio::EffectType_Reverb &&
+				effect.state != SysAudio::EFFECT_STATE_NONE;
+		}
+	}
+	return count;
+}
+
+
+static SoundHandle play( const i16 *samples, const u32 chain )
+{
+	AudioEffects effects;
+	effects.set_gain( 0.8f );
+	if( chain >= 1 ) { effects.set_lowpass_cutoff( 8000.0f ); }
+	if( chain >= 2 ) { effects.set_reverb_wet( 0.5f ); }
+	return SysAudio::play_sound( 0, samples, SAMPLES, 1, effects, "bench" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_effects()
+{
+	static const char *CHAINS[] = { "core", "core + lowpass", "core + lowpass + reverb" };
+
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SAMPLES * sizeof( i16 ) ) );
+	for( u32 i = 0; i < SAMPLES; i++ ) { samples[i] = static_cast<i16>( static_cast<i16>( ( i * 2654435761u ) >> 16 ) / 8 ); }
+	benchmark_header( "Audio effect footprint", "                  bytes" );
+	benchmark_row( "AudioEffects     | %10llu", static_cast<u64>( sizeof( AudioEffects ) ) );
+	benchmark_row( "SysAudio::voices | %10llu", static_cast<u64>( sizeof( SysAudio::voices ) ) );
+	benchmark_row( "SysAudio::buses  | %10llu", static_cast<u64>( sizeof( SysAudio::buses ) ) );
+
+	// Each play + stop round trip is drained by a zero-frame audio_mixer() call
+	benchmark_header( "SysAudio::play_sound (200000 play + stop)",
+		"chain                   |      time ms |    calls/s" );
+	for( u32 chain = 0; chain < ARRAY_LENGTH( CHAINS ); chain++ )
+	{
+		Timer timer;
+		for( u32 i = 0; i < CALLS; i++ ) { play( samples, chain ).stop(); SysAudio::audio_mixer( nullptr, 0 ); }
+		timer.stop();
+		benchmark_row( "%-23s | %12.3f | %10.0f", CHAINS[chain], timer.elapsed_ms(), CALLS / ( timer.elapsed_ms() * 0.001 ) );
+	}
+
+	// Pooled reverb: more reverb voices than pool entries, mixed until they finish
+	benchmark_header( "Pooled reverb (AUDIO_EFFECT_REVERB_POOL_SIZE entries)",
+		"   voices | pooled | period us | peak" );
+	const u32 voices = AUDIO_EFFECT_REVERB_POOL_SIZE + 2;
+	SoundHandle first = play( samples, 2 );
+	for( u32 i = 1; i < voices; i++ ) { play( samples, 2 ); }
+
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( FRAMES * 2 * sizeof( i16 ) ) );
+	u32 periods = 0;
+	u32 pooled = 0;
+	i32 peak = 0;
+	Timer timer;
+	while( first.is_playing() )
+	{
+		SysAudio::audio_mixer( output, FRAMES );
+		pooled = periods == 0 ? reverbs_active() : pooled;
+		for( u32 i = 0; i < FRAMES * 2; i++ ) { peak = output[i] > peak ? output[i] : ( -output[i] > peak ? -output[i] : peak ); }
+		periods++;
+	}
+	timer.stop();
+	ErrorIf( pooled != AUDIO_EFFECT_REVERB_POOL_SIZE, "Effects: %u reverbs pooled", pooled );
+	ErrorIf( reverbs_active() != 0, "Effects: reverb state not released" );
+	benchmark_row( "%9u | %6u | %9.3f | %d", voices, pooled, timer.elapsed_ms() * 1000.0 / periods, peak );
+	memory_free( output );
+
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,209 @@
+#include <benchmarks.hpp>
+
+#include <core/debug.hpp>
+
+#include <manta/draw.hpp>
+#include <manta/fonts.hpp>
+#include <manta/gfx.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Headless rendering (build with -gfx=none): CPU cost per frame of Gfx, draw_* & text through the recording backend.
+// Reports the backend calls each frame logs and checks that identical frames log identical command streams
+
+static constexpr u32 FRAMES = 32;
+static constexpr float WIDTH = 1280.0f;
+static constexpr float HEIGHT = 720.0f;
+
+struct GfxScene
+{
+	const char *name;
+	void ( *draw )();
+};
+
+
+static void scene_sprites()
+{
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 20000; i++ )
+	{
+		draw_sprite( SPRITE_DEFAULT, 0, rng.random<float>( 0.0f, WIDTH ), rng.random<float>( 0.0f, HEIGHT ) );
+	}
+}
+
+
+static void scene_rotated()
+{
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 20000; i++ )
+	{
+		draw_sprite_angle( SPRITE_DEFAULT, 0, rng.random<float>( 0.0f, WIDTH ), rng.random<float>( 0.0f, HEIGHT ),
+			rng.random<float>( 0.0f, 360.0f ), 2.0f, 2.0f, c_white );
+	}
+}
+
+
+static void scene_quads()
+{
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 20000; i++ )
+	{
+		const float x = rng.random<float>( 0.0f, WIDTH );
+		const float y = rng.random<float>( 0.0f, HEIGHT );
+		draw_quad( x, y, x + 8.0f, y + 8.0f, Color { static_cast<u8>( i ), 128, 255, 255 } );
+	}
+}
+
+
+static void scene_text()
+{
+	for( u32 i = 0; i < 40; i++ )
+	{
+		draw_text( fnt_iosevka, 16, 8.0f, 8.0f + i * 16.0f, c_white,
+			"The quick brown fox jumps over the lazy dog 0123456789 !?" );
+	}
+}
+
+
+static void scene_mixed()
+{
+	// Sprites & text interleaved: every switch between the sprite & glyph textures breaks the batch
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 2000; i++ )
+	{
+		const float x = rng.random<float>( 0.0f, WIDTH );
+		const float y = rng.random<float>( 0.0f, HEIGHT );
+		draw_sprite( SPRITE_DEFAULT, 0, x, y );
+		if( i % 8 == 0 ) { draw_text( fnt_iosevka, 12, x, y, c_white, "label" ); }
+	}
+}
+
+
+static void scene_states()
+{
+	// State changes every 64 quads (blend & scissor)
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 4096; i++ )
+	{
+		if( i % 64 == 0 )
+		{
+			Gfx::set_blend_enabled( ( i / 64 ) % 2 == 0 );
+			Gfx::set_scissor( 0, 0, static_cast<int>( WIDTH ) - static_cast<int>( i / 64 ), static_cast<int>( HEIGHT ) );
+		}
+		const float x = rng.random<float>( 0.0f, WIDTH );
+		const float y = rng.random<float>( 0.0f, HEIGHT );
+		draw_quad( x, y, x + 8.0f, y + 8.0f );
+	}
+	Gfx::reset_scissor();
+	Gfx::set_blend_enabled( true );
+}
+
+
+static void scene_rebinds()
+{
+	// Per-object binds of shader & state that are already bound (reach the backend only when they differ)
+	RandomContext rng { 1234 };
+	for( u32 i = 0; i < 4096; i++ )
+	{
+		Gfx::shader_bind( i % 256 == 0 ? SHADER_DEFAULT_RGB : SHADER_DEFAULT );
+		Gfx::set_blend_enabled( true );
+		Gfx::set_filtering_mode( GfxFilteringMode_NEAREST );
+		draw_sprite( SPRITE_DEFAULT, 0, rng.random<float>( 0.0f, WIDTH ), rng.random<float>( 0.0f, HEIGHT ) );
+		Gfx::shader_release();
+	}
+}
+
+
+static void scene_mixed_deferred()
+{
+	// Same submission, sorted by texture: one batch per texture
+	Gfx::quad_batch_deferred_begin();
+	scene_mixed();
+	Gfx::quad_batch_deferred_end();
+}
+
+
+static void scene_states_deferred()
+{
+	// Same submission, sorted by blend state first: every scissor rect still needs its own batch
+	Gfx::quad_batch_deferred_begin();
+	scene_states();
+	Gfx::quad_batch_deferred_end();
+}
+
+
+static const GfxScene SCENES[] =
+{
+	{ "sprites", scene_sprites },
+	{ "rotated", scene_rotated },
+	{ "quads", scene_quads },
+	{ "text", scene_text },
+	{ "mixed", scene_mixed },
+	{ "mixed/deferred", scene_mixed_deferred },
+	{ "states", scene_states },
+	{ "states/deferred", scene_states_deferred },
+	{ "rebinds", scene_rebinds },
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_gfx()
+{
+#if RENDER_NONE
+	ErrorIf( !SysGfx::init(), "Gfx: failed to initialize the headless backend" );
+	ErrorIf( !SysFonts::init(), "Gfx: failed to initialize fonts" );
+
+	benchmark_header( "Headless rendering (CPU per frame, recording backend)",
+		"scene           | frame us | draws | vertices | commands | checksum | stable" );
+	for( const GfxScene &scene : SCENES )
+	{
+		GfxHeadlessFrame first;
+		u32 unstable = 0;
+		double us = 0.0;
+		for( u32 frame = 0; frame < FRAMES; frame++ )
+		{
+			Timer timer;
+			Gfx::frame_begin();
+			Gfx::clear_color( { 20, 20, 40 } );
+			Gfx::set_matrix_mvp_2d_orthographic( 0.0f, 0.0f, 1.0f, 0.0f, WIDTH, HEIGHT );
+			scene.draw();
+			Gfx::frame_end();
+			timer.stop();
+
+			// The first frame caches glyphs (the font texture is rebuilt)
+			const GfxHeadlessFrame log = Gfx::headless_frame();
+			ErrorIf( log.dropped != 0, "Gfx: scene '%s' dropped %u commands", scene.name, log.dropped );
+			if( frame == 0 ) { continue; }
+			if( frame == 1 ) { first = log; }
+			unstable += log.checksum != first.checksum || log.count != first.count;
+			us += timer.elapsed_us();
+		}
+
+		benchmark_row( "%-15s | %8.1f | %5u | %8u | %8u | %08x | %6s", scene.name, us / ( FRAMES - 1 ),
+			first.drawCalls, first.vertexCount, first.count, first.checksum, unstable == 0 ? "yes" : "no" );
+		ErrorIf( first.drawCalls == 0, "Gfx: scene '%s' drew nothing", scene.name );
+		ErrorIf( unstable != 0, "Gfx: scene '%s' logged %u different command streams", scene.name, unstable );
+	}
+
+	// Command stream of the last frame by type
+	u32 counts[GFXHEADLESSCOMMANDTYPE_COUNT] = { 0 };
+	const GfxHeadlessFrame log = Gfx::headless_frame();
+	for( u32 i = 0; i < log.count; i++ ) { counts[log.commands[i].type]++; }
+	benchmark_header( "Command stream ('rebinds' frame)", "command               | count" );
+	for( u32 type = 0; type < GFXHEADLESSCOMMANDTYPE_COUNT; type++ )
+	{
+		if( counts[type] == 0 ) { continue; }
+		benchmark_row( "%-21s | %5u", Gfx::headless_command_name( static_cast<GfxHeadlessCommandType>( type ) ),
+			counts[type] );
+	}
+
+	SysFonts::free();
+	SysGfx::free();
+#else
+	benchmark_header( "Headless rendering", "skipped: build the benchmarks with -gfx=none" );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
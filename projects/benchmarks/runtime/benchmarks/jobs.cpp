@@ -0,0 +1,76 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/atomics.hpp>
+#include <core/debug.hpp>
+
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+#include <manta/math.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Job system: Jobs::parallel_for over a float transform (serial vs. pool), and submit/wait throughput for empty jobs
+
+static constexpr u32 COUNTS[] = { 10000, 100000, 1000000, 4000000 };
+static constexpr u32 GRAIN = 4096;
+static constexpr u32 EMPTY_JOBS = 100000;
+
+
+static void transform( float *values, const u32 start, const u32 end )
+{
+	for( u32 i = start; i < end; i++ ) { values[i] = sqrtf( values[i] * 1.5f + 1.0f ) * sinf( values[i] ); }
+}
+
+
+static void job_empty( void *userdata )
+{
+	atomic_add<u32>( reinterpret_cast<volatile u32 *>( userdata ), 1 );
+}
+
+
+void benchmark_jobs()
+{
+	benchmark_header( "Jobs::parallel_for (sqrt/sin transform)",
+		"    count |    serial ms |  parallel ms |  speedup |  threads" );
+
+	for( const u32 count : COUNTS )
+	{
+		float *serial = reinterpret_cast<float *>( memory_alloc( count * sizeof( float ) ) );
+		float *parallel = reinterpret_cast<float *>( memory_alloc( count * sizeof( float ) ) );
+		for( u32 i = 0; i < count; i++ ) { serial[i] = parallel[i] = static_cast<float>( i % 1024 ) * 0.01f; }
+
+		Timer timerSerial;
+		transform( serial, 0, count );
+		timerSerial.stop();
+
+		Timer timerParallel;
+		Jobs::parallel_for( 0, count, GRAIN, [parallel]( u32 start, u32 end ) { transform( parallel, start, end ); } );
+		timerParallel.stop();
+
+		ErrorIf( memory_compare( serial, parallel, count * sizeof( float ) ) != 0, "Jobs: parallel_for result mismatch" );
+		benchmark_row( "%9u | %12.3f | %12.3f | %7.1fx | %8u", count, timerSerial.elapsed_ms(),
+			timerParallel.elapsed_ms(), timerSerial.elapsed_ms() /
+			( timerParallel.elapsed_ms() > 0.0 ? timerParallel.elapsed_ms() : 1e-6 ), Jobs::thread_count() );
+
+		memory_free( serial );
+		memory_free( parallel );
+	}
+
+	benchmark_header( "Jobs::submit/wait (empty jobs)", "     jobs |      time ms |  ns / job" );
+	{
+		volatile u32 executed = 0;
+		JobCounter counter;
+
+		Timer timer;
+		for( u32 i = 0; i < EMPTY_JOBS; i++ ) { Jobs::submit( job_empty, const_cast<u32 *>( &executed ), &counter ); }
+		Jobs::wait( counter );
+		timer.stop();
+
+		ErrorIf( executed != EMPTY_JOBS, "Jobs: executed %u of %u jobs", executed, EMPTY_JOBS );
+		benchmark_row( "%9u | %12.3f | %9.1f", EMPTY_JOBS, timer.elapsed_ms(),
+			timer.elapsed_ms() * 1000000.0 / EMPTY_JOBS );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,223 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/audio.simd.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Audio mixer kernels: scalar reference vs. SIMD (see vendor/simd.hpp) for each stage of SysAudio::audio_mixer, then
+// the full mixer with VOICES playing on bus 0. Reports ns per frame per voice and the largest SIMD/scalar difference
+
+static constexpr u32 FRAMES = 1024; // device period
+static constexpr u32 SOURCE_FRAMES = 44100 * 4;
+static constexpr u32 ITERATIONS = 2000;
+static constexpr u32 VOICES[] = { 1, 8, 32 };
+static constexpr float PITCH = 0.917f;
+
+
+static float max_difference( const float *a, const float *b, const u32 count )
+{
+	float result = 0.0f;
+	for( u32 i = 0; i < count; i++ )
+	{
+		const float d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+		result = d > result ? d : result;
+	}
+	return result;
+}
+
+
+static float max_difference( const i16 *a, const i16 *b, const u32 count )
+{
+	float result = 0.0f;
+	for( u32 i = 0; i < count; i++ )
+	{
+		const float d = static_cast<float>( a[i] > b[i] ? a[i] - b[i] : b[i] - a[i] );
+		result = d > result ? d : result;
+	}
+	return result;
+}
+
+
+template <typename Function> static double kernel_ns( Function function )
+{
+	Timer timer;
+	for( u32 i = 0; i < ITERATIONS; i++ ) { function( i ); }
+	timer.stop();
+	return timer.elapsed_ms() * 1000000.0 / ( static_cast<double>( ITERATIONS ) * FRAMES );
+}
+
+
+static void kernel_row( const char *name, const double scalarNs, const double simdNs, const float difference )
+{
+	benchmark_row( "%-16s | %9.3f | %9.3f | %7.2fx | %.2e", name, scalarNs, simdNs,
+		scalarNs / ( simdNs > 0.0 ? simdNs : 1e-9 ), difference );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_mixer()
+{
+	RandomContext rng { 1234 };
+
+	// Sources (mono & interleaved stereo)
+	i16 *mono = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	i16 *stereo = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * 2 * sizeof( i16 ) ) );
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ ) { mono[i] = static_cast<i16>( rng.random<int>( -32768, 32767 ) ); }
+	for( u32 i = 0; i < SOURCE_FRAMES * 2; i++ ) { stereo[i] = static_cast<i16>( rng.random<int>( -32768, 32767 ) ); }
+
+	float *scalar = reinterpret_cast<float *>( memory_alloc( FRAMES * 2 * sizeof( float ) ) );
+	float *simd = reinterpret_cast<float *>( memory_alloc( FRAMES * 2 * sizeof( float ) ) );
+	float *input = reinterpret_cast<float *>( memory_alloc( FRAMES * 2 * sizeof( float ) ) );
+	i16 *outputScalar = reinterpret_cast<i16 *>( memory_alloc( FRAMES * 2 * sizeof( i16 ) ) );
+	i16 *outputSimd = reinterpret_cast<i16 *>( memory_alloc( FRAMES * 2 * sizeof( i16 ) ) );
+	for( u32 i = 0; i < FRAMES * 2; i++ ) { input[i] = rng.random<float>( -1.5f, 1.5f ); }
+
+	// Kernels
+	benchmark_header( "Audio mixer kernels (1024 frame period, ns per frame)",
+		"kernel           |    scalar |      simd |  speedup | max diff" );
+
+	// Read positions stay inside the source: ITERATIONS * FRAMES * PITCH < SOURCE_FRAMES - 1
+	const auto position = []( const u32 i ) { return static_cast<float>( ( i * 97 ) % 1000 ) + 0.37f; };
+	{
+		const double scalarNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_i16_to_float_scalar( scalar, mono + i, FRAMES * 2 ); } );
+		const double simdNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_i16_to_float( simd, mono + i, FRAMES * 2 ); } );
+		kernel_row( "i16 to float", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		// Unit step from a whole frame (device rate == AUDIO_SAMPLE_RATE): a copy
+		const i32 end = static_cast<i32>( SOURCE_FRAMES );
+		const auto whole = []( const u32 i ) { return static_cast<float>( ( i * 97 ) % 1000 ); };
+		const double scalarNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_mono_scalar( scalar, mono, 0, end, whole( i ), 1.0f, FRAMES ); } );
+		const double simdNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_mono( simd, mono, 0, end, whole( i ), 1.0f, FRAMES ); } );
+		kernel_row( "unit mono", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		const i32 end = static_cast<i32>( SOURCE_FRAMES );
+		const auto whole = []( const u32 i ) { return static_cast<float>( ( i * 97 ) % 1000 ); };
+		const double scalarNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_stereo_scalar( scalar, stereo, 0, end, whole( i ), 1.0f, FRAMES ); } );
+		const double simdNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_stereo( simd, stereo, 0, end, whole( i ), 1.0f, FRAMES ); } );
+		kernel_row( "unit stereo", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		const i32 end = static_cast<i32>( SOURCE_FRAMES );
+		const double scalarNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_mono_scalar( scalar, mono, 0, end, position( i ), PITCH, FRAMES ); } );
+		const double simdNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_mono( simd, mono, 0, end, position( i ), PITCH, FRAMES ); } );
+		kernel_row( "sinc mono", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		const i32 end = static_cast<i32>( SOURCE_FRAMES );
+		const double scalarNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_stereo_scalar( scalar, stereo, 0, end, position( i ), PITCH, FRAMES ); } );
+		const double simdNs = kernel_ns( [&]( u32 i )
+			{ SysAudio::mix_resample_sinc_stereo( simd, stereo, 0, end, position( i ), PITCH, FRAMES ); } );
+		kernel_row( "sinc stereo", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		// Sinc edges: taps before 'begin' & past 'end' read silence
+		const i32 end = static_cast<i32>( FRAMES );
+		float difference = 0.0f;
+		SysAudio::mix_resample_sinc_mono_scalar( scalar, mono, 0, end, 0.0f, 0.999f, FRAMES );
+		SysAudio::mix_resample_sinc_mono( simd, mono, 0, end, 0.0f, 0.999f, FRAMES );
+		difference += max_difference( scalar, simd, FRAMES * 2 );
+		SysAudio::mix_resample_sinc_stereo_scalar( scalar, stereo, 0, end, 0.0f, 0.999f, FRAMES );
+		SysAudio::mix_resample_sinc_stereo( simd, stereo, 0, end, 0.0f, 0.999f, FRAMES );
+		difference += max_difference( scalar, simd, FRAMES * 2 );
+		ErrorIf( difference > 1e-5f, "Mixer: sinc resample mismatch at source edges" );
+	}
+	{
+		// Source end: unit step copies stop at 'end', the rest is silent
+		const i32 end = static_cast<i32>( SOURCE_FRAMES );
+		const float position = static_cast<float>( SOURCE_FRAMES - FRAMES / 2 - 3 );
+		SysAudio::mix_resample_sinc_mono_scalar( scalar, mono, 0, end, position, 1.0f, FRAMES );
+		SysAudio::mix_resample_sinc_mono( simd, mono, 0, end, position, 1.0f, FRAMES );
+		const float differenceMono = max_difference( scalar, simd, FRAMES * 2 );
+		const bool silentMono = simd[FRAMES * 2 - 1] == 0.0f && simd[0] == mono[SOURCE_FRAMES - FRAMES / 2 - 3] * ( 1.0f / I16_MAX );
+		SysAudio::mix_resample_sinc_stereo_scalar( scalar, stereo, 0, end, position, 1.0f, FRAMES );
+		SysAudio::mix_resample_sinc_stereo( simd, stereo, 0, end, position, 1.0f, FRAMES );
+		const float differenceStereo = max_difference( scalar, simd, FRAMES * 2 );
+		ErrorIf( differenceMono > 0.0f || differenceStereo > 0.0f || !silentMono,
+			"Mixer: unit step resample mismatch at source end" );
+	}
+	{
+		memory_set( scalar, 0, FRAMES * 2 * sizeof( float ) );
+		memory_set( simd, 0, FRAMES * 2 * sizeof( float ) );
+		const double scalarNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_accumulate_scalar( scalar, input, FRAMES * 2 ); } );
+		const double simdNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_accumulate( simd, input, FRAMES * 2 ); } );
+		kernel_row( "accumulate", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		// Slow ramp around unity so repeated application stays in range
+		memory_copy( scalar, input, FRAMES * 2 * sizeof( float ) );
+		memory_copy( simd, input, FRAMES * 2 * sizeof( float ) );
+		const double scalarNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_gain_ramp_scalar( scalar, FRAMES, 0.9999f, 1e-7f ); } );
+		const double simdNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_gain_ramp( simd, FRAMES, 0.9999f, 1e-7f ); } );
+		kernel_row( "gain ramp", scalarNs, simdNs, max_difference( scalar, simd, FRAMES * 2 ) );
+	}
+	{
+		const double scalarNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_float_to_i16_scalar( outputScalar, input, FRAMES * 2 ); } );
+		const double simdNs = kernel_ns( [&]( u32 i ) { SysAudio::mix_float_to_i16( outputSimd, input, FRAMES * 2 ); } );
+		kernel_row( "float to i16", scalarNs, simdNs, max_difference( outputScalar, outputSimd, FRAMES * 2 ) );
+	}
+
+	// Full mixer
+	benchmark_header( "SysAudio::audio_mixer (1024 frame period, voices on bus 0)",
+		"   voices | channels |   period us |  ns/frame/voice" );
+
+	SoundHandle handles[AUDIO_VOICE_COUNT];
+	for( const u32 voices : VOICES )
+	{
+		for( int channels = 1; channels <= 2; channels++ )
+		{
+			u32 periods = 0;
+			double elapsedMs = 0.0;
+			while( periods < ITERATIONS / 4 )
+			{
+				// Restart voices as they finish
+				for( u32 v = 0; v < voices; v++ )
+				{
+					if( handles[v].is_playing() ) { continue; }
+					AudioEffects effects;
+					effects.set_pitch( 0.5f + 0.05f * static_cast<float>( v % 20 ) );
+					handles[v] = SysAudio::play_sound( 0, channels == 1 ? mono : stereo, SOURCE_FRAMES * channels,
+						channels, effects, "bench" );
+				}
+
+				Timer timer;
+				SysAudio::audio_mixer( outputSimd, FRAMES );
+				timer.stop();
+				elapsedMs += timer.elapsed_ms();
+				periods++;
+			}
+
+			const double periodUs = elapsedMs * 1000.0 / periods;
+			benchmark_row( "%9u | %8d | %11.3f | %15.3f", voices, channels, periodUs,
+				periodUs * 1000.0 / ( static_cast<double>( FRAMES ) * voices ) );
+
+			// Stop (the mixer drains the commands)
+			for( SoundHandle &handle : handles ) { handle.stop(); }
+			SysAudio::audio_mixer( outputSimd, 0 );
+		}
+	}
+
+	memory_free( outputSimd );
+	memory_free( outputScalar );
+	memory_free( input );
+	memory_free( simd );
+	memory_free( scalar );
+	memory_free( stereo );
+	memory_free( mono );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
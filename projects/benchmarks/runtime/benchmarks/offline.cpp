@@ -0,0 +1,210 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/filesystem.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+#include <vendor/stdio.hpp>
+#include <vendor/string.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Offline audio backend (AUDIO_OFFLINE): scripted scenes are rendered by SysAudio::offline_render() as fast as the
+// mixer runs. Reports the realtime factor and the AUDIO_PROFILER cost of each mixer stage per period, checks that
+// rendering a scene twice is bit-identical, and writes a scene to a WAV sink
+
+static constexpr u32 SAMPLE_RATE = 44100;
+static constexpr u32 SOURCE_FRAMES = SAMPLE_RATE * 12; // Outlasts every render (no restarts mid-scene)
+static constexpr u32 RENDER_FRAMES = SAMPLE_RATE * 10;
+static constexpr u32 CHECK_FRAMES = SAMPLE_RATE * 2;
+static constexpr u32 SCENE_BUSES = 4;
+
+struct OfflineScene
+{
+	const char *name;
+	u32 voices;
+	u32 chain;    // 0: core, 1: + lowpass, 2: + lowpass + reverb
+	bool buses;   // Voices spread over SCENE_BUSES AudioContexts with lowpass & reverb bus effects
+	bool automate; // Gain ramps on every voice
+};
+
+static const OfflineScene SCENES[] =
+{
+	{ "one-shots", 32, 0, false, false },
+	{ "automated", 32, 0, false, true },
+	{ "lowpass", 32, 1, false, false },
+	{ "reverb", 32, 2, false, false },
+	{ "virtual", 1000, 0, false, false },
+	{ "buses", 32, 0, true, false },
+};
+
+static SoundHandle g_handles[AUDIO_VOICE_COUNT];
+static AudioContext g_contexts[SCENE_BUSES];
+static const char *CONTEXT_NAMES[SCENE_BUSES] = { "bench0", "bench1", "bench2", "bench3" };
+
+
+static int context_bus( const u32 context )
+{
+	// AudioContext keeps its bus private: find it by name
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		if( !SysAudio::buses[i].available && SysAudio::buses[i].name == CONTEXT_NAMES[context] ) { return i; }
+	}
+	return -1;
+}
+
+
+static void scene_start( const OfflineScene &scene, const i16 *samples )
+{
+	RandomContext rng { 1234 };
+
+	int buses[SCENE_BUSES] = { 0 };
+	if( scene.buses )
+	{
+		for( u32 i = 0; i < SCENE_BUSES; i++ )
+		{
+			AudioEffects effects;
+			effects.set_lowpass_cutoff( 4000.0f + 2000.0f * i );
+			effects.set_reverb_wet( 0.3f );
+			g_contexts[i].init( effects, CONTEXT_NAMES[i] );
+			buses[i] = context_bus( i );
+			ErrorIf( buses[i] < 0, "Offline: bus context %u missing", i );
+		}
+	}
+
+	for( u32 i = 0; i < scene.voices; i++ )
+	{
+		AudioEffects effects;
+		const float gain = rng.random<float>( 0.05f, 0.5f );
+		if( scene.automate ) { effects.set_gain( 0.0f, gain, 2000 ); } else { effects.set_gain( gain ); }
+		effects.set_pitch( rng.random<float>( 0.5f, 1.5f ) );
+		if( scene.chain >= 1 ) { effects.set_lowpass_cutoff( rng.random<float>( 500.0f, 8000.0f ) ); }
+		if( scene.chain >= 2 ) { effects.set_reverb_wet( 0.4f ); }
+
+		const int bus = scene.buses ? buses[i % SCENE_BUSES] : 0;
+		const SoundHandle handle = SysAudio::play_sound( bus, samples, SOURCE_FRAMES, 1, effects, "bench" );
+		ErrorIf( handle.voice < 0, "Offline: scene '%s' play %u failed", scene.name, i );
+		g_handles[handle.voice] = handle;
+	}
+}
+
+
+static void scene_stop( const OfflineScene &scene )
+{
+	// The next render drains the commands
+	for( SoundHandle &handle : g_handles ) { handle.stop(); handle = SoundHandle { }; }
+	if( scene.buses ) { for( AudioContext &context : g_contexts ) { context.free(); } }
+	SysAudio::offline_sink_discard();
+	SysAudio::offline_render( AUDIO_OFFLINE_PERIOD_FRAMES );
+}
+
+
+static double stage_us( const double seconds, const u32 periods )
+{
+	return seconds * 1000000.0 / ( periods > 0 ? periods : 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_offline()
+{
+	// Low-passed noise so resampling & filters have something to work on
+	RandomContext rng { 1234 };
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	float smooth = 0.0f;
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ )
+	{
+		smooth += ( rng.random<float>( -16384.0f, 16384.0f ) - smooth ) * 0.2f;
+		samples[i] = static_cast<i16>( smooth );
+	}
+
+	// Realtime factor & per-stage cost
+	benchmark_header( "Offline render (10 s per scene, AUDIO_OFFLINE_PERIOD_FRAMES periods, stage us per period)",
+		"scene     | voices | render ms | realtime | commands |   voices |  effects |    buses |   master" );
+	for( const OfflineScene &scene : SCENES )
+	{
+		scene_start( scene, samples );
+		SysAudio::offline_sink_discard();
+		SysAudio::mixer_profile_reset();
+
+		Timer timer;
+		SysAudio::offline_render( RENDER_FRAMES );
+		timer.stop();
+
+		const SysAudio::MixerProfile profile = SysAudio::mixer_profile();
+		ErrorIf( profile.frames != RENDER_FRAMES || SysAudio::offline_sink_frames() != RENDER_FRAMES,
+			"Offline: scene '%s' rendered %llu frames", scene.name, profile.frames );
+		const double renderedMs = RENDER_FRAMES * 1000.0 / SAMPLE_RATE;
+		benchmark_row( "%-9s | %6u | %9.3f | %7.1fx | %8.2f | %8.2f | %8.2f | %8.2f | %8.2f", scene.name, scene.voices,
+			timer.elapsed_ms(), renderedMs / ( timer.elapsed_ms() > 0.0 ? timer.elapsed_ms() : 1e-6 ),
+			stage_us( profile.commands, profile.periods ), stage_us( profile.voices, profile.periods ),
+			stage_us( profile.effects, profile.periods ), stage_us( profile.buses, profile.periods ),
+			stage_us( profile.master, profile.periods ) );
+
+		scene_stop( scene );
+	}
+
+	// Determinism: the same scene rendered twice into memory is bit-identical
+	{
+		i16 *first = reinterpret_cast<i16 *>( memory_alloc( CHECK_FRAMES * 2 * sizeof( i16 ) ) );
+		i16 *second = reinterpret_cast<i16 *>( memory_alloc( CHECK_FRAMES * 2 * sizeof( i16 ) ) );
+		const OfflineScene &scene = SCENES[5];
+
+		scene_start( scene, samples );
+		SysAudio::offline_sink_memory( first, CHECK_FRAMES );
+		SysAudio::offline_render( CHECK_FRAMES );
+		scene_stop( scene );
+
+		scene_start( scene, samples );
+		SysAudio::offline_sink_memory( second, CHECK_FRAMES );
+		SysAudio::offline_render( CHECK_FRAMES );
+		scene_stop( scene );
+
+		u32 mismatches = 0;
+		i32 peak = 0;
+		for( u32 i = 0; i < CHECK_FRAMES * 2; i++ )
+		{
+			mismatches += first[i] != second[i];
+			peak = first[i] > peak ? first[i] : ( -first[i] > peak ? -first[i] : peak );
+		}
+		benchmark_row( "determinism | '%s' rendered twice: %u mismatched samples (peak %d)", scene.name, mismatches, peak );
+		ErrorIf( mismatches != 0 || peak == 0, "Offline: renders differ or are silent" );
+
+		memory_free( second );
+		memory_free( first );
+	}
+
+	// WAV sink (kept next to the executable for listening): header sizes are patched when the sink closes
+	{
+		char path[sizeof( WORKING_DIRECTORY ) + sizeof( "offline.wav" )];
+		snprintf( path, sizeof( path ), "%s%s", WORKING_DIRECTORY, "offline.wav" );
+		const OfflineScene &scene = SCENES[3];
+
+		scene_start( scene, samples );
+		ErrorIf( !SysAudio::offline_sink_wav( path ), "Offline: failed to open '%s'", path );
+		SysAudio::offline_render( CHECK_FRAMES );
+		const u64 frames = SysAudio::offline_sink_frames();
+		scene_stop( scene );
+
+		u8 header[44];
+		FILE *file = fopen( path, "rb" );
+		ErrorIf( file == nullptr, "Offline: failed to reopen '%s'", path );
+		const usize size = fsize( file );
+		const bool read = fread( header, sizeof( header ), 1, file ) == 1;
+		fclose( file );
+
+		const u32 dataSize = header[40] | ( header[41] << 8 ) | ( header[42] << 16 ) | ( static_cast<u32>( header[43] ) << 24 );
+		const bool valid = read && memcmp( header, "RIFF", 4 ) == 0 && memcmp( header + 8, "WAVE", 4 ) == 0 &&
+			dataSize == frames * 4 && size == sizeof( header ) + dataSize;
+		benchmark_row( "       wav | '%s' %llu frames, %llu bytes, header %s", scene.name, frames, static_cast<u64>( size ), valid ? "valid" : "INVALID" );
+		ErrorIf( !valid || frames != CHECK_FRAMES, "Offline: invalid WAV output" );
+	}
+
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
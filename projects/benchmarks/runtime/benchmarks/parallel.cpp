@@ -0,0 +1,158 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/random.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+#include <vendor/stdio.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Parallel mixing (SysAudio::init_workers): voice groups & buses mixed by worker threads alongside the audio thread.
+// Renders each scene offline with 0-4 workers, reports the period time against its budget, the speedup over serial
+// mixing & the tasks workers took, and checks the output is bit-identical to serial mixing
+
+static constexpr u32 SOURCE_FRAMES = AUDIO_SAMPLE_RATE * 6; // Outlasts every render (no restarts mid-scene)
+static constexpr u32 RENDER_FRAMES = AUDIO_SAMPLE_RATE * 4;
+static constexpr u32 SCENE_BUSES = 8;
+static constexpr u32 WORKERS[] = { 0, 1, 2, 4 };
+
+struct ParallelScene
+{
+	const char *name;
+	u32 voices;
+	u32 buses;    // AudioContexts the voices are spread over (0: master bus)
+	u32 reverbs;  // Buses with a reverb (AUDIO_EFFECT_REVERB_POOL_SIZE at most)
+	bool lowpass; // Per-voice lowpass
+};
+
+static const ParallelScene SCENES[] =
+{
+	{ "one bus", 32, 0, 0, false },
+	{ "lowpass", 32, 0, 0, true },
+	{ "buses", 32, 4, 4, true },
+	{ "8 buses", 64, 8, 4, true },
+};
+
+static SoundHandle g_handles[AUDIO_VOICE_COUNT];
+static AudioContext g_contexts[SCENE_BUSES];
+static const char *CONTEXT_NAMES[SCENE_BUSES] =
+	{ "par0", "par1", "par2", "par3", "par4", "par5", "par6", "par7" };
+
+
+static int context_bus( const u32 context )
+{
+	// AudioContext keeps its bus private: find it by name
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		if( !SysAudio::buses[i].available && SysAudio::buses[i].name == CONTEXT_NAMES[context] ) { return i; }
+	}
+	return -1;
+}
+
+
+static void scene_start( const ParallelScene &scene, const i16 *samples )
+{
+	RandomContext rng { 4321 };
+
+	int buses[SCENE_BUSES] = { 0 };
+	for( u32 i = 0; i < scene.buses; i++ )
+	{
+		AudioEffects effects;
+		effects.set_lowpass_cutoff( 3000.0f + 1000.0f * i );
+		if( i < scene.reverbs ) { effects.set_reverb_wet( 0.3f ); }
+		g_contexts[i].init( effects, CONTEXT_NAMES[i] );
+		buses[i] = context_bus( i );
+		ErrorIf( buses[i] < 0, "Parallel: bus context %u missing", i );
+	}
+
+	for( u32 i = 0; i < scene.voices; i++ )
+	{
+		AudioEffects effects;
+		effects.set_gain( rng.random<float>( 0.05f, 0.3f ) );
+		effects.set_pitch( rng.random<float>( 0.5f, 1.5f ) );
+		if( scene.lowpass ) { effects.set_lowpass_cutoff( rng.random<float>( 500.0f, 8000.0f ) ); }
+
+		const int bus = scene.buses > 0 ? buses[i % scene.buses] : 0;
+		const SoundHandle handle = SysAudio::play_sound( bus, samples, SOURCE_FRAMES, 1, effects, "bench" );
+		ErrorIf( handle.voice < 0, "Parallel: scene '%s' play %u failed", scene.name, i );
+		g_handles[handle.voice] = handle;
+	}
+}
+
+
+static void scene_stop( const ParallelScene &scene )
+{
+	// The next render drains the commands
+	for( SoundHandle &handle : g_handles ) { handle.stop(); handle = SoundHandle { }; }
+	for( u32 i = 0; i < scene.buses; i++ ) { g_contexts[i].free(); }
+	SysAudio::offline_sink_discard();
+	SysAudio::offline_render( AUDIO_OFFLINE_PERIOD_FRAMES );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_parallel()
+{
+	// Low-passed noise so resampling & filters have something to work on
+	RandomContext rng { 4321 };
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	float smooth = 0.0f;
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ )
+	{
+		smooth += ( rng.random<float>( -16384.0f, 16384.0f ) - smooth ) * 0.2f;
+		samples[i] = static_cast<i16>( smooth );
+	}
+
+	i16 *serial = reinterpret_cast<i16 *>( memory_alloc( RENDER_FRAMES * 2 * sizeof( i16 ) ) );
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( RENDER_FRAMES * 2 * sizeof( i16 ) ) );
+
+	char title[128];
+	snprintf( title, sizeof( title ), "Parallel mixing (4 s per scene, %u hardware threads, us per period)",
+		Thread::hardware_threads() );
+	benchmark_header( title,
+		"scene    | voices | workers | period us | speedup | load % | peak % | parallel | misses | worker tasks | diff" );
+	for( const ParallelScene &scene : SCENES )
+	{
+		double serialUs = 0.0;
+		for( const u32 workers : WORKERS )
+		{
+			ErrorIf( !SysAudio::init_workers( workers ), "Parallel: failed to start %u workers", workers );
+			scene_start( scene, samples );
+			SysAudio::offline_sink_memory( workers == 0 ? serial : output, RENDER_FRAMES );
+			SysAudio::mixer_statistics_reset();
+			SysAudio::offline_render( RENDER_FRAMES );
+			const SysAudio::MixerStatistics statistics = SysAudio::mixer_statistics();
+			scene_stop( scene );
+			SysAudio::free_workers();
+
+			// Same mixing order on any thread: output matches serial mixing exactly
+			u32 mismatches = 0;
+			if( workers > 0 )
+			{
+				for( u32 i = 0; i < RENDER_FRAMES * 2; i++ ) { mismatches += serial[i] != output[i]; }
+			}
+
+			const u32 periods = statistics.periods > 0 ? statistics.periods : 1;
+			const double us = static_cast<double>( statistics.usTotal ) / periods;
+			if( workers == 0 ) { serialUs = us; }
+			benchmark_row( "%-8s | %6u | %7u | %9.1f | %6.2fx | %6.1f | %6u | %8u | %6u | %12u | %4u", scene.name,
+				scene.voices, workers, us, serialUs / ( us > 0.0 ? us : 1e-6 ),
+				100.0 * statistics.usTotal / ( statistics.budgetUsTotal > 0 ? statistics.budgetUsTotal : 1 ),
+				statistics.loadPeak, statistics.parallel, statistics.deadlineMisses, statistics.workerTasks, mismatches );
+			ErrorIf( statistics.periods != RENDER_FRAMES / AUDIO_OFFLINE_PERIOD_FRAMES + ( RENDER_FRAMES % AUDIO_OFFLINE_PERIOD_FRAMES != 0 ),
+				"Parallel: scene '%s' mixed %u periods", scene.name, statistics.periods );
+			ErrorIf( mismatches != 0, "Parallel: scene '%s' with %u workers differs from serial mixing", scene.name, workers );
+		}
+	}
+
+	memory_free( output );
+	memory_free( serial );
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
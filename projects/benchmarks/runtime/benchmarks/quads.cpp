@@ -0,0 +1,261 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/draw.hpp>
+#include <manta/gfx.hpp>
+#include <manta/math.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bulk quads: scalar reference vs. dispatched kernel (see manta/gfx.simd.hpp: SIMD for rotated fills only) for the
+// Gfx::quad_fill* kernels, then 100k particles & tiles submitted through Gfx::quad_batch_write() vs.
+// Gfx::quad_batch_reserve() + fills (build with -gfx=none for the submission half, which also checks that both log the
+// same command stream)
+
+static constexpr u32 QUADS = 100000;
+static constexpr u32 KERNEL_QUADS = 4099; // Not a multiple of the SIMD width (scalar tails)
+static constexpr u32 KERNEL_FIRST = 3; // Offset into the input arrays
+static constexpr u32 ITERATIONS = 200;
+static constexpr u32 FRAMES = 16;
+static constexpr float WIDTH = 1280.0f;
+static constexpr float HEIGHT = 720.0f;
+
+struct QuadsInput
+{
+	float *x;
+	float *y;
+	float *sin;
+	float *cos;
+	GfxQuadUV *uvs;
+	Color *colors;
+};
+
+struct QuadsCase
+{
+	const char *name;
+	bool rotated;
+	bool uvs;
+	bool colors;
+};
+
+static const QuadsCase CASES[] =
+{
+	{ "sprites", false, false, true },
+	{ "tiles", false, true, false },
+	{ "rotated", true, false, true },
+	{ "rotated/uvs", true, true, true },
+};
+
+
+static GfxQuadFill quads_fill( const QuadsInput &input, const QuadsCase &test )
+{
+	GfxQuadFill fill;
+	fill.x = input.x;
+	fill.y = input.y;
+	fill.sin = input.sin;
+	fill.cos = input.cos;
+	fill.uvs = test.uvs ? input.uvs : nullptr;
+	fill.colors = test.colors ? input.colors : nullptr;
+	fill.width = 16.0f;
+	fill.height = 24.0f;
+	fill.xorigin = 8.0f;
+	fill.yorigin = 12.0f;
+	fill.depth = 0.5f;
+	fill.uv = { 0, 0, 4096, 8192 };
+	fill.color = Color { 255, 128, 64, 255 };
+	return fill;
+}
+
+
+static void quads_compare( const GfxBuiltInQuad *a, const GfxBuiltInQuad *b, const u32 count, float &position,
+	u32 &mismatches )
+{
+	// Positions may round differently (contracted multiply-adds); depth, UVs & colors must match exactly
+	position = 0.0f;
+	mismatches = 0;
+	for( u32 i = 0; i < count; i++ )
+	{
+		const GfxVertex::BuiltinVertex *va = &a[i].v1;
+		const GfxVertex::BuiltinVertex *vb = &b[i].v1;
+		for( u32 v = 0; v < 4; v++ )
+		{
+			const float dx = va[v].position.x - vb[v].position.x;
+			const float dy = va[v].position.y - vb[v].position.y;
+			position = max( position, max( dx < 0.0f ? -dx : dx, dy < 0.0f ? -dy : dy ) );
+			mismatches += va[v].position.z != vb[v].position.z ||
+				memory_compare( &va[v].uv, &vb[v].uv, sizeof( va[v].uv ) ) != 0 ||
+				memory_compare( &va[v].color, &vb[v].color, sizeof( va[v].color ) ) != 0;
+		}
+	}
+}
+
+
+template <typename Function> static double kernel_ns( Function function )
+{
+	Timer timer;
+	for( u32 i = 0; i < ITERATIONS; i++ ) { function(); }
+	timer.stop();
+	return timer.elapsed_ms() * 1000000.0 / ( static_cast<double>( ITERATIONS ) * KERNEL_QUADS );
+}
+
+
+static void quads_fill( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const bool rotated, const u32 first,
+	const u32 count )
+{
+	if( rotated ) { Gfx::quad_fill_rotated( quads, fill, first, count ); }
+	else { Gfx::quad_fill( quads, fill, first, count ); }
+}
+
+
+static void quads_fill_scalar( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const bool rotated, const u32 first,
+	const u32 count )
+{
+	if( rotated ) { Gfx::quad_fill_rotated_scalar( quads, fill, first, count ); }
+	else { Gfx::quad_fill_scalar( quads, fill, first, count ); }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if RENDER_NONE
+static void frame_begin()
+{
+	Gfx::frame_begin();
+	Gfx::clear_color( { 20, 20, 40 } );
+	Gfx::set_matrix_mvp_2d_orthographic( 0.0f, 0.0f, 1.0f, 0.0f, WIDTH, HEIGHT );
+}
+
+
+static void submit_write( const GfxQuadFill &fill, const bool rotated, const GfxTexture2D *texture )
+{
+	// One quad at a time, built on the stack
+	for( u32 i = 0; i < QUADS; i++ )
+	{
+		GfxBuiltInQuad quad;
+		quads_fill_scalar( &quad, fill, rotated, i, 1 );
+		Gfx::quad_batch_write( quad, texture );
+	}
+}
+
+
+static void submit_reserve( const GfxQuadFill &fill, const bool rotated, const GfxTexture2D *texture )
+{
+	// Filled in place, one span per batch
+	for( u32 i = 0; i < QUADS; )
+	{
+		const GfxQuadSpan span = Gfx::quad_batch_reserve( QUADS - i, texture );
+		quads_fill( span.quads, fill, rotated, i, span.count );
+		i += span.count;
+	}
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_quads()
+{
+	RandomContext rng { 1234 };
+
+	QuadsInput input;
+	input.x = reinterpret_cast<float *>( memory_alloc( QUADS * sizeof( float ) ) );
+	input.y = reinterpret_cast<float *>( memory_alloc( QUADS * sizeof( float ) ) );
+	input.sin = reinterpret_cast<float *>( memory_alloc( QUADS * sizeof( float ) ) );
+	input.cos = reinterpret_cast<float *>( memory_alloc( QUADS * sizeof( float ) ) );
+	input.uvs = reinterpret_cast<GfxQuadUV *>( memory_alloc( QUADS * sizeof( GfxQuadUV ) ) );
+	input.colors = reinterpret_cast<Color *>( memory_alloc( QUADS * sizeof( Color ) ) );
+	for( u32 i = 0; i < QUADS; i++ )
+	{
+		input.x[i] = rng.random<float>( 0.0f, WIDTH );
+		input.y[i] = rng.random<float>( 0.0f, HEIGHT );
+		fast_sin_cos( degtorad( rng.random<float>( 0.0f, 360.0f ) ), input.sin[i], input.cos[i] );
+		const u16 u = static_cast<u16>( rng.random<int>( 0, 15 ) * 4096 );
+		const u16 v = static_cast<u16>( rng.random<int>( 0, 15 ) * 4096 );
+		input.uvs[i] = { u, v, static_cast<u16>( u + 4095 ), static_cast<u16>( v + 4095 ) };
+		input.colors[i] = Color { static_cast<u8>( i ), static_cast<u8>( i >> 8 ), 255, 255 };
+	}
+
+	// Kernels
+	GfxBuiltInQuad *scalar = reinterpret_cast<GfxBuiltInQuad *>( memory_alloc( QUADS * sizeof( GfxBuiltInQuad ) ) );
+	GfxBuiltInQuad *simd = reinterpret_cast<GfxBuiltInQuad *>( memory_alloc( QUADS * sizeof( GfxBuiltInQuad ) ) );
+
+	benchmark_header( "Quad fill kernels (ns per quad)",
+		"kernel           |    scalar |  dispatch |  speedup | max diff | mismatches" );
+	for( const QuadsCase &test : CASES )
+	{
+		const GfxQuadFill fill = quads_fill( input, test );
+		const double scalarNs = kernel_ns( [&]()
+			{ quads_fill_scalar( scalar, fill, test.rotated, KERNEL_FIRST, KERNEL_QUADS ); } );
+		const double simdNs = kernel_ns( [&]()
+			{ quads_fill( simd, fill, test.rotated, KERNEL_FIRST, KERNEL_QUADS ); } );
+
+		float difference;
+		u32 mismatches;
+		quads_compare( scalar, simd, KERNEL_QUADS, difference, mismatches );
+		benchmark_row( "%-16s | %9.3f | %9.3f | %7.2fx | %.2e | %10u", test.name, scalarNs, simdNs,
+			scalarNs / ( simdNs > 0.0 ? simdNs : 1e-9 ), difference, mismatches );
+		ErrorIf( mismatches != 0 || difference > 1e-3f, "Quads: '%s' dispatched fill differs from the scalar reference",
+			test.name );
+	}
+
+#if RENDER_NONE
+	// Submission
+	ErrorIf( !SysGfx::init(), "Quads: failed to initialize the headless backend" );
+	const GfxTexture2D *const texture = &GfxCore::textures[Assets::sprites[SPRITE_DEFAULT].texture];
+
+	benchmark_header( "100k quad submission (CPU per frame)",
+		"scene                |  write us | reserve us | speedup | draws | same stream" );
+	for( const QuadsCase &test : CASES )
+	{
+		const GfxQuadFill fill = quads_fill( input, test );
+		for( u32 deferred = 0; deferred < 2; deferred++ )
+		{
+			double us[2] = { 0.0, 0.0 };
+			GfxHeadlessFrame logs[2];
+			for( u32 mode = 0; mode < 2; mode++ )
+			{
+				for( u32 frame = 0; frame < FRAMES; frame++ )
+				{
+					Timer timer;
+					frame_begin();
+					if( deferred ) { Gfx::quad_batch_deferred_begin(); }
+					if( mode == 0 ) { submit_write( fill, test.rotated, texture ); }
+					else { submit_reserve( fill, test.rotated, texture ); }
+					if( deferred ) { Gfx::quad_batch_deferred_end(); }
+					Gfx::frame_end();
+					timer.stop();
+
+					if( frame == 0 ) { continue; }
+					logs[mode] = Gfx::headless_frame();
+					us[mode] += timer.elapsed_us();
+				}
+				us[mode] /= FRAMES - 1;
+			}
+
+			char scene[32];
+			snprintf( scene, sizeof( scene ), "%s%s", test.name, deferred ? "/deferred" : "" );
+			const bool same = logs[0].checksum == logs[1].checksum && logs[0].count == logs[1].count;
+			benchmark_row( "%-20s | %9.1f | %10.1f | %6.2fx | %5u | %11s", scene, us[0], us[1], us[0] / us[1],
+				logs[1].drawCalls, same ? "yes" : "no" );
+			ErrorIf( !same, "Quads: '%s' logged a different command stream through Gfx::quad_batch_reserve()", scene );
+		}
+	}
+
+	SysGfx::free();
+#else
+	benchmark_header( "100k quad submission", "skipped: build the benchmarks with -gfx=none" );
+#endif
+
+	memory_free( simd );
+	memory_free( scalar );
+	memory_free( input.colors );
+	memory_free( input.uvs );
+	memory_free( input.cos );
+	memory_free( input.sin );
+	memory_free( input.y );
+	memory_free( input.x );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/atomics.hpp>
+#include <core/debug.hpp>
+
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Queue contention: ConcurrentQueue (mutex + condition) vs. MpmcQueue vs. SpscRing across producers x consumers x
+// payload size. Every producer pushes ITEMS elements; consumers verify the sum of received sequence numbers
+
+static constexpr u32 ITEMS = 200000;
+static constexpr u32 CAPACITY = 1024;
+
+struct QueueSetup
+{
+	u32 producers;
+	u32 consumers;
+};
+
+static constexpr QueueSetup SETUPS[] = { { 1, 1 }, { 1, 4 }, { 4, 1 }, { 2, 2 }, { 4, 4 } };
+
+
+template <usize BYTES> struct QueuePayload
+{
+	static_assert( BYTES >= sizeof( u64 ) && BYTES % sizeof( u64 ) == 0, "QueuePayload: invalid size" );
+	u64 words[BYTES / sizeof( u64 )];
+};
+
+
+template <typename Queue> struct QueueTest
+{
+	Queue *queue;
+	u32 producers;
+	volatile u32 producersDone;
+	volatile u32 threadsDone;
+	volatile u64 consumed;
+	volatile u64 checksum;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T> static bool queue_push( ConcurrentQueue<T> &queue, const T &element ) { return queue.enqueue( element ); }
+template <typename T> static bool queue_pop( ConcurrentQueue<T> &queue, T &element ) { return queue.dequeue( element ); }
+template <typename T> static bool queue_push( MpmcQueue<T> &queue, const T &element ) { return queue.push( element ); }
+template <typename T> static bool queue_pop( MpmcQueue<T> &queue, T &element ) { return queue.pop( element ); }
+template <typename T, usize N> static bool queue_push( SpscRing<T, N> &queue, const T &element ) { return queue.push( element ); }
+template <typename T, usize N> static bool queue_pop( SpscRing<T, N> &queue, T &element ) { return queue.pop( element ); }
+
+
+template <typename Queue, typename T> static THREAD_FUNCTION( queue_producer )
+{
+	QueueTest<Queue> &test = *reinterpret_cast<QueueTest<Queue> *>( userdata );
+
+	T element;
+	memory_set( &element, 0, sizeof( T ) );
+	for( u32 i = 0; i < ITEMS; i++ )
+	{
+		element.words[0] = i;
+		while( !queue_push( *test.queue, element ) ) { Thread::yield(); }
+	}
+
+	atomic_add<u32>( &test.producersDone, 1 );
+	atomic_add<u32>( &test.threadsDone, 1 );
+	return 0;
+}
+
+
+template <typename Queue, typename T> static THREAD_FUNCTION( queue_consumer )
+{
+	QueueTest<Queue> &test = *reinterpret_cast<QueueTest<Queue> *>( userdata );
+
+	u64 consumed = 0;
+	u64 checksum = 0;
+	T element;
+	for( ;; )
+	{
+		if( queue_pop( *test.queue, element ) ) { consumed++; checksum += element.words[0]; continue; }
+
+		// Producers finished: drain whatever is left, then exit
+		if( atomic_load( &test.producersDone ) == test.producers )
+		{
+			if( !queue_pop( *test.queue, element ) ) { break; }
+			consumed++; checksum += element.words[0];
+			continue;
+		}
+
+		Thread::yield();
+	}
+
+	atomic_add<u64>( &test.consumed, consumed );
+	atomic_add<u64>( &test.checksum, checksum );
+	atomic_add<u32>( &test.threadsDone, 1 );
+	return 0;
+}
+
+
+template <typename Queue, typename T> static void queue_run( const char *name, Queue &queue, const QueueSetup &setup )
+{
+	QueueTest<Queue> test { &queue, setup.producers, 0, 0, 0, 0 };
+
+	Timer timer;
+	for( u32 i = 0; i < setup.consumers; i++ ) { Thread::create( queue_consumer<Queue, T>, &test ); }
+	for( u32 i = 0; i < setup.producers; i++ ) { Thread::create( queue_producer<Queue, T>, &test ); }
+	while( atomic_load( &test.threadsDone ) < setup.producers + setup.consumers ) { Thread::sleep( 1 ); }
+	timer.stop();
+
+	const u64 items = static_cast<u64>( ITEMS ) * setup.producers;
+	const u64 checksum = static_cast<u64>( ITEMS ) * ( ITEMS - 1 ) / 2 * setup.producers;
+	ErrorIf( test.consumed != items || test.checksum != checksum, "%s: lost elements (consumed %llu of %llu)",
+		name, test.consumed, items );
+
+	benchmark_row( "%-16s | %9u | %9u | %7llu B | %12.3f | %10.2f", name, setup.producers, setup.consumers,
+		static_cast<u64>( sizeof( T ) ), timer.elapsed_ms(), items / ( timer.elapsed_ms() * 1000.0 ) );
+}
+
+
+template <usize BYTES> static void queue_payload()
+{
+	using T = QueuePayload<BYTES>;
+
+	for( const QueueSetup &setup : SETUPS )
+	{
+		ConcurrentQueue<T> concurrent;
+		concurrent.init( CAPACITY );
+		queue_run<ConcurrentQueue<T>, T>( "ConcurrentQueue", concurrent, setup );
+		concurrent.free();
+
+		MpmcQueue<T> mpmc;
+		mpmc.init( CAPACITY );
+		queue_run<MpmcQueue<T>, T>( "MpmcQueue", mpmc, setup );
+		mpmc.free();
+
+		if( setup.producers == 1 && setup.consumers == 1 )
+		{
+			static SpscRing<T, CAPACITY> spsc;
+			spsc.clear();
+			queue_run<SpscRing<T, CAPACITY>, T>( "SpscRing", spsc, setup );
+		}
+	}
+}
+
+
+void benchmark_queues()
+{
+	benchmark_header( "Queue contention (200000 elements per producer)",
+		"queue            | producers | consumers |   payload |      time ms |  Mitems/s" );
+
+	queue_payload<8>();
+	queue_payload<64>();
+	queue_payload<256>();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
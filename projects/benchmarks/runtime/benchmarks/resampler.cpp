@@ -0,0 +1,254 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+#include <core/resample.hpp>
+
+#include <manta/assets.hpp>
+#include <manta/audio.hpp>
+#include <manta/audio.simd.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+#include <vendor/math.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sample rate independence: sounds stay at AUDIO_SAMPLE_RATE and the mixer resamples to the device rate. Measures the
+// SNR of pure tones through the sinc mixer kernels (against a linear baseline) and the build-time resample_i16(), then
+// renders a tone and the first song offline at each device rate (pitch must not change, streams must match in-memory
+// playback)
+
+static constexpr u32 SOURCE_FRAMES = AUDIO_SAMPLE_RATE * 2;
+static constexpr u32 FRAMES = 1024; // device period
+static constexpr u32 EDGE_FRAMES = 64; // Skipped when measuring (filter warm-up)
+static constexpr float TONES[] = { 1000.0f, 5000.0f, 10000.0f, 15000.0f };
+static constexpr u32 DEVICE_RATES[] = { 44100, 48000, 32000 };
+static constexpr double PI_F64 = 3.14159265358979323846;
+
+// Streams read from a window relative float position, voices from an absolute one: rounding differs by a few LSB
+static constexpr i32 DIFFERENCE_MAX = 32;
+
+
+static void tone( i16 *samples, const u32 frames, const double hz, const double rate )
+{
+	for( u32 i = 0; i < frames; i++ ) { samples[i] = static_cast<i16>( 16384.0 * sin( 2.0 * PI_F64 * hz * i / rate ) ); }
+}
+
+
+static double snr_db( const double signal, const double noise )
+{
+	return noise <= 0.0 ? 999.0 : 10.0 * log10( signal / noise );
+}
+
+
+static void resample_linear( float *output, const i16 *samples, const float step, const u32 frames )
+{
+	// Baseline only (the mixer resamples through the sinc kernels)
+	for( u32 k = 0; k < frames; k++ )
+	{
+		const float p = static_cast<float>( k ) * step;
+		const u32 index = static_cast<u32>( p );
+		const float s1 = samples[index] * ( 1.0f / I16_MAX );
+		const float s2 = index + 1 < SOURCE_FRAMES ? samples[index + 1] * ( 1.0f / I16_MAX ) : s1;
+		output[k * 2 + 0] = s1 + ( s2 - s1 ) * ( p - static_cast<float>( index ) );
+		output[k * 2 + 1] = output[k * 2 + 0];
+	}
+}
+
+
+static double kernel_snr( const i16 *samples, float *output, const float hz, const float step, const bool sinc )
+{
+	// 'output' holds 'frames' stereo frames read at 'step' source frames per frame
+	const u32 frames = static_cast<u32>( ( SOURCE_FRAMES - EDGE_FRAMES ) / step );
+	if( sinc ) { SysAudio::mix_resample_sinc_mono( output, samples, 0, SOURCE_FRAMES, 0.0f, step, frames ); }
+	else { resample_linear( output, samples, step, frames ); }
+
+	double signal = 0.0;
+	double noise = 0.0;
+	for( u32 k = EDGE_FRAMES; k < frames - EDGE_FRAMES; k++ )
+	{
+		const double expected = 0.5 * sin( 2.0 * PI_F64 * hz * ( static_cast<double>( k ) * step ) / AUDIO_SAMPLE_RATE );
+		const double error = output[k * 2] - expected;
+		signal += expected * expected;
+		noise += error * error;
+	}
+	return snr_db( signal, noise );
+}
+
+
+static double render_hz( const i16 *output, const u32 frames, const u32 rate )
+{
+	// Frequency from rising zero crossings (left channel)
+	u32 first = 0;
+	u32 last = 0;
+	u32 crossings = 0;
+	for( u32 i = 1; i < frames; i++ )
+	{
+		if( !( output[( i - 1 ) * 2] < 0 && output[i * 2] >= 0 ) ) { continue; }
+		if( crossings == 0 ) { first = i; }
+		last = i;
+		crossings++;
+	}
+	return crossings < 2 ? 0.0 : ( crossings - 1 ) * static_cast<double>( rate ) / ( last - first );
+}
+
+
+static void stream_wait_drained()
+{
+	SysAudio::audio_mixer( nullptr, 0 );
+	while( SysAudio::stream_statistics().playing != 0 ) { Thread::sleep( 1 ); }
+}
+
+
+static u32 render_song( const SoundHandle &handle, i16 *output, const u32 capacity, const bool streamed )
+{
+	// Returns the frames rendered until the song finished (streams give the read thread time between periods)
+	u32 frames = 0;
+	while( handle.is_playing() )
+	{
+		ErrorIf( frames + FRAMES > capacity, "Resampler: song output overflow" );
+		SysAudio::offline_sink_memory( &output[frames * 2], FRAMES );
+		SysAudio::offline_render( FRAMES );
+		frames += FRAMES;
+		if( streamed ) { Thread::sleep( 1 ); }
+	}
+	SysAudio::offline_sink_discard();
+	return frames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void benchmark_resampler()
+{
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	float *output = reinterpret_cast<float *>( memory_alloc( SOURCE_FRAMES * 2 * 2 * sizeof( float ) ) );
+
+	// Mixer kernels: a source tone resampled to each device rate
+	benchmark_header( "Mixer resampling SNR (sine at AUDIO_SAMPLE_RATE, dB)",
+		"   tone Hz | device Hz | linear | sinc" );
+	for( const u32 rate : DEVICE_RATES )
+	{
+		if( rate == AUDIO_SAMPLE_RATE ) { continue; }
+		const float step = static_cast<float>( AUDIO_SAMPLE_RATE ) / static_cast<float>( rate );
+		for( const float hz : TONES )
+		{
+			// Tones above the device Nyquist rate are filtered, not measured
+			if( hz * 2.0f >= static_cast<float>( rate ) * 0.9f ) { continue; }
+			tone( samples, SOURCE_FRAMES, hz, AUDIO_SAMPLE_RATE );
+			const double linear = kernel_snr( samples, output, hz, step, false );
+			const double sinc = kernel_snr( samples, output, hz, step, true );
+			benchmark_row( "%10.0f | %9u | %6.1f | %6.1f", hz, rate, linear, sinc );
+			ErrorIf( sinc < linear, "Resampler: sinc is worse than linear at %.0f Hz", hz );
+		}
+	}
+
+	// Asset builder: 48 kHz tones converted to AUDIO_SAMPLE_RATE
+	benchmark_header( "resample_i16 (48 kHz sine to AUDIO_SAMPLE_RATE, dB)", "   tone Hz |    ms |  snr" );
+	{
+		const u32 framesIn = 48000 * 2;
+		const u32 framesOut = static_cast<u32>( resample_frames( framesIn, 48000, AUDIO_SAMPLE_RATE ) );
+		i16 *input = reinterpret_cast<i16 *>( memory_alloc( framesIn * sizeof( i16 ) ) );
+		i16 *converted = reinterpret_cast<i16 *>( memory_alloc( framesOut * sizeof( i16 ) ) );
+		for( const float hz : TONES )
+		{
+			tone( input, framesIn, hz, 48000.0 );
+			Timer timer;
+			resample_i16( converted, input, framesIn, 1, 48000, AUDIO_SAMPLE_RATE );
+			timer.stop();
+
+			double signal = 0.0;
+			double noise = 0.0;
+			for( u32 i = EDGE_FRAMES; i < framesOut - EDGE_FRAMES; i++ )
+			{
+				const double expected = 16384.0 * sin( 2.0 * PI_F64 * hz * i / AUDIO_SAMPLE_RATE );
+				signal += expected * expected;
+				noise += ( converted[i] - expected ) * ( converted[i] - expected );
+			}
+			const double snr = snr_db( signal, noise );
+			benchmark_row( "%10.0f | %5.1f | %4.1f", hz, timer.elapsed_ms(), snr );
+			ErrorIf( snr < 60.0, "Resampler: resample_i16 SNR %.1f dB at %.0f Hz", snr, hz );
+		}
+		memory_free( converted );
+		memory_free( input );
+	}
+
+	// Device rates: a 1 kHz tone keeps its pitch, and the first song streams as it plays from memory
+	benchmark_header( "Offline render per device rate (1 kHz tone, first song streamed vs. in memory)",
+		" device Hz | tone Hz | realtime | song frames | expected | max diff | underruns" );
+	{
+		tone( samples, SOURCE_FRAMES, 1000.0, AUDIO_SAMPLE_RATE );
+		i16 *render = reinterpret_cast<i16 *>( memory_alloc( AUDIO_SAMPLE_RATE_MAX * 2 * sizeof( i16 ) ) );
+
+		ErrorIf( Assets::songCount == 0, "Resampler: the benchmark binary has no songs" );
+		const DiskSong &song = Assets::songs[0];
+		ErrorIf( song.format != AudioFormat_PCM16, "Resampler: the benchmark song must be PCM" );
+		const u32 songSamples = static_cast<u32>( song.frames * song.channels );
+		i16 *songSamplesMemory = reinterpret_cast<i16 *>( memory_alloc( song.length ) );
+		memory_copy( songSamplesMemory, &Assets::binary.data[song.offset], song.length );
+		const u32 capacity =
+			static_cast<u32>( resample_frames( song.frames, AUDIO_SAMPLE_RATE, AUDIO_SAMPLE_RATE_MAX ) ) + FRAMES * 2;
+		i16 *streamed = reinterpret_cast<i16 *>( memory_alloc( capacity * 2 * sizeof( i16 ) ) );
+		i16 *reference = reinterpret_cast<i16 *>( memory_alloc( capacity * 2 * sizeof( i16 ) ) );
+		ErrorIf( !SysAudio::init_streams(), "Resampler: failed to start the stream thread" );
+
+		for( const u32 rate : DEVICE_RATES )
+		{
+			SysAudio::offline_sample_rate( rate );
+
+			// Tone (one second at the device rate)
+			const SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, { }, "bench" );
+			ErrorIf( handle.voice < 0, "Resampler: tone play failed" );
+			SysAudio::offline_sink_memory( render, rate );
+			Timer timer;
+			SysAudio::offline_render( rate );
+			timer.stop();
+			handle.stop();
+			SysAudio::offline_sink_discard();
+			SysAudio::offline_render( FRAMES );
+			const double hz = render_hz( render, rate, rate );
+
+			// Song: streamed (sinc window) vs. in memory (sinc voice)
+			const SysAudio::StreamStatistics before = SysAudio::stream_statistics();
+			SoundHandle songHandle = SysAudio::play_song( 0, song, false, { }, "bench" );
+			SysAudio::audio_mixer( nullptr, 0 );
+			while( SysAudio::stream_statistics().blocksRead == before.blocksRead ) { Thread::sleep( 1 ); }
+			const u32 streamedFrames = render_song( songHandle, streamed, capacity, true );
+			stream_wait_drained();
+			const u32 underruns = SysAudio::stream_statistics().underruns - before.underruns;
+
+			songHandle = SysAudio::play_sound( 0, songSamplesMemory, songSamples, song.channels, { }, "bench" );
+			const u32 referenceFrames = render_song( songHandle, reference, capacity, false );
+
+			i32 difference = 0;
+			const u32 count = ( streamedFrames < referenceFrames ? streamedFrames : referenceFrames ) * 2;
+			for( u32 i = 0; i < count; i++ )
+			{
+				const i32 d = streamed[i] > reference[i] ? streamed[i] - reference[i] : reference[i] - streamed[i];
+				difference = d > difference ? d : difference;
+			}
+
+			// Songs end within a period of their resampled length
+			const u32 expected = static_cast<u32>( resample_frames( song.frames, AUDIO_SAMPLE_RATE, rate ) );
+			benchmark_row( "%10u | %7.1f | %7.1fx | %11u | %8u | %8d | %9u", rate, hz,
+				1000.0 / ( timer.elapsed_ms() > 0.0 ? timer.elapsed_ms() : 1e-6 ), streamedFrames, expected,
+				difference, underruns );
+			ErrorIf( hz < 999.0 || hz > 1001.0, "Resampler: tone plays at %.1f Hz at %u Hz", hz, rate );
+			ErrorIf( streamedFrames < expected || streamedFrames > expected + FRAMES,
+				"Resampler: song rendered %u frames at %u Hz (expected %u)", streamedFrames, rate, expected );
+			ErrorIf( difference > DIFFERENCE_MAX || underruns != 0, "Resampler: streamed song differs from memory at %u Hz", rate );
+		}
+
+		SysAudio::offline_sample_rate( AUDIO_SAMPLE_RATE );
+		SysAudio::free_streams();
+		memory_free( reference );
+		memory_free( streamed );
+		memory_free( songSamplesMemory );
+		memory_free( render );
+	}
+
+	memory_free( output );
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+#include <benchmarks.hpp>
+
+#include <core/buffer.hpp>
+#include <core/debug.hpp>
+
+#include <manta/objects.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+#include <scene.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ObjectSnapshot delta serialization: COUNT bench_spatial instances, CHURN of them destroyed & replaced each frame
+// while a fraction move. Every frame is captured, diffed against the previous frame, then applied backward & forward
+// again; both round trips must reproduce the captured snapshots exactly (an empty delta)
+
+static constexpr u32 COUNT = 10000;
+static constexpr u32 CHURN = COUNT / 20; // 5%
+static constexpr u32 FRAMES = 60;
+static constexpr u32 MOVING[] = { 0, 10, 50, 100 }; // percent of instances moving per frame
+
+
+static void snapshot_verify( ObjectSnapshot &scratch, const ObjectSnapshot &expected, Buffer &buffer )
+{
+	scratch.capture( Scene::objects );
+	buffer.clear();
+	ObjectSnapshot::delta( buffer, scratch, expected );
+	ErrorIf( buffer.tell != sizeof( u16 ), "Snapshot: round trip mismatch (%llu byte delta)",
+		static_cast<u64>( buffer.tell ) );
+}
+
+
+void benchmark_snapshot()
+{
+	benchmark_header( "ObjectSnapshot deltas (10000 instances, 5% churn per frame)",
+		"moving |  full KB | delta KB |    ratio | capture ms |   delta ms | backward ms |  forward ms" );
+
+	Object *handles = reinterpret_cast<Object *>( memory_alloc( COUNT * sizeof( Object ) ) );
+	for( const u32 moving : MOVING )
+	{
+		RandomContext rng { 1234 };
+		Scene::objects.init();
+		for( u32 i = 0; i < COUNT; i++ )
+		{
+			handles[i] = Scene::objects.create<bench_spatial>( rng.random<float>( 1024.0f ), rng.random<float>( 1024.0f ),
+				rng.random<float>( -1.0f, 1.0f ), rng.random<float>( -1.0f, 1.0f ) );
+		}
+
+		ObjectSnapshot previous;
+		ObjectSnapshot next;
+		ObjectSnapshot scratch;
+		previous.init();
+		next.init();
+		scratch.init();
+		Buffer delta;
+		delta.init( 1024 * 1024 );
+		Buffer check;
+		check.init( 1024 );
+		previous.capture( Scene::objects );
+
+		// First capture into a fresh (unallocated) snapshot
+		ObjectSnapshot fresh;
+		fresh.init();
+		snapshot_verify( fresh, previous, check );
+		ErrorIf( fresh.size_bytes() != previous.size_bytes(), "Snapshot: fresh capture size mismatch" );
+		fresh.free();
+
+		double fullBytes = 0.0;
+		double deltaBytes = 0.0;
+		double captureMs = 0.0;
+		double deltaMs = 0.0;
+		double backwardMs = 0.0;
+		double forwardMs = 0.0;
+		for( u32 frame = 0; frame < FRAMES; frame++ )
+		{
+			// Simulate: churn & movement
+			for( u32 i = 0; i < CHURN; i++ )
+			{
+				const u32 slot = rng.random<u32>( COUNT - 1 );
+				Scene::objects.destroy( handles[slot] );
+				handles[slot] = Scene::objects.create<bench_spatial>( rng.random<float>( 1024.0f ),
+					rng.random<float>( 1024.0f ), rng.random<float>( -1.0f, 1.0f ), rng.random<float>( -1.0f, 1.0f ) );
+			}
+			foreach_object( Scene::objects, bench_spatial, h )
+			{
+				if( rng.random<u32>( 99 ) < moving ) { h->x += h->vx; h->y += h->vy; }
+			}
+
+			// Capture & diff
+			Timer timerCapture;
+			next.capture( Scene::objects );
+			timerCapture.stop();
+
+			delta.clear();
+			Timer timerDelta;
+			ObjectSnapshot::delta( delta, previous, next );
+			timerDelta.stop();
+
+			// Rollback, then replay
+			delta.seek_start();
+			Timer timerBackward;
+			ErrorIf( !ObjectSnapshot::apply( delta, Scene::objects, false ), "Snapshot: backward apply failed" );
+			timerBackward.stop();
+			snapshot_verify( scratch, previous, check );
+
+			delta.seek_start();
+			Timer timerForward;
+			ErrorIf( !ObjectSnapshot::apply( delta, Scene::objects, true ), "Snapshot: forward apply failed" );
+			timerForward.stop();
+			snapshot_verify( scratch, next, check );
+
+			// Handles stay valid across apply()
+			for( u32 i = 0; i < COUNT; i += 97 )
+			{
+				ErrorIf( !Scene::objects.handle<bench_spatial>( handles[i] ), "Snapshot: handle %u lost", i );
+			}
+
+			fullBytes += static_cast<double>( next.size_bytes() );
+			deltaBytes += static_cast<double>( delta.tell );
+			captureMs += timerCapture.elapsed_ms();
+			deltaMs += timerDelta.elapsed_ms();
+			backwardMs += timerBackward.elapsed_ms();
+			forwardMs += timerForward.elapsed_ms();
+
+			ObjectSnapshot swap = previous;
+			previous = next;
+			next = swap;
+		}
+
+		benchmark_row( "%5u%% | %8.1f | %8.1f | %7.1f%% | %10.4f | %10.4f | %11.4f | %11.4f", moving,
+			KB( fullBytes / FRAMES ), KB( deltaBytes / FRAMES ), deltaBytes / fullBytes * 100.0,
+			captureMs / FRAMES, deltaMs / FRAMES, backwardMs / FRAMES, forwardMs / FRAMES );
+
+		previous.free();
+		next.free();
+		scratch.free();
+		delta.free();
+		check.free();
+		Scene::objects.free();
+	}
+	memory_free( handles );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+#include <benchmarks.hpp>
+
+#include <manta/objects.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+#include <manta/math.hpp>
+
+#include <scene.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPATIAL broadphase vs. brute-force iteration (the obj_asteroid/obj_projectile pattern): QUERIES instances each test
+// a radius against every bench_spatial instance. World size scales with the instance count (constant density)
+
+static constexpr u32 COUNTS[] = { 1000, 5000, 10000, 25000, 50000, 100000 };
+static constexpr u32 QUERIES = 1000;
+static constexpr float QUERY_RADIUS = 24.0f;
+static constexpr float SPACING = 24.0f; // world units per instance (per axis)
+static constexpr u32 DRIFT_COUNT = 10000;
+static constexpr u32 DRIFT_UPDATES = 256;
+static constexpr float DRIFT_STEP = 32.0f; // one cell per update
+
+
+void benchmark_spatial()
+{
+	benchmark_header( "SPATIAL broadphase (1000 radius queries)",
+		"    count |   rebuild ms |    update ms |   spatial ms |     brute ms |  speedup |   hits" );
+
+	for( const u32 count : COUNTS )
+	{
+		RandomContext rng { 1234 };
+		const float world = sqrtf( static_cast<float>( count ) ) * SPACING;
+
+		Scene::objects.init();
+		for( u32 i = 0; i < count; i++ )
+		{
+			Scene::objects.create<bench_spatial>( rng.random<float>( world ), rng.random<float>( world ),
+				rng.random<float>( -1.0f, 1.0f ), rng.random<float>( -1.0f, 1.0f ) );
+		}
+
+		float queryX[QUERIES];
+		float queryY[QUERIES];
+		for( u32 i = 0; i < QUERIES; i++ ) { queryX[i] = rng.random<float>( world ); queryY[i] = rng.random<float>( world ); }
+
+		// Initial build
+		Timer timerRebuild;
+		Scene::objects.spatial_update();
+		timerRebuild.stop();
+
+		// Incremental rebuild after every instance moves
+		foreach_object( Scene::objects, bench_spatial, h ) { h->x += h->vx; h->y += h->vy; }
+		Timer timerUpdate;
+		Scene::objects.spatial_update();
+		timerUpdate.stop();
+
+		// Spatial queries
+		u32 hitsSpatial = 0;
+		Timer timerSpatial;
+		for( u32 i = 0; i < QUERIES; i++ )
+		{
+			for( auto h : Scene::objects.query_radius<bench_spatial>( queryX[i], queryY[i], QUERY_RADIUS ) )
+			{
+				const float r = QUERY_RADIUS + h->radius;
+				hitsSpatial += floatv2_distance_sqr( { queryX[i], queryY[i] }, { h->x, h->y } ) < r * r;
+			}
+		}
+		timerSpatial.stop();
+
+		// Brute force
+		u32 hitsBrute = 0;
+		Timer timerBrute;
+		for( u32 i = 0; i < QUERIES; i++ )
+		{
+			foreach_object( Scene::objects, bench_spatial, h )
+			{
+				const float r = QUERY_RADIUS + h->radius;
+				hitsBrute += floatv2_distance_sqr( { queryX[i], queryY[i] }, { h->x, h->y } ) < r * r;
+			}
+		}
+		timerBrute.stop();
+
+		ErrorIf( hitsSpatial != hitsBrute, "SPATIAL query mismatch (spatial: %u, brute: %u)", hitsSpatial, hitsBrute );
+		benchmark_row( "%9u | %12.3f | %12.3f | %12.3f | %12.3f | %7.1fx | %6u", count,
+			timerRebuild.elapsed_ms(), timerUpdate.elapsed_ms(), timerSpatial.elapsed_ms(), timerBrute.elapsed_ms(),
+			timerBrute.elapsed_ms() / ( timerSpatial.elapsed_ms() > 0.0 ? timerSpatial.elapsed_ms() : 1e-6 ), hitsSpatial );
+
+		Scene::objects.free();
+	}
+
+	// Drift: every instance crosses into a new cell on each update. Cells left behind are pruned, so the cell count
+	// stays near the occupied cells instead of growing with every cell ever touched (queries still match brute force)
+	benchmark_header( "SPATIAL drift (10000 instances, 256 updates)",
+		"   update |  cells |   update ms | hits" );
+
+	RandomContext rng { 1234 };
+	const float world = sqrtf( static_cast<float>( DRIFT_COUNT ) ) * SPACING;
+	Scene::objects.init();
+	for( u32 i = 0; i < DRIFT_COUNT; i++ )
+	{
+		Scene::objects.create<bench_spatial>( rng.random<float>( world ), rng.random<float>( world ), DRIFT_STEP, 0.0f );
+	}
+	Scene::objects.spatial_update();
+	const u32 cellsInitial = Scene::objects.memory_statistics().spatialCells;
+
+	u32 cellsPeak = cellsInitial;
+	for( u32 update = 1; update <= DRIFT_UPDATES; update++ )
+	{
+		foreach_object( Scene::objects, bench_spatial, h ) { h->x += h->vx; }
+		Timer timer;
+		Scene::objects.spatial_update();
+		timer.stop();
+
+		const u32 cells = Scene::objects.memory_statistics().spatialCells;
+		cellsPeak = cells > cellsPeak ? cells : cellsPeak;
+		if( update % 64 != 0 ) { continue; }
+
+		const float qx = world * 0.5f + DRIFT_STEP * update;
+		const float qy = world * 0.5f;
+		u32 hitsSpatial = 0;
+		for( auto h : Scene::objects.query_radius<bench_spatial>( qx, qy, QUERY_RADIUS * 4.0f ) ) { hitsSpatial += h->radius > 0.0f; }
+		u32 hitsBrute = 0;
+		foreach_object( Scene::objects, bench_spatial, h )
+		{
+			const float r = QUERY_RADIUS * 4.0f + h->radius;
+			hitsBrute += floatv2_distance_sqr( { qx, qy }, { h->x, h->y } ) <= r * r;
+		}
+		ErrorIf( hitsSpatial != hitsBrute, "SPATIAL drift query mismatch (spatial: %u, brute: %u)", hitsSpatial, hitsBrute );
+		benchmark_row( "%9u | %6u | %11.3f | %4u", update, cells, timer.elapsed_ms(), hitsSpatial );
+	}
+	ErrorIf( cellsPeak > cellsInitial * 3, "SPATIAL drift: cells grew from %u to %u", cellsInitial, cellsPeak );
+	Scene::objects.free();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/assets.hpp>
+#include <manta/audio.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Disk streaming (SysAudio::play_song): the first song in the asset binary is mixed from AUDIO_STREAM_READ_AHEAD
+// blocks of AUDIO_STREAM_BLOCK_FRAMES. Streamed output is checked against the same samples played from memory, then a
+// looping stream is mixed at real-time pace and back to back (faster than the stream thread refills) to count underruns
+
+static constexpr u32 FRAMES = 1024;
+static constexpr u32 PERIODS_FAST = 2000;
+static constexpr double SECONDS_PACED = 1.0;
+static constexpr u32 PERIOD_FRAMES[] = { 256, 1024, 4096 };
+
+
+static void wait_until( const double time )
+{
+	while( Time::value() < time ) { Thread::sleep( 1 ); }
+}
+
+
+static void stream_drain()
+{
+	// Apply queued stops, then wait for the stream thread to release the stream
+	SysAudio::audio_mixer( nullptr, 0 );
+	while( SysAudio::stream_statistics().playing != 0 ) { Thread::sleep( 1 ); }
+}
+
+
+static u32 mix_until_finished( const SoundHandle &handle, i16 *output, const u32 capacity, const bool paced )
+{
+	// Returns the samples written to 'output'
+	u32 written = 0;
+	const double start = Time::value();
+	for( u32 period = 0; handle.is_playing(); period++ )
+	{
+		if( paced ) { wait_until( start + period * FRAMES / 44100.0 ); }
+		ErrorIf( written + FRAMES * 2 > capacity, "Streaming: output overflow" );
+		SysAudio::audio_mixer( &output[written], FRAMES );
+		written += FRAMES * 2;
+	}
+	return written;
+}
+
+
+static void stream_run( const char *mode, const u32 frames, const u32 periods, const bool paced, i16 *output )
+{
+	const SysAudio::StreamStatistics before = SysAudio::stream_statistics();
+	const SoundHandle handle = SysAudio::play_song( 0, Assets::songs[0], true, { }, "bench" );
+	ErrorIf( !handle.is_playing(), "Streaming: failed to play song" );
+
+	double mixMs = 0.0;
+	const double start = Time::value();
+	for( u32 period = 0; period < periods; period++ )
+	{
+		if( paced ) { wait_until( start + period * frames / 44100.0 ); }
+		Timer timer;
+		SysAudio::audio_mixer( output, frames );
+		timer.stop();
+		mixMs += timer.elapsed_ms();
+	}
+	handle.stop();
+	stream_drain();
+
+	const SysAudio::StreamStatistics after = SysAudio::stream_statistics();
+	benchmark_row( "%-6s | %6u | %7u | %9u | %11u | %9.3f", mode, frames, periods, after.underruns - before.underruns,
+		after.blocksRead - before.blocksRead, mixMs * 1000.0 / periods );
+}
+
+
+void benchmark_streaming()
+{
+	ErrorIf( Assets::songCount == 0, "Streaming: the benchmark binary has no songs" );
+	const DiskSong &song = Assets::songs[0];
+	ErrorIf( song.format != AudioFormat_PCM16, "Streaming: the benchmark song must be PCM" );
+	const u32 songSamples = static_cast<u32>( song.frames * song.channels );
+	const u32 streamBytes = AUDIO_STREAM_READ_AHEAD * AUDIO_STREAM_BLOCK_FRAMES * 2 * sizeof( i16 );
+
+	benchmark_header( "Song memory (resident PCM vs. stream blocks)", "                  bytes" );
+	benchmark_row( "song PCM         | %10llu", static_cast<u64>( song.length ) );
+	benchmark_row( "stream blocks    | %10u", streamBytes );
+	ErrorIf( !SysAudio::init_streams(), "Streaming: failed to start the stream thread" );
+
+	// Streamed vs. in-memory playback of the same samples
+	const u32 capacity = ( songSamples / song.channels / FRAMES + 2 ) * FRAMES * 2;
+	i16 *streamed = reinterpret_cast<i16 *>( memory_alloc( capacity * sizeof( i16 ) ) );
+	i16 *reference = reinterpret_cast<i16 *>( memory_alloc( capacity * sizeof( i16 ) ) );
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( song.length ) );
+	memory_copy( samples, &Assets::binary.data[song.offset], song.length );
+
+	const SysAudio::StreamStatistics before = SysAudio::stream_statistics();
+	SoundHandle handle = SysAudio::play_song( 0, song, false, { }, "bench" );
+	SysAudio::audio_mixer( nullptr, 0 );
+	while( SysAudio::stream_statistics().blocksRead == before.blocksRead ) { Thread::sleep( 1 ); }
+	const u32 streamedCount = mix_until_finished( handle, streamed, capacity, true );
+	stream_drain();
+
+	handle = SysAudio::play_sound( 0, samples, songSamples, song.channels, { }, "bench" );
+	const u32 referenceCount = mix_until_finished( handle, reference, capacity, false );
+
+	u32 mismatches = 0;
+	const u32 count = streamedCount < referenceCount ? streamedCount : referenceCount;
+	for( u32 i = 0; i < count; i++ ) { mismatches += streamed[i] != reference[i]; }
+	const SysAudio::StreamStatistics after = SysAudio::stream_statistics();
+	benchmark_header( "Streamed vs. in-memory song (1024 frame periods)",
+		" samples | reference | mismatches | underruns | blocks read | read peak us" );
+	benchmark_row( "%8u | %9u | %10u | %9u | %11u | %12.1f", streamedCount, referenceCount, mismatches,
+		after.underruns - before.underruns, after.blocksRead - before.blocksRead, after.readNsPeak * 0.001 );
+	ErrorIf( mismatches != 0 || streamedCount != referenceCount, "Streaming: streamed output differs from memory" );
+
+	// Looping stream: real-time pace vs. back to back
+	benchmark_header( "Looping stream underruns",
+		"mode   | period | periods | underruns | blocks read | mix us" );
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( AUDIO_MIX_FRAMES_MAX * 2 * sizeof( i16 ) ) );
+	for( const u32 frames : PERIOD_FRAMES )
+	{
+		stream_run( "paced", frames, static_cast<u32>( SECONDS_PACED * 44100.0 / frames ), true, output );
+	}
+	stream_run( "fast", FRAMES, PERIODS_FAST, false, output );
+	memory_free( output );
+
+	SysAudio::free_streams();
+	memory_free( samples );
+	memory_free( reference );
+	memory_free( streamed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,146 @@
+#include <benchmarks.hpp>
+
+#include <core/memory.hpp>
+#include <core/debug.hpp>
+
+#include <manta/audio.hpp>
+#include <manta/random.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Voice virtualization: COUNTS one-shots with random gains play on bus 0 while only AUDIO_VOICE_REAL_COUNT are mixed
+// (SysAudio::audio_mixer, 1024 frame periods). Reports period cost, failed play calls, and checks that priority wins
+// a real voice (below streamed songs), that silent voices stay virtual, and that virtual voices resume at the right
+// position
+
+static constexpr u32 SOURCE_FRAMES = 44100 * 4;
+static constexpr u32 FRAMES = 1024; // device period
+static constexpr u32 PERIODS = 100;
+static constexpr u32 COUNTS[] = { 32, 128, 512, 1000 };
+static constexpr u32 PRIORITY_VOICES = 8;
+static constexpr u32 RESUME_PERIODS = 20;
+
+static SoundHandle g_handles[AUDIO_VOICE_COUNT];
+
+
+static u32 voices_play( const i16 *samples, RandomContext &rng, const u32 count, const float gainMin,
+	const float gainMax, const int priority )
+{
+	// Returns the number of failed play calls
+	u32 failed = 0;
+	for( u32 i = 0; i < count; i++ )
+	{
+		AudioEffects effects;
+		effects.set_gain( rng.random<float>( gainMin, gainMax ) );
+		const SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, effects, "bench",
+			AudioFormat_PCM16, priority );
+		if( handle.voice < 0 ) { failed++; continue; }
+		g_handles[handle.voice] = handle;
+	}
+	return failed;
+}
+
+
+static void voices_stop( i16 *output )
+{
+	// The mixer drains the commands
+	for( SoundHandle &handle : g_handles ) { handle.stop(); handle = SoundHandle { }; }
+	SysAudio::audio_mixer( output, 0 );
+	SysAudio::audio_mixer( output, FRAMES );
+}
+
+
+void benchmark_voices()
+{
+	RandomContext rng { 1234 };
+	i16 *samples = reinterpret_cast<i16 *>( memory_alloc( SOURCE_FRAMES * sizeof( i16 ) ) );
+	for( u32 i = 0; i < SOURCE_FRAMES; i++ ) { samples[i] = static_cast<i16>( rng.random<int>( -8192, 8191 ) ); }
+	i16 *output = reinterpret_cast<i16 *>( memory_alloc( FRAMES * 2 * sizeof( i16 ) ) );
+
+	benchmark_header( "Voice virtualization (1024 frame period, one-shots on bus 0)",
+		" one-shots | failed | playing |   real |   period us | ns/frame/playing voice" );
+
+	for( const u32 count : COUNTS )
+	{
+		const u32 failed = voices_play( samples, rng, count, 0.05f, 1.0f, 0 );
+
+		Timer timer;
+		for( u32 i = 0; i < PERIODS; i++ ) { SysAudio::audio_mixer( output, FRAMES ); }
+		timer.stop();
+
+		const SysAudio::VoiceStatistics statistics = SysAudio::voice_statistics();
+		const double periodUs = timer.elapsed_ms() * 1000.0 / PERIODS;
+		benchmark_row( "%10u | %6u | %7u | %6u | %11.3f | %22.3f", count, failed, statistics.playing, statistics.real,
+			periodUs, periodUs * 1000.0 / ( static_cast<double>( FRAMES ) * statistics.playing ) );
+		ErrorIf( failed != 0, "Voices: %u of %u play calls failed", failed, count );
+
+		voices_stop( output );
+	}
+
+	// Priority: quiet high priority one-shots take real voices from loud ones
+	{
+		voices_play( samples, rng, COUNTS[3], 0.5f, 1.0f, 0 );
+		SysAudio::audio_mixer( output, FRAMES );
+		const u32 demotionsStart = SysAudio::voice_statistics().demotions;
+
+		for( u32 i = 0; i < PRIORITY_VOICES; i++ )
+		{
+			AudioEffects effects;
+			effects.set_gain( 0.01f );
+			const SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, effects, "bench",
+				AudioFormat_PCM16, 1 );
+			ErrorIf( handle.voice < 0, "Voices: priority play failed" );
+			g_handles[handle.voice] = handle;
+		}
+		SysAudio::audio_mixer( output, FRAMES );
+
+		u32 real = 0;
+		for( const SoundHandle &handle : g_handles )
+		{
+			if( handle.voice < 0 || SysAudio::voices[handle.voice].priority != 1 ) { continue; }
+			real += SysAudio::voices[handle.voice].real >= 0;
+		}
+		const u32 demotions = SysAudio::voice_statistics().demotions - demotionsStart;
+		benchmark_row( "  priority | %u of %u high priority voices real, %u demotions", real, PRIORITY_VOICES, demotions );
+		ErrorIf( real != PRIORITY_VOICES, "Voices: high priority voices were not made real" );
+
+		voices_stop( output );
+	}
+
+	// Sounds rank below streamed songs, whatever priority they ask for
+	{
+		const SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, AudioEffects { }, "bench",
+			AudioFormat_PCM16, I32_MAX );
+		ErrorIf( handle.voice < 0, "Voices: clamped priority play failed" );
+		g_handles[handle.voice] = handle;
+		ErrorIf( SysAudio::voices[handle.voice].priority >= I32_MAX, "Voices: sound priority not clamped below songs" );
+		voices_stop( output );
+	}
+
+	// Audibility & resume: a silent voice stays virtual but keeps its place in the sound
+	{
+		AudioEffects effects;
+		effects.set_gain( 0.0f );
+		const SoundHandle handle = SysAudio::play_sound( 0, samples, SOURCE_FRAMES, 1, effects, "bench" );
+		g_handles[handle.voice] = handle;
+		for( u32 i = 0; i < RESUME_PERIODS; i++ ) { SysAudio::audio_mixer( output, FRAMES ); }
+		const bool virtualSilent = SysAudio::voices[handle.voice].real < 0;
+
+		handle->set_gain( 1.0f );
+		SysAudio::audio_mixer( output, FRAMES );
+		const bool realAudible = SysAudio::voices[handle.voice].real >= 0;
+		const float position = SysAudio::voices[handle.voice].position;
+		const float expected = static_cast<float>( ( RESUME_PERIODS + 1 ) * FRAMES );
+		benchmark_row( "    resume | silent voice virtual: %s, real once audible: %s, position %.0f (expected %.0f)",
+			virtualSilent ? "yes" : "no", realAudible ? "yes" : "no", position, expected );
+		ErrorIf( !virtualSilent || !realAudible || position != expected, "Voices: virtual voice did not resume" );
+
+		voices_stop( output );
+	}
+
+	memory_free( output );
+	memory_free( samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,45 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PROJECT_NAME "Benchmarks"
+#define PROJECT_VERSION "0.0.1"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define OFFICIAL_HEADERS ( 0 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define FPS_LIMIT ( 0 )
+#define FPS_MARGIN ( 5 )
+#define DELTA_TIME_FRAMERATE ( 60.0f )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define WINDOW_WIDTH_DEFAULT ( 1280 )
+#define WINDOW_HEIGHT_DEFAULT ( 720 )
+
+#define WINDOW_WIDTH_MIN ( 480 )
+#define WINDOW_HEIGHT_MIN ( 480 )
+
+#define WINDOW_WIDTH_MAX ( -1 )
+#define WINDOW_HEIGHT_MAX ( -1 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define RENDER_QUAD_BATCH_SIZE ( 8192 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define AUDIO_BUS_COUNT ( 8 )
+#define AUDIO_VOICE_COUNT ( 1024 )
+#define AUDIO_VOICE_REAL_COUNT ( 32 )
+#define AUDIO_OFFLINE ( 1 )
+#define AUDIO_PROFILER ( 1 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <manta.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <core/types.hpp>
+#include <core/debug.hpp>
+
+#include <manta/assets.hpp>
+#include <manta/filesystem.hpp>
+#include <manta/objects.hpp>
+#include <manta/time.hpp>
+#include <manta/thread.hpp>
+
+#include <vendor/stdarg.hpp>
+#include <vendor/stdio.hpp>
+#include <vendor/string.hpp>
+
+#include <benchmarks.hpp>
+#include <scene.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Scene
+{
+	ObjectContext objects;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct BenchmarkEntry
+{
+	const char *name;
+	void ( *function )();
+};
+
+static const BenchmarkEntry BENCHMARKS[] =
+{
+	{ "spatial", benchmark_spatial },
+	{ "jobs", benchmark_jobs },
+	{ "queues", benchmark_queues },
+	{ "commands", benchmark_commands },
+	{ "compaction", benchmark_compaction },
+	{ "snapshot", benchmark_snapshot },
+	{ "mixer", benchmark_mixer },
+	{ "effects", benchmark_effects },
+	{ "streaming", benchmark_streaming },
+	{ "adpcm", benchmark_adpcm },
+	{ "automation", benchmark_automation },
+	{ "voices", benchmark_voices },
+	{ "offline", benchmark_offline },
+	{ "resampler", benchmark_resampler },
+	{ "parallel", benchmark_parallel },
+	{ "gfx", benchmark_gfx },
+	{ "arenas", benchmark_arenas },
+	{ "quads", benchmark_quads },
+};
+
+
+void benchmark_header( const char *name, const char *columns )
+{
+	PrintLnColor( LOG_CYAN, "\n%s", name );
+	PrintLnColor( LOG_WHITE, "%s", columns );
+}
+
+
+void benchmark_row( const char *format, ... )
+{
+	char buffer[512];
+	va_list args;
+	va_start( args, format );
+	vsnprintf( buffer, sizeof( buffer ), format, args );
+	va_end( args );
+	PrintLn( "%s", buffer );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Usage: benchmarks [name ...] (runs every benchmark when no names are given)
+int main( int argc, char **argv )
+{
+	path_get_directory( WORKING_DIRECTORY, sizeof( WORKING_DIRECTORY ), argv[0] );
+	SysTime::init();
+	SysJobs::init();
+	SysObjects::init();
+	ErrorIf( !SysAssets::init(), "Failed to load the benchmarks asset binary" );
+
+	for( const BenchmarkEntry &benchmark : BENCHMARKS )
+	{
+		bool run = argc <= 1;
+		for( int i = 1; i < argc; i++ ) { run |= strcmp( argv[i], benchmark.name ) == 0; }
+		if( !run ) { continue; }
+
+		Timer timer;
+		benchmark.function();
+		timer.stop();
+		PrintLnColor( LOG_WHITE, "(%s: %.3f ms)", benchmark.name, timer.elapsed_ms() );
+	}
+
+	SysAssets::free();
+	SysObjects::free();
+	SysJobs::free();
+
+	// Same exit as Engine::main(): the default input devices stay bound until static destruction
+	Debug::memoryLeakDetection = false;
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
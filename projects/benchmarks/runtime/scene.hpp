@@ -0,0 +1,12 @@
+#pragma once
+
+#include <manta/objects.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Scene
+{
+	extern ObjectContext objects;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
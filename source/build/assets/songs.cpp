@@ -3,6 +3,7 @@
 #include <core/types.hpp>
 #include <core/debug.hpp>
 #include <core/list.hpp>
+#include <core/resample.hpp>
 
 #include <build/build.hpp>
 #include <build/assets.hpp>
@@ -45,6 +46,7 @@ void Songs::load( const char *path )
 	path_get_filename( filename, sizeof( filename ), path );
 	String name = filename;
 	song.name = name.substr( 0, name.find( "." ) );
+	song.format = name.contains( ".adpcm." ) ? AudioFormat_ADPCM : AudioFormat_PCM16;
 
 	// Build Cache
 	Assets::assetFileCount++;
@@ -71,17 +73,30 @@ void Songs::load( const char *path )
 	const u16 fmtBitsPerSample = file.read<u16>();
 	const u32 data = file.read<u32>();
 	const u32 dataSize = file.read<u32>();
-	ErrorIf( fmtSampleRate != 44100, "Song: WAV format files must be 44.1khz! (%s)", path );
+	ErrorIf( fmtSampleRate == 0, "Song: WAV format invalid sample rate! (%s)", path );
 	ErrorIf( fmtBitsPerSample != 16, "Song: WAV format files must be 16-bit! (%s)", path );
 	ErrorIf( fmtBlockAlign != 2 * fmtChannels, "Sound: WAV format invalid! (%s)", path );
 
 	// Read Samples
-	song.sampleData = reinterpret_cast<byte *>( memory_alloc( dataSize ) );
-	song.sampleDataSize = dataSize;
 	song.numChannels = fmtChannels;
 	void *wavData = file.read_bytes( dataSize );
 	ErrorIf( wavData == nullptr, "Song: Failed to read samples (%s)", path );
-	memory_copy( song.sampleData, wavData, dataSize );
+	if( fmtSampleRate == AUDIO_SAMPLE_RATE )
+	{
+		song.sampleData = reinterpret_cast<byte *>( memory_alloc( dataSize ) );
+		song.sampleDataSize = dataSize;
+		memory_copy( song.sampleData, wavData, dataSize );
+	}
+	else
+	{
+		// Other rates are resampled to the asset rate (the mixer converts to the device rate)
+		const usize framesIn = dataSize / fmtBlockAlign;
+		const usize framesOut = resample_frames( framesIn, fmtSampleRate, AUDIO_SAMPLE_RATE );
+		song.sampleDataSize = framesOut * fmtBlockAlign;
+		song.sampleData = reinterpret_cast<byte *>( memory_alloc( song.sampleDataSize ) );
+		resample_i16( reinterpret_cast<i16 *>( song.sampleData ), reinterpret_cast<const i16 *>( wavData ), framesIn,
+			fmtChannels, fmtSampleRate, AUDIO_SAMPLE_RATE );
+	}
 
 	// Free buffer
 	file.free();
@@ -104,7 +119,20 @@ void Songs::write()
 		{
 			// Write Sample Data
 			song.sampleDataOffsetBytes = binary.tell;
-			binary.write( song.sampleData, song.sampleDataSize );
+			if( song.format == AudioFormat_ADPCM )
+			{
+				const usize frames = song.sampleDataSize / sizeof( i16 ) / song.numChannels;
+				const usize size = adpcm_encoded_bytes( frames, song.numChannels );
+				byte *encoded = reinterpret_cast<byte *>( memory_alloc( size ) );
+				adpcm_encode( encoded, reinterpret_cast<const i16 *>( song.sampleData ), frames, song.numChannels );
+				binary.write( encoded, size );
+				memory_free( encoded );
+			}
+			else
+			{
+				binary.write( song.sampleData, song.sampleDataSize );
+			}
+			song.sampleDataLengthBytes = binary.tell - song.sampleDataOffsetBytes;
 		}
 		songsSampleDataSize = binary.tell - songsSampleDataOffset;
 		ErrorIf( songsSampleDataSize & 1, "Songs: Sample data size is not even!" );
@@ -119,8 +147,10 @@ void Songs::write()
 		assets_struct( header,
 			"DiskSong",
 			"int channels;",
+			"int format;",
 			"usize offset;",
 			"usize length;",
+			"usize frames;",
 			"DEBUG( const char *name );" );
 
 		// Enums
@@ -154,10 +184,12 @@ void Songs::write()
 		for( Song &song : songs )
 		{
 			snprintf( buffer, PATH_SIZE,
-				"\t\t{ %d, %lluULL, %lluULL, DEBUG( \"%s\" ) },\n",
+				"\t\t{ %d, %d, %lluULL, %lluULL, %lluULL, DEBUG( \"%s\" ) },\n",
 				song.numChannels,
+				song.format,
 				song.sampleDataOffsetBytes,
-				song.sampleDataSize,
+				song.sampleDataLengthBytes,
+				song.sampleDataSize / sizeof( i16 ) / song.numChannels,
 				song.name.cstr() );
 
 			source.append( buffer );
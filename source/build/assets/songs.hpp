@@ -4,6 +4,7 @@
 #include <core/list.hpp>
 #include <core/buffer.hpp>
 #include <core/string.hpp>
+#include <core/adpcm.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -15,7 +16,9 @@ struct Song
 	byte *sampleData;
 	usize sampleDataSize;
 	usize sampleDataOffsetBytes;
+	usize sampleDataLengthBytes;
 	u8 numChannels;
+	AudioFormat format; // AudioFormat_ADPCM: *.adpcm.*.wav
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
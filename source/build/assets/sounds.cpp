@@ -3,6 +3,7 @@
 #include <core/types.hpp>
 #include <core/debug.hpp>
 #include <core/list.hpp>
+#include <core/resample.hpp>
 
 #include <build/build.hpp>
 #include <build/assets.hpp>
@@ -45,6 +46,7 @@ void Sounds::load( const char *path )
 	path_get_filename( filename, sizeof( filename ), path );
 	String name = filename;
 	sound.name = name.substr( 0, name.find( "." ) );
+	sound.format = name.contains( ".adpcm." ) ? AudioFormat_ADPCM : AudioFormat_PCM16;
 
 	// Build Cache
 	Assets::assetFileCount++;
@@ -71,17 +73,30 @@ void Sounds::load( const char *path )
 	const u16 fmtBitsPerSample = file.read<u16>();
 	const u32 data = file.read<u32>();
 	const u32 dataSize = file.read<u32>();
-	ErrorIf( fmtSampleRate != 44100, "Sound: WAV format files must be 44.1khz! (%s)", path );
+	ErrorIf( fmtSampleRate == 0, "Sound: WAV format invalid sample rate! (%s)", path );
 	ErrorIf( fmtBitsPerSample != 16, "Sound: WAV format files must be 16-bit! (%s)", path );
 	ErrorIf( fmtBlockAlign != 2 * fmtChannels, "Sound: WAV format invalid! (%s)", path );
 
 	// Read Samples
-	sound.sampleData = reinterpret_cast<byte *>( memory_alloc( dataSize ) );
-	sound.sampleDataSize = dataSize;
 	sound.numChannels = fmtChannels;
 	void *wavData = file.read_bytes( dataSize );
 	ErrorIf( wavData == nullptr, "Sound: Failed to read samples (%s)", path );
-	memory_copy( sound.sampleData, wavData, dataSize );
+	if( fmtSampleRate == AUDIO_SAMPLE_RATE )
+	{
+		sound.sampleData = reinterpret_cast<byte *>( memory_alloc( dataSize ) );
+		sound.sampleDataSize = dataSize;
+		memory_copy( sound.sampleData, wavData, dataSize );
+	}
+	else
+	{
+		// Other rates are resampled to the asset rate (the mixer converts to the device rate)
+		const usize framesIn = dataSize / fmtBlockAlign;
+		const usize framesOut = resample_frames( framesIn, fmtSampleRate, AUDIO_SAMPLE_RATE );
+		sound.sampleDataSize = framesOut * fmtBlockAlign;
+		sound.sampleData = reinterpret_cast<byte *>( memory_alloc( sound.sampleDataSize ) );
+		resample_i16( reinterpret_cast<i16 *>( sound.sampleData ), reinterpret_cast<const i16 *>( wavData ), framesIn,
+			fmtChannels, fmtSampleRate, AUDIO_SAMPLE_RATE );
+	}
 
 	// Free buffer
 	file.free();
@@ -105,7 +120,19 @@ void Sounds::write()
 			// Write Sample Data
 			sound.sampleOffsetBytes = binary.tell - soundsSampleDataOffset;
 			sound.sampleCountBytes = sound.sampleDataSize;
-			binary.write( sound.sampleData, sound.sampleDataSize );
+			if( sound.format == AudioFormat_ADPCM )
+			{
+				const usize frames = sound.sampleDataSize / sizeof( i16 ) / sound.numChannels;
+				const usize size = adpcm_encoded_bytes( frames, sound.numChannels );
+				byte *encoded = reinterpret_cast<byte *>( memory_alloc( size ) );
+				adpcm_encode( encoded, reinterpret_cast<const i16 *>( sound.sampleData ), frames, sound.numChannels );
+				binary.write( encoded, size );
+				memory_free( encoded );
+			}
+			else
+			{
+				binary.write( sound.sampleData, sound.sampleDataSize );
+			}
 		}
 		soundsSampleDataSize = binary.tell - soundsSampleDataOffset;
 		ErrorIf( soundsSampleDataSize & 1, "Sounds: Sample data size is not even!" );
@@ -120,6 +147,7 @@ void Sounds::write()
 		assets_struct( header,
 			"DiskSound",
 			"int channels;",
+			"int format;",
 			"usize sampleOffset;",
 			"usize sampleCount;",
 			"DEBUG( const char *name );" );
@@ -154,8 +182,9 @@ void Sounds::write()
 		for( Sound &sound : sounds )
 		{
 			snprintf( buffer, PATH_SIZE,
-				"\t\t{ %d, %lluULL, %lluULL, DEBUG( \"%s\" ) },\n",
+				"\t\t{ %d, %d, %lluULL, %lluULL, DEBUG( \"%s\" ) },\n",
 				sound.numChannels,
+				sound.format,
 				sound.sampleOffsetBytes / sizeof( i16 ),
 				sound.sampleCountBytes / sizeof( i16 ),
 				sound.name.cstr() );
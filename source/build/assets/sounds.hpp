@@ -4,6 +4,7 @@
 #include <core/list.hpp>
 #include <core/buffer.hpp>
 #include <core/string.hpp>
+#include <core/adpcm.hpp>
 
 #include <build/objloader.hpp>
 
@@ -19,6 +20,7 @@ struct Sound
 	usize sampleOffsetBytes;
 	usize sampleCountBytes;
 	u8 numChannels;
+	AudioFormat format; // AudioFormat_ADPCM: *.adpcm.*.wav
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
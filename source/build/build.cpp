@@ -665,7 +665,7 @@ void BuilderCore::compile_engine()
 			ErrorIf( !count, "No backend found for 'audio' (%s)", path );
 			if( OS_WINDOWS ) { Build::compile_add_library( "Ole32" ); }
 			if( OS_MACOS ) { Build::compile_add_library( "AudioToolbox" ); }
-			if( OS_LINUX ) { Build::compile_add_library( "asound" ); }
+			if( AUDIO_ALSA ) { Build::compile_add_library( "asound" ); }
 
 			// Filesystem | -r source/manta/backend/filesystem/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "filesystem" SLASH, BACKEND_FILESYSTEM );
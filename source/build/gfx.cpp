@@ -102,9 +102,9 @@ void Gfx::build()
 	#elif GRAPHICS_VULKAN
 		const ShaderType shaderType = ShaderType_GLSL;
 	#elif GRAPHICS_METAL
-		const ShaderType shaderType = ShaderType_METAL;
+		const ShaderType shaderType = ShaderType_Metal;
 	#else
-		const ShaderType shaderType = ShaderType_DEFAULT;
+		const ShaderType shaderType = ShaderType_Default;
 	#endif
 
 	// Build Shaders
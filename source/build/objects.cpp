@@ -136,6 +136,9 @@ const char *g_KEYWORDS[] =
 	"VERSIONS",              // KeywordID_VERSIONS
 	"ABSTRACT",              // KeywordID_ABSTRACT
 	"NETWORKED",             // KeywordID_NETWORKED
+	"PARALLEL",              // KeywordID_PARALLEL
+	"SPATIAL",               // KeywordID_SPATIAL
+	"UPDATE_RATE",           // KeywordID_UPDATE_RATE
 	"CONSTRUCTOR",           // KeywordID_CONSTRUCTOR
 	"WRITE",                 // KeywordID_WRITE
 	"READ",                  // KeywordID_READ
@@ -197,6 +200,9 @@ KeywordRequirements g_KEYWORD_REQUIREMENTS[] =
 	{ false,    1 }, // KeywordID_VERSIONS
 	{ false,    1 }, // KeywordID_ABSTRACT
 	{ false,    1 }, // KeywordID_NETWORKED
+	{ false,    1 }, // KeywordID_PARALLEL
+	{ false,    1 }, // KeywordID_SPATIAL
+	{ false,    1 }, // KeywordID_UPDATE_RATE
 	{ false,   -1 }, // KeywordID_CONSTRUCTOR
 	{ false,    1 }, // KeywordID_WRITE
 	{ false,    1 }, // KeywordID_READ
@@ -477,6 +483,30 @@ void ObjectFile::parse_keywords_values( const String &buffer )
 				networked = keyword_PARENTHESES_bool( buffer, keyword );
 			}
 			break;
+
+			// PARALLEL
+			case KeywordID_PARALLEL:
+			{
+				parallel = keyword_PARENTHESES_bool( buffer, keyword );
+			}
+			break;
+
+			// SPATIAL
+			case KeywordID_SPATIAL:
+			{
+				keyword_SPATIAL( buffer, keyword );
+			}
+			break;
+
+			// UPDATE_RATE
+			case KeywordID_UPDATE_RATE:
+			{
+				const int value = keyword_PARENTHESES_int( buffer, keyword );
+				ErrorIfLine( value < 1 || value > U16_MAX, line, "%s() must be range 1 - %u",
+					g_KEYWORDS[KeywordID_UPDATE_RATE], U16_MAX );
+				updateRate = static_cast<usize>( value );
+			}
+			break;
 		}
 	}
 }
@@ -1047,6 +1077,39 @@ void ObjectFile::keyword_VERSIONS( const String &buffer, Keyword &keyword )
 }
 
 
+void ObjectFile::keyword_SPATIAL( const String &buffer, Keyword &keyword )
+{
+	usize current = 0;
+	usize end = 0;
+	const usize line = line_at( buffer, keyword.start );
+	const bool found = find_keyword_parentheses( buffer, keyword.start, keyword.end, current, end );
+	ErrorIfLine( !found, line, "%s(...) must not be empty!", g_KEYWORDS[KeywordID_SPATIAL] );
+
+	// Arguments: x, y, radius, cell size (optional)
+	String *arguments[] = { &spatialX, &spatialY, &spatialRadius, &spatialCellSize };
+	usize count = 0;
+	usize delimiter = min( buffer.find( ",", current + 1, end ), end );
+	for( ;; )
+	{
+		ErrorIfLine( count == ARRAY_LENGTH( arguments ), line, "%s( x, y, radius, [cell size] ) has too many arguments!",
+			g_KEYWORDS[KeywordID_SPATIAL] );
+		*arguments[count] = buffer.substr( current + 1, delimiter ).trim();
+		ErrorIfLine( arguments[count]->length_bytes() == 0, line, "%s( x, y, radius, [cell size] ) has an empty argument!",
+			g_KEYWORDS[KeywordID_SPATIAL] );
+		count++;
+
+		// Loop
+		if( delimiter == end ) { break; }
+		current = delimiter + 1;
+		delimiter = min( buffer.find( ",", current + 1, end ), end );
+	}
+
+	ErrorIfLine( count < 3, line, "%s( x, y, radius, [cell size] ) requires at least 3 arguments!", g_KEYWORDS[KeywordID_SPATIAL] );
+	if( count == 3 ) { spatialCellSize = "OBJECT_SPATIAL_CELL_SIZE"; }
+	spatial = true;
+}
+
+
 String ObjectFile::keyword_PARENTHESES_string( const String &buffer, Keyword &keyword, const bool requireParentheses )
 {
 	// Find parentheses
@@ -1230,9 +1293,25 @@ void ObjectFile::write_header()
 					}
 				}
 
+				// Update Rate (UPDATE_RATE -- declared once by the first type in the chain)
+				if( updateRate > 0 && ( parent == nullptr || parent->update_rate() == 0 ) )
+				{
+					output.append( "\tu16 updateRate = 0; // EVENT_UPDATE frame interval override (0: UPDATE_RATE default)\n" );
+					output.append( "\tDelta updateStamp = -1.0; // ObjectContext update time of the last EVENT_UPDATE\n" );
+				}
+
 				// Public Functions
 				for( String &func : publicFunctionHeader ) { output.append( "\tvirtual " ).append( func ).append( "\n" ); }
 
+				// Spatial Bounds (SPATIAL)
+				if( spatial )
+				{
+					output.append( "\tvoid spatial_bounds( ObjectSpatialBounds &bounds ) const { bounds = { " );
+					output.append( "static_cast<float>( " ).append( spatialX ).append( " ), " );
+					output.append( "static_cast<float>( " ).append( spatialY ).append( " ), " );
+					output.append( "static_cast<float>( " ).append( spatialRadius ).append( " ) }; }\n" );
+				}
+
 				// Public Events
 				for( u8 eventID = 0; eventID < EVENT_COUNT; eventID++ )
 				{
@@ -1342,6 +1421,137 @@ void ObjectFile::write_header()
 }
 
 
+static bool char_identifier( const char c )
+{
+	return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || c == '_';
+}
+
+
+static bool declaration_has_word( const String &declaration, const char *word )
+{
+	const usize length = strlen( word );
+	for( usize i = declaration.find( word ); i != USIZE_MAX; i = declaration.find( word, i + 1 ) )
+	{
+		const bool before = i > 0 && char_identifier( declaration[i - 1] );
+		const bool after = i + length < declaration.length_bytes() && char_identifier( declaration[i + length] );
+		if( !before && !after ) { return true; }
+	}
+	return false;
+}
+
+
+static void declarator_name( const String &declaration, const usize start, const usize end, List<String> &outNames )
+{
+	// Name of the declarator in [start, end) (e.g. "float x" -> "x", " *grid[4][4]" -> "grid")
+	usize last = end;
+	for( ;; )
+	{
+		while( last > start && char_whitespace( declaration[last - 1] ) ) { last--; }
+		if( last == start || declaration[last - 1] != ']' ) { break; }
+		while( last > start && declaration[last - 1] != '[' ) { last--; }
+		if( last > start ) { last--; }
+	}
+
+	usize first = last;
+	while( first > start && char_identifier( declaration[first - 1] ) ) { first--; }
+	if( first == last || ( declaration[first] >= '0' && declaration[first] <= '9' ) ) { return; }
+	outNames.add( declaration.substr( first, last ) );
+}
+
+
+static void declaration_members( const String &declaration, List<String> &outNames )
+{
+	// Instance members named by a variable declaration (e.g. "float x = 0.0f, y;" -> "x", "y")
+	// Only members offsetof() can address are listed: static data, nested types, references, bitfields & function
+	// pointers are skipped (the generated offsetof() fails to compile rather than silently snapshot a wrong name)
+	static const char *SKIP[] = { "static", "constexpr", "typedef", "using", "struct", "class", "enum", "enum_type" };
+	for( const char *word : SKIP ) { if( declaration_has_word( declaration, word ) ) { return; } }
+
+	const usize length = declaration.length_bytes();
+	usize start = 0; // Current declarator
+	usize end = USIZE_MAX; // End of the current declarator name (initializer start)
+	bool addressable = true;
+	int depth = 0; // () [] {}
+	int angles = 0; // <> (template arguments, outside initializers only)
+	for( usize i = 0; i < length; i++ )
+	{
+		const char c = declaration[i];
+		if( c == '(' || c == '[' || c == '{' )
+		{
+			if( depth == 0 && angles == 0 && end == USIZE_MAX )
+			{
+				if( c == '(' ) { return; } // Function pointer
+				if( c == '{' ) { end = i; }
+			}
+			depth++;
+			continue;
+		}
+		if( c == ')' || c == ']' || c == '}' ) { depth--; continue; }
+		if( depth != 0 ) { continue; }
+
+		if( end == USIZE_MAX )
+		{
+			if( c == '<' ) { angles++; continue; }
+			if( c == '>' ) { angles--; continue; }
+			if( angles != 0 ) { continue; }
+			if( c == '=' ) { end = i; continue; }
+			if( c == '&' ) { addressable = false; continue; }
+			if( c == ':' )
+			{
+				if( i + 1 < length && declaration[i + 1] == ':' ) { i++; continue; }
+				addressable = false; // Bitfield
+				end = i;
+				continue;
+			}
+		}
+
+		if( c == ',' || c == ';' )
+		{
+			if( addressable ) { declarator_name( declaration, start, end == USIZE_MAX ? i : end, outNames ); }
+			if( c == ';' ) { return; }
+			start = i + 1;
+			end = USIZE_MAX;
+			addressable = true;
+		}
+	}
+}
+
+
+void ObjectFile::snapshot_fields( List<String> &outNames ) const
+{
+	// Instance members declared by this type (inherited members belong to the parent's list)
+	if( name.equals( "OBJECT_TYPE_DEFAULT" ) ) { return; } // 'id' is snapshotted separately
+
+	for( const String &var : publicVariableHeader )
+	{
+		if( parent != nullptr && parent->inheritedVariables.contains( var ) ) { continue; }
+		declaration_members( var, outNames );
+	}
+	for( const String &var : protectedVariableHeader )
+	{
+		if( parent != nullptr && parent->inheritedVariables.contains( var ) ) { continue; }
+		declaration_members( var, outNames );
+	}
+	for( const String &var : privateVariableHeader )
+	{
+		declaration_members( var, outNames );
+	}
+}
+
+
+usize ObjectFile::snapshot_field_count() const
+{
+	usize count = 0;
+	for( const ObjectFile *object = this; object != nullptr; object = object->parent )
+	{
+		List<String> names;
+		object->snapshot_fields( names );
+		count += names.size();
+	}
+	return count;
+}
+
+
 void ObjectFile::write_source()
 {
 	// Header Break
@@ -1370,6 +1580,30 @@ void ObjectFile::write_source()
 		output.append( "\tstatic void deserialize( class Buffer &buffer, OBJECT_ENCODER<" );
 		output.append( name ).append( "> &context ) { context.object._deserialize( buffer ); }\n" );
 	}
+	{
+		// ObjectSnapshot fields declared by this type (offsetof() table, laid out by the compiler)
+		List<String> fields;
+		snapshot_fields( fields );
+		output.append( "\tstatic u32 snapshot_fields( ObjectSnapshotField *fields )\n\t{\n" );
+		if( fields.size() == 0 )
+		{
+			output.append( "\t\t(void)fields;\n\t\treturn 0;\n\t}\n" );
+		}
+		else
+		{
+			output.append( "\t\tstatic constexpr ObjectSnapshotField FIELDS[] =\n\t\t{\n" );
+			for( const String &field : fields )
+			{
+				output.append( "\t\t\t{ offsetof( " ).append( type ).append( ", " ).append( field );
+				output.append( " ), sizeof( " ).append( type ).append( "::" ).append( field );
+				output.append( " ), __is_trivially_copyable( decltype( " ).append( type ).append( "::" );
+				output.append( field ).append( " ) ) },\n" );
+			}
+			output.append( "\t\t};\n" );
+			output.append( "\t\tfor( u32 i = 0; i < static_cast<u32>( ARRAY_LENGTH( FIELDS ) ); i++ ) { fields[i] = FIELDS[i]; }\n" );
+			output.append( "\t\treturn static_cast<u32>( ARRAY_LENGTH( FIELDS ) );\n\t}\n" );
+		}
+	}
 	output.append( "};\n\n" );
 
 	// Constructors
@@ -1820,6 +2054,17 @@ void Objects::generate_intellisense( String &output )
 }
 
 
+// OBJECT_EVENT_* enum name for an event (e.g. event_render_gui -> OBJECT_EVENT_RENDER_GUI)
+static void append_event_enum( String &output, const u8 eventID )
+{
+	output.append( "OBJECT_EVENT_" );
+	for( const char *c = g_EVENT_FUNCTIONS[eventID][EventFunction_Name] + strlen( "event_" ); *c != '\0'; c++ )
+	{
+		output.append( static_cast<char>( *c >= 'a' && *c <= 'z' ? *c - 'a' + 'A' : *c ) );
+	}
+}
+
+
 void Objects::generate_header_system( String &output )
 {
 	// File Info
@@ -1852,6 +2097,26 @@ void Objects::generate_header_system( String &output )
 	output.append( "\tOBJECT_CATEGORY_COUNT,\n" );
 	output.append( "};\n\n" );
 
+	// Object Events
+	output.append( COMMENT_BREAK "\n\n" );
+	output.append( "enum\n{\n" );
+	for( u8 eventID = 0; eventID < EVENT_COUNT; eventID++ )
+	{
+		output.append( "\t" );
+		append_event_enum( output, eventID );
+		output.append( ",\n" );
+	}
+	output.append( "\tOBJECT_EVENT_COUNT,\n" );
+	output.append( "};\n\n" );
+
+	// ObjectSnapshot field table size (sum of every type's fields, inherited fields included)
+	usize snapshotFields = 0;
+	for( ObjectFile *object : objectFilesSorted ) { snapshotFields += object->snapshot_field_count(); }
+	char snapshotFieldsString[32];
+	snprintf( snapshotFieldsString, sizeof( snapshotFieldsString ), "%u", static_cast<u32>( snapshotFields ) );
+	output.append( COMMENT_BREAK "\n\n" );
+	output.append( "#define OBJECT_SNAPSHOT_FIELD_TOTAL ( " ).append( snapshotFieldsString ).append( " )\n\n" );
+
 	// EOF
 	output.append( COMMENT_BREAK );
 }
@@ -1891,7 +2156,7 @@ void Objects::generate_source_system( String &output )
 	output.append( "\n};\n\n" );
 
 	// CATEGORY_NAME
-	output.append( "#if COMPILE_DEBUG\n" );
+	output.append( "#if COMPILE_DEBUG || OBJECT_PROFILER\n" );
 	output.append( "const char *SysObjects::CATEGORY_NAME[OBJECT_CATEGORY_COUNT] =\n{\n" );
 	output.append( "\t\"OBJECT_CATEGORY_DEFAULT\",\n" );
 	for( auto &category : objectCategories )
@@ -1913,7 +2178,7 @@ void Objects::generate_source_system( String &output )
 	output.append( "\n};\n\n" );
 
 	// TYPE_NAME
-	output.append( "#if COMPILE_DEBUG\n" );
+	output.append( "#if COMPILE_DEBUG || OBJECT_PROFILER\n" );
 	output.append( "const char *SysObjects::TYPE_NAME[OBJECT_TYPE_COUNT] =\n{\n" );
 	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
 	{
@@ -1985,11 +2250,57 @@ void Objects::generate_source_system( String &output )
 	}
 	output.append( "\n};\n\n" );
 
+	// TYPE_SPATIAL (SPATIAL is inherited by child types)
+	output.append( "void ( *const SysObjects::TYPE_SPATIAL[OBJECT_TYPE_COUNT] )( const void *, ObjectSpatialBounds & ) =\n{\n" );
+	for( ObjectFile *object : objectFilesSorted )
+	{
+		ObjectFile *spatial = object;
+		while( spatial != nullptr && !spatial->spatial ) { spatial = spatial->parent; }
+		if( spatial == nullptr || !object->instantiable() ) { output.append( "\tnullptr,\n" ); continue; }
+		output.append( "\t[]( const void *object, ObjectSpatialBounds &bounds ) { reinterpret_cast<const SysObjects::" );
+		output.append( object->type ).append( " *>( object )->spatial_bounds( bounds ); },\n" );
+	}
+	output.append( "};\n\n" );
+
+	// TYPE_SPATIAL_CELL_SIZE
+	output.append( "const float SysObjects::TYPE_SPATIAL_CELL_SIZE[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile *spatial = objectFilesSorted[i];
+		while( spatial != nullptr && !spatial->spatial ) { spatial = spatial->parent; }
+		if( spatial == nullptr ) { output.append( "0.0f" ); }
+		else { output.append( "static_cast<float>( " ).append( spatial->spatialCellSize ).append( " )" ); }
+		output.append( ( j % 7 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// TYPE_UPDATE_RATE (UPDATE_RATE is inherited by child types)
+	output.append( "const u16 SysObjects::TYPE_UPDATE_RATE[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		char rate[16];
+		snprintf( rate, sizeof( rate ), "%u", static_cast<u32>( objectFilesSorted[i]->update_rate() ) );
+		output.append( rate );
+		output.append( ( j % 15 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// EVENT_NAME
+	output.append( "#if OBJECT_PROFILER\n" );
+	output.append( "const char *SysObjects::EVENT_NAME[OBJECT_EVENT_COUNT] =\n{\n" );
+	for( u8 eventID = 0; eventID < EVENT_COUNT; eventID++ )
+	{
+		output.append( "\t\"" ).append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] ).append( "\",\n" );
+	}
+	output.append( "};\n" );
+	output.append( "#endif\n\n" );
+
 	// bool init()
 	output.append( COMMENT_BREAK "\n\n" );
 	output.append( "bool SysObjects::init()\n{\n" );
 	{
-		output.append( "\tObject::Serialization::init();\n\n" );
+		output.append( "\tObject::Serialization::init();\n" );
+		output.append( "\tSysObjects::parallel_init();\n\n" );
 		output.append( "\treturn true;\n" );
 	}
 	output.append( "}\n\n" );
@@ -1997,7 +2308,8 @@ void Objects::generate_source_system( String &output )
 	// bool free()
 	output.append( "bool SysObjects::free()\n{\n" );
 	{
-		output.append( "\tObject::Serialization::free();\n\n" );
+		output.append( "\tObject::Serialization::free();\n" );
+		output.append( "\tSysObjects::parallel_free();\n\n" );
 		output.append( "\treturn true;\n" );
 	}
 	output.append( "}\n\n" );
@@ -2214,6 +2526,23 @@ void Objects::generate_source_objects( String &output )
 	// Object Classes
 	for( ObjectFile *object : objectFilesSorted ) { object->write_source(); }
 
+	// TYPE_SNAPSHOT_FIELDS (inherited fields first)
+	output.append( COMMENT_BREAK "\n\n" );
+	output.append( "u32 ( *const SysObjects::TYPE_SNAPSHOT_FIELDS[OBJECT_TYPE_COUNT] )( ObjectSnapshotField * ) =\n{\n" );
+	for( ObjectFile *object : objectFilesSorted )
+	{
+		List<ObjectFile *> chain;
+		for( ObjectFile *par = object; par != nullptr; par = par->parent ) { chain.add( par ); }
+		output.append( "\t[]( ObjectSnapshotField *fields ) -> u32 { u32 count = 0; " );
+		for( usize i = chain.size(); i > 0; i-- )
+		{
+			output.append( "count += SysObjects::OBJECT_ENCODER<" ).append( chain[i - 1]->name );
+			output.append( ">::snapshot_fields( fields + count ); " );
+		}
+		output.append( "return count; },\n" );
+	}
+	output.append( "};\n\n" );
+
 	// EOF
 	output.append( COMMENT_BREAK );
 
@@ -2224,6 +2553,14 @@ void Objects::generate_source_objects( String &output )
 
 void Objects::generate_source_objects_events( String &output )
 {
+	// SPATIAL objects: ObjectContext::event_update() syncs the spatial index first
+	bool spatial = false;
+	for( ObjectFile *object : objectFilesSorted ) { spatial |= object->spatial; }
+
+	// UPDATE_RATE objects: ObjectContext::event_update() advances the stagger frame & accumulated time
+	bool updateRate = false;
+	for( ObjectFile *object : objectFilesSorted ) { updateRate |= object->updateRate > 0; }
+
 	// Events
 	for( u8 eventID = 0; eventID < EVENT_COUNT; eventID++ )
 	{
@@ -2257,6 +2594,8 @@ void Objects::generate_source_objects_events( String &output )
 		output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
 		output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_Parameters] );
 		output.append( "\n{\n" );
+		if( eventID == KeywordID_EVENT_UPDATE && spatial ) { output.append( "\tspatial_update();\n" ); }
+		if( eventID == KeywordID_EVENT_UPDATE && updateRate ) { output.append( "\tupdate_rate_advance( delta );\n" ); }
 		output.append( "\tif( SysObjects::").append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
 		output.append( "[category] == nullptr ) { return; }\n" );
 		output.append( "\tSysObjects::" ).append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
@@ -2274,6 +2613,9 @@ String Objects::generate_source_objects_events_category( String &output, const u
 	bool generated = false;
 	const bool defaultCategory = category.equals( "OBJECT_CATEGORY_DEFAULT" );
 
+	String eventEnum;
+	append_event_enum( eventEnum, eventID );
+
 	// Generate event function
 	event.append( "void " );
 	event.append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] ).append( "_" ).append( category );
@@ -2289,9 +2631,44 @@ String Objects::generate_source_objects_events_category( String &output, const u
 		if( object->events[eventID].manual ) { continue; }
 		if( !defaultCategory && !object->categories.contains( category.hash() ) ) { continue; }
 
-		event.append( "\tforeach_object( context, " ).append( object->name ).append( ", h ) { " );
+		// OBJECT_PROFILER scope & instance counter (expand to nothing when disabled)
+		event.append( "\t{ OBJECT_PROFILE_SCOPE( " ).append( object->name ).append( ", " );
+		event.append( eventEnum ).append( " ); " );
+
+		// UPDATE_RATE objects: only instances due this frame run, receiving their accumulated delta
+		if( eventID == KeywordID_EVENT_UPDATE && object->update_rate() > 0 )
+		{
+			if( object->parallel )
+			{
+				event.append( "context.parallel_foreach<" ).append( object->name ).append( ">( [&]( ObjectHandle<" );
+				event.append( object->name ).append( "> h ) { Delta rateDelta; if( context.update_rate_due<" );
+				event.append( object->name ).append( ">( h, rateDelta ) ) { OBJECT_PROFILE_INSTANCE_PARALLEL(); " );
+				event.append( "h->event_update( rateDelta ); } } ); }\n" );
+			}
+			else
+			{
+				event.append( "context.foreach_update_rate<" ).append( object->name ).append( ">( [&]( ObjectHandle<" );
+				event.append( object->name ).append( "> h, const Delta rateDelta ) { OBJECT_PROFILE_INSTANCE(); " );
+				event.append( "h->event_update( rateDelta ); } ); }\n" );
+			}
+			generated = true;
+			continue;
+		}
+
+		// PARALLEL objects: dispatch bucket chunks across the job system
+		if( object->parallel && ( eventID == KeywordID_EVENT_UPDATE || eventID == KeywordID_EVENT_UPDATE_CUSTOM ) )
+		{
+			event.append( "context.parallel_foreach<" ).append( object->name ).append( ">( [&]( ObjectHandle<" );
+			event.append( object->name ).append( "> h ) { OBJECT_PROFILE_INSTANCE_PARALLEL(); " );
+			event.append( "h->" ).append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
+			event.append( g_EVENT_FUNCTIONS[eventID][EventFunction_ParametersCaller] ).append( "; } ); }\n" );
+			generated = true;
+			continue;
+		}
+
+		event.append( "foreach_object( context, " ).append( object->name ).append( ", h ) { OBJECT_PROFILE_INSTANCE(); " );
 		event.append( "h->" ).append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
-		event.append( g_EVENT_FUNCTIONS[eventID][EventFunction_ParametersCaller] ).append( "; }\n" );
+		event.append( g_EVENT_FUNCTIONS[eventID][EventFunction_ParametersCaller] ).append( "; } }\n" );
 		generated = true;
 	}
 	event.append( "}\n\n" );
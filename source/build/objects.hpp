@@ -56,6 +56,9 @@ enum_type( KeywordID, u8 )
 	KeywordID_VERSIONS,
 	KeywordID_ABSTRACT,
 	KeywordID_NETWORKED,
+	KeywordID_PARALLEL,
+	KeywordID_SPATIAL,
+	KeywordID_UPDATE_RATE,
 	KeywordID_CONSTRUCTOR,
 	KeywordID_WRITE,
 	KeywordID_READ,
@@ -151,6 +154,19 @@ struct ObjectFile
 	void keyword_FRIEND( const String &buffer, Keyword &keyword );
 	void keyword_CATEGORY( const String &buffer, Keyword &keyword );
 	void keyword_VERSIONS( const String &buffer, Keyword &keyword );
+	void keyword_SPATIAL( const String &buffer, Keyword &keyword );
+
+	void snapshot_fields( List<String> &outNames ) const;
+	usize snapshot_field_count() const;
+
+	usize update_rate() const
+	{
+		for( const ObjectFile *object = this; object != nullptr; object = object->parent )
+		{
+			if( object->updateRate > 0 ) { return object->updateRate; }
+		}
+		return 0;
+	}
 
 	bool instantiable()
 	{
@@ -173,6 +189,9 @@ struct ObjectFile
 	bool abstract = false;
 	bool noinherit = false;
 	bool networked = false;
+	bool parallel = false;
+	bool spatial = false;
+	usize updateRate = 0;
 	bool hasSerialize = false;
 	bool hasWriteRead = false;
 
@@ -223,6 +242,10 @@ struct ObjectFile
 	String serializeSource;
 	String deserializeHeader;
 	String deserializeSource;
+	String spatialX;
+	String spatialY;
+	String spatialRadius;
+	String spatialCellSize;
 
 	// Override Error Macros
 	void ERROR_HANDLER_FUNCTION_DECL;
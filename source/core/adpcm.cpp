@@ -0,0 +1,124 @@
+#include <core/adpcm.hpp>
+
+#include <core/memory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const i16 adpcm_step_table[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107,
+	118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+	6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+	32767
+};
+
+
+static const i8 adpcm_index_table[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+
+struct AdpcmState
+{
+	int predictor;
+	int index;
+};
+
+
+static inline i16 adpcm_decode_nibble( AdpcmState &state, const u32 nibble )
+{
+	const int step = adpcm_step_table[state.index];
+	int difference = step >> 3;
+	if( nibble & 1 ) { difference += step >> 2; }
+	if( nibble & 2 ) { difference += step >> 1; }
+	if( nibble & 4 ) { difference += step; }
+	if( nibble & 8 ) { difference = -difference; }
+
+	state.predictor += difference;
+	state.predictor = state.predictor < -32768 ? -32768 : ( state.predictor > 32767 ? 32767 : state.predictor );
+	state.index += adpcm_index_table[nibble];
+	state.index = state.index < 0 ? 0 : ( state.index > 88 ? 88 : state.index );
+	return static_cast<i16>( state.predictor );
+}
+
+
+static inline u32 adpcm_encode_sample( AdpcmState &state, const int sample )
+{
+	// Quantize the difference against the current step, then track the decoder exactly
+	const int step = adpcm_step_table[state.index];
+	int difference = sample - state.predictor;
+	u32 nibble = 0;
+	if( difference < 0 ) { nibble = 8; difference = -difference; }
+	if( difference >= step ) { nibble |= 4; difference -= step; }
+	if( difference >= step >> 1 ) { nibble |= 2; difference -= step >> 1; }
+	if( difference >= step >> 2 ) { nibble |= 1; }
+
+	adpcm_decode_nibble( state, nibble );
+	return nibble;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void adpcm_encode( byte *output, const i16 *samples, const usize frames, const int channels )
+{
+	// The first block starts at the first frame (no ramp from silence)
+	AdpcmState states[2] = { { 0, 0 }, { 0, 0 } };
+	for( int c = 0; c < channels && frames > 0; c++ ) { states[c].predictor = samples[c]; }
+	const usize blocks = ( frames + ADPCM_BLOCK_FRAMES - 1 ) / ADPCM_BLOCK_FRAMES;
+
+	for( usize block = 0; block < blocks; block++ )
+	{
+		const usize first = block * ADPCM_BLOCK_FRAMES;
+		for( int c = 0; c < channels; c++ )
+		{
+			// Header: state at the start of the block
+			AdpcmState &state = states[c];
+			byte *header = output;
+			const i16 predictor = static_cast<i16>( state.predictor );
+			memory_copy( header, &predictor, sizeof( i16 ) );
+			header[2] = static_cast<byte>( state.index );
+			header[3] = 0;
+			output += ADPCM_BLOCK_HEADER_BYTES;
+
+			// Nibbles (past the end: silence)
+			for( usize i = 0; i < ADPCM_BLOCK_FRAMES; i += 2 )
+			{
+				const usize frame = first + i;
+				const int s0 = frame + 0 < frames ? samples[( frame + 0 ) * channels + c] : 0;
+				const int s1 = frame + 1 < frames ? samples[( frame + 1 ) * channels + c] : 0;
+				const u32 n0 = adpcm_encode_sample( state, s0 );
+				const u32 n1 = adpcm_encode_sample( state, s1 );
+				*output++ = static_cast<byte>( n0 | ( n1 << 4 ) );
+			}
+		}
+	}
+}
+
+
+void adpcm_decode_block( i16 *output, const byte *block, const u32 frames, const int channels )
+{
+	for( int c = 0; c < channels; c++ )
+	{
+		const byte *data = block + c * ( ADPCM_BLOCK_HEADER_BYTES + ADPCM_BLOCK_FRAMES / 2 );
+		i16 predictor;
+		memory_copy( &predictor, data, sizeof( i16 ) );
+		AdpcmState state { predictor, data[2] > 88 ? 88 : data[2] };
+		data += ADPCM_BLOCK_HEADER_BYTES;
+
+		i16 *destination = output + c;
+		u32 i = 0;
+		for( ; i + 2 <= frames; i += 2 )
+		{
+			const u32 nibbles = *data++;
+			destination[0] = adpcm_decode_nibble( state, nibbles & 0x0F );
+			destination[channels] = adpcm_decode_nibble( state, nibbles >> 4 );
+			destination += channels * 2;
+		}
+		if( i < frames ) { destination[0] = adpcm_decode_nibble( state, *data & 0x0F ); }
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
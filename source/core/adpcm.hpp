@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vendor/config.hpp>
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sample data formats in the asset binary (DiskSound::format, DiskSong::format)
+enum_type( AudioFormat, int )
+{
+	AudioFormat_PCM16,
+	AudioFormat_ADPCM,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// IMA-ADPCM: 4 bits per sample (~4:1 vs. 16-bit PCM). Samples are coded in independent blocks of ADPCM_BLOCK_FRAMES
+// frames, so any block decodes on its own. Per channel, a block holds a 4 byte header (i16 predictor, u8 step index,
+// u8 padding) followed by ADPCM_BLOCK_FRAMES / 2 bytes of nibbles (low nibble first). The final block is zero padded
+
+#define ADPCM_BLOCK_FRAMES ( 1024 )
+#define ADPCM_BLOCK_HEADER_BYTES ( 4 )
+
+static_assert( ADPCM_BLOCK_FRAMES % 2 == 0, "ADPCM_BLOCK_FRAMES must be even" );
+
+
+constexpr usize adpcm_block_bytes( const int channels )
+{
+	return static_cast<usize>( channels ) * ( ADPCM_BLOCK_HEADER_BYTES + ADPCM_BLOCK_FRAMES / 2 );
+}
+
+
+constexpr usize adpcm_encoded_bytes( const usize frames, const int channels )
+{
+	return ( frames + ADPCM_BLOCK_FRAMES - 1 ) / ADPCM_BLOCK_FRAMES * adpcm_block_bytes( channels );
+}
+
+
+// Encodes 'frames' interleaved frames into adpcm_encoded_bytes( frames, channels ) bytes
+extern void adpcm_encode( byte *output, const i16 *samples, const usize frames, const int channels );
+
+// Decodes the first 'frames' frames (<= ADPCM_BLOCK_FRAMES) of a block into interleaved samples
+extern void adpcm_decode_block( i16 *output, const byte *block, const u32 frames, const int channels );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
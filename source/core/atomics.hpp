@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vendor/vendor.hpp>
+#include <vendor/intrin.hpp>
+
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Atomic operations on naturally aligned 32-bit & 64-bit integers
+//
+// Loads have acquire semantics, stores have release semantics, and read-modify-write operations are
+// sequentially consistent. MSVC x64 relies on TSO ordering for plain volatile loads & stores; MSVC ARM64 pairs
+// them with full barriers (dmb ish)
+
+#if PIPELINE_COMPILER_MSVC
+	static_assert( PIPELINE_ARCHITECTURE_X64 || PIPELINE_ARCHITECTURE_ARM64, "atomic: unsupported MSVC architecture" );
+	#define ATOMIC_BARRIER_ISH ( 0xB ) // __dmb() option: inner shareable, full (_ARM64_BARRIER_ISH)
+#endif
+
+template <typename T> inline T atomic_load( const volatile T *address )
+{
+	static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "atomic: unsupported type size" );
+#if PIPELINE_COMPILER_MSVC && PIPELINE_ARCHITECTURE_ARM64
+	T value;
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		value = static_cast<T>( __iso_volatile_load32( reinterpret_cast<const volatile __int32 *>( address ) ) );
+	}
+	else
+	{
+		value = static_cast<T>( __iso_volatile_load64( reinterpret_cast<const volatile __int64 *>( address ) ) );
+	}
+	__dmb( ATOMIC_BARRIER_ISH );
+	return value;
+#elif PIPELINE_COMPILER_MSVC
+	const T value = *address;
+	_ReadWriteBarrier();
+	return value;
+#else
+	return __atomic_load_n( address, __ATOMIC_ACQUIRE );
+#endif
+}
+
+
+template <typename T> inline void atomic_store( volatile T *address, const T value )
+{
+	static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "atomic: unsupported type size" );
+#if PIPELINE_COMPILER_MSVC && PIPELINE_ARCHITECTURE_ARM64
+	__dmb( ATOMIC_BARRIER_ISH );
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		__iso_volatile_store32( reinterpret_cast<volatile __int32 *>( address ), static_cast<__int32>( value ) );
+	}
+	else
+	{
+		__iso_volatile_store64( reinterpret_cast<volatile __int64 *>( address ), static_cast<__int64>( value ) );
+	}
+#elif PIPELINE_COMPILER_MSVC
+	_ReadWriteBarrier();
+	*address = value;
+#else
+	__atomic_store_n( address, value, __ATOMIC_RELEASE );
+#endif
+}
+
+
+// Returns the previous value
+template <typename T> inline T atomic_exchange( volatile T *address, const T value )
+{
+	static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "atomic: unsupported type size" );
+#if PIPELINE_COMPILER_MSVC
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		return static_cast<T>( _InterlockedExchange( reinterpret_cast<volatile long *>( address ),
+			static_cast<long>( value ) ) );
+	}
+	else
+	{
+		return static_cast<T>( _InterlockedExchange64( reinterpret_cast<volatile long long *>( address ),
+			static_cast<long long>( value ) ) );
+	}
+#else
+	return __atomic_exchange_n( address, value, __ATOMIC_SEQ_CST );
+#endif
+}
+
+
+// Returns the previous value
+template <typename T> inline T atomic_add( volatile T *address, const T value )
+{
+	static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "atomic: unsupported type size" );
+#if PIPELINE_COMPILER_MSVC
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		return static_cast<T>( _InterlockedExchangeAdd( reinterpret_cast<volatile long *>( address ),
+			static_cast<long>( value ) ) );
+	}
+	else
+	{
+		return static_cast<T>( _InterlockedExchangeAdd64( reinterpret_cast<volatile long long *>( address ),
+			static_cast<long long>( value ) ) );
+	}
+#else
+	return __atomic_fetch_add( address, value, __ATOMIC_SEQ_CST );
+#endif
+}
+
+
+// Returns the previous value
+template <typename T> inline T atomic_sub( volatile T *address, const T value )
+{
+	return atomic_add( address, static_cast<T>( 0 - value ) );
+}
+
+
+// Returns true if *address was 'expected' and has been replaced with 'desired'
+template <typename T> inline bool atomic_compare_exchange( volatile T *address, const T expected, const T desired )
+{
+	static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "atomic: unsupported type size" );
+#if PIPELINE_COMPILER_MSVC
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		return _InterlockedCompareExchange( reinterpret_cast<volatile long *>( address ),
+			static_cast<long>( desired ), static_cast<long>( expected ) ) == static_cast<long>( expected );
+	}
+	else
+	{
+		return _InterlockedCompareExchange64( reinterpret_cast<volatile long long *>( address ),
+			static_cast<long long>( desired ), static_cast<long long>( expected ) ) == static_cast<long long>( expected );
+	}
+#else
+	T value = expected;
+	return __atomic_compare_exchange_n( address, &value, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+#endif
+}
+
+
+// CPU hint for spin-wait loops
+inline void atomic_pause()
+{
+#if PIPELINE_COMPILER_MSVC && PIPELINE_ARCHITECTURE_ARM64
+	__yield();
+#elif PIPELINE_COMPILER_MSVC
+	_mm_pause();
+#elif PIPELINE_ARCHITECTURE_X64
+	__builtin_ia32_pause();
+#elif PIPELINE_ARCHITECTURE_ARM64
+	__asm__ __volatile__( "yield" );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Minimal test-and-set lock for short critical sections
+struct SpinLock
+{
+	volatile u32 locked = 0;
+
+	void lock()
+	{
+		for( ;; )
+		{
+			if( atomic_exchange<u32>( &locked, 1 ) == 0 ) { return; }
+			while( atomic_load( &locked ) != 0 ) { atomic_pause(); }
+		}
+	}
+
+	bool try_lock() { return atomic_load( &locked ) == 0 && atomic_exchange<u32>( &locked, 1 ) == 0; }
+	void unlock() { atomic_store<u32>( &locked, 0 ); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
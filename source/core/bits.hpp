@@ -0,0 +1,128 @@
+#pragma once
+
+#include <vendor/vendor.hpp>
+#include <vendor/intrin.hpp>
+
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Number of u64 words required to store 'count' bits
+#define BITS_WORDS_U64( count ) ( ( ( count ) + 63 ) / 64 )
+
+// Index of the lowest set bit (value must be non-zero)
+inline u32 bits_ctz64( const u64 value )
+{
+#if PIPELINE_COMPILER_MSVC
+	unsigned long index;
+	_BitScanForward64( &index, value );
+	return static_cast<u32>( index );
+#else
+	return static_cast<u32>( __builtin_ctzll( value ) );
+#endif
+}
+
+
+// Number of leading zero bits (value must be non-zero)
+inline u32 bits_clz64( const u64 value )
+{
+#if PIPELINE_COMPILER_MSVC
+	unsigned long index;
+	_BitScanReverse64( &index, value );
+	return 63 - static_cast<u32>( index );
+#else
+	return static_cast<u32>( __builtin_clzll( value ) );
+#endif
+}
+
+
+// Number of set bits
+inline u32 bits_popcount64( u64 value )
+{
+#if PIPELINE_COMPILER_MSVC
+	// SWAR popcount (__popcnt64 requires hardware POPCNT support)
+	value = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+	value = ( value & 0x3333333333333333ULL ) + ( ( value >> 2 ) & 0x3333333333333333ULL );
+	value = ( value + ( value >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+	return static_cast<u32>( ( value * 0x0101010101010101ULL ) >> 56 );
+#else
+	return static_cast<u32>( __builtin_popcountll( value ) );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the index of the first set bit in [start, end), or 'end' if none
+inline u32 bits_find_set( const u64 *const words, const u32 start, const u32 end )
+{
+	if( start >= end ) { return end; }
+	u32 word = start >> 6;
+	u64 bits = words[word] & ( ~0ULL << ( start & 63 ) );
+	const u32 wordEnd = BITS_WORDS_U64( end );
+
+	for( ;; )
+	{
+		if( bits != 0 )
+		{
+			const u32 index = ( word << 6 ) + bits_ctz64( bits );
+			return index < end ? index : end;
+		}
+		if( ++word >= wordEnd ) { return end; }
+		bits = words[word];
+	}
+}
+
+
+// Returns the index of the first clear bit in [start, end), or 'end' if none
+inline u32 bits_find_clear( const u64 *const words, const u32 start, const u32 end )
+{
+	if( start >= end ) { return end; }
+	u32 word = start >> 6;
+	u64 bits = ~words[word] & ( ~0ULL << ( start & 63 ) );
+	const u32 wordEnd = BITS_WORDS_U64( end );
+
+	for( ;; )
+	{
+		if( bits != 0 )
+		{
+			const u32 index = ( word << 6 ) + bits_ctz64( bits );
+			return index < end ? index : end;
+		}
+		if( ++word >= wordEnd ) { return end; }
+		bits = ~words[word];
+	}
+}
+
+
+// Returns one past the index of the last set bit in [0, end), or 0 if none
+inline u32 bits_find_set_reverse( const u64 *const words, const u32 end )
+{
+	if( end == 0 ) { return 0; }
+	u32 word = ( end - 1 ) >> 6;
+	u64 bits = words[word] & ( ~0ULL >> ( 63 - ( ( end - 1 ) & 63 ) ) );
+
+	for( ;; )
+	{
+		if( bits != 0 ) { return ( word << 6 ) + ( 64 - bits_clz64( bits ) ); }
+		if( word-- == 0 ) { return 0; }
+		bits = words[word];
+	}
+}
+
+
+// Returns the number of set bits in [0, count)
+inline u32 bits_count( const u64 *const words, const u32 count )
+{
+	u32 total = 0;
+	const u32 wordsFull = count >> 6;
+	for( u32 i = 0; i < wordsFull; i++ ) { total += bits_popcount64( words[i] ); }
+	if( count & 63 ) { total += bits_popcount64( words[wordsFull] & ( ( 1ULL << ( count & 63 ) ) - 1 ) ); }
+	return total;
+}
+
+
+inline void bits_set( u64 *const words, const u32 index ) { words[index >> 6] |= ( 1ULL << ( index & 63 ) ); }
+inline void bits_clear( u64 *const words, const u32 index ) { words[index >> 6] &= ~( 1ULL << ( index & 63 ) ); }
+inline bool bits_test( const u64 *const words, const u32 index ) { return ( words[index >> 6] >> ( index & 63 ) ) & 1; }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
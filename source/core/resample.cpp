@@ -0,0 +1,108 @@
+#include <core/resample.hpp>
+
+#include <core/memory.hpp>
+
+#include <vendor/math.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Asset builders: 32 taps, 1024 phases (interpolated), cutoff just below the lower Nyquist rate
+static constexpr u32 RESAMPLE_OFFLINE_TAPS = 32;
+static constexpr u32 RESAMPLE_OFFLINE_PHASES = 1024;
+static constexpr double RESAMPLE_OFFLINE_CUTOFF = 0.95;
+static constexpr double RESAMPLE_OFFLINE_BETA = 9.0;
+
+static constexpr double RESAMPLE_PI = 3.14159265358979323846;
+
+
+static double bessel_i0( const double x )
+{
+	// Power series (converges quickly for the window's range)
+	double sum = 1.0;
+	double term = 1.0;
+	for( int k = 1; k < 32; k++ )
+	{
+		const double t = x / ( 2.0 * k );
+		term *= t * t;
+		sum += term;
+		if( term < sum * 1e-12 ) { break; }
+	}
+	return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void resample_sinc_kernel( float *table, const u32 taps, const u32 phases, const double cutoff, const double beta )
+{
+	const double half = static_cast<double>( taps / 2 );
+	const double windowScale = 1.0 / bessel_i0( beta );
+
+	for( u32 p = 0; p <= phases; p++ )
+	{
+		const double phase = static_cast<double>( p ) / phases;
+		float *row = &table[p * taps];
+		double sum = 0.0;
+		for( u32 j = 0; j < taps; j++ )
+		{
+			// Distance from the read position to tap j
+			const double distance = static_cast<double>( j ) - ( half - 1.0 ) - phase;
+			const double x = distance / half;
+			const double window = x * x < 1.0 ? bessel_i0( beta * sqrt( 1.0 - x * x ) ) * windowScale : 0.0;
+			const double t = RESAMPLE_PI * cutoff * distance;
+			const double sinc = t == 0.0 ? 1.0 : sin( t ) / t;
+			const double coefficient = cutoff * sinc * window;
+			row[j] = static_cast<float>( coefficient );
+			sum += coefficient;
+		}
+		for( u32 j = 0; j < taps; j++ ) { row[j] = static_cast<float>( row[j] / sum ); }
+	}
+}
+
+
+usize resample_frames( const usize frames, const u32 rateIn, const u32 rateOut )
+{
+	return static_cast<usize>( ( static_cast<u64>( frames ) * rateOut + rateIn - 1 ) / rateIn );
+}
+
+
+void resample_i16( i16 *output, const i16 *input, const usize framesIn, const int channels, const u32 rateIn,
+	const u32 rateOut )
+{
+	// Downsampling lowers the cutoff to the output Nyquist rate
+	const double ratio = static_cast<double>( rateIn ) / rateOut;
+	const double cutoff = RESAMPLE_OFFLINE_CUTOFF * ( ratio > 1.0 ? 1.0 / ratio : 1.0 );
+	float *table = reinterpret_cast<float *>(
+		memory_alloc( ( RESAMPLE_OFFLINE_PHASES + 1 ) * RESAMPLE_OFFLINE_TAPS * sizeof( float ) ) );
+	resample_sinc_kernel( table, RESAMPLE_OFFLINE_TAPS, RESAMPLE_OFFLINE_PHASES, cutoff, RESAMPLE_OFFLINE_BETA );
+
+	const usize framesOut = resample_frames( framesIn, rateIn, rateOut );
+	const i64 first = -static_cast<i64>( RESAMPLE_OFFLINE_TAPS / 2 - 1 );
+	for( usize n = 0; n < framesOut; n++ )
+	{
+		// Source position (exact in 64-bit integers, so long assets do not drift)
+		const u64 numerator = static_cast<u64>( n ) * rateIn;
+		const i64 index = static_cast<i64>( numerator / rateOut );
+		const double phase = static_cast<double>( numerator % rateOut ) / rateOut * RESAMPLE_OFFLINE_PHASES;
+		const u32 row = static_cast<u32>( phase );
+		const float t = static_cast<float>( phase - row );
+		const float *a = &table[row * RESAMPLE_OFFLINE_TAPS];
+		const float *b = a + RESAMPLE_OFFLINE_TAPS;
+
+		for( int c = 0; c < channels; c++ )
+		{
+			double sum = 0.0;
+			for( u32 j = 0; j < RESAMPLE_OFFLINE_TAPS; j++ )
+			{
+				const i64 source = index + first + j;
+				if( source < 0 || source >= static_cast<i64>( framesIn ) ) { continue; }
+				sum += static_cast<double>( a[j] + ( b[j] - a[j] ) * t ) * input[source * channels + c];
+			}
+			const double rounded = sum < 0.0 ? sum - 0.5 : sum + 0.5;
+			output[n * channels + c] = static_cast<i16>( rounded < -32768.0 ? -32768.0 : ( rounded > 32767.0 ? 32767.0 : rounded ) );
+		}
+	}
+
+	memory_free( table );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vendor/config.hpp>
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Windowed-sinc (Kaiser) resampling, shared by the asset builders & the mixer kernels (see manta/audio.simd.hpp)
+//
+// A kernel table holds 'phases + 1' rows of 'taps' coefficients. Row p filters the source at fractional position
+// p / phases: output = sum over j of table[p][j] * source[index - ( taps / 2 - 1 ) + j]. Rows are normalized to unit
+// DC gain, and row 'phases' (position 1.0) lets callers interpolate linearly between neighbouring rows
+
+// Fills 'table' with ( phases + 1 ) * taps coefficients. 'cutoff' is a fraction of the source Nyquist rate
+extern void resample_sinc_kernel( float *table, const u32 taps, const u32 phases, const double cutoff, const double beta );
+
+// Number of frames 'frames' source frames become at 'rateOut'
+extern usize resample_frames( const usize frames, const u32 rateIn, const u32 rateOut );
+
+// Offline, high quality conversion of interleaved samples (asset builders). 'output' holds
+// resample_frames( framesIn, rateIn, rateOut ) frames
+extern void resample_i16( i16 *output, const i16 *input, const usize framesIn, const int channels, const u32 rateIn,
+	const u32 rateOut );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
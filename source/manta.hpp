@@ -81,6 +81,10 @@
 	#define RENDER_QUAD_BATCH_SIZE ( 4096 )
 #endif
 
+#ifndef RENDER_HEADLESS_COMMANDS
+	#define RENDER_HEADLESS_COMMANDS ( 65536 ) // Commands the headless backend (-gfx=none) logs per frame
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifndef AUDIO_BUS_COUNT
@@ -88,17 +92,147 @@
 #endif
 
 #ifndef AUDIO_VOICE_COUNT
-	#define AUDIO_VOICE_COUNT ( 32 )
+	#define AUDIO_VOICE_COUNT ( 1024 ) // Sounds playing at once (real & virtual)
+#endif
+
+#ifndef AUDIO_VOICE_REAL_COUNT
+	#define AUDIO_VOICE_REAL_COUNT ( 32 ) // Voices mixed per pass (the rest are virtual: they advance without mixing)
+#endif
+
+#ifndef AUDIO_VOICE_AUDIBILITY_MIN
+	#define AUDIO_VOICE_AUDIBILITY_MIN ( 0.001f ) // Voice x bus gain below which a voice stays virtual (-60 dB)
+#endif
+
+#ifndef AUDIO_COMMAND_QUEUE_SIZE
+	#define AUDIO_COMMAND_QUEUE_SIZE ( 2048 ) // Game -> mixer commands per audio period (power of two, >= voices)
+#endif
+
+#ifndef AUDIO_EVENT_QUEUE_SIZE
+	#define AUDIO_EVENT_QUEUE_SIZE ( 2048 ) // Mixer -> game events (power of two, > voices + buses)
+#endif
+
+#ifndef AUDIO_EFFECT_REVERB_POOL_SIZE
+	#define AUDIO_EFFECT_REVERB_POOL_SIZE ( 4 ) // Reverbs active at once (across voices & buses)
+#endif
+
+#ifndef AUDIO_SAMPLE_RATE
+	#define AUDIO_SAMPLE_RATE ( 44100 ) // Asset rate & preferred device rate (the mixer resamples to other device rates)
+#endif
+
+#ifndef AUDIO_SAMPLE_RATE_MAX
+	#define AUDIO_SAMPLE_RATE_MAX ( 48000 ) // Highest device rate accepted (sizes delay lines, <= 2x AUDIO_SAMPLE_RATE)
+#endif
+
+#ifndef AUDIO_MIX_FRAMES_MAX
+	#define AUDIO_MIX_FRAMES_MAX ( 4096 ) // Frames mixed per pass (longer device periods are mixed in chunks)
+#endif
+
+#ifndef AUDIO_MIX_WORKERS
+	#define AUDIO_MIX_WORKERS ( 0 ) // Threads started by SysAudio::init to mix voice groups & buses with the audio thread
+#endif
+
+#ifndef AUDIO_MIX_WORKERS_MAX
+	#define AUDIO_MIX_WORKERS_MAX ( 8 ) // Most threads SysAudio::init_workers accepts (each owns a voice mix buffer)
+#endif
+
+#ifndef AUDIO_MIX_GROUP_VOICES
+	#define AUDIO_MIX_GROUP_VOICES ( 8 ) // Real voices per parallel mixing task (a bus is split into groups)
+#endif
+
+#ifndef AUDIO_MIX_DEADLINE
+	#define AUDIO_MIX_DEADLINE ( 0.5 ) // Fraction of a period after which waiting on workers counts as a deadline miss
+#endif
+
+#ifndef AUDIO_MIX_FALLBACK_PERIODS
+	#define AUDIO_MIX_FALLBACK_PERIODS ( 64 ) // Periods mixed on the audio thread alone after a deadline miss
+#endif
+
+#ifndef AUDIO_AUTOMATION_FRAMES
+	#define AUDIO_AUTOMATION_FRAMES ( 32 ) // Frames per effect parameter ramp segment (automation control rate)
+#endif
+
+#ifndef AUDIO_OFFLINE
+	#define AUDIO_OFFLINE ( 0 ) // No audio device: the mixer runs on demand (see SysAudio::offline_render)
+#endif
+
+#ifndef AUDIO_OFFLINE_PERIOD_FRAMES
+	#define AUDIO_OFFLINE_PERIOD_FRAMES ( 1024 ) // Frames per audio_mixer call when rendering offline
+#endif
+
+#ifndef AUDIO_PROFILER
+	#define AUDIO_PROFILER ( 0 ) // Time each audio_mixer stage (see SysAudio::mixer_profile)
+#endif
+
+#ifndef AUDIO_STREAM_COUNT
+	#define AUDIO_STREAM_COUNT ( 4 ) // Songs streamed from disk at once
+#endif
+
+#ifndef AUDIO_STREAM_BLOCK_FRAMES
+	#define AUDIO_STREAM_BLOCK_FRAMES ( 4096 ) // Frames per streamed block (~93 ms at 44.1 kHz)
+#endif
+
+#ifndef AUDIO_STREAM_READ_AHEAD
+	#define AUDIO_STREAM_READ_AHEAD ( 3 ) // Blocks buffered per stream (2: double buffering, 3: triple buffering)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOB_WORKER_THREADS
+	#define JOB_WORKER_THREADS ( -1 ) // Job system worker threads (-1: hardware threads - 1)
+#endif
+
+#ifndef JOB_WORKER_THREADS_MAX
+	#define JOB_WORKER_THREADS_MAX ( 63 )
+#endif
+
+#ifndef JOB_PIN_THREADS
+	#define JOB_PIN_THREADS ( 1 ) // Pin job workers to hardware threads
+#endif
+
+#ifndef JOB_QUEUE_SIZE
+	#define JOB_QUEUE_SIZE ( 4096 ) // Per-thread job deque capacity (power of two)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OBJECT_PARALLEL_CHUNK_SIZE
+	#define OBJECT_PARALLEL_CHUNK_SIZE ( 256 ) // ObjectBucket slots per PARALLEL work chunk
+#endif
+
+#ifndef OBJECT_PARALLEL_CONTEXTS
+	#define OBJECT_PARALLEL_CONTEXTS ( 8 ) // Max ObjectContexts a single PARALLEL dispatch may create() & destroy() in
+#endif
+
+#ifndef OBJECT_SPATIAL_CELL_SIZE
+	#define OBJECT_SPATIAL_CELL_SIZE ( 64.0f ) // Default SPATIAL cell size (world units)
+#endif
+
+#ifndef OBJECT_COMPACT_SPARSE
+	#define OBJECT_COMPACT_SPARSE ( 25 ) // ObjectContext::compact() drains overflow buckets at most this % occupied
+#endif
+
+#ifndef OBJECT_COMPACT_RELOCATION_PASSES
+	#define OBJECT_COMPACT_RELOCATION_PASSES ( 120 ) // compact() passes a retired bucket's handles keep resolving
+#endif
+
+#ifndef OBJECT_PROFILER
+	#define OBJECT_PROFILER ( 0 ) // Time every generated per-type event loop (see ObjectProfiler)
+#endif
+
+#ifndef OBJECT_PROFILER_HISTORY
+	#define OBJECT_PROFILER_HISTORY ( 120 ) // ObjectProfiler frames of history
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define AUDIO_ALSA ( OS_LINUX | OS_ANDROID )
-#define AUDIO_COREAUDIO ( OS_MACOS | OS_IOS | OS_IPADOS )
-#define AUDIO_WASAPI ( OS_WINDOWS )
-#define AUDIO_NONE ( !( AUDIO_ALSA || AUDIO_COREAUDIO || AUDIO_WASAPI ))
+#define AUDIO_ALSA ( ( OS_LINUX | OS_ANDROID ) && !AUDIO_OFFLINE )
+#define AUDIO_COREAUDIO ( ( OS_MACOS | OS_IOS | OS_IPADOS ) && !AUDIO_OFFLINE )
+#define AUDIO_WASAPI ( OS_WINDOWS && !AUDIO_OFFLINE )
+#define AUDIO_NONE ( !( AUDIO_ALSA || AUDIO_COREAUDIO || AUDIO_WASAPI || AUDIO_OFFLINE ) )
 
-#if AUDIO_ALSA
+#if AUDIO_OFFLINE
+	#define BACKEND_AUDIO "offline"
+#elif AUDIO_ALSA
 	#define BACKEND_AUDIO "alsa"
 #elif AUDIO_COREAUDIO
 	#define BACKEND_AUDIO "coreaudio"
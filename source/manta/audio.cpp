@@ -1,11 +1,14 @@
 #include <manta/audio.hpp>
+#include <manta/audio.simd.hpp>
 
 #include <vendor/new.hpp>
+#include <vendor/stdio.hpp>
 #include <core/debug.hpp>
 
 #include <manta/thread.hpp>
 #include <manta/assets.hpp>
 #include <manta/math.hpp>
+#include <manta/time.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -13,9 +16,6 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define I16_TO_FLOAT(value) ( ( value ) * ( 1.0f / I16_MAX ) )
-#define FLOAT_TO_I16(value) static_cast<i16>( ( value ) * I16_MAX )
-
 #define undenormalise( sample ) \
 	if( ( ( *reinterpret_cast<unsigned int *>( &sample ) ) & 0x7f800000 ) == 0 ) { sample = 0.0f; }
 
@@ -28,6 +28,7 @@ namespace SysAudio
 	Voice voices[AUDIO_VOICE_COUNT];
 	Bus buses[AUDIO_BUS_COUNT];
 	i16 *g_AUDIO_SAMPLES = nullptr; // TODO: refactor
+	u32 sampleRate = AUDIO_SAMPLE_RATE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +44,22 @@ float SysAudio::Effect::get_parameter( const EffectParam param, const bool incre
 }
 
 
+bool SysAudio::Effect::parameter_ramp( const EffectParam param, const u32 frames, float &outValue, float &outStep )
+{
+	// Linear segment over the next 'frames' frames: frame k is 'outValue + k * outStep' (false once settled)
+	EffectParameter &parameter = parameters[param];
+	const float amount = parameter.sampleCurrent * parameter.sampleToInv;
+	if( !( amount < 1.0f ) ) { outValue = parameter.valueTo; outStep = 0.0f; return false; }
+
+	parameter.sampleCurrent += static_cast<float>( frames );
+	const float amountEnd = parameter.sampleCurrent * parameter.sampleToInv;
+	const float valueEnd = amountEnd < 1.0f ? lerp( parameter.valueFrom, parameter.valueTo, amountEnd ) : parameter.valueTo;
+	outValue = lerp( parameter.valueFrom, parameter.valueTo, amount );
+	outStep = ( valueEnd - outValue ) / static_cast<float>( frames );
+	return true;
+}
+
+
 void SysAudio::Effect::set_parameter( const EffectParam param, const float value )
 {
 	parameters[param].valueFrom = value;
@@ -57,7 +74,7 @@ void SysAudio::Effect::set_parameter( const EffectParam param, const float value
 	parameters[param].valueFrom = get_parameter( param, false );
 	parameters[param].valueTo = value;
 	parameters[param].sampleCurrent = 0.0f;
-	constexpr float msToHz = ( 44100.0f / 1000.0f );
+	const float msToHz = static_cast<float>( SysAudio::sampleRate ) / 1000.0f;
 	parameters[param].sampleToInv = 1.0f / ( timeMS * msToHz );
 }
 
@@ -67,7 +84,7 @@ void SysAudio::Effect::set_parameter( const EffectParam param, const float v0, c
 	parameters[param].valueFrom = v0;
 	parameters[param].valueTo = v1;
 	parameters[param].sampleCurrent = 0.0f;
-	constexpr float msToHz = ( 44100.0f / 1000.0f );
+	const float msToHz = static_cast<float>( SysAudio::sampleRate ) / 1000.0f;
 	parameters[param].sampleToInv = 1.0f / ( timeMS * msToHz );
 }
 
@@ -83,13 +100,17 @@ static void core_init( SysAudio::Effect &effect )
 
 static void core_apply( SysAudio::Effect &effect, float *samples, u32 sampleCount )
 {
-	SysAudio::EffectStateCore &core = effect.stateGain;
-
-	for( u32 i = 0; i < sampleCount; i++ )
+	for( u32 frame = 0; frame < sampleCount; frame += AUDIO_AUTOMATION_FRAMES )
 	{
-		const float volume = effect.get_parameter( SysAudio::EffectParam_Core_Gain, true );
-		samples[i * 2 + 0] *= volume;
-		samples[i * 2 + 1] *= volume;
+		const u32 frames = sampleCount - frame < AUDIO_AUTOMATION_FRAMES ? sampleCount - frame : AUDIO_AUTOMATION_FRAMES;
+		float gain, step;
+		if( !effect.parameter_ramp( SysAudio::EffectParam_Core_Gain, frames, gain, step ) )
+		{
+			// Settled: constant gain for the rest of the buffer
+			if( gain != 1.0f ) { SysAudio::mix_gain( samples + frame * 2, ( sampleCount - frame ) * 2, gain ); }
+			return;
+		}
+		SysAudio::mix_gain_ramp( samples + frame * 2, frames, gain, step );
 	}
 }
 
@@ -99,12 +120,12 @@ __AUDIO_EFFECT_PARAM_GET_SET_NOAUTOMATION_IMPL( SysAudio::EffectType_Core, pitch
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // EffectType_Lowpass
 
-static void lowpass_update( SysAudio::Effect &effect )
+static void lowpass_update( SysAudio::Effect &effect, const float paramCutoff )
 {
 	SysAudio::EffectStateLowpass &lowpass = effect.stateLowpass;
 
 	// Parameters
-	const float paramCutoff = effect.get_parameter( SysAudio::EffectParam_Lowpass_Cutoff, true );
+	lowpass.cutoff = paramCutoff;
 	lowpass.omega0 = 6.28318530718f * paramCutoff;
 
 	// Internal State
@@ -131,9 +152,8 @@ static void lowpass_init( SysAudio::Effect &effect )
 {
 	SysAudio::EffectStateLowpass &lowpass = effect.stateLowpass;
 	effect.set_parameter( SysAudio::EffectParam_Lowpass_Cutoff, 20000.0f );
-	static float sampleRate = 44100.0f;
-	lowpass.dt = 1.0f / sampleRate;
-	lowpass_update( effect );
+	lowpass.dt = 1.0f / static_cast<float>( SysAudio::sampleRate );
+	lowpass_update( effect, 20000.0f );
 }
 
 
@@ -143,8 +163,14 @@ static void lowpass_apply( SysAudio::Effect &effect, float *samples, u32 sampleC
 
 	for( u32 i = 0; i < sampleCount; i++ )
 	{
-		// Update coefficients
-		lowpass_update( effect );
+		// Update coefficients (once per automation segment, only when the cutoff moved)
+		if( i % AUDIO_AUTOMATION_FRAMES == 0 )
+		{
+			float cutoff, step;
+			const u32 frames = sampleCount - i < AUDIO_AUTOMATION_FRAMES ? sampleCount - i : AUDIO_AUTOMATION_FRAMES;
+			effect.parameter_ramp( SysAudio::EffectParam_Lowpass_Cutoff, frames, cutoff, step );
+			if( cutoff != lowpass.cutoff ) { lowpass_update( effect, cutoff ); }
+		}
 
 		lowpass.y[0] = 0;
 		lowpass.x[0] = samples[i * 2 + 0];
@@ -176,6 +202,25 @@ __AUDIO_EFFECT_PARAM_GET_SET_IMPL( SysAudio::EffectType_Lowpass, lowpass_cutoff,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // EffectType_Reverb
 
+static SysAudio::EffectStateReverb g_reverbPool[AUDIO_EFFECT_REVERB_POOL_SIZE];
+static u32 g_reverbPoolUsed[AUDIO_EFFECT_REVERB_POOL_SIZE]; // Claimed with atomic_compare_exchange (0 -> 1)
+static_assert( AUDIO_EFFECT_REVERB_POOL_SIZE < SysAudio::EFFECT_STATE_NONE, "AUDIO_EFFECT_REVERB_POOL_SIZE too large" );
+
+
+static u16 reverb_pool_acquire()
+{
+	// Lock-free: the mixer & job workers acquire/release concurrently
+	for( u16 i = 0; i < AUDIO_EFFECT_REVERB_POOL_SIZE; i++ )
+	{
+		if( atomic_load( &g_reverbPoolUsed[i] ) != 0 ) { continue; }
+		if( atomic_compare_exchange<u32>( &g_reverbPoolUsed[i], 0, 1 ) ) { return i; }
+	}
+
+	// Exhausted
+	return SysAudio::EFFECT_STATE_NONE;
+}
+
+
 static void reverb_comb_mute( SysAudio::EffectStateReverbComb &comb )
 {
 	for( int i = 0; i < comb.bufsize; i++ ) { comb.buffer[i] = 0.0f; }
@@ -186,6 +231,8 @@ static void reverb_comb_set_buffer( SysAudio::EffectStateReverbComb &comb, float
 {
 	comb.buffer = buffer;
 	comb.bufsize = size;
+	comb.bufidx = 0;
+	comb.filterstore = 0.0f;
 }
 
 
@@ -218,6 +265,7 @@ static void reverb_allpass_set_buffer( SysAudio::EffectStateReverbAllPass &allpa
 {
 	allpass.buffer = buffer;
 	allpass.bufsize = size;
+	allpass.bufidx = 0;
 }
 
 
@@ -246,7 +294,7 @@ static inline float reverb_allpass_process( SysAudio::EffectStateReverbAllPass &
 
 static void reverb_mute( SysAudio::Effect &effect )
 {
-	SysAudio::EffectStateReverb &reverb = effect.stateReverb;
+	SysAudio::EffectStateReverb &reverb = g_reverbPool[effect.state];
 
 	// Mute Combs
 	for( int i = 0; i < SysAudioTuning::numCombs; i++ )
@@ -264,25 +312,26 @@ static void reverb_mute( SysAudio::Effect &effect )
 }
 
 
-static void reverb_update( SysAudio::Effect &effect )
+static void reverb_update( SysAudio::Effect &effect, const float *parameters )
 {
-	SysAudio::EffectStateReverb &reverb = effect.stateReverb;
+	SysAudio::EffectStateReverb &reverb = g_reverbPool[effect.state];
 
 	// Parameters
-	const float paramRoomsize = effect.get_parameter( SysAudio::EffectParam_Reverb_RoomSize, true );
-	const float paramWet = effect.get_parameter( SysAudio::EffectParam_Reverb_Wet, true );
-	const float paramDry = effect.get_parameter( SysAudio::EffectParam_Reverb_Dry, true );
-	const float paramDamp = effect.get_parameter( SysAudio::EffectParam_Reverb_Damp, true );
-	const float paramWidth = effect.get_parameter( SysAudio::EffectParam_Reverb_Width, true );
+	const float paramRoomsize = parameters[SysAudio::EffectParam_Reverb_RoomSize];
+	const float paramWet = parameters[SysAudio::EffectParam_Reverb_Wet];
+	const float paramDry = parameters[SysAudio::EffectParam_Reverb_Dry];
+	const float paramWidth = parameters[SysAudio::EffectParam_Reverb_Width];
+	memory_copy( reverb.parameters, parameters, sizeof( reverb.parameters ) );
+	reverb.parametersValid = true;
 
 	// Recalculate internal values after parameter change (TODO: Refactor?)
 	reverb.roomsize = paramRoomsize * SysAudioTuning::scaleRoom + SysAudioTuning::offsetRoom; // TODO
 	reverb.wet = paramWet * SysAudioTuning::scaleWet; // TODO
+	reverb.width = paramWidth; // TODO
 	reverb.wet1 = reverb.wet * ( reverb.width * 0.5f + 0.5f );
 	reverb.wet2 = reverb.wet * ( ( 1.0f - reverb.width ) * 0.5f );
 	reverb.dry = paramDry * SysAudioTuning::scaleDry; // TODO
 	reverb.damp = paramDry * SysAudioTuning::scaleDamp; // TODO
-	reverb.width = paramWidth; // TODO
 	reverb.dry = paramDry; // TODO
 
 	reverb.roomsize1 = reverb.roomsize;
@@ -301,34 +350,52 @@ static void reverb_update( SysAudio::Effect &effect )
 
 static void reverb_init( SysAudio::Effect &effect )
 {
-	SysAudio::EffectStateReverb &reverb = effect.stateReverb;
+	effect.set_parameter( SysAudio::EffectParam_Reverb_Wet, SysAudioTuning::initialWet, 0 );
+	effect.set_parameter( SysAudio::EffectParam_Reverb_RoomSize, SysAudioTuning::initialRoom, 0 );
+	effect.set_parameter( SysAudio::EffectParam_Reverb_Dry, SysAudioTuning::initialDry, 0 );
+	effect.set_parameter( SysAudio::EffectParam_Reverb_Damp, SysAudioTuning::initialDamp, 0 );
+	effect.set_parameter( SysAudio::EffectParam_Reverb_Width, SysAudioTuning::initialWidth, 0 );
+}
+
+
+static int reverb_tuning( const int length )
+{
+	// Delay line length at the device rate (buffers are sized for AUDIO_SAMPLE_RATE_MAX)
+	Assert( SysAudio::sampleRate <= AUDIO_SAMPLE_RATE_MAX );
+	return SysAudioTuning::scaled( length, SysAudio::sampleRate );
+}
+
+
+static void reverb_init_state( SysAudio::Effect &effect )
+{
+	SysAudio::EffectStateReverb &reverb = g_reverbPool[effect.state];
 	{
 		// Tie the components to their buffers
-		reverb_comb_set_buffer( reverb.combL[0], reverb.bufcombL1, SysAudioTuning::combTuningL1 );
-		reverb_comb_set_buffer( reverb.combR[0], reverb.bufcombR1, SysAudioTuning::combTuningR1 );
-		reverb_comb_set_buffer( reverb.combL[1], reverb.bufcombL2, SysAudioTuning::combTuningL2 );
-		reverb_comb_set_buffer( reverb.combR[1], reverb.bufcombR2, SysAudioTuning::combTuningR2 );
-		reverb_comb_set_buffer( reverb.combL[2], reverb.bufcombL3, SysAudioTuning::combTuningL3 );
-		reverb_comb_set_buffer( reverb.combR[2], reverb.bufcombR3, SysAudioTuning::combTuningR3 );
-		reverb_comb_set_buffer( reverb.combL[3], reverb.bufcombL4, SysAudioTuning::combTuningL4 );
-		reverb_comb_set_buffer( reverb.combR[3], reverb.bufcombR4, SysAudioTuning::combTuningR4 );
-		reverb_comb_set_buffer( reverb.combL[4], reverb.bufcombL5, SysAudioTuning::combTuningL5 );
-		reverb_comb_set_buffer( reverb.combR[4], reverb.bufcombR5, SysAudioTuning::combTuningR5 );
-		reverb_comb_set_buffer( reverb.combL[5], reverb.bufcombL6, SysAudioTuning::combTuningL6 );
-		reverb_comb_set_buffer( reverb.combR[5], reverb.bufcombR6, SysAudioTuning::combTuningR6 );
-		reverb_comb_set_buffer( reverb.combL[6], reverb.bufcombL7, SysAudioTuning::combTuningL7 );
-		reverb_comb_set_buffer( reverb.combR[6], reverb.bufcombR7, SysAudioTuning::combTuningR7 );
-		reverb_comb_set_buffer( reverb.combL[7], reverb.bufcombL8, SysAudioTuning::combTuningL8 );
-		reverb_comb_set_buffer( reverb.combR[7], reverb.bufcombR8, SysAudioTuning::combTuningR8 );
-
-		reverb_allpass_set_buffer( reverb.allpassL[0], reverb.bufallpassL1, SysAudioTuning::allpassTuningL1 );
-		reverb_allpass_set_buffer( reverb.allpassR[0], reverb.bufallpassR1, SysAudioTuning::allpassTuningR1 );
-		reverb_allpass_set_buffer( reverb.allpassL[1], reverb.bufallpassL2, SysAudioTuning::allpassTuningL2 );
-		reverb_allpass_set_buffer( reverb.allpassR[1], reverb.bufallpassR2, SysAudioTuning::allpassTuningR2 );
-		reverb_allpass_set_buffer( reverb.allpassL[2], reverb.bufallpassL3, SysAudioTuning::allpassTuningL3 );
-		reverb_allpass_set_buffer( reverb.allpassR[2], reverb.bufallpassR3, SysAudioTuning::allpassTuningR3 );
-		reverb_allpass_set_buffer( reverb.allpassL[3], reverb.bufallpassL4, SysAudioTuning::allpassTuningL4 );
-		reverb_allpass_set_buffer( reverb.allpassR[3], reverb.bufallpassR4, SysAudioTuning::allpassTuningR4 );
+		reverb_comb_set_buffer( reverb.combL[0], reverb.bufcombL1, reverb_tuning( SysAudioTuning::combTuningL1 ) );
+		reverb_comb_set_buffer( reverb.combR[0], reverb.bufcombR1, reverb_tuning( SysAudioTuning::combTuningR1 ) );
+		reverb_comb_set_buffer( reverb.combL[1], reverb.bufcombL2, reverb_tuning( SysAudioTuning::combTuningL2 ) );
+		reverb_comb_set_buffer( reverb.combR[1], reverb.bufcombR2, reverb_tuning( SysAudioTuning::combTuningR2 ) );
+		reverb_comb_set_buffer( reverb.combL[2], reverb.bufcombL3, reverb_tuning( SysAudioTuning::combTuningL3 ) );
+		reverb_comb_set_buffer( reverb.combR[2], reverb.bufcombR3, reverb_tuning( SysAudioTuning::combTuningR3 ) );
+		reverb_comb_set_buffer( reverb.combL[3], reverb.bufcombL4, reverb_tuning( SysAudioTuning::combTuningL4 ) );
+		reverb_comb_set_buffer( reverb.combR[3], reverb.bufcombR4, reverb_tuning( SysAudioTuning::combTuningR4 ) );
+		reverb_comb_set_buffer( reverb.combL[4], reverb.bufcombL5, reverb_tuning( SysAudioTuning::combTuningL5 ) );
+		reverb_comb_set_buffer( reverb.combR[4], reverb.bufcombR5, reverb_tuning( SysAudioTuning::combTuningR5 ) );
+		reverb_comb_set_buffer( reverb.combL[5], reverb.bufcombL6, reverb_tuning( SysAudioTuning::combTuningL6 ) );
+		reverb_comb_set_buffer( reverb.combR[5], reverb.bufcombR6, reverb_tuning( SysAudioTuning::combTuningR6 ) );
+		reverb_comb_set_buffer( reverb.combL[6], reverb.bufcombL7, reverb_tuning( SysAudioTuning::combTuningL7 ) );
+		reverb_comb_set_buffer( reverb.combR[6], reverb.bufcombR7, reverb_tuning( SysAudioTuning::combTuningR7 ) );
+		reverb_comb_set_buffer( reverb.combL[7], reverb.bufcombL8, reverb_tuning( SysAudioTuning::combTuningL8 ) );
+		reverb_comb_set_buffer( reverb.combR[7], reverb.bufcombR8, reverb_tuning( SysAudioTuning::combTuningR8 ) );
+
+		reverb_allpass_set_buffer( reverb.allpassL[0], reverb.bufallpassL1, reverb_tuning( SysAudioTuning::allpassTuningL1 ) );
+		reverb_allpass_set_buffer( reverb.allpassR[0], reverb.bufallpassR1, reverb_tuning( SysAudioTuning::allpassTuningR1 ) );
+		reverb_allpass_set_buffer( reverb.allpassL[1], reverb.bufallpassL2, reverb_tuning( SysAudioTuning::allpassTuningL2 ) );
+		reverb_allpass_set_buffer( reverb.allpassR[1], reverb.bufallpassR2, reverb_tuning( SysAudioTuning::allpassTuningR2 ) );
+		reverb_allpass_set_buffer( reverb.allpassL[2], reverb.bufallpassL3, reverb_tuning( SysAudioTuning::allpassTuningL3 ) );
+		reverb_allpass_set_buffer( reverb.allpassR[2], reverb.bufallpassR3, reverb_tuning( SysAudioTuning::allpassTuningR3 ) );
+		reverb_allpass_set_buffer( reverb.allpassL[3], reverb.bufallpassL4, reverb_tuning( SysAudioTuning::allpassTuningL4 ) );
+		reverb_allpass_set_buffer( reverb.allpassR[3], reverb.bufallpassR4, reverb_tuning( SysAudioTuning::allpassTuningR4 ) );
 
 		// Set default values
 		reverb.allpassL[0].feedback = 0.5f;
@@ -340,25 +407,50 @@ static void reverb_init( SysAudio::Effect &effect )
 		reverb.allpassL[3].feedback = 0.5f;
 		reverb.allpassR[3].feedback = 0.5f;
 
-		effect.set_parameter( SysAudio::EffectParam_Reverb_Wet, SysAudioTuning::initialWet, 0 );
-		effect.set_parameter( SysAudio::EffectParam_Reverb_RoomSize, SysAudioTuning::initialRoom, 0 );
-		effect.set_parameter( SysAudio::EffectParam_Reverb_Dry, SysAudioTuning::initialDry, 0 );
-		effect.set_parameter( SysAudio::EffectParam_Reverb_Damp, SysAudioTuning::initialDamp, 0 );
-		effect.set_parameter( SysAudio::EffectParam_Reverb_Width, SysAudioTuning::initialWidth, 0 );
-
 		// Buffer will be full of rubbish - so we MUST mute them
 		reverb_mute( effect );
+
+		// Internal values are computed on the first reverb_apply
+		reverb.parametersValid = false;
 	}
 }
 
 
+static void reverb_release( SysAudio::Effect &effect )
+{
+	atomic_store<u32>( &g_reverbPoolUsed[effect.state], 0 );
+	effect.state = SysAudio::EFFECT_STATE_NONE;
+}
+
+
 static void reverb_apply( SysAudio::Effect &effect, float *samples, u32 sampleCount )
 {
-	SysAudio::EffectStateReverb &reverb = effect.stateReverb;
+	// Take pooled state on first use (passthrough while the pool is exhausted)
+	if( effect.state == SysAudio::EFFECT_STATE_NONE )
+	{
+		effect.state = reverb_pool_acquire();
+		if( effect.state == SysAudio::EFFECT_STATE_NONE ) { return; }
+		reverb_init_state( effect );
+	}
+
+	SysAudio::EffectStateReverb &reverb = g_reverbPool[effect.state];
 
 	for( u32 i = 0; i < sampleCount; i++ )
 	{
-		reverb_update( effect );
+		// Update internal values (once per automation segment, only when a parameter moved)
+		if( i % AUDIO_AUTOMATION_FRAMES == 0 )
+		{
+			float parameters[SysAudio::EFFECTPARAM_REVERB_COUNT];
+			bool changed = !reverb.parametersValid;
+			const u32 frames = sampleCount - i < AUDIO_AUTOMATION_FRAMES ? sampleCount - i : AUDIO_AUTOMATION_FRAMES;
+			for( int p = 0; p < SysAudio::EFFECTPARAM_REVERB_COUNT; p++ )
+			{
+				float step;
+				effect.parameter_ramp( p, frames, parameters[p], step );
+				changed |= parameters[p] != reverb.parameters[p];
+			}
+			if( changed ) { reverb_update( effect, parameters ); }
+		}
 
 		float outL = 0.0f;
 		float outR = 0.0f;
@@ -396,417 +488,2140 @@ struct EffectFunctions
 {
 	void ( *init )( struct SysAudio::Effect &effect );
 	void ( *apply )( struct SysAudio::Effect &effect, float *output, u32 frames );
+	void ( *release )( struct SysAudio::Effect &effect ); // Returns pooled state (nullptr: none)
 };
 
 static EffectFunctions effectFunctions[] =
 {
-	{ core_init, core_apply },       // EffectType_Core
- 	{ lowpass_init, lowpass_apply }, // EffectType_Lowpass
-	{ reverb_init, reverb_apply },   // EffectType_Reverb
+	{ core_init, core_apply, nullptr },            // EffectType_Core
+ 	{ lowpass_init, lowpass_apply, nullptr },      // EffectType_Lowpass
+	{ reverb_init, reverb_apply, reverb_release }, // EffectType_Reverb
 };
 
 static_assert( ARRAY_LENGTH( effectFunctions ) == SysAudio::EFFECTTYPE_COUNT, "Missing audio effect type" );
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool SysAudio::init()
+static void effects_release( AudioEffects &effects )
 {
-	// Initialize Audio Buses & Voices
-	for( int i = 0; i < AUDIO_BUS_COUNT; i++ ) { new ( &buses[i] ) SysAudio::Bus { }; }
-	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ ) { new ( &voices[i] ) SysAudio::Voice { }; }
-
-	// Initialize Samples Buffer
-	ErrorReturnIf( g_AUDIO_SAMPLES != nullptr, false, "Audio: samples buffer already initialized" );
-	if constexpr ( Assets::soundSampleDataSize == 0 ) { return true; }
-
-	g_AUDIO_SAMPLES = reinterpret_cast<i16 *>( memory_alloc( Assets::soundSampleDataSize ) );
-	ErrorReturnIf( g_AUDIO_SAMPLES == nullptr, false,
-		"Audio: failed to allocate samples buffer (%llu bytes)", Assets::soundSampleDataSize );
-	memory_copy( g_AUDIO_SAMPLES, &Assets::binary.data[Assets::soundSampleDataOffset], Assets::soundSampleDataSize );
-
-	// Initialize Backend
-	bool failure = !init_backend();
-	ErrorReturnIf( failure, false, "Audio: failed to initialize audio backend" );
-
-	// Success
-	return true;
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
+	{
+		SysAudio::Effect &effect = effects[i];
+		if( effect.type < 0 || effect.state == SysAudio::EFFECT_STATE_NONE ) { continue; }
+		if( effectFunctions[effect.type].release != nullptr ) { effectFunctions[effect.type].release( effect ); }
+	}
 }
 
 
-bool SysAudio::free()
+static void effects_copy( AudioEffects &destination, const AudioEffects &source )
 {
-	// Free Backend
-	bool failure = !free_backend();
-	ErrorReturnIf( failure, false, "Audio: failed to free audio backend" );
+	// Pooled state stays with its owner; the copy takes its own on first use
+	destination = source;
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ ) { destination[i].state = SysAudio::EFFECT_STATE_NONE; }
+}
 
-	// Free Samples
-	if( g_AUDIO_SAMPLES != nullptr )
-	{
-		memory_free( g_AUDIO_SAMPLES );
-		g_AUDIO_SAMPLES = nullptr;
-	}
 
-	// Free Voices
-	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
+static void effects_advance( AudioEffects &effects, const u32 frames )
+{
+	// Move automation along without processing (virtual voices)
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
 	{
-		new ( &voices[i] ) Voice { };
+		SysAudio::Effect &effect = effects[i];
+		if( effect.type < 0 ) { break; }
+		for( usize j = 0; j < SysAudio::EFFECTPARAM_COUNT_MAX; j++ )
+		{
+			float value, step;
+			effect.parameter_ramp( static_cast<SysAudio::EffectParam>( j ), frames, value, step );
+		}
 	}
-
-	// Success
-	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Streaming
 
-static THREAD_FUNCTION( audio_stream )
-{
-	return 0;
-}
+// Songs are never loaded into memory: a stream thread reads each playing song from the asset binary in blocks of
+// AUDIO_STREAM_BLOCK_FRAMES (converted to stereo) into a ring of AUDIO_STREAM_READ_AHEAD blocks, so memory use does not
+// depend on track length. ADPCM songs are decoded as they are read. The stream thread publishes blocks by advancing
+// 'filled' and the mixer releases them by advancing 'consumed'; neither side takes a lock.
+//
+// 'state' decides who owns a stream: the game thread claims Free streams, the mixer stops Playing streams, and the
+// stream thread returns Stopping streams to Free once it is no longer reading into them
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static_assert( AUDIO_STREAM_READ_AHEAD >= 2, "AUDIO_STREAM_READ_AHEAD must be at least 2 (double buffering)" );
+static_assert( AUDIO_STREAM_BLOCK_FRAMES % ADPCM_BLOCK_FRAMES == 0,
+	"AUDIO_STREAM_BLOCK_FRAMES must be a multiple of ADPCM_BLOCK_FRAMES" );
 
-static int find_voice()
+enum_type( AudioStreamState, u32 )
 {
-	// Find first available voice
-	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
-	if( SysAudio::voices[i].bus < 0 ) { return i; }
-
-	// Failure
-	return -1;
-}
+	AudioStreamState_Free,
+	AudioStreamState_Playing,
+	AudioStreamState_Stopping,
+};
 
 
-static int find_bus()
-{
-	// Find first available bus
-	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
-	if( SysAudio::buses[i].available ) { return i; }
+// A mixer pass reads up to 2 source frames per device frame (AUDIO_SAMPLE_RATE_MAX), plus the sinc filter taps
+static constexpr u32 AUDIO_STREAM_WINDOW_FRAMES = AUDIO_MIX_FRAMES_MAX * 2 + MIX_SINC_TAPS * 2;
 
-	// Failure
-	return -1;
-}
 
-void SysAudio::audio_mixer( i16 *output, u32 frames )
+struct AudioStream
 {
-	const int CHANNELS = 2; // TODO
-	const usize framesBufferI16Size = frames * CHANNELS * sizeof( i16 );
-	const usize framesBufferFloatSize = frames * CHANNELS * sizeof( float );
+	volatile u32 state;    // AudioStreamState
+	volatile u32 filled;   // Blocks read (stream thread)
+	volatile u32 consumed; // Blocks mixed (mixer)
+	volatile u32 ended;    // Final block read (stream thread)
+
+	// Stream thread (set by the game thread while Free)
+	usize offset;
+	usize frames;
+	usize readFrame;
+	u32 channels;
+	AudioFormat format;
+	bool loop;
+
+	// Mixer
+	u32 blockPosition;
+	bool started;
+
+	// Mixer: resampling window (device rate != AUDIO_SAMPLE_RATE), stereo frames with sinc history & lookahead
+	float windowPosition;
+	u32 windowFrames;
+	alignas( 32 ) i16 window[AUDIO_STREAM_WINDOW_FRAMES * 2];
+
+	u32 blockFrames[AUDIO_STREAM_READ_AHEAD];
+	alignas( 32 ) i16 blocks[AUDIO_STREAM_READ_AHEAD][AUDIO_STREAM_BLOCK_FRAMES * 2];
+};
 
-	// Allocate float buffer
-	byte *buffer = reinterpret_cast<byte *>( memory_alloc( 3 * framesBufferFloatSize ) ); // TODO: Remove malloc
-	ErrorIf( buffer == nullptr, "Audio: Failed to allocate memory for mixing buffer" );
-	float *bufferBus = reinterpret_cast<float *>( &buffer[0 * framesBufferFloatSize] );
-	float *bufferVoice = reinterpret_cast<float *>( &buffer[1 * framesBufferFloatSize] );
-	float *bufferMaster = reinterpret_cast<float *>( &buffer[2 * framesBufferFloatSize] );
-	memory_set( bufferMaster, 0, framesBufferFloatSize );
 
-	// Mix buses
-	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+static struct
+{
+	AudioStream streams[AUDIO_STREAM_COUNT];
+	FILE *file = nullptr;
+	byte scratch[AUDIO_STREAM_BLOCK_FRAMES / ADPCM_BLOCK_FRAMES * adpcm_block_bytes( 2 )]; // ADPCM reads
+	volatile u32 running = 0;
+	volatile u32 alive = 0;
+
+	// The stream thread sleeps on 'wake' while no stream needs reading (see audio_stream_wake)
+	volatile u32 sleeping = 0;
+	Mutex mutex;
+	Condition wake;
+
+	// Statistics (SysAudio::stream_statistics)
+	volatile u32 underruns = 0;
+	volatile u32 blocksRead = 0;
+	volatile u32 readNsPeak = 0;
+	volatile u32 readErrors = 0;
+} g_audioStreams;
+
+
+static u32 audio_stream_read( AudioStream &stream, i16 *block )
+{
+	// Stream thread: returns the frames read into 'block' (0: end of song)
+	if( stream.readFrame >= stream.frames )
 	{
-		Bus &bus = buses[i];
-		memory_set( bufferBus, 0, framesBufferFloatSize );
+		if( !stream.loop || stream.frames == 0 ) { return 0; }
+		stream.readFrame = 0;
+	}
 
-		Assert( bus.effects[0].type == SysAudio::EffectType_Core );
-		const float pitchBus = bus.effects[0].get_parameter( SysAudio::EffectParam_Core_Pitch, false );
+	const usize framesLeft = stream.frames - stream.readFrame;
+	const u32 frames = static_cast<u32>( framesLeft < AUDIO_STREAM_BLOCK_FRAMES ? framesLeft : AUDIO_STREAM_BLOCK_FRAMES );
+	const int channels = static_cast<int>( stream.channels );
 
-		// Mix voices
-		for( int j = 0; j < AUDIO_VOICE_COUNT; j++ )
+	// Mono is read into the upper half of the block and expanded to stereo in place
+	i16 *destination = channels == 1 ? &block[AUDIO_STREAM_BLOCK_FRAMES] : block;
+	const double timeStart = Time::value();
+	bool read;
+	if( stream.format == AudioFormat_ADPCM )
+	{
+		// 'readFrame' is always at an ADPCM block boundary (AUDIO_STREAM_BLOCK_FRAMES is a multiple)
+		const usize blockBytes = adpcm_block_bytes( channels );
+		const u32 blocks = ( frames + ADPCM_BLOCK_FRAMES - 1 ) / ADPCM_BLOCK_FRAMES;
+		const usize position = stream.offset + stream.readFrame / ADPCM_BLOCK_FRAMES * blockBytes;
+		read = fseek64( g_audioStreams.file, position, SEEK_SET ) == 0 &&
+			fread( g_audioStreams.scratch, blocks * blockBytes, 1, g_audioStreams.file ) == 1;
+		for( u32 i = 0; read && i < blocks; i++ )
 		{
-			Voice &voice = voices[j];
-			if( voice.bus != i || voice.bypass ) { continue; }
-			memory_set( bufferVoice, 0, framesBufferFloatSize );
-
-			Assert( voice.effects[0].type == SysAudio::EffectType_Core );
-			const float pitchVoice = voice.effects[0].get_parameter( SysAudio::EffectParam_Core_Pitch, false ) * pitchBus;
-
-			const u32 frameCurrent = static_cast<u32>( voice.position );
-			const u32 framesRemaining = ( voice.samplesCount - frameCurrent ) / voice.channels;
-			const u32 framesToMix = min( frames, framesRemaining );
-
-			// Read voice samples
-			switch( voice.channels )
-			{
-				// Mono
-				case 1:
-				{
-					for( u32 k = 0; k < framesToMix && voice.position < voice.samplesCount; k++ )
-					{
-						const u32 sampleIndex = static_cast<u32>( voice.position );
-
-						const float sample1 = I16_TO_FLOAT( voice.samples[sampleIndex + 0] );
-						const float sample2 = ( sampleIndex + 1 < voice.samplesCount ) ?
-											  I16_TO_FLOAT( voice.samples[sampleIndex + 1] ) : sample1;
-
-						const float sampleFrac = voice.position - sampleIndex;
-						const float sampleInterpolated = sample1 * ( 1.0f - sampleFrac ) + sample2 * sampleFrac;
-
-						bufferVoice[k * 2 + 0] = sampleInterpolated;
-						bufferVoice[k * 2 + 1] = sampleInterpolated;
-						voice.position += pitchVoice;
-					}
-				}
-				break;
-
-				// Stereo
-				case 2:
-				{
-					for( u32 k = 0; k < framesToMix && voice.position < voice.samplesCount; k++ )
-					{
-						const u32 sampleIndex = static_cast<u32>( voice.position );
-
-						const float left1 = I16_TO_FLOAT( voice.samples[sampleIndex + 0] );
-						const float left2 = ( sampleIndex + 2 < voice.samplesCount ) ?
-						                    I16_TO_FLOAT( voice.samples[sampleIndex + 2] ) : left1;
-						const float right1 = I16_TO_FLOAT( voice.samples[sampleIndex + 1] );
-						const float right2 = ( sampleIndex + 3 < voice.samplesCount ) ?
-						                     I16_TO_FLOAT( voice.samples[sampleIndex + 3] ) : right1;
-
-						const float sampleFrac = voice.position - static_cast<u32>( voice.position );
-						const float leftInterpolated = left1 * ( 1.0f - sampleFrac ) + left2 * sampleFrac;
-						const float rightInterpolated = right1 * ( 1.0f - sampleFrac ) + right2 * sampleFrac;
-
-						bufferVoice[k * 2 + 0] = leftInterpolated;
-						bufferVoice[k * 2 + 1] = rightInterpolated;
-						voice.position += pitchVoice * 2;
-					}
-				}
-				break;
-			}
-
-			// Process per-voice effects
-			for( u32 k = 0; k < SysAudio::EFFECTTYPE_COUNT; k++ )
-			{
-				Effect &effect = voice.effects[k];
-				if( effect.type < 0 ) { break; }
-				effectFunctions[effect.type].apply( effect, bufferVoice, frames );
-			}
-
-			// Write voice to bus
-			for( u32 k = 0; k < framesToMix; k++ )
-			{
-				bufferBus[k * 2 + 0] += bufferVoice[k * 2 + 0];
-				bufferBus[k * 2 + 1] += bufferVoice[k * 2 + 1];
-			}
-
-			// Voice complete?
-			if( static_cast<u32>( voice.position ) >= voice.samplesCount ) { voice.bus = -1; }
+			const u32 first = i * ADPCM_BLOCK_FRAMES;
+			const u32 count = frames - first < ADPCM_BLOCK_FRAMES ? frames - first : ADPCM_BLOCK_FRAMES;
+			adpcm_decode_block( &destination[first * channels], &g_audioStreams.scratch[i * blockBytes], count, channels );
 		}
+	}
+	else
+	{
+		const usize frameBytes = channels * sizeof( i16 );
+		read = fseek64( g_audioStreams.file, stream.offset + stream.readFrame * frameBytes, SEEK_SET ) == 0 &&
+			fread( destination, frames * frameBytes, 1, g_audioStreams.file ) == 1;
+	}
+	const u32 ns = static_cast<u32>( ( Time::value() - timeStart ) * 1000000000.0 );
+	stream.readFrame += frames;
 
-		// Process per-bus effects
-		for( u32 j = 0; j < SysAudio::EFFECTTYPE_COUNT; j++ )
-		{
-			Effect &effect = bus.effects[j];
-			if( effect.type < 0 ) { continue; }
-			effectFunctions[effect.type].apply( effect, bufferBus, frames );
-		}
+	if( !read )
+	{
+		memory_set( block, 0, frames * 2 * sizeof( i16 ) );
+		atomic_add<u32>( &g_audioStreams.readErrors, 1 );
+		return frames;
+	}
 
-		// Write bus to master
-		for( u32 j = 0; j < frames; j++ )
+	if( stream.channels == 1 )
+	{
+		for( u32 i = 0; i < frames; i++ )
 		{
-			bufferMaster[j * 2 + 0] += bufferBus[j * 2 + 0];
-			bufferMaster[j * 2 + 1] += bufferBus[j * 2 + 1];
+			const i16 sample = destination[i];
+			block[i * 2 + 0] = sample;
+			block[i * 2 + 1] = sample;
 		}
 	}
 
-	// Write to master output as i16
-	for( u32 i = 0; i < frames; i++ )
-	{
-		const float lClamped = clamp( bufferMaster[i * 2 + 0], -1.0f, 1.0f );
-		output[i * 2 + 0] = FLOAT_TO_I16( lClamped );
-		const float rClamped = clamp( bufferMaster[i * 2 + 1], -1.0f, 1.0f );
-		output[i * 2 + 1] = FLOAT_TO_I16( rClamped );
-	}
+	// Statistics
+	atomic_add<u32>( &g_audioStreams.blocksRead, 1 );
+	if( ns > g_audioStreams.readNsPeak ) { atomic_store( &g_audioStreams.readNsPeak, ns ); }
+	return frames;
+}
+
 
-	// Free float buffer
-	memory_free( buffer );
+static void audio_stream_wake()
+{
+	// Any thread, after publishing stream work with a sequentially consistent atomic (a state change or a consumed
+	// block): pairs with the 'sleeping' increment in audio_stream, so either the stream thread sees the work before it
+	// sleeps or we see it sleeping
+	if( atomic_load( &g_audioStreams.sleeping ) == 0 ) { return; }
+	g_audioStreams.mutex.lock();
+	g_audioStreams.wake.wake();
+	g_audioStreams.mutex.unlock();
 }
 
 
-SoundHandle SysAudio::play_sound( const int bus, const i16 *const samples, const u32 samplesCount, const int channels,
-                                  const AudioEffects &effects, const char *name )
+static bool audio_stream_pending()
 {
-	const int voice = find_voice();
-	if( voice < 0 ) { return SoundHandle { -1, -1 }; }
-	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+	// Stream thread: a stream to free or a read-ahead to top up
+	for( int i = 0; i < AUDIO_STREAM_COUNT; i++ )
+	{
+		AudioStream &stream = g_audioStreams.streams[i];
+		const u32 state = atomic_load( &stream.state );
+		if( state == AudioStreamState_Stopping ) { return true; }
+		if( state != AudioStreamState_Playing || stream.ended ) { continue; }
+		if( stream.filled - atomic_load( &stream.consumed ) < AUDIO_STREAM_READ_AHEAD ) { return true; }
+	}
+	return false;
+}
 
-	// Copy Effects
-	memory_copy( &audioVoice.effects, &effects, sizeof( AudioEffects ) );
 
-	// Setup State
-	audioVoice.position = 0.0f;
-	audioVoice.channels = channels;
-	audioVoice.samples = samples;
-	audioVoice.samplesCount = samplesCount;
-#if COMPILE_DEBUG
-	audioVoice.name = name;
-#endif
+static THREAD_FUNCTION( audio_stream )
+{
+	while( atomic_load( &g_audioStreams.running ) != 0 )
+	{
+		for( int i = 0; i < AUDIO_STREAM_COUNT; i++ )
+		{
+			AudioStream &stream = g_audioStreams.streams[i];
+			const u32 state = atomic_load( &stream.state );
 
-	// TODO: Thread/Compile Barrier here
-	audioVoice.id++;
-	audioVoice.bus = bus;
+			// Stopped by the mixer: nothing reads this stream anymore
+			if( state == AudioStreamState_Stopping ) { atomic_store<u32>( &stream.state, AudioStreamState_Free ); }
+			if( state != AudioStreamState_Playing || stream.ended ) { continue; }
 
+			// Top up the read-ahead
+			while( stream.filled - atomic_load( &stream.consumed ) < AUDIO_STREAM_READ_AHEAD )
+			{
+				const u32 index = stream.filled % AUDIO_STREAM_READ_AHEAD;
+				const u32 frames = audio_stream_read( stream, stream.blocks[index] );
+				if( frames == 0 ) { atomic_store<u32>( &stream.ended, 1 ); break; }
+				stream.blockFrames[index] = frames;
+				atomic_store( &stream.filled, stream.filled + 1 );
+			}
+		}
 
-	// Return handle
-	return SoundHandle { voice, audioVoice.id };
+		// Sleep until the mixer consumes a block or a stream starts/stops
+		g_audioStreams.mutex.lock();
+		atomic_add<u32>( &g_audioStreams.sleeping, 1 );
+		while( atomic_load( &g_audioStreams.running ) != 0 && !audio_stream_pending() )
+		{
+			g_audioStreams.wake.sleep( g_audioStreams.mutex );
+		}
+		atomic_sub<u32>( &g_audioStreams.sleeping, 1 );
+		g_audioStreams.mutex.unlock();
+	}
+
+	atomic_sub<u32>( &g_audioStreams.alive, 1 );
+	return 0;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void AudioEffects::init()
+static int find_stream()
 {
-	// Default-initialize Effects
-	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
-	{
-		SysAudio::Effect &effect = effects[i];
-		new ( &effect ) SysAudio::Effect { };
+	// Find first available stream
+	for( int i = 0; i < AUDIO_STREAM_COUNT; i++ )
+	if( atomic_load( &g_audioStreams.streams[i].state ) == AudioStreamState_Free ) { return i; }
 
-		// First effect is always AudioEffect_Core
-		effects[0].type = SysAudio::EffectType_Core;
-		effects[0].set_parameter( SysAudio::EffectParam_Core_Gain, 1.0f, 0.0f );
-		effects[0].set_parameter( SysAudio::EffectParam_Core_Pitch, 1.0f, 0.0f );
-	}
+	// Failure
+	return -1;
 }
 
 
-SysAudio::Effect &AudioEffects::find_effect( const SysAudio::EffectType effectType )
+template <typename Consume> static u32 audio_stream_consume( AudioStream &stream, const u32 frames, bool &complete,
+	Consume consume )
 {
-	Assert( effectType < SysAudio::EFFECTTYPE_COUNT );
+	// Mixer thread: hands up to 'frames' streamed frames to 'consume( samples, offset, count )' block by block
+	u32 mixed = 0;
+	complete = false;
 
-	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
+	while( mixed < frames )
 	{
-		SysAudio::Effect &effect = effects[i];
-
-		// Found an already-enabled slot with our type, early exit
-		if( effect.type == effectType )
+		const u32 consumed = stream.consumed;
+		if( consumed == atomic_load( &stream.filled ) )
 		{
-			return effect;
+			// 'ended' is published after the final block, so 'filled' is re-checked once it is set
+			if( atomic_load( &stream.ended ) != 0 )
+			{
+				if( consumed != atomic_load( &stream.filled ) ) { continue; }
+				complete = true;
+			}
+			else if( stream.started )
+			{
+				// Underrun: the rest of the period is silent
+				atomic_add<u32>( &g_audioStreams.underruns, 1 );
+			}
+			break;
 		}
 
-		// Found empty effect slot, so let's enable it as our type
-		if( effect.type < 0 )
+		const u32 index = consumed % AUDIO_STREAM_READ_AHEAD;
+		const u32 available = stream.blockFrames[index] - stream.blockPosition;
+		const u32 count = available < frames - mixed ? available : frames - mixed;
+		consume( &stream.blocks[index][stream.blockPosition * 2], mixed, count );
+		mixed += count;
+		stream.started = true;
+
+		// Release the block to the stream thread
+		stream.blockPosition += count;
+		if( stream.blockPosition == stream.blockFrames[index] )
 		{
-			effect.type = effectType;
-			if( effectFunctions[effectType].init != nullptr ) { effectFunctions[effectType].init( effect ); }
-			return effect;
+			stream.blockPosition = 0;
+			atomic_exchange( &stream.consumed, consumed + 1 );
+			audio_stream_wake();
 		}
 	}
 
-	AssertMsg( true, "Failed to find effect id!" );
-	return effects[0]; // Unreachable
+	return mixed;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool SoundHandle::is_playing() const
+static u32 audio_mix_stream_resample( AudioStream &stream, float *bufferVoice, const float rate, const u32 frames,
+	bool &complete )
 {
-	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return false; }
-	if( SysAudio::voices[voice].id != id ) { return false; }
-	return !( SysAudio::voices[voice].bus < 0 );
+	// Top up the window with the source frames this pass reads (positions + sinc lookahead)
+	const float needed = stream.windowPosition + static_cast<float>( frames ) * rate + MIX_SINC_TAPS / 2 + 1;
+	const u32 target = needed < AUDIO_STREAM_WINDOW_FRAMES ? static_cast<u32>( needed ) : AUDIO_STREAM_WINDOW_FRAMES;
+	u32 read = 0;
+	complete = false;
+	if( stream.windowFrames < target )
+	{
+		read = audio_stream_consume( stream, target - stream.windowFrames, complete,
+			[&stream]( const i16 *samples, const u32 offset, const u32 count )
+			{
+				memory_copy( &stream.window[( stream.windowFrames + offset ) * 2], samples, count * 2 * sizeof( i16 ) );
+			} );
+		stream.windowFrames += read;
+	}
+
+	// Mix the frames whose taps are loaded (past the end of the song, the filter reads silence)
+	const float limit = complete ? static_cast<float>( stream.windowFrames ) :
+		static_cast<float>( stream.windowFrames ) - MIX_SINC_TAPS / 2;
+	const u32 mixed = SysAudio::mix_frames_before( stream.windowPosition, rate, limit, frames );
+	SysAudio::mix_resample_sinc_stereo( bufferVoice, stream.window, 0, static_cast<i32>( stream.windowFrames ),
+		stream.windowPosition, rate, mixed );
+	stream.windowPosition += static_cast<float>( mixed ) * rate;
+	complete = complete && mixed < frames;
+
+	// Drop consumed frames, keeping the filter history
+	const i32 drop = static_cast<i32>( stream.windowPosition ) - ( MIX_SINC_TAPS / 2 - 1 );
+	if( drop > 0 )
+	{
+		const u32 dropped = static_cast<u32>( drop ) < stream.windowFrames ? static_cast<u32>( drop ) : stream.windowFrames;
+		memory_move( stream.window, &stream.window[dropped * 2], ( stream.windowFrames - dropped ) * 2 * sizeof( i16 ) );
+		stream.windowFrames -= dropped;
+		stream.windowPosition -= static_cast<float>( dropped );
+	}
+
+	memory_set( &bufferVoice[mixed * 2], 0, ( frames - mixed ) * 2 * sizeof( float ) );
+	return read;
 }
 
 
-bool SoundHandle::is_paused() const
+static bool audio_mix_stream( SysAudio::Voice &voice, float *bufferVoice, const float rate, const u32 frames )
 {
-	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return false; }
-	if( SysAudio::voices[voice].bus < 0 || SysAudio::voices[voice].id != id ) { return false; }
-	return SysAudio::voices[voice].bypass;
+	// Mixer thread: streamed blocks play at AUDIO_SAMPLE_RATE ('rate' converts to the device, pitch does not apply)
+	AudioStream &stream = g_audioStreams.streams[voice.stream];
+	bool complete;
+	u32 read;
+
+	if( rate == 1.0f && stream.windowFrames == 0 )
+	{
+		// Device runs at the asset rate: blocks convert straight into the voice buffer
+		read = audio_stream_consume( stream, frames, complete,
+			[bufferVoice]( const i16 *samples, const u32 offset, const u32 count )
+			{
+				SysAudio::mix_i16_to_float( &bufferVoice[offset * 2], samples, count * 2 );
+			} );
+		memory_set( &bufferVoice[read * 2], 0, ( frames - read ) * 2 * sizeof( float ) );
+	}
+	else
+	{
+		read = audio_mix_stream_resample( stream, bufferVoice, rate, frames, complete );
+	}
+
+	// Progress in samples (SysAudio::draw_voice)
+	voice.position += static_cast<float>( read * voice.channels );
+	if( voice.position >= voice.samplesCount ) { voice.position -= voice.samplesCount; }
+	return complete;
 }
 
 
-bool SoundHandle::pause( const bool pause ) const
+bool SysAudio::init_streams()
 {
-	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return false; }
-	if( SysAudio::voices[voice].bus < 0 || SysAudio::voices[voice].id != id ) { return false; }
-	SysAudio::voices[voice].bypass = pause;
+	Assert( g_audioStreams.file == nullptr );
+	for( int i = 0; i < AUDIO_STREAM_COUNT; i++ ) { g_audioStreams.streams[i].state = AudioStreamState_Free; }
+	if constexpr ( Assets::songCount == 0 ) { return true; }
+
+	// The stream thread reads through its own handle to the asset binary
+	g_audioStreams.file = fopen( Assets::binaryPath, "rb" );
+	ErrorReturnIf( g_audioStreams.file == nullptr, false, "Audio: failed to open stream file: %s", Assets::binaryPath );
+
+	// Start Thread
+	g_audioStreams.mutex.init();
+	g_audioStreams.wake.init();
+	atomic_store<u32>( &g_audioStreams.running, 1 );
+	atomic_store<u32>( &g_audioStreams.alive, 1 );
+	bool failure = Thread::create( audio_stream ) == nullptr;
+	if( failure ) { atomic_store<u32>( &g_audioStreams.alive, 0 ); }
+	ErrorReturnIf( failure, false, "Audio: failed to start audio stream thread" );
+
+	// Success
 	return true;
 }
 
 
-bool SoundHandle::stop() const
+bool SysAudio::free_streams()
 {
-	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return false; }
-	if( SysAudio::voices[voice].bus < 0 || SysAudio::voices[voice].id != id ) { return false; }
-	SysAudio::voices[voice].bus = -1;
+	// Stop Thread
+	atomic_store<u32>( &g_audioStreams.running, 0 );
+	while( atomic_load( &g_audioStreams.alive ) != 0 )
+	{
+		g_audioStreams.mutex.lock();
+		g_audioStreams.wake.wake_all();
+		g_audioStreams.mutex.unlock();
+		Thread::sleep( 1 );
+	}
+
+	// Close File
+	if( g_audioStreams.file != nullptr )
+	{
+		fclose( g_audioStreams.file );
+		g_audioStreams.file = nullptr;
+		g_audioStreams.wake.free();
+		g_audioStreams.mutex.free();
+	}
+
+	for( int i = 0; i < AUDIO_STREAM_COUNT; i++ ) { g_audioStreams.streams[i].state = AudioStreamState_Free; }
+	g_audioStreams.underruns = 0;
+	g_audioStreams.blocksRead = 0;
+	g_audioStreams.readNsPeak = 0;
+	g_audioStreams.readErrors = 0;
+
+	// Success
 	return true;
 }
 
 
-AudioEffects *SoundHandle::operator->() const
+SysAudio::StreamStatistics SysAudio::stream_statistics()
 {
-	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return &NULL_AUDIO_EFFECTS; }
-	if( SysAudio::voices[voice].bus < 0 || SysAudio::voices[voice].id != id ) { return &NULL_AUDIO_EFFECTS; }
-	return &SysAudio::voices[voice].effects;
+	StreamStatistics statistics;
+	statistics.playing = 0;
+	for( int i = 0; i < AUDIO_STREAM_COUNT; i++ )
+	{
+		statistics.playing += atomic_load( &g_audioStreams.streams[i].state ) != AudioStreamState_Free;
+	}
+	statistics.underruns = atomic_load( &g_audioStreams.underruns );
+	statistics.blocksRead = atomic_load( &g_audioStreams.blocksRead );
+	statistics.readNsPeak = atomic_load( &g_audioStreams.readNsPeak );
+	statistics.readErrors = atomic_load( &g_audioStreams.readErrors );
+	return statistics;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ADPCM
 
-void AudioContext::init( const AudioEffects &effects, const char *name )
-{
-	// Reserve an audio bus
-	bus = find_bus();
-	ErrorIf( bus < 0, "AudioLayer init: exceeded bus capacity!" );
-	SysAudio::Bus &audioBus = SysAudio::buses[bus];
-	audioBus.available = false;
-	this->name = name;
-	audioBus.name = name;
+// ADPCM sounds stay encoded in g_AUDIO_SAMPLES. Each real voice decodes the block under its read position into a cache,
+// between the tail of the previous block and the head of the next so the sinc filter never reads past the cache
 
-	// Copy Effects
-	memory_copy( &audioBus.effects, &effects, sizeof( AudioEffects ) );
+static constexpr u32 AUDIO_ADPCM_CACHE_BEFORE = MIX_SINC_TAPS / 2 - 1; // History frames
+static constexpr u32 AUDIO_ADPCM_CACHE_AFTER = MIX_SINC_TAPS / 2;      // Lookahead frames
+
+struct AudioAdpcmCache
+{
+	u32 block = U32_MAX;
+	u32 frames = 0;     // Decoded frames after the history (block + lookahead unless it is the final block)
+	u32 framesLimit = 0; // Frames in the block
+	alignas( 32 ) i16 samples[( AUDIO_ADPCM_CACHE_BEFORE + ADPCM_BLOCK_FRAMES + AUDIO_ADPCM_CACHE_AFTER ) * 2];
 };
 
+static AudioAdpcmCache g_adpcmCache[AUDIO_VOICE_REAL_COUNT];
 
-void AudioContext::free()
-{
-	if( bus < 0 || bus >= AUDIO_BUS_COUNT ) { return; }
 
-	// Stop playing voices
-	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
+static void audio_adpcm_cache_block( AudioAdpcmCache &cache, const SysAudio::Voice &voice, const u32 block )
+{
+	const int channels = voice.channels;
+	const u32 framesCount = voice.samplesCount / static_cast<u32>( channels );
+	const byte *data = reinterpret_cast<const byte *>( voice.samples );
+	const usize blockBytes = adpcm_block_bytes( channels );
+
+	i16 *history = cache.samples;
+	i16 *samples = &cache.samples[AUDIO_ADPCM_CACHE_BEFORE * channels];
+	const usize historyBytes = AUDIO_ADPCM_CACHE_BEFORE * channels * sizeof( i16 );
+	const u32 historyOffset = ( ADPCM_BLOCK_FRAMES - AUDIO_ADPCM_CACHE_BEFORE ) * channels;
+
+	// History: the tail of the previous block (always a full block), decoded again unless it is cached
+	if( block == 0 )
 	{
-		SysAudio::Voice &voice = SysAudio::voices[i];
-		if( voice.bus == bus ) { voice.bus = -1; }
+		memory_set( history, 0, historyBytes );
 	}
-
-	// Mark our audio bus as available
+	else
+	{
+		if( cache.block != block - 1 )
+		{
+			adpcm_decode_block( samples, &data[( block - 1 ) * blockBytes], ADPCM_BLOCK_FRAMES, channels );
+		}
+		memory_copy( history, &samples[historyOffset], historyBytes );
+	}
+
+	const u32 first = block * ADPCM_BLOCK_FRAMES;
+	const u32 frames = framesCount - first < ADPCM_BLOCK_FRAMES ? framesCount - first : ADPCM_BLOCK_FRAMES;
+	adpcm_decode_block( samples, &data[block * blockBytes], frames, channels );
+	cache.block = block;
+	cache.frames = frames;
+	cache.framesLimit = frames;
+
+	// Lookahead: the head of the next block
+	const u32 framesAfter = framesCount - ( first + frames );
+	if( framesAfter > 0 )
+	{
+		const u32 lookahead = framesAfter < AUDIO_ADPCM_CACHE_AFTER ? framesAfter : AUDIO_ADPCM_CACHE_AFTER;
+		adpcm_decode_block( &samples[frames * channels], &data[( block + 1 ) * blockBytes], lookahead, channels );
+		cache.frames += lookahead;
+	}
+}
+
+
+static bool audio_mix_voice_adpcm( SysAudio::Voice &voice, const float pitch, float *bufferVoice, const u32 frames )
+{
+	Assert( voice.real >= 0 );
+	AudioAdpcmCache &cache = g_adpcmCache[voice.real];
+	const u32 channels = static_cast<u32>( voice.channels );
+	const float framesCount = static_cast<float>( voice.samplesCount / channels );
+	float position = voice.position / channels;
+
+	// Mix block by block (the position is relative to the cached block)
+	u32 mixed = 0;
+	while( mixed < frames && position >= 0.0f && position < framesCount )
+	{
+		const u32 block = static_cast<u32>( position ) / ADPCM_BLOCK_FRAMES;
+		if( cache.block != block ) { audio_adpcm_cache_block( cache, voice, block ); }
+
+		const float local = position - static_cast<float>( block * ADPCM_BLOCK_FRAMES );
+		const u32 count = SysAudio::mix_frames_before( local, pitch, static_cast<float>( cache.framesLimit ),
+			frames - mixed );
+		if( count == 0 ) { break; }
+
+		const i16 *samples = &cache.samples[AUDIO_ADPCM_CACHE_BEFORE * channels];
+		const i32 begin = -static_cast<i32>( AUDIO_ADPCM_CACHE_BEFORE );
+		const i32 end = static_cast<i32>( cache.frames );
+		switch( channels )
+		{
+			case 1: SysAudio::mix_resample_sinc_mono( &bufferVoice[mixed * 2], samples, begin, end, local, pitch, count ); break;
+			case 2: SysAudio::mix_resample_sinc_stereo( &bufferVoice[mixed * 2], samples, begin, end, local, pitch, count ); break;
+		}
+		mixed += count;
+		position += static_cast<float>( count ) * pitch;
+	}
+	memory_set( &bufferVoice[mixed * 2], 0, ( frames - mixed ) * 2 * sizeof( float ) );
+
+	// Voice complete?
+	if( mixed < frames ) { return true; }
+	voice.position = position * channels;
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Voice Virtualization
+
+// Only AUDIO_VOICE_REAL_COUNT voices are mixed per pass: the highest priority, then the most audible (voice x bus gain).
+// The rest are virtual: they advance their position & automation without mixing, and become real again once they
+// rank high enough. Each bus links its playing voices, so the mixer never visits idle voices
+
+// Streamed voices outrank every sound (play_sound clamps below this): their blocks are only consumed by mixing
+static constexpr int AUDIO_VOICE_PRIORITY_STREAM = I32_MAX;
+
+struct AudioVoiceCandidate
+{
+	int voice;
+	int priority;
+	float audibility;
+};
+
+// Streamed voices outrank every sound (see play_song), so they always get a real voice
+static_assert( AUDIO_STREAM_COUNT <= AUDIO_VOICE_REAL_COUNT, "AUDIO_VOICE_REAL_COUNT must cover every stream" );
+
+// Real voices rank as if this much louder, so near-equal voices do not trade places every pass
+static constexpr float AUDIO_VOICE_REAL_MARGIN = 2.0f;
+
+static struct
+{
+	bool used[AUDIO_VOICE_REAL_COUNT];
+	int slots[AUDIO_VOICE_REAL_COUNT]; // Voice in each used real slot
+	AudioVoiceCandidate candidates[AUDIO_VOICE_REAL_COUNT];
+	bool selected[AUDIO_VOICE_COUNT];
+
+	// Statistics
+	volatile u32 playing = 0;
+	volatile u32 real = 0;
+	volatile u32 demotions = 0;
+
+#if COMPILE_DEBUG
+	// Published by the mixer each period for SysAudio::draw_voice: progress (16-bit fraction) | real << 31
+	volatile u32 display[AUDIO_VOICE_COUNT];
+#endif
+} g_audioVoices;
+
+
+static void audio_voice_link( const int voice, const int bus )
+{
+	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+	SysAudio::Bus &audioBus = SysAudio::buses[bus];
+	audioVoice.busPrev = -1;
+	audioVoice.busNext = audioBus.voiceFirst;
+	if( audioBus.voiceFirst >= 0 ) { SysAudio::voices[audioBus.voiceFirst].busPrev = voice; }
+	audioBus.voiceFirst = voice;
+}
+
+
+static void audio_voice_unlink( const int voice )
+{
+	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+	if( audioVoice.busPrev >= 0 ) { SysAudio::voices[audioVoice.busPrev].busNext = audioVoice.busNext; }
+	else { SysAudio::buses[audioVoice.bus].voiceFirst = audioVoice.busNext; }
+	if( audioVoice.busNext >= 0 ) { SysAudio::voices[audioVoice.busNext].busPrev = audioVoice.busPrev; }
+	audioVoice.busPrev = -1;
+	audioVoice.busNext = -1;
+
+	// Release the real slot
+	if( audioVoice.real >= 0 )
+	{
+		g_audioVoices.used[audioVoice.real] = false;
+		audioVoice.real = -1;
+	}
+}
+
+
+static bool audio_voice_ranks_above( const AudioVoiceCandidate &a, const AudioVoiceCandidate &b )
+{
+	return a.priority != b.priority ? a.priority > b.priority : a.audibility > b.audibility;
+}
+
+
+static void audio_voices_select()
+{
+	using namespace SysAudio;
+
+	// Rank audible voices, keeping the best AUDIO_VOICE_REAL_COUNT (sorted, best first)
+	AudioVoiceCandidate *candidates = g_audioVoices.candidates;
+	u32 count = 0;
+	u32 playing = 0;
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		Bus &bus = buses[i];
+		const float gainBus = bus.effects[0].get_parameter( EffectParam_Core_Gain, false );
+
+		for( int j = bus.voiceFirst; j >= 0; j = voices[j].busNext )
+		{
+			Voice &voice = voices[j];
+			playing++;
+			if( voice.bypass ) { continue; }
+
+			// Streamed voices are always real (their blocks are consumed by mixing)
+			float audibility = voice.effects[0].get_parameter( EffectParam_Core_Gain, false ) * gainBus;
+			if( voice.stream < 0 && audibility < AUDIO_VOICE_AUDIBILITY_MIN ) { continue; }
+			if( voice.real >= 0 ) { audibility *= AUDIO_VOICE_REAL_MARGIN; }
+
+			const AudioVoiceCandidate candidate { j, voice.priority, audibility };
+			if( count == AUDIO_VOICE_REAL_COUNT && !audio_voice_ranks_above( candidate, candidates[count - 1] ) ) { continue; }
+			u32 k = count < AUDIO_VOICE_REAL_COUNT ? count++ : count - 1;
+			for( ; k > 0 && audio_voice_ranks_above( candidate, candidates[k - 1] ); k-- ) { candidates[k] = candidates[k - 1]; }
+			candidates[k] = candidate;
+		}
+	}
+
+	// Demote real voices that fell out of the ranking (their pooled effect state goes back to the pool)
+	u32 demotions = 0;
+	for( u32 k = 0; k < count; k++ ) { g_audioVoices.selected[candidates[k].voice] = true; }
+	for( int slot = 0; slot < AUDIO_VOICE_REAL_COUNT; slot++ )
+	{
+		if( !g_audioVoices.used[slot] ) { continue; }
+		Voice &voice = voices[g_audioVoices.slots[slot]];
+		if( g_audioVoices.selected[g_audioVoices.slots[slot]] ) { continue; }
+		effects_release( voice.effects );
+		voice.real = -1;
+		g_audioVoices.used[slot] = false;
+		demotions++;
+	}
+
+	// Promote ranked virtual voices into the free slots
+	int slot = 0;
+	for( u32 k = 0; k < count; k++ )
+	{
+		const int index = candidates[k].voice;
+		g_audioVoices.selected[index] = false;
+		if( voices[index].real >= 0 ) { continue; }
+
+		while( g_audioVoices.used[slot] ) { slot++; }
+		g_audioVoices.used[slot] = true;
+		g_audioVoices.slots[slot] = index;
+		g_adpcmCache[slot].block = U32_MAX;
+		voices[index].real = slot;
+	}
+
+	// Statistics
+	atomic_store( &g_audioVoices.playing, playing );
+	atomic_store( &g_audioVoices.real, count );
+	if( demotions > 0 ) { atomic_add<u32>( &g_audioVoices.demotions, demotions ); }
+}
+
+
+static bool audio_voice_advance( SysAudio::Voice &voice, const float pitch, const u32 frames )
+{
+	// Virtual voices move their read position as audio_mix_voice would
+	const u32 channels = static_cast<u32>( voice.channels );
+	const u32 framesCount = voice.samplesCount / channels;
+	const float position = voice.position / channels;
+	if( SysAudio::mix_frames_before( position, pitch, static_cast<float>( framesCount ), frames ) < frames ) { return true; }
+	voice.position = ( position + static_cast<float>( frames ) * pitch ) * channels;
+	return false;
+}
+
+
+#if COMPILE_DEBUG
+static constexpr u32 AUDIO_VOICE_DISPLAY_REAL = 1U << 31;
+
+
+static void audio_voices_publish()
+{
+	// Mixer thread: the game thread never reads SysAudio::voices
+	using namespace SysAudio;
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		for( int j = buses[i].voiceFirst; j >= 0; j = voices[j].busNext )
+		{
+			const Voice &voice = voices[j];
+			const float progress = voice.samplesCount > 0 ? voice.position / voice.samplesCount : 0.0f;
+			const u32 display = static_cast<u32>( clamp( progress, 0.0f, 1.0f ) * 65535.0f ) |
+				( voice.real >= 0 ? AUDIO_VOICE_DISPLAY_REAL : 0 );
+			atomic_store( &g_audioVoices.display[j], display );
+		}
+	}
+}
+#endif
+
+
+static void audio_voices_reset()
+{
+	memory_set( g_audioVoices.used, 0, sizeof( g_audioVoices.used ) );
+	memory_set( g_audioVoices.selected, 0, sizeof( g_audioVoices.selected ) );
+	g_audioVoices.playing = 0;
+	g_audioVoices.real = 0;
+	g_audioVoices.demotions = 0;
+}
+
+
+SysAudio::VoiceStatistics SysAudio::voice_statistics()
+{
+	VoiceStatistics statistics;
+	statistics.playing = atomic_load( &g_audioVoices.playing );
+	statistics.real = atomic_load( &g_audioVoices.real );
+	statistics.demotions = atomic_load( &g_audioVoices.demotions );
+	return statistics;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Command Queue
+
+// Game-side calls never write mixer state: they queue commands that audio_mixer() drains before mixing, and the mixer
+// reports back through an event ring. A free voice is staged directly in SysAudio::voices[] (the mixer ignores it until
+// the Play command, whose ring push publishes the staged data)
+
+enum_type( AudioCommandType, u8 )
+{
+	AudioCommandType_Play,
+	AudioCommandType_Stop,
+	AudioCommandType_Pause,
+	AudioCommandType_Parameter,
+	AudioCommandType_BusInit,
+	AudioCommandType_BusFree,
+	AudioCommandType_BusPause,
+};
+
+
+struct AudioCommand
+{
+	AudioCommandType type;
+	u8 effectType;
+	u8 param;
+	bool flag;  // Pause: paused, Parameter: ranged (valueFrom -> valueTo)
+	int index;  // Voice or bus (Parameter: voice, or AUDIO_VOICE_COUNT + bus)
+	int id;     // Voice id
+	int bus;    // Play
+	float valueFrom;
+	float valueTo;
+	u32 timeMS;
+};
+
+
+enum_type( AudioEventType, u8 )
+{
+	AudioEventType_VoiceFinished,
+	AudioEventType_BusFreed,
+	AudioEventType_Meter,
+};
+
+
+struct AudioEvent
+{
+	AudioEventType type;
+	int index;
+	int id;
+	float peak[2];
+};
+
+
+// Game thread view of a voice
+struct AudioVoiceState
+{
+	int bus = -1;
+	int id = 0;
+	bool bypass = false;
+	bool stopping = false; // Stop queued, waiting for AudioEventType_VoiceFinished
+	AudioEffects effects;
+#if COMPILE_DEBUG
+	const char *name = "";
+#endif
+};
+
+
+// Game thread view of a bus
+struct AudioBusState
+{
+	bool bypass = false;
+	AudioEffects effects;
+	AudioEffects staged; // Read by the mixer on AudioCommandType_BusInit
+};
+
+
+// Voice finished & bus freed events always fit (meters only use the space left over)
+static_assert( AUDIO_EVENT_QUEUE_SIZE > AUDIO_VOICE_COUNT + AUDIO_BUS_COUNT, "AUDIO_EVENT_QUEUE_SIZE too small" );
+
+static struct
+{
+	SpscRing<AudioCommand, AUDIO_COMMAND_QUEUE_SIZE> commands;
+	SpscRing<AudioEvent, AUDIO_EVENT_QUEUE_SIZE> events;
+	AudioVoiceState voices[AUDIO_VOICE_COUNT];
+	AudioBusState buses[AUDIO_BUS_COUNT];
+
+	// Free voices: finished voices, then voices not played since init (find_voice never scans)
+	int voicesFree[AUDIO_VOICE_COUNT];
+	int voicesFreeCount = 0;
+	int voicesUnused = 0;
+
+	// Mixer statistics (SysAudio::draw)
+	volatile u32 drainDepth = 0;
+	volatile u32 drainDepthPeak = 0;
+	volatile u32 drainNs = 0;
+	volatile u32 drainNsPeak = 0;
+	volatile u32 metersDropped = 0;
+
+	// Game statistics
+	u32 commandsDropped = 0;
+	float meter[2] = { 0.0f, 0.0f };
+} g_audioQueue;
+
+
+struct AudioEffectsBinding
+{
+	static void bind( AudioEffects &effects, const int target, const int id )
+	{
+		effects.target = target;
+		effects.targetId = id;
+	}
+
+	static SysAudio::Effect &find_effect( AudioEffects &effects, const SysAudio::EffectType type )
+	{
+		return effects.find_effect( type );
+	}
+};
+
+
+static bool audio_command( const AudioCommand &command )
+{
+	// Game thread: a full ring means the mixer is not running
+	if( LIKELY( g_audioQueue.commands.push( command ) ) ) { return true; }
+	g_audioQueue.commandsDropped++;
+	return false;
+}
+
+
+static void audio_event( const AudioEvent &event )
+{
+	const bool pushed = g_audioQueue.events.push( event );
+	Assert( pushed );
+}
+
+
+static void audio_voice_finish( const int voice )
+{
+	// Mixer thread
+	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+	effects_release( audioVoice.effects );
+	audio_voice_unlink( voice );
+	audioVoice.bus = -1;
+	if( audioVoice.stream >= 0 )
+	{
+		atomic_exchange<u32>( &g_audioStreams.streams[audioVoice.stream].state, AudioStreamState_Stopping );
+		audio_stream_wake();
+		audioVoice.stream = -1;
+	}
+	audio_event( AudioEvent { AudioEventType_VoiceFinished, voice, audioVoice.id, { 0.0f, 0.0f } } );
+}
+
+
+static void audio_command_apply( const AudioCommand &command )
+{
+	using namespace SysAudio;
+
+	switch( command.type )
+	{
+		case AudioCommandType_Play:
+		{
+			Voice &voice = voices[command.index];
+			voice.id = command.id;
+			voice.bypass = false;
+			voice.bus = command.bus;
+			audio_voice_link( command.index, command.bus );
+		}
+		break;
+
+		case AudioCommandType_Stop:
+		{
+			Voice &voice = voices[command.index];
+			if( voice.bus < 0 || voice.id != command.id ) { break; }
+			audio_voice_finish( command.index );
+		}
+		break;
+
+		case AudioCommandType_Pause:
+		{
+			Voice &voice = voices[command.index];
+			if( voice.bus < 0 || voice.id != command.id ) { break; }
+			voice.bypass = command.flag;
+		}
+		break;
+
+		case AudioCommandType_Parameter:
+		{
+			// Voices occupy [0, AUDIO_VOICE_COUNT), buses follow
+			AudioEffects *effects;
+			if( command.index < AUDIO_VOICE_COUNT )
+			{
+				Voice &voice = voices[command.index];
+				if( voice.bus < 0 || voice.id != command.id ) { break; }
+				effects = &voice.effects;
+			}
+			else
+			{
+				if( command.index >= AUDIO_VOICE_COUNT + AUDIO_BUS_COUNT ) { break; }
+				effects = &buses[command.index - AUDIO_VOICE_COUNT].effects;
+			}
+
+			Effect &effect = AudioEffectsBinding::find_effect( *effects, static_cast<EffectType>( command.effectType ) );
+			const EffectParam param = static_cast<EffectParam>( command.param );
+			if( command.flag ) { effect.set_parameter( param, command.valueFrom, command.valueTo, command.timeMS ); }
+			else { effect.set_parameter( param, command.valueFrom, command.timeMS ); }
+		}
+		break;
+
+		case AudioCommandType_BusInit:
+		{
+			Bus &bus = buses[command.index];
+			effects_release( bus.effects );
+			effects_copy( bus.effects, g_audioQueue.buses[command.index].staged );
+			bus.bypass = false;
+		}
+		break;
+
+		case AudioCommandType_BusFree:
+		{
+			// Voices stop with their bus
+			Bus &bus = buses[command.index];
+			while( bus.voiceFirst >= 0 ) { audio_voice_finish( bus.voiceFirst ); }
+
+			// Freed buses mix silence (effects would keep pooled reverbs & their tails alive)
+			effects_release( bus.effects );
+			bus.effects = AudioEffects { };
+			bus.bypass = false;
+			audio_event( AudioEvent { AudioEventType_BusFreed, command.index, 0, { 0.0f, 0.0f } } );
+		}
+		break;
+
+		case AudioCommandType_BusPause:
+		{
+			buses[command.index].bypass = command.flag;
+		}
+		break;
+	}
+}
+
+
+static void audio_commands_drain()
+{
+	// Mixer thread
+	const double timeStart = Time::value();
+	const u32 depth = static_cast<u32>( g_audioQueue.commands.count() );
+
+	AudioCommand command;
+	while( g_audioQueue.commands.pop( command ) ) { audio_command_apply( command ); }
+
+	// Statistics
+	const u32 ns = static_cast<u32>( ( Time::value() - timeStart ) * 1000000000.0 );
+	atomic_store( &g_audioQueue.drainDepth, depth );
+	atomic_store( &g_audioQueue.drainNs, ns );
+	if( depth > g_audioQueue.drainDepthPeak ) { atomic_store( &g_audioQueue.drainDepthPeak, depth ); }
+	if( ns > g_audioQueue.drainNsPeak ) { atomic_store( &g_audioQueue.drainNsPeak, ns ); }
+}
+
+
+static void audio_events_drain()
+{
+	// Game thread
+	AudioEvent event;
+	while( g_audioQueue.events.pop( event ) )
+	{
+		switch( event.type )
+		{
+			case AudioEventType_VoiceFinished:
+			{
+				AudioVoiceState &voice = g_audioQueue.voices[event.index];
+				if( voice.id != event.id ) { break; }
+				voice.bus = -1;
+				voice.stopping = false;
+				g_audioQueue.voicesFree[g_audioQueue.voicesFreeCount++] = event.index;
+			}
+			break;
+
+			case AudioEventType_BusFreed:
+			{
+				SysAudio::buses[event.index].available = true;
+			}
+			break;
+
+			case AudioEventType_Meter:
+			{
+				g_audioQueue.meter[0] = event.peak[0];
+				g_audioQueue.meter[1] = event.peak[1];
+			}
+			break;
+		}
+	}
+}
+
+
+static AudioVoiceState *audio_voice_state( const int voice, const int id )
+{
+	// Game thread: playing voices only
+	if( voice < 0 || voice >= AUDIO_VOICE_COUNT ) { return nullptr; }
+	audio_events_drain();
+	AudioVoiceState &state = g_audioQueue.voices[voice];
+	if( state.bus < 0 || state.stopping || state.id != id ) { return nullptr; }
+	return &state;
+}
+
+
+static void audio_queue_reset()
+{
+	g_audioQueue.commands.clear();
+	g_audioQueue.events.clear();
+	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ ) { new ( &g_audioQueue.voices[i] ) AudioVoiceState { }; }
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ ) { new ( &g_audioQueue.buses[i] ) AudioBusState { }; }
+	g_audioQueue.voicesFreeCount = 0;
+	g_audioQueue.voicesUnused = 0;
+	g_audioQueue.drainDepthPeak = 0;
+	g_audioQueue.drainNsPeak = 0;
+	g_audioQueue.metersDropped = 0;
+	g_audioQueue.commandsDropped = 0;
+}
+
+
+void AudioEffects::submit( const SysAudio::EffectType type, const SysAudio::EffectParam param, const float valueFrom,
+	const float valueTo, const usize timeMS, const bool ranged )
+{
+	if( target < 0 ) { return; }
+
+	AudioCommand command { };
+	command.type = AudioCommandType_Parameter;
+	command.effectType = static_cast<u8>( type );
+	command.param = static_cast<u8>( param );
+	command.flag = ranged;
+	command.index = target;
+	command.id = targetId;
+	command.valueFrom = valueFrom;
+	command.valueTo = valueTo;
+	command.timeMS = static_cast<u32>( timeMS );
+	audio_command( command );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SysAudio::init()
+{
+	// Initialize Audio Buses & Voices
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ ) { new ( &buses[i] ) SysAudio::Bus { }; }
+	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ ) { new ( &voices[i] ) SysAudio::Voice { }; }
+	memory_set( g_reverbPoolUsed, 0, sizeof( g_reverbPoolUsed ) );
+	audio_voices_reset();
+	audio_queue_reset();
+
+	// Initialize Streaming
+	bool failure = !init_streams();
+	ErrorReturnIf( failure, false, "Audio: failed to initialize streaming" );
+
+	// Initialize Mixing Workers
+	failure = !init_workers( AUDIO_MIX_WORKERS );
+	ErrorReturnIf( failure, false, "Audio: failed to initialize mixing workers" );
+
+	// Initialize Samples Buffer
+	ErrorReturnIf( g_AUDIO_SAMPLES != nullptr, false, "Audio: samples buffer already initialized" );
+	if constexpr ( Assets::soundSampleDataSize == 0 ) { return true; }
+
+	g_AUDIO_SAMPLES = reinterpret_cast<i16 *>( memory_alloc( Assets::soundSampleDataSize ) );
+	ErrorReturnIf( g_AUDIO_SAMPLES == nullptr, false,
+		"Audio: failed to allocate samples buffer (%llu bytes)", Assets::soundSampleDataSize );
+	memory_copy( g_AUDIO_SAMPLES, &Assets::binary.data[Assets::soundSampleDataOffset], Assets::soundSampleDataSize );
+
+	// Initialize Backend
+	failure = !init_backend();
+	ErrorReturnIf( failure, false, "Audio: failed to initialize audio backend" );
+
+	// Success
+	return true;
+}
+
+
+bool SysAudio::free()
+{
+	// Free Backend
+	bool failure = !free_backend();
+	ErrorReturnIf( failure, false, "Audio: failed to free audio backend" );
+
+	// Free Streaming
+	failure = !free_streams();
+	ErrorReturnIf( failure, false, "Audio: failed to free streaming" );
+
+	// Free Mixing Workers
+	failure = !free_workers();
+	ErrorReturnIf( failure, false, "Audio: failed to free mixing workers" );
+
+	// Free Samples
+	if( g_AUDIO_SAMPLES != nullptr )
+	{
+		memory_free( g_AUDIO_SAMPLES );
+		g_AUDIO_SAMPLES = nullptr;
+	}
+
+	// Free Voices & Buses
+	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
+	{
+		effects_release( voices[i].effects );
+		new ( &voices[i] ) Voice { };
+	}
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		effects_release( buses[i].effects );
+		buses[i].voiceFirst = -1;
+	}
+	audio_voices_reset();
+	audio_queue_reset();
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int find_voice()
+{
+	// Most recently finished voice, then the next voice not played since init (taken by audio_voice_play)
+	if( g_audioQueue.voicesFreeCount > 0 ) { return g_audioQueue.voicesFree[g_audioQueue.voicesFreeCount - 1]; }
+	if( g_audioQueue.voicesUnused < AUDIO_VOICE_COUNT ) { return g_audioQueue.voicesUnused; }
+
+	// Failure
+	return -1;
+}
+
+
+static int find_bus()
+{
+	// Find first available bus
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	if( SysAudio::buses[i].available ) { return i; }
+
+	// Failure
+	return -1;
+}
+
+// Mix buffers (interleaved stereo), preallocated for the audio thread. Each mixing thread owns a voice buffer, each bus
+// a bus buffer, and bus voice groups after the first (which mixes straight into its bus buffer) a group buffer
+static constexpr u32 AUDIO_MIX_GROUPS_MAX = AUDIO_VOICE_REAL_COUNT / AUDIO_MIX_GROUP_VOICES + 1;
+alignas( 32 ) static float g_mixBufferVoices[AUDIO_MIX_WORKERS_MAX + 1][AUDIO_MIX_FRAMES_MAX * 2];
+alignas( 32 ) static float g_mixBufferGroups[AUDIO_MIX_GROUPS_MAX][AUDIO_MIX_FRAMES_MAX * 2];
+alignas( 32 ) static float g_mixBufferBuses[AUDIO_BUS_COUNT][AUDIO_MIX_FRAMES_MAX * 2];
+alignas( 32 ) static float g_mixBufferMaster[AUDIO_MIX_FRAMES_MAX * 2];
+static float g_mixPeak[2];
+
+// AUDIO_PROFILER: each AUDIO_PROFILE( stage ) charges the time since the previous mark to 'stage'. Mixing tasks charge
+// their thread's profile (AUDIO_PROFILE_TASK), merged into g_mixerProfile after each audio_mixer call
+#if AUDIO_PROFILER
+static SysAudio::MixerProfile g_mixerProfile;
+static SysAudio::MixerProfile g_mixerProfileWorkers[AUDIO_MIX_WORKERS_MAX];
+#define AUDIO_PROFILE_START() double profileTime = Time::value()
+#define AUDIO_PROFILE( stage ) \
+	{ const double now = Time::value(); g_mixerProfile.stage += now - profileTime; profileTime = now; }
+#define AUDIO_PROFILE_SKIP() profileTime = Time::value()
+#define AUDIO_PROFILE_TASK_START( thread ) \
+	SysAudio::MixerProfile &profile = ( thread ) == 0 ? g_mixerProfile : g_mixerProfileWorkers[( thread ) - 1]; \
+	double profileTime = Time::value()
+#define AUDIO_PROFILE_TASK( stage ) \
+	{ const double now = Time::value(); profile.stage += now - profileTime; profileTime = now; }
+
+SysAudio::MixerProfile SysAudio::mixer_profile() { return g_mixerProfile; }
+void SysAudio::mixer_profile_reset() { memory_set( &g_mixerProfile, 0, sizeof( g_mixerProfile ) ); }
+#else
+#define AUDIO_PROFILE_START()
+#define AUDIO_PROFILE( stage )
+#define AUDIO_PROFILE_SKIP()
+#define AUDIO_PROFILE_TASK_START( thread )
+#define AUDIO_PROFILE_TASK( stage )
+#endif
+
+
+static bool audio_mix_voice( SysAudio::Voice &voice, const float pitch, float *bufferVoice, const u32 frames )
+{
+	// Source position & length in frames (voice.position counts samples)
+	const u32 channels = static_cast<u32>( voice.channels );
+	const u32 framesCount = voice.samplesCount / channels;
+	const float position = voice.position / channels;
+
+	// Frames with a source position inside the sound
+	const u32 framesToMix = SysAudio::mix_frames_before( position, pitch, static_cast<float>( framesCount ), frames );
+
+	// Read voice samples
+	const i32 end = static_cast<i32>( framesCount );
+	switch( channels )
+	{
+		case 1: SysAudio::mix_resample_sinc_mono( bufferVoice, voice.samples, 0, end, position, pitch, framesToMix ); break;
+		case 2: SysAudio::mix_resample_sinc_stereo( bufferVoice, voice.samples, 0, end, position, pitch, framesToMix ); break;
+	}
+	memory_set( &bufferVoice[framesToMix * 2], 0, ( frames - framesToMix ) * 2 * sizeof( float ) );
+
+	// Voice complete?
+	if( framesToMix < frames ) { return true; }
+	voice.position = ( position + static_cast<float>( frames ) * pitch ) * channels;
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parallel Mixing
+
+// A mixer pass runs in two phases of independent tasks: voice groups (up to AUDIO_MIX_GROUP_VOICES real voices of one
+// bus, mixed with their effects), then buses (group sums & bus effects). The audio thread claims tasks alongside
+// SysAudio::init_workers threads, which spin briefly for the next phase before sleeping. Sums happen in a fixed order,
+// so output does not depend on which thread ran a task.
+//
+// Workers that are still busy AUDIO_MIX_DEADLINE into a period count as a deadline miss: the next
+// AUDIO_MIX_FALLBACK_PERIODS periods are mixed on the audio thread alone
+
+enum_type( AudioMixPhase, u32 )
+{
+	AudioMixPhase_Groups,
+	AudioMixPhase_Buses,
+};
+
+
+struct AudioMixGroup
+{
+	u32 bus;
+	u32 voiceFirst; // Index into AudioMixPlan::voices
+	u32 voiceCount;
+	float *buffer;
+};
+
+
+static struct
+{
+	u32 frames;
+	float rate;
+
+	AudioMixGroup groups[AUDIO_MIX_GROUPS_MAX + AUDIO_BUS_COUNT];
+	u32 groupCount;
+	u32 busGroupFirst[AUDIO_BUS_COUNT];
+	u32 busGroupEnd[AUDIO_BUS_COUNT];
+
+	// Buses whose groups have all run are mixed by the audio thread while it waits on workers (see audio_mix_phase);
+	// the rest become the tasks of the bus phase
+	volatile u32 busGroupsDone[AUDIO_BUS_COUNT];
+	bool busMixed[AUDIO_BUS_COUNT];
+	u32 busTasks[AUDIO_BUS_COUNT];
+	u32 busTaskCount;
+
+	// Real voices in group order
+	int voices[AUDIO_VOICE_REAL_COUNT];
+	float pitches[AUDIO_VOICE_REAL_COUNT];
+	bool complete[AUDIO_VOICE_REAL_COUNT];
+	u32 voiceCount;
+} g_audioMixPlan;
+
+
+// Phase & claim words: generation (high 16 bits) | phase kind (bit 15) & task count, or next task (low bits)
+static constexpr u32 AUDIO_MIX_TASKS_MASK = 0x7FFF;
+static constexpr u32 AUDIO_MIX_SPIN = 4096;
+
+static struct
+{
+	u32 count = 0; // Worker threads
+	volatile u32 running = 0;
+	volatile u32 alive = 0;
+
+	volatile u32 phase = 0;
+	volatile u32 claim = 0;
+	volatile u32 done = 0;
+	volatile u32 sleeping = 0;
+	Mutex mutex;
+	Condition wake;
+
+	// Audio thread
+	u32 generation = 0;
+	u32 fallback = 0; // Serial periods left after a deadline miss
+	bool missed = false;
+
+	// Statistics (SysAudio::mixer_statistics)
+	volatile u32 periods = 0;
+	volatile u32 parallel = 0;
+	volatile u32 overBudget = 0;
+	volatile u32 deadlineMisses = 0;
+	volatile u32 workerTasks = 0;
+	volatile u32 usLast = 0;
+	volatile u32 usPeak = 0;
+	volatile u32 budgetUsLast = 0;
+	volatile u32 loadPeak = 0;
+	volatile u64 usTotal = 0;
+	volatile u64 budgetUsTotal = 0;
+} g_audioWorkers;
+
+
+static void audio_mix_plan( const u32 frames, const float rate )
+{
+	// Audio thread: advances virtual voices and splits the real voices of each bus into groups
+	using namespace SysAudio;
+	auto &plan = g_audioMixPlan;
+	plan.frames = frames;
+	plan.rate = rate;
+	plan.groupCount = 0;
+	plan.voiceCount = 0;
+	u32 groupBuffers = 0;
+
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		Bus &bus = buses[i];
+		Assert( bus.effects[0].type == SysAudio::EffectType_Core );
+		const float pitchBus = bus.effects[0].get_parameter( SysAudio::EffectParam_Core_Pitch, false ) * rate;
+		plan.busGroupFirst[i] = plan.groupCount;
+		plan.busGroupsDone[i] = 0;
+		plan.busMixed[i] = false;
+
+		int next;
+		for( int j = bus.voiceFirst; j >= 0; j = next )
+		{
+			Voice &voice = voices[j];
+			next = voice.busNext; // audio_voice_finish unlinks the voice
+			if( voice.bypass ) { continue; }
+
+			Assert( voice.effects[0].type == SysAudio::EffectType_Core );
+			const float pitchVoice = voice.effects[0].get_parameter( SysAudio::EffectParam_Core_Pitch, false ) * pitchBus;
+
+			// Virtual voices advance without mixing
+			if( voice.real < 0 )
+			{
+				effects_advance( voice.effects, frames );
+				if( audio_voice_advance( voice, pitchVoice, frames ) ) { audio_voice_finish( j ); }
+				continue;
+			}
+
+			// The first group of a bus mixes straight into the bus buffer
+			const bool first = plan.groupCount == plan.busGroupFirst[i];
+			if( first || plan.groups[plan.groupCount - 1].voiceCount == AUDIO_MIX_GROUP_VOICES )
+			{
+				Assert( first || groupBuffers < AUDIO_MIX_GROUPS_MAX );
+				AudioMixGroup &group = plan.groups[plan.groupCount++];
+				group.bus = static_cast<u32>( i );
+				group.voiceFirst = plan.voiceCount;
+				group.voiceCount = 0;
+				group.buffer = first ? g_mixBufferBuses[i] : g_mixBufferGroups[groupBuffers++];
+			}
+
+			Assert( plan.voiceCount < AUDIO_VOICE_REAL_COUNT );
+			plan.voices[plan.voiceCount] = j;
+			plan.pitches[plan.voiceCount] = pitchVoice;
+			plan.complete[plan.voiceCount] = false;
+			plan.voiceCount++;
+			plan.groups[plan.groupCount - 1].voiceCount++;
+		}
+
+		plan.busGroupEnd[i] = plan.groupCount;
+	}
+}
+
+
+static void audio_mix_group( const u32 index, const u32 thread )
+{
+	using namespace SysAudio;
+	auto &plan = g_audioMixPlan;
+	const AudioMixGroup &group = plan.groups[index];
+	const u32 frames = plan.frames;
+	const u32 count = frames * 2;
+	float *bufferVoice = g_mixBufferVoices[thread];
+	AUDIO_PROFILE_TASK_START( thread );
+	memory_set( group.buffer, 0, count * sizeof( float ) );
+
+	for( u32 i = group.voiceFirst; i < group.voiceFirst + group.voiceCount; i++ )
+	{
+		Voice &voice = voices[plan.voices[i]];
+		const float pitch = plan.pitches[i];
+
+		bool complete;
+		if( voice.stream >= 0 ) { complete = audio_mix_stream( voice, bufferVoice, plan.rate, frames ); }
+		else if( voice.format == AudioFormat_ADPCM ) { complete = audio_mix_voice_adpcm( voice, pitch, bufferVoice, frames ); }
+		else { complete = audio_mix_voice( voice, pitch, bufferVoice, frames ); }
+		plan.complete[i] = complete;
+		AUDIO_PROFILE_TASK( voices );
+
+		// Process per-voice effects
+		for( u32 k = 0; k < SysAudio::EFFECTTYPE_COUNT; k++ )
+		{
+			Effect &effect = voice.effects[k];
+			if( effect.type < 0 ) { break; }
+			effectFunctions[effect.type].apply( effect, bufferVoice, frames );
+		}
+		AUDIO_PROFILE_TASK( effects );
+
+		// Write voice to group
+		mix_accumulate( group.buffer, bufferVoice, count );
+		AUDIO_PROFILE_TASK( buses );
+	}
+
+	atomic_add<u32>( &plan.busGroupsDone[group.bus], 1 );
+}
+
+
+static void audio_mix_bus( const u32 index, const u32 thread )
+{
+	using namespace SysAudio;
+	auto &plan = g_audioMixPlan;
+	Bus &bus = buses[index];
+	float *buffer = g_mixBufferBuses[index];
+	const u32 count = plan.frames * 2;
+	AUDIO_PROFILE_TASK_START( thread );
+
+	// Sum the groups (the first mixed into the bus buffer)
+	const u32 first = plan.busGroupFirst[index];
+	const u32 end = plan.busGroupEnd[index];
+	if( first == end ) { memory_set( buffer, 0, count * sizeof( float ) ); }
+	for( u32 i = first + 1; i < end; i++ ) { mix_accumulate( buffer, plan.groups[i].buffer, count ); }
+
+	// Process per-bus effects
+	for( u32 j = 0; j < SysAudio::EFFECTTYPE_COUNT; j++ )
+	{
+		Effect &effect = bus.effects[j];
+		if( effect.type < 0 ) { continue; }
+		effectFunctions[effect.type].apply( effect, buffer, plan.frames );
+	}
+	AUDIO_PROFILE_TASK( buses );
+}
+
+
+static void audio_mix_task( const u32 phase, const u32 task, const u32 thread )
+{
+	switch( phase )
+	{
+		case AudioMixPhase_Groups: audio_mix_group( task, thread ); break;
+		case AudioMixPhase_Buses: audio_mix_bus( g_audioMixPlan.busTasks[task], thread ); break;
+	}
+}
+
+
+static void audio_mix_claim( const u32 phase, const u32 thread )
+{
+	// Runs tasks of 'phase' until none are left (claims fail once the audio thread moves to another phase)
+	const u32 generation = phase >> 16;
+	const u32 kind = ( phase >> 15 ) & 1;
+	const u32 tasks = phase & AUDIO_MIX_TASKS_MASK;
+
+	for( ;; )
+	{
+		const u32 claim = atomic_load( &g_audioWorkers.claim );
+		if( claim >> 16 != generation || ( claim & 0xFFFF ) >= tasks ) { return; }
+		if( !atomic_compare_exchange( &g_audioWorkers.claim, claim, claim + 1 ) ) { continue; }
+
+		audio_mix_task( kind, claim & 0xFFFF, thread );
+		if( thread > 0 ) { atomic_add<u32>( &g_audioWorkers.workerTasks, 1 ); }
+		atomic_add<u32>( &g_audioWorkers.done, 1 );
+	}
+}
+
+
+static THREAD_FUNCTION( audio_mix_worker )
+{
+	const u32 thread = static_cast<u32>( reinterpret_cast<usize>( userdata ) );
+	u32 seen = atomic_load( &g_audioWorkers.phase ) >> 16;
+
+	while( atomic_load( &g_audioWorkers.running ) != 0 )
+	{
+		// Next phase: spin for a moment (phases follow each other closely), then sleep until woken
+		u32 phase = atomic_load( &g_audioWorkers.phase );
+		for( u32 i = 0; phase >> 16 == seen && i < AUDIO_MIX_SPIN; i++ )
+		{
+			atomic_pause();
+			phase = atomic_load( &g_audioWorkers.phase );
+		}
+
+		if( phase >> 16 == seen )
+		{
+			g_audioWorkers.mutex.lock();
+			atomic_add<u32>( &g_audioWorkers.sleeping, 1 );
+			while( ( phase = atomic_load( &g_audioWorkers.phase ) ) >> 16 == seen &&
+				atomic_load( &g_audioWorkers.running ) != 0 )
+			{
+				g_audioWorkers.wake.sleep( g_audioWorkers.mutex );
+			}
+			atomic_sub<u32>( &g_audioWorkers.sleeping, 1 );
+			g_audioWorkers.mutex.unlock();
+			if( phase >> 16 == seen ) { continue; }
+		}
+
+		seen = phase >> 16;
+		audio_mix_claim( phase, thread );
+	}
+
+	atomic_sub<u32>( &g_audioWorkers.alive, 1 );
+	return 0;
+}
+
+
+static bool audio_mix_buses_ready()
+{
+	// Audio thread: mixes the buses whose groups have all run (returns whether any was mixed)
+	auto &plan = g_audioMixPlan;
+	bool mixed = false;
+	for( u32 i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		if( plan.busMixed[i] ) { continue; }
+		if( atomic_load( &plan.busGroupsDone[i] ) != plan.busGroupEnd[i] - plan.busGroupFirst[i] ) { continue; }
+		audio_mix_bus( i, 0 );
+		plan.busMixed[i] = true;
+		mixed = true;
+	}
+	return mixed;
+}
+
+
+static void audio_mix_buses_plan()
+{
+	// Audio thread: the buses left for the bus phase
+	auto &plan = g_audioMixPlan;
+	plan.busTaskCount = 0;
+	for( u32 i = 0; i < AUDIO_BUS_COUNT; i++ )
+	{
+		if( !plan.busMixed[i] ) { plan.busTasks[plan.busTaskCount++] = i; }
+	}
+}
+
+
+static void audio_mix_phase( const AudioMixPhase kind, const u32 tasks, const bool parallel, const double deadline )
+{
+	// Audio thread: returns once every task of the phase has run
+	if( !parallel || tasks < 2 )
+	{
+		for( u32 i = 0; i < tasks; i++ ) { audio_mix_task( kind, i, 0 ); }
+		return;
+	}
+
+	// Publish (claims of the previous phase fail from here on)
+	Assert( tasks <= AUDIO_MIX_TASKS_MASK );
+	g_audioWorkers.generation = ( g_audioWorkers.generation + 1 ) & 0xFFFF;
+	const u32 phase = ( g_audioWorkers.generation << 16 ) | ( static_cast<u32>( kind ) << 15 ) | tasks;
+	atomic_store<u32>( &g_audioWorkers.done, 0 );
+	atomic_exchange<u32>( &g_audioWorkers.claim, g_audioWorkers.generation << 16 );
+	atomic_exchange<u32>( &g_audioWorkers.phase, phase );
+	if( atomic_load( &g_audioWorkers.sleeping ) != 0 )
+	{
+		g_audioWorkers.mutex.lock();
+		g_audioWorkers.wake.wake_all();
+		g_audioWorkers.mutex.unlock();
+	}
+
+	// Work alongside the workers until no task is left to claim. Claimed tasks advance voice state, so the ones workers
+	// still hold cannot be taken over: meanwhile, buses whose groups have all run are mixed here. The audio thread never
+	// yields or sleeps (a miss past the deadline makes the next periods serial instead)
+	audio_mix_claim( phase, 0 );
+	for( u32 spin = 0; atomic_load( &g_audioWorkers.done ) < tasks; spin++ )
+	{
+		if( kind == AudioMixPhase_Groups && audio_mix_buses_ready() ) { continue; }
+		atomic_pause();
+		if( !g_audioWorkers.missed && spin % 64 == 0 && Time::value() > deadline ) { g_audioWorkers.missed = true; }
+	}
+}
+
+
+bool SysAudio::init_workers( const u32 count )
+{
+	Assert( g_audioWorkers.count == 0 );
+	ErrorReturnIf( count > AUDIO_MIX_WORKERS_MAX, false, "Audio: %u mixing workers requested (max %d)", count,
+		AUDIO_MIX_WORKERS_MAX );
+	if( count == 0 ) { return true; }
+
+	g_audioWorkers.mutex.init();
+	g_audioWorkers.wake.init();
+	g_audioWorkers.fallback = 0;
+	atomic_store<u32>( &g_audioWorkers.running, 1 );
+
+	// Start Threads (worker i mixes into voice buffer i, the audio thread into 0)
+	for( u32 i = 1; i <= count; i++ )
+	{
+		atomic_add<u32>( &g_audioWorkers.alive, 1 );
+		bool failure = Thread::create( audio_mix_worker, reinterpret_cast<void *>( static_cast<usize>( i ) ) ) == nullptr;
+		if( failure ) { atomic_sub<u32>( &g_audioWorkers.alive, 1 ); free_workers(); }
+		ErrorReturnIf( failure, false, "Audio: failed to start mixing worker %u", i );
+		g_audioWorkers.count = i;
+	}
+
+	// Success
+	return true;
+}
+
+
+bool SysAudio::free_workers()
+{
+	if( atomic_load( &g_audioWorkers.running ) == 0 ) { return true; }
+
+	// Stop Threads
+	atomic_store<u32>( &g_audioWorkers.running, 0 );
+	while( atomic_load( &g_audioWorkers.alive ) != 0 )
+	{
+		g_audioWorkers.mutex.lock();
+		g_audioWorkers.wake.wake_all();
+		g_audioWorkers.mutex.unlock();
+		Thread::sleep( 1 );
+	}
+
+	g_audioWorkers.count = 0;
+	g_audioWorkers.wake.free();
+	g_audioWorkers.mutex.free();
+
+	// Success
+	return true;
+}
+
+
+SysAudio::MixerStatistics SysAudio::mixer_statistics()
+{
+	MixerStatistics statistics;
+	statistics.workers = g_audioWorkers.count;
+	statistics.periods = atomic_load( &g_audioWorkers.periods );
+	statistics.parallel = atomic_load( &g_audioWorkers.parallel );
+	statistics.overBudget = atomic_load( &g_audioWorkers.overBudget );
+	statistics.deadlineMisses = atomic_load( &g_audioWorkers.deadlineMisses );
+	statistics.workerTasks = atomic_load( &g_audioWorkers.workerTasks );
+	statistics.usLast = atomic_load( &g_audioWorkers.usLast );
+	statistics.usPeak = atomic_load( &g_audioWorkers.usPeak );
+	statistics.budgetUsLast = atomic_load( &g_audioWorkers.budgetUsLast );
+	statistics.loadPeak = atomic_load( &g_audioWorkers.loadPeak );
+	statistics.usTotal = atomic_load( &g_audioWorkers.usTotal );
+	statistics.budgetUsTotal = atomic_load( &g_audioWorkers.budgetUsTotal );
+	return statistics;
+}
+
+
+void SysAudio::mixer_statistics_reset()
+{
+	atomic_store<u32>( &g_audioWorkers.periods, 0 );
+	atomic_store<u32>( &g_audioWorkers.parallel, 0 );
+	atomic_store<u32>( &g_audioWorkers.overBudget, 0 );
+	atomic_store<u32>( &g_audioWorkers.deadlineMisses, 0 );
+	atomic_store<u32>( &g_audioWorkers.workerTasks, 0 );
+	atomic_store<u32>( &g_audioWorkers.usPeak, 0 );
+	atomic_store<u32>( &g_audioWorkers.loadPeak, 0 );
+	atomic_store<u64>( &g_audioWorkers.usTotal, 0 );
+	atomic_store<u64>( &g_audioWorkers.budgetUsTotal, 0 );
+}
+
+
+static void audio_mixer_statistics( const double seconds, const u32 frames, const bool parallel )
+{
+	// Audio thread: period time against the duration of the audio it produced
+	const u32 us = static_cast<u32>( seconds * 1000000.0 );
+	const u32 budgetUs = static_cast<u32>( static_cast<u64>( frames ) * 1000000 / SysAudio::sampleRate );
+	const u32 load = budgetUs > 0 ? static_cast<u32>( static_cast<u64>( us ) * 100 / budgetUs ) : 0;
+	atomic_add<u32>( &g_audioWorkers.periods, 1 );
+	if( parallel ) { atomic_add<u32>( &g_audioWorkers.parallel, 1 ); }
+	if( us > budgetUs ) { atomic_add<u32>( &g_audioWorkers.overBudget, 1 ); }
+	atomic_store( &g_audioWorkers.usLast, us );
+	atomic_store( &g_audioWorkers.budgetUsLast, budgetUs );
+	if( us > atomic_load( &g_audioWorkers.usPeak ) ) { atomic_store( &g_audioWorkers.usPeak, us ); }
+	if( load > atomic_load( &g_audioWorkers.loadPeak ) ) { atomic_store( &g_audioWorkers.loadPeak, load ); }
+	atomic_add<u64>( &g_audioWorkers.usTotal, us );
+	atomic_add<u64>( &g_audioWorkers.budgetUsTotal, budgetUs );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void audio_mix_chunk( i16 *output, const u32 frames, const bool parallel, const double deadline )
+{
+	using namespace SysAudio;
+	Assert( frames <= AUDIO_MIX_FRAMES_MAX );
+	const u32 count = frames * 2;
+	AUDIO_PROFILE_START();
+	memory_set( g_mixBufferMaster, 0, count * sizeof( float ) );
+	AUDIO_PROFILE( master );
+
+	// Choose real voices
+	audio_voices_select();
+	AUDIO_PROFILE( voices );
+
+	// Sounds play at AUDIO_SAMPLE_RATE: read positions advance by the rate ratio per device frame
+	const float rate = static_cast<float>( AUDIO_SAMPLE_RATE ) / static_cast<float>( sampleRate );
+	audio_mix_plan( frames, rate );
+	AUDIO_PROFILE( voices );
+
+	// Mix voice groups, then buses (tasks charge their own profile)
+	audio_mix_phase( AudioMixPhase_Groups, g_audioMixPlan.groupCount, parallel, deadline );
+	audio_mix_buses_plan();
+	audio_mix_phase( AudioMixPhase_Buses, g_audioMixPlan.busTaskCount, parallel, deadline );
+	AUDIO_PROFILE_SKIP();
+
+	// Voices that ran out (in mixing order)
+	for( u32 i = 0; i < g_audioMixPlan.voiceCount; i++ )
+	{
+		if( g_audioMixPlan.complete[i] ) { audio_voice_finish( g_audioMixPlan.voices[i] ); }
+	}
+	AUDIO_PROFILE( voices );
+
+	// Write buses to master
+	for( int i = 0; i < AUDIO_BUS_COUNT; i++ ) { mix_accumulate( g_mixBufferMaster, g_mixBufferBuses[i], count ); }
+	AUDIO_PROFILE( buses );
+
+	// Meter
+	for( u32 i = 0; i < count; i += 2 )
+	{
+		g_mixPeak[0] = max( g_mixPeak[0], fabsf( g_mixBufferMaster[i + 0] ) );
+		g_mixPeak[1] = max( g_mixPeak[1], fabsf( g_mixBufferMaster[i + 1] ) );
+	}
+
+	// Write to master output as i16
+	mix_float_to_i16( output, g_mixBufferMaster, count );
+	AUDIO_PROFILE( master );
+}
+
+
+void SysAudio::audio_mixer( i16 *output, u32 frames )
+{
+	// Game thread commands
+	const double timeStart = Time::value();
+	AUDIO_PROFILE_START();
+	audio_commands_drain();
+	AUDIO_PROFILE( commands );
+#if AUDIO_PROFILER
+	g_mixerProfile.frames += frames;
+	g_mixerProfile.periods++;
+#endif
+
+	// Fan out to the workers unless they recently missed a deadline
+	const bool parallel = g_audioWorkers.count > 0 && g_audioWorkers.fallback == 0;
+	if( g_audioWorkers.fallback > 0 ) { g_audioWorkers.fallback--; }
+	g_audioWorkers.missed = false;
+
+	// Device periods longer than the mix buffers are mixed in chunks
+	g_mixPeak[0] = 0.0f;
+	g_mixPeak[1] = 0.0f;
+	const u32 framesTotal = frames;
+	double chunkStart = timeStart;
+	while( frames > 0 )
+	{
+		const u32 chunk = frames < AUDIO_MIX_FRAMES_MAX ? frames : AUDIO_MIX_FRAMES_MAX;
+		const double deadline = chunkStart + AUDIO_MIX_DEADLINE * chunk / sampleRate;
+		audio_mix_chunk( output, chunk, parallel, deadline );
+		output += chunk * 2;
+		frames -= chunk;
+		chunkStart = deadline;
+	}
+
+#if AUDIO_PROFILER
+	// Worker stage times
+	for( u32 i = 0; i < g_audioWorkers.count; i++ )
+	{
+		MixerProfile &worker = g_mixerProfileWorkers[i];
+		g_mixerProfile.voices += worker.voices;
+		g_mixerProfile.effects += worker.effects;
+		g_mixerProfile.buses += worker.buses;
+		memory_set( &worker, 0, sizeof( worker ) );
+	}
+#endif
+
+	// Meter event (only into space not reserved for voice & bus events)
+	if( framesTotal == 0 ) { return; }
+#if COMPILE_DEBUG
+	audio_voices_publish();
+#endif
+	if( g_audioQueue.events.count() + AUDIO_VOICE_COUNT + AUDIO_BUS_COUNT < AUDIO_EVENT_QUEUE_SIZE )
+	{
+		audio_event( AudioEvent { AudioEventType_Meter, 0, 0, { g_mixPeak[0], g_mixPeak[1] } } );
+	}
+	else
+	{
+		atomic_add<u32>( &g_audioQueue.metersDropped, 1 );
+	}
+
+	// Deadline misses fall back to serial mixing
+	if( g_audioWorkers.missed )
+	{
+		g_audioWorkers.fallback = AUDIO_MIX_FALLBACK_PERIODS;
+		atomic_add<u32>( &g_audioWorkers.deadlineMisses, 1 );
+	}
+	audio_mixer_statistics( Time::value() - timeStart, framesTotal, parallel );
+}
+
+
+static SoundHandle audio_voice_play( const int voice, const int bus, const AudioEffects &effects )
+{
+	// Play (the voice is already staged)
+	AudioVoiceState &state = g_audioQueue.voices[voice];
+	AudioCommand command { };
+	command.type = AudioCommandType_Play;
+	command.index = voice;
+	command.id = state.id + 1;
+	command.bus = bus;
+	if( !audio_command( command ) ) { return SoundHandle { -1, -1 }; }
+
+	// Take the voice off the free list (see find_voice)
+	if( g_audioQueue.voicesFreeCount > 0 && g_audioQueue.voicesFree[g_audioQueue.voicesFreeCount - 1] == voice )
+	{
+		g_audioQueue.voicesFreeCount--;
+	}
+	else
+	{
+		Assert( voice == g_audioQueue.voicesUnused );
+		g_audioQueue.voicesUnused++;
+	}
+
+	// Game-side state
+	state.id = command.id;
+	state.bus = bus;
+	state.bypass = false;
+	state.stopping = false;
+	state.effects = effects;
+	AudioEffectsBinding::bind( state.effects, voice, state.id );
+
+	// Return handle
+	return SoundHandle { voice, state.id };
+}
+
+
+SoundHandle SysAudio::play_sound( const int bus, const i16 *const samples, const u32 samplesCount, const int channels,
+                                  const AudioEffects &effects, const char *name, const AudioFormat format,
+                                  const int priority )
+{
+	audio_events_drain();
+	const int voice = find_voice();
+	if( voice < 0 ) { return SoundHandle { -1, -1 }; }
+	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+
+	// Stage the voice (the mixer ignores it until the Play command)
+	effects_copy( audioVoice.effects, effects );
+	audioVoice.position = 0.0f;
+	audioVoice.channels = channels;
+	audioVoice.samples = samples;
+	audioVoice.samplesCount = samplesCount;
+	audioVoice.format = format;
+	audioVoice.stream = -1;
+	audioVoice.priority = priority < AUDIO_VOICE_PRIORITY_STREAM ? priority : AUDIO_VOICE_PRIORITY_STREAM - 1;
+#if COMPILE_DEBUG
+	g_audioQueue.voices[voice].name = name;
+#endif
+
+	return audio_voice_play( voice, bus, effects );
+}
+
+
+SoundHandle SysAudio::play_song( const int bus, const DiskSong &song, const bool loop, const AudioEffects &effects,
+                                 const char *name )
+{
+	Assert( song.channels == 1 || song.channels == 2 );
+	audio_events_drain();
+	const int voice = find_voice();
+	if( voice < 0 ) { return SoundHandle { -1, -1 }; }
+	const int stream = find_stream();
+	if( stream < 0 ) { return SoundHandle { -1, -1 }; }
+	SysAudio::Voice &audioVoice = SysAudio::voices[voice];
+
+	// Claim the stream (Free: neither the stream thread nor the mixer touches it)
+	AudioStream &audioStream = g_audioStreams.streams[stream];
+	audioStream.offset = song.offset;
+	audioStream.frames = song.frames;
+	audioStream.readFrame = 0;
+	audioStream.channels = static_cast<u32>( song.channels );
+	audioStream.format = static_cast<AudioFormat>( song.format );
+	audioStream.loop = loop;
+	audioStream.blockPosition = 0;
+	audioStream.started = false;
+	audioStream.windowPosition = 0.0f;
+	audioStream.windowFrames = 0;
+	audioStream.filled = 0;
+	audioStream.consumed = 0;
+	audioStream.ended = 0;
+	atomic_exchange<u32>( &audioStream.state, AudioStreamState_Playing );
+	audio_stream_wake();
+
+	// Stage the voice (the mixer ignores it until the Play command)
+	effects_copy( audioVoice.effects, effects );
+	audioVoice.position = 0.0f;
+	audioVoice.channels = song.channels;
+	audioVoice.samples = nullptr;
+	audioVoice.samplesCount = static_cast<u32>( song.frames * song.channels );
+	audioVoice.format = AudioFormat_PCM16;
+	audioVoice.stream = stream;
+	audioVoice.priority = AUDIO_VOICE_PRIORITY_STREAM;
+#if COMPILE_DEBUG
+	g_audioQueue.voices[voice].name = name;
+#endif
+
+	const SoundHandle handle = audio_voice_play( voice, bus, effects );
+	if( handle.voice < 0 )
+	{
+		// Hand the stream back through the stream thread
+		audioVoice.stream = -1;
+		atomic_exchange<u32>( &audioStream.state, AudioStreamState_Stopping );
+		audio_stream_wake();
+	}
+	return handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AudioEffects::init()
+{
+	// Default-initialize Effects
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
+	{
+		SysAudio::Effect &effect = effects[i];
+		new ( &effect ) SysAudio::Effect { };
+
+		// First effect is always AudioEffect_Core
+		effects[0].type = SysAudio::EffectType_Core;
+		effects[0].set_parameter( SysAudio::EffectParam_Core_Gain, 1.0f, 0.0f );
+		effects[0].set_parameter( SysAudio::EffectParam_Core_Pitch, 1.0f, 0.0f );
+	}
+}
+
+
+SysAudio::Effect &AudioEffects::find_effect( const SysAudio::EffectType effectType )
+{
+	Assert( effectType < SysAudio::EFFECTTYPE_COUNT );
+
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ )
+	{
+		SysAudio::Effect &effect = effects[i];
+
+		// Found an already-enabled slot with our type, early exit
+		if( effect.type == effectType )
+		{
+			return effect;
+		}
+
+		// Found empty effect slot, so let's enable it as our type
+		if( effect.type < 0 )
+		{
+			effect.type = effectType;
+			if( effectFunctions[effectType].init != nullptr ) { effectFunctions[effectType].init( effect ); }
+			return effect;
+		}
+	}
+
+	AssertMsg( true, "Failed to find effect id!" );
+	return effects[0]; // Unreachable
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SoundHandle::is_playing() const
+{
+	return audio_voice_state( voice, id ) != nullptr;
+}
+
+
+bool SoundHandle::is_paused() const
+{
+	AudioVoiceState *state = audio_voice_state( voice, id );
+	return state != nullptr && state->bypass;
+}
+
+
+bool SoundHandle::pause( const bool pause ) const
+{
+	AudioVoiceState *state = audio_voice_state( voice, id );
+	if( state == nullptr ) { return false; }
+
+	AudioCommand command { };
+	command.type = AudioCommandType_Pause;
+	command.index = voice;
+	command.id = id;
+	command.flag = pause;
+	if( !audio_command( command ) ) { return false; }
+	state->bypass = pause;
+	return true;
+}
+
+
+bool SoundHandle::stop() const
+{
+	AudioVoiceState *state = audio_voice_state( voice, id );
+	if( state == nullptr ) { return false; }
+
+	// The voice is reusable once the mixer reports it finished
+	AudioCommand command { };
+	command.type = AudioCommandType_Stop;
+	command.index = voice;
+	command.id = id;
+	if( !audio_command( command ) ) { return false; }
+	state->stopping = true;
+	return true;
+}
+
+
+AudioEffects *SoundHandle::operator->() const
+{
+	AudioVoiceState *state = audio_voice_state( voice, id );
+	return state != nullptr ? &state->effects : &NULL_AUDIO_EFFECTS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AudioContext::init( const AudioEffects &effects, const char *name )
+{
+	// Reserve an audio bus
+	audio_events_drain();
+	bus = find_bus();
+	ErrorIf( bus < 0, "AudioLayer init: exceeded bus capacity!" );
 	SysAudio::Bus &audioBus = SysAudio::buses[bus];
-	audioBus.available = true;
+	audioBus.available = false;
+	this->name = name;
+	audioBus.name = name;
+
+	// Stage Effects
+	AudioBusState &state = g_audioQueue.buses[bus];
+	state.staged = effects;
+	state.effects = effects;
+	state.bypass = false;
+	AudioEffectsBinding::bind( state.effects, AUDIO_VOICE_COUNT + bus, 0 );
+
+	AudioCommand command { };
+	command.type = AudioCommandType_BusInit;
+	command.index = bus;
+	audio_command( command );
+};
+
+
+void AudioContext::free()
+{
+	if( bus < 0 || bus >= AUDIO_BUS_COUNT ) { return; }
+	audio_events_drain();
+
+	// The mixer stops our voices, then marks the bus available (AudioEventType_BusFreed)
+	AudioCommand command { };
+	command.type = AudioCommandType_BusFree;
+	command.index = bus;
+	if( !audio_command( command ) ) { return; }
+
+	for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
+	{
+		AudioVoiceState &voice = g_audioQueue.voices[i];
+		if( voice.bus == bus ) { voice.stopping = true; }
+	}
 };
 
 
 AudioEffects *AudioContext::operator->() const
 {
 	Assert( bus > 0 || bus < AUDIO_BUS_COUNT );
-	return &SysAudio::buses[bus].effects;
+	return &g_audioQueue.buses[bus].effects;
 }
 
 
 bool AudioContext::is_paused() const
 {
 	if( bus < 0 || bus >= AUDIO_BUS_COUNT ) { return false; }
-	return SysAudio::buses[bus].bypass;
+	return g_audioQueue.buses[bus].bypass;
 }
 
 
 bool AudioContext::pause( const bool pause ) const
 {
 	if( bus < 0 || bus >= AUDIO_BUS_COUNT ) { return false; }
-	SysAudio::buses[bus].bypass = pause;
+
+	AudioCommand command { };
+	command.type = AudioCommandType_BusPause;
+	command.index = bus;
+	command.flag = pause;
+	if( !audio_command( command ) ) { return false; }
+	g_audioQueue.buses[bus].bypass = pause;
 	return true;
 }
 
 
-SoundHandle AudioContext::play_sound( const u32 sound, const AudioEffects &effects )
+SoundHandle AudioContext::play_sound( const u32 sound, const AudioEffects &effects, const int priority )
 {
 	Assert( sound < Assets::soundCount );
 	Assert( bus >= 0 || bus < AUDIO_BUS_COUNT );
 	const i16 *const samples = &SysAudio::g_AUDIO_SAMPLES[Assets::sounds[sound].sampleOffset];
 	const u32 samplesCount = Assets::sounds[sound].sampleCount;
 	const int channels = Assets::sounds[sound].channels;
+	const AudioFormat format = static_cast<AudioFormat>( Assets::sounds[sound].format );
 #if COMPILE_DEBUG
 	const char *name = Assets::sounds[sound].name;
 #else
 	const char *name = "";
 #endif
-	return SysAudio::play_sound( bus, samples, samplesCount, channels, effects, name );
+	return SysAudio::play_sound( bus, samples, samplesCount, channels, effects, name, format, priority );
+}
+
+
+SoundHandle AudioContext::play_song( const u32 song, const AudioEffects &effects, const bool loop )
+{
+	Assert( song < Assets::songCount );
+	Assert( bus >= 0 || bus < AUDIO_BUS_COUNT );
+#if COMPILE_DEBUG
+	const char *name = Assets::songs[song].name;
+#else
+	const char *name = "";
+#endif
+	return SysAudio::play_song( bus, Assets::songs[song], loop, effects, name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -835,7 +2650,7 @@ static void audio_time_string( char *buffer, const usize size,
 {
 	// Total Time
 	char timeTotal[32];
-	const usize secondsTotal = sampleCount / 44100 / sizeof( i16 ) / channels;
+	const usize secondsTotal = sampleCount / AUDIO_SAMPLE_RATE / sizeof( i16 ) / channels;
 	{
 		const u32 minutes = static_cast<u32>( secondsTotal / 60 );
 		const u32 seconds = static_cast<u32>( secondsTotal % 60 );
@@ -882,11 +2697,34 @@ static void audio_draw_label_value( const float x, const float y, const int widt
 intv2 SysAudio::draw( const Delta delta, const float x, const float y )
 {
 	intv2 dimensions = { 0, 0 };
+	audio_events_drain();
+
+	// Command Queue
+	draw_text_f( font, fontSizeLabel, x, y, c_white,
+		"Commands: %u queued, %u drained (peak %u), %.1f us drain (peak %.1f us), %u dropped",
+		static_cast<u32>( g_audioQueue.commands.count() ), atomic_load( &g_audioQueue.drainDepth ),
+		atomic_load( &g_audioQueue.drainDepthPeak ), atomic_load( &g_audioQueue.drainNs ) * 0.001f,
+		atomic_load( &g_audioQueue.drainNsPeak ) * 0.001f, g_audioQueue.commandsDropped );
+	draw_text_f( font, fontSizeLabel, x, y + 16.0f, c_white, "Master: %.2f L, %.2f R (%u meters dropped)",
+		g_audioQueue.meter[0], g_audioQueue.meter[1], atomic_load( &g_audioQueue.metersDropped ) );
+
+	// Streams
+	const StreamStatistics streams = stream_statistics();
+	draw_text_f( font, fontSizeLabel, x, y + 32.0f, c_white,
+		"Streams: %u/%d playing, %u blocks read (peak %.1f us), %u underruns, %u read errors",
+		streams.playing, AUDIO_STREAM_COUNT, streams.blocksRead, streams.readNsPeak * 0.001f, streams.underruns,
+		streams.readErrors );
+
+	// Voices
+	const VoiceStatistics voices = voice_statistics();
+	draw_text_f( font, fontSizeLabel, x, y + 48.0f, c_white, "Voices: %u/%d playing, %u/%d real, %u demotions",
+		voices.playing, AUDIO_VOICE_COUNT, voices.real, AUDIO_VOICE_REAL_COUNT, voices.demotions );
+	dimensions.y = 72;
 
 	for( int i = 0; i < AUDIO_BUS_COUNT; i++ )
 	{
 		float dX = x + i * 224;
-		float dY = y;
+		float dY = y + 72.0f;
 		if( !draw_bus( delta, i, dX, dY ) ) { continue; }
 
 		const int width = ( i + 1 ) * 224;
@@ -914,7 +2752,7 @@ bool SysAudio::draw_bus( const Delta delta, const int bus, float &x, float &y )
 
 	// Effects
 	x += 16.0f;
-	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ ) { draw_effect( delta, audioBus.effects[i], x, y ); }
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ ) { draw_effect( delta, g_audioQueue.buses[bus].effects[i], x, y ); }
 	x -= 16.0f;
 	y += 4.0f;
 
@@ -925,8 +2763,7 @@ bool SysAudio::draw_bus( const Delta delta, const int bus, float &x, float &y )
 
 		for( int i = 0; i < AUDIO_VOICE_COUNT; i++ )
 		{
-			const Voice &audioVoice = voices[i];
-			if( audioVoice.bus != bus ) { continue; }
+			if( g_audioQueue.voices[i].bus != bus ) { continue; }
 			hasVoices |= draw_voice( delta, i, x, y );
 			y += 4.0f;
 		}
@@ -945,26 +2782,29 @@ bool SysAudio::draw_bus( const Delta delta, const int bus, float &x, float &y )
 
 bool SysAudio::draw_voice( const Delta delta, const int voice, float &x, float &y )
 {
-	Voice &audioVoice = voices[voice];
-	if( audioVoice.bus < 0 ) { return false; }
+	// Game-side state & the mixer's published progress (see audio_voices_publish)
+	AudioVoiceState &state = g_audioQueue.voices[voice];
+	if( state.bus < 0 ) { return false; }
+	const u32 display = atomic_load( &g_audioVoices.display[voice] );
+	const bool real = ( display & AUDIO_VOICE_DISPLAY_REAL ) != 0;
 
 	// Widget State
 	const int widgetWidth = 192;
 
 	// Voice Label
-	const char *labelFormat = audioVoice.name[0] == '\0' ? "v%d" : "v%d: ";
+	const char *labelFormat = state.name[0] == '\0' ? "v%d" : "v%d: ";
 	const intv2 labelDimensions = text_dimensions_f( font, fontSizeLabel, labelFormat, voice );
-	draw_text_f( font, fontSizeLabel, x, y, c_white, labelFormat, voice );
-	draw_text( font, fontSizeLabel, x + labelDimensions.x, y, c_yellow, audioVoice.name );
+	draw_text_f( font, fontSizeLabel, x, y, real ? c_white : c_gray, labelFormat, voice );
+	draw_text( font, fontSizeLabel, x + labelDimensions.x, y, real ? c_yellow : c_gray, state.name );
 	y += 16.0f;
 
 	// Progress Bar
-	const float progress = audioVoice.position / audioVoice.samplesCount;
+	const float progress = static_cast<float>( display & 0xFFFF ) / 65535.0f;
 	draw_progress_bar( x, y, widgetWidth, 10.0f, progress, c_dkgray, c_white );
 	y += 16.0f;
 
 	// Effects
-	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ ) { draw_effect( delta, audioVoice.effects[i], x, y ); }
+	for( int i = 0; i < SysAudio::EFFECTTYPE_COUNT; i++ ) { draw_effect( delta, state.effects[i], x, y ); }
 	y += 4.0f;
 
 	return true;
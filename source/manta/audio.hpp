@@ -2,6 +2,8 @@
 
 #include <core/types.hpp>
 #include <core/debug.hpp>
+#include <core/memory.hpp>
+#include <core/adpcm.hpp>
 
 #include <manta/audio.tuning.hpp>
 
@@ -23,12 +25,88 @@ namespace SysAudio
 
 	extern i16 *g_AUDIO_SAMPLES; // TODO: refactor
 
+	// Device rate, set by init_backend() before the first mix (assets play at AUDIO_SAMPLE_RATE and are resampled)
+	extern u32 sampleRate;
+
 	extern bool init();
 	extern bool free();
 	extern bool init_backend();
 	extern bool free_backend();
+	extern bool init_streams();
+	extern bool free_streams();
+	extern bool init_workers( const u32 count );
+	extern bool free_workers();
 	extern void audio_mixer( i16 *output, u32 frames );
 
+	struct StreamStatistics
+	{
+		u32 playing;     // Streams claimed by voices
+		u32 underruns;   // Mixer periods that ran out of read-ahead
+		u32 blocksRead;  // Blocks read from disk
+		u32 readNsPeak;  // Slowest block read
+		u32 readErrors;  // Blocks that failed to read (played as silence)
+	};
+
+	extern StreamStatistics stream_statistics();
+
+	struct VoiceStatistics
+	{
+		u32 playing;    // Voices playing (real & virtual)
+		u32 real;       // Voices mixed by the last pass
+		u32 demotions;  // Real voices made virtual (outranked or fell silent)
+	};
+
+	extern VoiceStatistics voice_statistics();
+
+	// Accumulated by audio_mixer: each period's time against the duration of audio it produced (its budget)
+	struct MixerStatistics
+	{
+		u32 workers;        // Mixing threads besides the audio thread (see init_workers)
+		u32 periods;        // audio_mixer calls that mixed frames
+		u32 parallel;       // Periods mixed with the workers
+		u32 overBudget;     // Periods that took longer than their audio lasts
+		u32 deadlineMisses; // Parallel periods still waiting on workers at AUDIO_MIX_DEADLINE
+		u32 workerTasks;    // Voice group & bus tasks run by workers
+		u32 usLast;         // Last period time
+		u32 usPeak;
+		u32 budgetUsLast;   // Last period duration
+		u32 loadPeak;       // Percent of budget
+		u64 usTotal;
+		u64 budgetUsTotal;
+	};
+
+	extern MixerStatistics mixer_statistics();
+	extern void mixer_statistics_reset();
+
+	// Accumulated by audio_mixer when AUDIO_PROFILER is enabled (read while the mixer is idle). Stage times are summed over
+	// mixing threads
+	struct MixerProfile
+	{
+		u64 frames;      // Frames mixed
+		u32 periods;     // audio_mixer calls
+		double commands; // Seconds: draining game thread commands
+		double voices;   // Seconds: voice selection, source reads (resampling, ADPCM, streams), virtual voices
+		double effects;  // Seconds: per-voice effects
+		double buses;    // Seconds: voice & bus accumulation, per-bus effects
+		double master;   // Seconds: metering & i16 conversion
+	};
+
+#if AUDIO_PROFILER
+	extern MixerProfile mixer_profile();
+	extern void mixer_profile_reset();
+#endif
+
+#if AUDIO_OFFLINE
+	// Offline backend: the mixer only runs inside offline_render(), on the calling thread, in periods of
+	// AUDIO_OFFLINE_PERIOD_FRAMES. Output goes to the current sink (discarded until one is set)
+	extern void offline_sink_discard();
+	extern void offline_sink_memory( i16 *buffer, const u32 frames );
+	extern bool offline_sink_wav( const char *path );
+	extern u64 offline_sink_frames(); // Frames written to the current sink
+	extern void offline_render( const u32 frames );
+	extern void offline_sample_rate( const u32 rate ); // Render rate (effects started afterwards use it)
+#endif
+
 #if COMPILE_DEBUG
 	extern intv2 draw( const Delta delta, const float x, const float y );
 	extern bool draw_bus( const Delta delta, const int voice, float &x, float &y );
@@ -107,6 +185,7 @@ namespace SysAudio
 		float b[LPF_ORDER + 1];
 		float omega0;
 		float dt;
+		float cutoff; // Cutoff the coefficients were computed for
 	};
 
 
@@ -141,6 +220,10 @@ namespace SysAudio
 		float width;
 		float mode;
 
+		// Parameters the internal values were computed for
+		float parameters[EFFECTPARAM_REVERB_COUNT];
+		bool parametersValid;
+
 		// EffectStateReverbComb Filter
 		EffectStateReverbComb combL[SysAudioTuning::numCombs];
 		EffectStateReverbComb combR[SysAudioTuning::numCombs];
@@ -150,49 +233,55 @@ namespace SysAudio
 		EffectStateReverbAllPass allpassR[SysAudioTuning::numAllpasses];
 
 		// Buffers for the combs
-		float bufcombL1[SysAudioTuning::combTuningL1];
-		float bufcombR1[SysAudioTuning::combTuningR1];
-		float bufcombL2[SysAudioTuning::combTuningL2];
-		float bufcombR2[SysAudioTuning::combTuningR2];
-		float bufcombL3[SysAudioTuning::combTuningL3];
-		float bufcombR3[SysAudioTuning::combTuningR3];
-		float bufcombL4[SysAudioTuning::combTuningL4];
-		float bufcombR4[SysAudioTuning::combTuningR4];
-		float bufcombL5[SysAudioTuning::combTuningL5];
-		float bufcombR5[SysAudioTuning::combTuningR5];
-		float bufcombL6[SysAudioTuning::combTuningL6];
-		float bufcombR6[SysAudioTuning::combTuningR6];
-		float bufcombL7[SysAudioTuning::combTuningL7];
-		float bufcombR7[SysAudioTuning::combTuningR7];
-		float bufcombL8[SysAudioTuning::combTuningL8];
-		float bufcombR8[SysAudioTuning::combTuningR8];
+		float bufcombL1[SysAudioTuning::scaled( SysAudioTuning::combTuningL1, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR1[SysAudioTuning::scaled( SysAudioTuning::combTuningR1, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL2[SysAudioTuning::scaled( SysAudioTuning::combTuningL2, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR2[SysAudioTuning::scaled( SysAudioTuning::combTuningR2, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL3[SysAudioTuning::scaled( SysAudioTuning::combTuningL3, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR3[SysAudioTuning::scaled( SysAudioTuning::combTuningR3, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL4[SysAudioTuning::scaled( SysAudioTuning::combTuningL4, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR4[SysAudioTuning::scaled( SysAudioTuning::combTuningR4, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL5[SysAudioTuning::scaled( SysAudioTuning::combTuningL5, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR5[SysAudioTuning::scaled( SysAudioTuning::combTuningR5, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL6[SysAudioTuning::scaled( SysAudioTuning::combTuningL6, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR6[SysAudioTuning::scaled( SysAudioTuning::combTuningR6, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL7[SysAudioTuning::scaled( SysAudioTuning::combTuningL7, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR7[SysAudioTuning::scaled( SysAudioTuning::combTuningR7, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombL8[SysAudioTuning::scaled( SysAudioTuning::combTuningL8, AUDIO_SAMPLE_RATE_MAX )];
+		float bufcombR8[SysAudioTuning::scaled( SysAudioTuning::combTuningR8, AUDIO_SAMPLE_RATE_MAX )];
 
 		// Buffers for the allpasses
-		float bufallpassL1[SysAudioTuning::allpassTuningL1];
-		float bufallpassR1[SysAudioTuning::allpassTuningR1];
-		float bufallpassL2[SysAudioTuning::allpassTuningL2];
-		float bufallpassR2[SysAudioTuning::allpassTuningR2];
-		float bufallpassL3[SysAudioTuning::allpassTuningL3];
-		float bufallpassR3[SysAudioTuning::allpassTuningR3];
-		float bufallpassL4[SysAudioTuning::allpassTuningL4];
-		float bufallpassR4[SysAudioTuning::allpassTuningR4];
+		float bufallpassL1[SysAudioTuning::scaled( SysAudioTuning::allpassTuningL1, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassR1[SysAudioTuning::scaled( SysAudioTuning::allpassTuningR1, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassL2[SysAudioTuning::scaled( SysAudioTuning::allpassTuningL2, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassR2[SysAudioTuning::scaled( SysAudioTuning::allpassTuningR2, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassL3[SysAudioTuning::scaled( SysAudioTuning::allpassTuningL3, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassR3[SysAudioTuning::scaled( SysAudioTuning::allpassTuningR3, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassL4[SysAudioTuning::scaled( SysAudioTuning::allpassTuningL4, AUDIO_SAMPLE_RATE_MAX )];
+		float bufallpassR4[SysAudioTuning::scaled( SysAudioTuning::allpassTuningR4, AUDIO_SAMPLE_RATE_MAX )];
 	};
 
 
+	// Handle into a pooled effect state (EffectStateReverb)
+	constexpr u16 EFFECT_STATE_NONE = U16_MAX;
+
+
 	struct Effect
 	{
 		int type = -1;
 		bool bypass = false;
 		EffectParameter parameters[EFFECTPARAM_COUNT_MAX];
 
+		// Heavy state is taken from a pool when the effect first runs in the mixer
+		u16 state = EFFECT_STATE_NONE;
 		union
 		{
 			EffectStateCore stateGain;
 			EffectStateLowpass stateLowpass;
-			EffectStateReverb stateReverb;
 		};
 
 		float get_parameter( const EffectParam param, const bool incrementTime = false );
+		bool parameter_ramp( const EffectParam param, const u32 frames, float &outValue, float &outStep );
 		void set_parameter( const EffectParam param, const float value );
 		void set_parameter( const EffectParam param, const float value, const usize timeMS );
 		void set_parameter( const EffectParam param, const float valueFrom, const float valueTo, const usize timeMS );
@@ -215,11 +304,13 @@ namespace SysAudio
 	{ \
 		SysAudio::Effect &effect = find_effect( effectType ); \
 		effect.set_parameter( effectParam, value, timeMS ); \
+		submit( effectType, effectParam, value, value, timeMS, false ); \
 	} \
 	void AudioEffects::set_##name( const float valueFrom, const float valueTo, const usize timeMS ) \
 	{ \
 		SysAudio::Effect &effect = find_effect( effectType ); \
 		effect.set_parameter( effectParam, valueFrom, valueTo, timeMS ); \
+		submit( effectType, effectParam, valueFrom, valueTo, timeMS, true ); \
 	} \
 	float AudioEffects::get_##name() \
 	{ \
@@ -232,6 +323,7 @@ namespace SysAudio
 	{ \
 		SysAudio::Effect &effect = find_effect( effectType ); \
 		effect.set_parameter( effectParam, value, 0.0f ); \
+		submit( effectType, effectParam, value, value, 0, false ); \
 	} \
 	float AudioEffects::get_##name() \
 	{ \
@@ -245,6 +337,8 @@ class AudioEffects
 {
 _PUBLIC:
 	AudioEffects() { init(); }
+	AudioEffects( const AudioEffects &other ) { memory_copy( effects, other.effects, sizeof( effects ) ); }
+	AudioEffects &operator=( const AudioEffects &other ) { memory_copy( effects, other.effects, sizeof( effects ) ); return *this; }
     SysAudio::Effect &operator[]( const usize index ) { return effects[index]; }
 	const SysAudio::Effect &operator[]( const usize index ) const { return effects[index]; }
 
@@ -264,9 +358,16 @@ _PUBLIC:
 	__AUDIO_EFFECT_PARAM_GET_SET_DECL( reverb_width )
 
 _PRIVATE:
+	friend struct AudioEffectsBinding;
 	void init();
 	SysAudio::Effect &find_effect( SysAudio::EffectType effect );
+	void submit( const SysAudio::EffectType type, const SysAudio::EffectParam param, const float valueFrom,
+		const float valueTo, const usize timeMS, const bool ranged );
 	SysAudio::Effect effects[SysAudio::EFFECTTYPE_COUNT];
+
+	// Game-side copies of playing voices & buses forward setters to the mixer (copies are never bound)
+	int target = -1;
+	int targetId = 0;
 };
 
 
@@ -303,7 +404,8 @@ _PUBLIC:
 
 	AudioEffects *operator->() const;
 
-	SoundHandle play_sound( const u32 sound, const AudioEffects &effects = { } );
+	SoundHandle play_sound( const u32 sound, const AudioEffects &effects = { }, const int priority = 0 );
+	SoundHandle play_song( const u32 song, const AudioEffects &effects = { }, const bool loop = false );
 
 _PUBLIC:
 	const char *name;
@@ -316,31 +418,43 @@ _PRIVATE:
 
 namespace SysAudio
 {
+	// Mixer thread only (staged by the game thread while the voice is free)
 	struct Voice
 	{
 		int bus = -1;
 		int id = 0;
 		bool bypass = false;
-		const char *name = "";
 
 		float position = 0.0f;
 		int channels = 1;
 		const i16 *samples = nullptr;
-		u32 samplesCount = 0;
+		u32 samplesCount = 0;           // Decoded samples
+		AudioFormat format = AudioFormat_PCM16; // AudioFormat_ADPCM: 'samples' holds encoded blocks
+		int stream = -1; // Songs: streamed blocks replace 'samples'
 		AudioEffects effects;
+
+		int priority = 0; // Outranks audibility when choosing real voices (sounds stay below streamed songs)
+		int real = -1;    // Real voice slot (-1: virtual)
+		int busPrev = -1; // Bus voice list
+		int busNext = -1;
 	};
 
+	// Game thread only: available, name
 	struct Bus
 	{
 		bool available = true;
 		bool bypass = false;
 		const char *name = "";
+		int voiceFirst = -1; // Mixer thread only: voices playing on this bus
 
 		AudioEffects effects;
 	};
 
 	extern SoundHandle play_sound( const int bus, const i16 *const samples, const u32 samplesCount, const int channels,
-	                               const AudioEffects &effects, const char *name );
+	                               const AudioEffects &effects, const char *name,
+	                               const AudioFormat format = AudioFormat_PCM16, const int priority = 0 );
+	extern SoundHandle play_song( const int bus, const DiskSong &song, const bool loop, const AudioEffects &effects,
+	                              const char *name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
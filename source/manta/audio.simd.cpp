@@ -0,0 +1,678 @@
+#include <manta/audio.simd.hpp>
+
+#include <core/resample.hpp>
+
+#include <vendor/simd.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static constexpr float SCALE_I16_TO_FLOAT = 1.0f / I16_MAX;
+static constexpr float SCALE_FLOAT_TO_I16 = static_cast<float>( I16_MAX );
+
+
+// Sinc kernel: cutoff below the source Nyquist rate (the transition band of 8 taps is wide)
+static constexpr double MIX_SINC_CUTOFF = 0.9;
+static constexpr double MIX_SINC_BETA = 6.0;
+static constexpr i32 MIX_SINC_BEFORE = MIX_SINC_TAPS / 2 - 1; // Taps before the read frame
+
+struct MixSincTable
+{
+	// Per phase: coefficients, then deltas to the next phase (stereo: each coefficient twice, for L & R)
+	alignas( 32 ) float mono[MIX_SINC_PHASES][2][MIX_SINC_TAPS];
+	alignas( 32 ) float stereo[MIX_SINC_PHASES][2][MIX_SINC_TAPS * 2];
+};
+
+
+static MixSincTable mix_sinc_table()
+{
+	float kernel[( MIX_SINC_PHASES + 1 ) * MIX_SINC_TAPS];
+	resample_sinc_kernel( kernel, MIX_SINC_TAPS, MIX_SINC_PHASES, MIX_SINC_CUTOFF, MIX_SINC_BETA );
+
+	MixSincTable table;
+	for( u32 p = 0; p < MIX_SINC_PHASES; p++ )
+	{
+		for( u32 j = 0; j < MIX_SINC_TAPS; j++ )
+		{
+			const float coefficient = kernel[p * MIX_SINC_TAPS + j];
+			const float delta = kernel[( p + 1 ) * MIX_SINC_TAPS + j] - coefficient;
+			table.mono[p][0][j] = coefficient;
+			table.mono[p][1][j] = delta;
+			table.stereo[p][0][j * 2 + 0] = coefficient;
+			table.stereo[p][0][j * 2 + 1] = coefficient;
+			table.stereo[p][1][j * 2 + 0] = delta;
+			table.stereo[p][1][j * 2 + 1] = delta;
+		}
+	}
+	return table;
+}
+
+static const MixSincTable g_sinc = mix_sinc_table();
+
+
+struct MixSincTap
+{
+	i32 first; // First source frame read
+	u32 phase;
+	float t;   // Interpolation between 'phase' and the next
+};
+
+
+static inline MixSincTap sinc_tap( const float position, const float step, const u32 k )
+{
+	const float p = position + static_cast<float>( k ) * step;
+	const i32 index = static_cast<i32>( p );
+	const float phase = ( p - static_cast<float>( index ) ) * MIX_SINC_PHASES;
+	const u32 row = static_cast<u32>( phase ) < MIX_SINC_PHASES - 1 ? static_cast<u32>( phase ) : MIX_SINC_PHASES - 1;
+	return MixSincTap { index - MIX_SINC_BEFORE, row, phase - static_cast<float>( row ) };
+}
+
+
+static inline bool sinc_unit( const float position, const float step )
+{
+	return step == 1.0f && position == static_cast<float>( static_cast<i32>( position ) );
+}
+
+
+static inline u32 sinc_unit_frames( const i32 end, const float position, const u32 frames )
+{
+	// Unit step: frames that copy the source (the rest read past 'end' and are silent)
+	const i32 index = static_cast<i32>( position );
+	if( index >= end ) { return 0; }
+	return static_cast<u32>( end - index ) < frames ? static_cast<u32>( end - index ) : frames;
+}
+
+
+static void copy_mono_scalar( float *output, const i16 *samples, const u32 first, const u32 frames )
+{
+	for( u32 k = first; k < frames; k++ )
+	{
+		const float sample = samples[k] * SCALE_I16_TO_FLOAT;
+		output[k * 2 + 0] = sample;
+		output[k * 2 + 1] = sample;
+	}
+}
+
+
+static void silence( float *output, const u32 first, const u32 frames )
+{
+	for( u32 i = first * 2; i < frames * 2; i++ ) { output[i] = 0.0f; }
+}
+
+
+static void resample_sinc_mono_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 first, const u32 frames )
+{
+	for( u32 k = first; k < frames; k++ )
+	{
+		const MixSincTap tap = sinc_tap( position, step, k );
+		const float *coefficients = g_sinc.mono[tap.phase][0];
+		const float *deltas = g_sinc.mono[tap.phase][1];
+		float sum = 0.0f;
+		for( i32 j = 0; j < MIX_SINC_TAPS; j++ )
+		{
+			const i32 index = tap.first + j;
+			if( index < begin || index >= end ) { continue; }
+			sum += samples[index] * ( coefficients[j] + deltas[j] * tap.t );
+		}
+		output[k * 2 + 0] = sum * SCALE_I16_TO_FLOAT;
+		output[k * 2 + 1] = sum * SCALE_I16_TO_FLOAT;
+	}
+}
+
+
+static void resample_sinc_stereo_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 first, const u32 frames )
+{
+	for( u32 k = first; k < frames; k++ )
+	{
+		const MixSincTap tap = sinc_tap( position, step, k );
+		const float *coefficients = g_sinc.mono[tap.phase][0];
+		const float *deltas = g_sinc.mono[tap.phase][1];
+		float l = 0.0f;
+		float r = 0.0f;
+		for( i32 j = 0; j < MIX_SINC_TAPS; j++ )
+		{
+			const i32 index = tap.first + j;
+			if( index < begin || index >= end ) { continue; }
+			const float coefficient = coefficients[j] + deltas[j] * tap.t;
+			l += samples[index * 2 + 0] * coefficient;
+			r += samples[index * 2 + 1] * coefficient;
+		}
+		output[k * 2 + 0] = l * SCALE_I16_TO_FLOAT;
+		output[k * 2 + 1] = r * SCALE_I16_TO_FLOAT;
+	}
+}
+
+
+static void sinc_range( const i32 begin, const i32 end, const float position, const float step, const u32 frames,
+	u32 &outFirst, u32 &outLast )
+{
+	// Frames [first, last) read every tap inside [begin, end) (positions increase, so edge frames lead & trail)
+	outFirst = SysAudio::mix_frames_before( position, step, static_cast<float>( begin + MIX_SINC_BEFORE ), frames );
+	outLast = SysAudio::mix_frames_before( position, step, static_cast<float>( end - MIX_SINC_TAPS / 2 ), frames );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+u32 SysAudio::mix_frames_before( const float position, const float step, const float limit, const u32 frames )
+{
+	if( !( position < limit ) ) { return 0; }
+	if( step <= 0.0f ) { return frames; }
+
+	// Estimate, then correct against the exact per-frame positions
+	const float estimate = ( limit - position ) / step;
+	u32 count = estimate >= static_cast<float>( frames ) ? frames : static_cast<u32>( estimate );
+	while( count > 0 && position + static_cast<float>( count - 1 ) * step >= limit ) { count--; }
+	while( count < frames && position + static_cast<float>( count ) * step < limit ) { count++; }
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SysAudio::mix_i16_to_float_scalar( float *output, const i16 *input, const u32 count )
+{
+	for( u32 i = 0; i < count; i++ ) { output[i] = input[i] * SCALE_I16_TO_FLOAT; }
+}
+
+
+void SysAudio::mix_resample_sinc_mono_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 frames )
+{
+	if( sinc_unit( position, step ) && position >= static_cast<float>( begin ) )
+	{
+		const u32 count = sinc_unit_frames( end, position, frames );
+		copy_mono_scalar( output, &samples[static_cast<i32>( position )], 0, count );
+		silence( output, count, frames );
+		return;
+	}
+
+	resample_sinc_mono_scalar( output, samples, begin, end, position, step, 0, frames );
+}
+
+
+void SysAudio::mix_resample_sinc_stereo_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 frames )
+{
+	if( sinc_unit( position, step ) && position >= static_cast<float>( begin ) )
+	{
+		const u32 count = sinc_unit_frames( end, position, frames );
+		mix_i16_to_float_scalar( output, &samples[static_cast<i32>( position ) * 2], count * 2 );
+		silence( output, count, frames );
+		return;
+	}
+
+	resample_sinc_stereo_scalar( output, samples, begin, end, position, step, 0, frames );
+}
+
+
+void SysAudio::mix_accumulate_scalar( float *output, const float *input, const u32 count )
+{
+	for( u32 i = 0; i < count; i++ ) { output[i] += input[i]; }
+}
+
+
+void SysAudio::mix_gain_scalar( float *samples, const u32 count, const float gain )
+{
+	for( u32 i = 0; i < count; i++ ) { samples[i] *= gain; }
+}
+
+
+void SysAudio::mix_gain_ramp_scalar( float *samples, const u32 frames, const float gain, const float step )
+{
+	for( u32 k = 0; k < frames; k++ )
+	{
+		const float g = gain + static_cast<float>( k ) * step;
+		samples[k * 2 + 0] *= g;
+		samples[k * 2 + 1] *= g;
+	}
+}
+
+
+void SysAudio::mix_float_to_i16_scalar( i16 *output, const float *input, const u32 count )
+{
+	for( u32 i = 0; i < count; i++ )
+	{
+		const float sample = input[i] < -1.0f ? -1.0f : ( input[i] > 1.0f ? 1.0f : input[i] );
+		output[i] = static_cast<i16>( sample * SCALE_FLOAT_TO_I16 );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SysAudio::mix_i16_to_float( float *output, const i16 *input, const u32 count )
+{
+	u32 i = 0;
+#if SIMD_AVX2
+	const __m256 scale = _mm256_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const __m256i x = _mm256_cvtepi16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( input + i ) ) );
+		_mm256_storeu_ps( output + i, _mm256_mul_ps( _mm256_cvtepi32_ps( x ), scale ) );
+	}
+#elif SIMD_SSE2
+	const __m128 scale = _mm_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i *>( input + i ) );
+		const __m128i lo = _mm_srai_epi32( _mm_unpacklo_epi16( x, x ), 16 );
+		const __m128i hi = _mm_srai_epi32( _mm_unpackhi_epi16( x, x ), 16 );
+		_mm_storeu_ps( output + i + 0, _mm_mul_ps( _mm_cvtepi32_ps( lo ), scale ) );
+		_mm_storeu_ps( output + i + 4, _mm_mul_ps( _mm_cvtepi32_ps( hi ), scale ) );
+	}
+#elif SIMD_NEON
+	const float32x4_t scale = vdupq_n_f32( SCALE_I16_TO_FLOAT );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const int16x8_t x = vld1q_s16( input + i );
+		vst1q_f32( output + i + 0, vmulq_f32( vcvtq_f32_s32( vmovl_s16( vget_low_s16( x ) ) ), scale ) );
+		vst1q_f32( output + i + 4, vmulq_f32( vcvtq_f32_s32( vmovl_s16( vget_high_s16( x ) ) ), scale ) );
+	}
+#endif
+	for( ; i < count; i++ ) { output[i] = input[i] * SCALE_I16_TO_FLOAT; }
+}
+
+
+static void copy_mono( float *output, const i16 *samples, const u32 frames )
+{
+	// Mono source frames to stereo output frames (sinc unit step)
+	u32 k = 0;
+#if SIMD_AVX2
+	const __m256 scale = _mm256_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 8 <= frames; k += 8 )
+	{
+		const __m256i x = _mm256_cvtepi16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( samples + k ) ) );
+		const __m256 s = _mm256_mul_ps( _mm256_cvtepi32_ps( x ), scale );
+		const __m256 lo = _mm256_unpacklo_ps( s, s ); // 0 0 1 1 | 4 4 5 5
+		const __m256 hi = _mm256_unpackhi_ps( s, s ); // 2 2 3 3 | 6 6 7 7
+		_mm256_storeu_ps( output + k * 2 + 0, _mm256_permute2f128_ps( lo, hi, 0x20 ) );
+		_mm256_storeu_ps( output + k * 2 + 8, _mm256_permute2f128_ps( lo, hi, 0x31 ) );
+	}
+#elif SIMD_SSE2
+	const __m128 scale = _mm_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 8 <= frames; k += 8 )
+	{
+		const __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i *>( samples + k ) );
+		const __m128 lo = _mm_mul_ps( _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( x, x ), 16 ) ), scale );
+		const __m128 hi = _mm_mul_ps( _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( x, x ), 16 ) ), scale );
+		_mm_storeu_ps( output + k * 2 + 0, _mm_unpacklo_ps( lo, lo ) );
+		_mm_storeu_ps( output + k * 2 + 4, _mm_unpackhi_ps( lo, lo ) );
+		_mm_storeu_ps( output + k * 2 + 8, _mm_unpacklo_ps( hi, hi ) );
+		_mm_storeu_ps( output + k * 2 + 12, _mm_unpackhi_ps( hi, hi ) );
+	}
+#elif SIMD_NEON
+	const float32x4_t scale = vdupq_n_f32( SCALE_I16_TO_FLOAT );
+	for( ; k + 8 <= frames; k += 8 )
+	{
+		const int16x8_t x = vld1q_s16( samples + k );
+		const float32x4_t lo = vmulq_f32( vcvtq_f32_s32( vmovl_s16( vget_low_s16( x ) ) ), scale );
+		const float32x4_t hi = vmulq_f32( vcvtq_f32_s32( vmovl_s16( vget_high_s16( x ) ) ), scale );
+		vst2q_f32( output + k * 2 + 0, float32x4x2_t { { lo, lo } } );
+		vst2q_f32( output + k * 2 + 8, float32x4x2_t { { hi, hi } } );
+	}
+#endif
+	copy_mono_scalar( output, samples, k, frames );
+}
+
+
+void SysAudio::mix_resample_sinc_mono( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 frames )
+{
+	if( sinc_unit( position, step ) && position >= static_cast<float>( begin ) )
+	{
+		const u32 count = sinc_unit_frames( end, position, frames );
+		copy_mono( output, &samples[static_cast<i32>( position )], count );
+		silence( output, count, frames );
+		return;
+	}
+
+	u32 first, last;
+	sinc_range( begin, end, position, step, frames, first, last );
+	resample_sinc_mono_scalar( output, samples, begin, end, position, step, 0, first );
+	u32 k = first;
+
+#if SIMD_AVX2
+	const __m256 scale = _mm256_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 8 <= last; k += 8 )
+	{
+		__m256 products[8];
+		for( u32 i = 0; i < 8; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const __m256 x = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32(
+				_mm_loadu_si128( reinterpret_cast<const __m128i *>( samples + tap.first ) ) ) );
+			const __m256 c = _mm256_add_ps( _mm256_load_ps( g_sinc.mono[tap.phase][0] ),
+				_mm256_mul_ps( _mm256_load_ps( g_sinc.mono[tap.phase][1] ), _mm256_set1_ps( tap.t ) ) );
+			products[i] = _mm256_mul_ps( x, c );
+		}
+
+		// Horizontal sums: frame i lands in lane i
+		const __m256 s01 = _mm256_hadd_ps( products[0], products[1] );
+		const __m256 s23 = _mm256_hadd_ps( products[2], products[3] );
+		const __m256 s45 = _mm256_hadd_ps( products[4], products[5] );
+		const __m256 s67 = _mm256_hadd_ps( products[6], products[7] );
+		const __m256 s0123 = _mm256_hadd_ps( s01, s23 );
+		const __m256 s4567 = _mm256_hadd_ps( s45, s67 );
+		const __m256 v = _mm256_mul_ps( _mm256_add_ps( _mm256_permute2f128_ps( s0123, s4567, 0x20 ),
+			_mm256_permute2f128_ps( s0123, s4567, 0x31 ) ), scale );
+
+		// Duplicate to stereo
+		const __m256 lo = _mm256_unpacklo_ps( v, v );
+		const __m256 hi = _mm256_unpackhi_ps( v, v );
+		_mm256_storeu_ps( output + k * 2 + 0, _mm256_permute2f128_ps( lo, hi, 0x20 ) );
+		_mm256_storeu_ps( output + k * 2 + 8, _mm256_permute2f128_ps( lo, hi, 0x31 ) );
+	}
+#elif SIMD_SSE2
+	const __m128 scale = _mm_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 4 <= last; k += 4 )
+	{
+		__m128 products[4];
+		for( u32 i = 0; i < 4; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i *>( samples + tap.first ) );
+			const __m128 x0 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( x, x ), 16 ) );
+			const __m128 x1 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( x, x ), 16 ) );
+			const __m128 t = _mm_set1_ps( tap.t );
+			const float *row = g_sinc.mono[tap.phase][0];
+			const __m128 c0 = _mm_add_ps( _mm_load_ps( row + 0 ), _mm_mul_ps( _mm_load_ps( row + MIX_SINC_TAPS + 0 ), t ) );
+			const __m128 c1 = _mm_add_ps( _mm_load_ps( row + 4 ), _mm_mul_ps( _mm_load_ps( row + MIX_SINC_TAPS + 4 ), t ) );
+			products[i] = _mm_add_ps( _mm_mul_ps( x0, c0 ), _mm_mul_ps( x1, c1 ) );
+		}
+
+		// Horizontal sums: frame i lands in lane i
+		const __m128 a = _mm_add_ps( _mm_unpacklo_ps( products[0], products[1] ), _mm_unpackhi_ps( products[0], products[1] ) );
+		const __m128 b = _mm_add_ps( _mm_unpacklo_ps( products[2], products[3] ), _mm_unpackhi_ps( products[2], products[3] ) );
+		const __m128 v = _mm_mul_ps( _mm_add_ps( _mm_movelh_ps( a, b ), _mm_movehl_ps( b, a ) ), scale );
+
+		// Duplicate to stereo
+		_mm_storeu_ps( output + k * 2 + 0, _mm_unpacklo_ps( v, v ) );
+		_mm_storeu_ps( output + k * 2 + 4, _mm_unpackhi_ps( v, v ) );
+	}
+#elif SIMD_NEON
+	const float32x4_t scale = vdupq_n_f32( SCALE_I16_TO_FLOAT );
+	for( ; k + 4 <= last; k += 4 )
+	{
+		float32x4_t products[4];
+		for( u32 i = 0; i < 4; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const int16x8_t x = vld1q_s16( samples + tap.first );
+			const float32x4_t x0 = vcvtq_f32_s32( vmovl_s16( vget_low_s16( x ) ) );
+			const float32x4_t x1 = vcvtq_f32_s32( vmovl_s16( vget_high_s16( x ) ) );
+			const float32x4_t t = vdupq_n_f32( tap.t );
+			const float *row = g_sinc.mono[tap.phase][0];
+			const float32x4_t c0 = vaddq_f32( vld1q_f32( row + 0 ), vmulq_f32( vld1q_f32( row + MIX_SINC_TAPS + 0 ), t ) );
+			const float32x4_t c1 = vaddq_f32( vld1q_f32( row + 4 ), vmulq_f32( vld1q_f32( row + MIX_SINC_TAPS + 4 ), t ) );
+			products[i] = vaddq_f32( vmulq_f32( x0, c0 ), vmulq_f32( x1, c1 ) );
+		}
+
+		// Horizontal sums: frame i lands in lane i
+		const float32x4_t v = vmulq_f32( vpaddq_f32( vpaddq_f32( products[0], products[1] ),
+			vpaddq_f32( products[2], products[3] ) ), scale );
+
+		// Duplicate to stereo
+		const float32x4x2_t stereo = vzipq_f32( v, v );
+		vst1q_f32( output + k * 2 + 0, stereo.val[0] );
+		vst1q_f32( output + k * 2 + 4, stereo.val[1] );
+	}
+#endif
+
+	resample_sinc_mono_scalar( output, samples, begin, end, position, step, k, frames );
+}
+
+
+void SysAudio::mix_resample_sinc_stereo( float *output, const i16 *samples, const i32 begin, const i32 end,
+	const float position, const float step, const u32 frames )
+{
+	if( sinc_unit( position, step ) && position >= static_cast<float>( begin ) )
+	{
+		const u32 count = sinc_unit_frames( end, position, frames );
+		mix_i16_to_float( output, &samples[static_cast<i32>( position ) * 2], count * 2 );
+		silence( output, count, frames );
+		return;
+	}
+
+	u32 first, last;
+	sinc_range( begin, end, position, step, frames, first, last );
+	resample_sinc_stereo_scalar( output, samples, begin, end, position, step, 0, first );
+	u32 k = first;
+
+#if SIMD_AVX2
+	const __m256 scale = _mm256_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 4 <= last; k += 4 )
+	{
+		// Per frame: (l, r) partial sums over taps 0, 2, 4, 6 & 1, 3, 5, 7
+		__m256 products[4];
+		for( u32 i = 0; i < 4; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const i16 *source = samples + tap.first * 2;
+			const __m256 x0 = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32(
+				_mm_loadu_si128( reinterpret_cast<const __m128i *>( source + 0 ) ) ) );
+			const __m256 x1 = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32(
+				_mm_loadu_si128( reinterpret_cast<const __m128i *>( source + 8 ) ) ) );
+			const __m256 t = _mm256_set1_ps( tap.t );
+			const float *row = g_sinc.stereo[tap.phase][0];
+			const __m256 c0 = _mm256_add_ps( _mm256_load_ps( row + 0 ), _mm256_mul_ps( _mm256_load_ps( row + MIX_SINC_TAPS * 2 + 0 ), t ) );
+			const __m256 c1 = _mm256_add_ps( _mm256_load_ps( row + 8 ), _mm256_mul_ps( _mm256_load_ps( row + MIX_SINC_TAPS * 2 + 8 ), t ) );
+			products[i] = _mm256_add_ps( _mm256_mul_ps( x0, c0 ), _mm256_mul_ps( x1, c1 ) );
+		}
+
+		// Fold halves, then tap pairs: frames 0 & 2 in the low lane, 1 & 3 in the high lane
+		const __m256 f01 = _mm256_add_ps( _mm256_permute2f128_ps( products[0], products[1], 0x20 ),
+			_mm256_permute2f128_ps( products[0], products[1], 0x31 ) );
+		const __m256 f23 = _mm256_add_ps( _mm256_permute2f128_ps( products[2], products[3], 0x20 ),
+			_mm256_permute2f128_ps( products[2], products[3], 0x31 ) );
+		const __m256 v = _mm256_add_ps( _mm256_shuffle_ps( f01, f23, _MM_SHUFFLE( 1, 0, 1, 0 ) ),
+			_mm256_shuffle_ps( f01, f23, _MM_SHUFFLE( 3, 2, 3, 2 ) ) );
+		const __m256 ordered = _mm256_castpd_ps( _mm256_permute4x64_pd( _mm256_castps_pd( v ), 0xD8 ) );
+		_mm256_storeu_ps( output + k * 2, _mm256_mul_ps( ordered, scale ) );
+	}
+#elif SIMD_SSE2
+	const __m128 scale = _mm_set1_ps( SCALE_I16_TO_FLOAT );
+	for( ; k + 2 <= last; k += 2 )
+	{
+		// Per frame: (l, r) partial sums over even & odd taps
+		__m128 products[2];
+		for( u32 i = 0; i < 2; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const i16 *source = samples + tap.first * 2;
+			const __m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i *>( source + 0 ) );
+			const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i *>( source + 8 ) );
+			const __m128 t = _mm_set1_ps( tap.t );
+			const float *row = g_sinc.stereo[tap.phase][0];
+			const float *delta = row + MIX_SINC_TAPS * 2;
+			const __m128 x0 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( a, a ), 16 ) );
+			const __m128 x1 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( a, a ), 16 ) );
+			const __m128 x2 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( b, b ), 16 ) );
+			const __m128 x3 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( b, b ), 16 ) );
+			const __m128 c0 = _mm_add_ps( _mm_load_ps( row + 0 ), _mm_mul_ps( _mm_load_ps( delta + 0 ), t ) );
+			const __m128 c1 = _mm_add_ps( _mm_load_ps( row + 4 ), _mm_mul_ps( _mm_load_ps( delta + 4 ), t ) );
+			const __m128 c2 = _mm_add_ps( _mm_load_ps( row + 8 ), _mm_mul_ps( _mm_load_ps( delta + 8 ), t ) );
+			const __m128 c3 = _mm_add_ps( _mm_load_ps( row + 12 ), _mm_mul_ps( _mm_load_ps( delta + 12 ), t ) );
+			products[i] = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x0, c0 ), _mm_mul_ps( x1, c1 ) ),
+				_mm_add_ps( _mm_mul_ps( x2, c2 ), _mm_mul_ps( x3, c3 ) ) );
+		}
+
+		const __m128 v = _mm_add_ps( _mm_movelh_ps( products[0], products[1] ), _mm_movehl_ps( products[1], products[0] ) );
+		_mm_storeu_ps( output + k * 2, _mm_mul_ps( v, scale ) );
+	}
+#elif SIMD_NEON
+	const float32x4_t scale = vdupq_n_f32( SCALE_I16_TO_FLOAT );
+	for( ; k + 2 <= last; k += 2 )
+	{
+		// Per frame: (l, r) partial sums over even & odd taps
+		float32x2_t sums[2];
+		for( u32 i = 0; i < 2; i++ )
+		{
+			const MixSincTap tap = sinc_tap( position, step, k + i );
+			const i16 *source = samples + tap.first * 2;
+			const int16x8_t a = vld1q_s16( source + 0 );
+			const int16x8_t b = vld1q_s16( source + 8 );
+			const float32x4_t t = vdupq_n_f32( tap.t );
+			const float *row = g_sinc.stereo[tap.phase][0];
+			const float *delta = row + MIX_SINC_TAPS * 2;
+			const float32x4_t x0 = vcvtq_f32_s32( vmovl_s16( vget_low_s16( a ) ) );
+			const float32x4_t x1 = vcvtq_f32_s32( vmovl_s16( vget_high_s16( a ) ) );
+			const float32x4_t x2 = vcvtq_f32_s32( vmovl_s16( vget_low_s16( b ) ) );
+			const float32x4_t x3 = vcvtq_f32_s32( vmovl_s16( vget_high_s16( b ) ) );
+			const float32x4_t c0 = vaddq_f32( vld1q_f32( row + 0 ), vmulq_f32( vld1q_f32( delta + 0 ), t ) );
+			const float32x4_t c1 = vaddq_f32( vld1q_f32( row + 4 ), vmulq_f32( vld1q_f32( delta + 4 ), t ) );
+			const float32x4_t c2 = vaddq_f32( vld1q_f32( row + 8 ), vmulq_f32( vld1q_f32( delta + 8 ), t ) );
+			const float32x4_t c3 = vaddq_f32( vld1q_f32( row + 12 ), vmulq_f32( vld1q_f32( delta + 12 ), t ) );
+			const float32x4_t v = vaddq_f32( vaddq_f32( vmulq_f32( x0, c0 ), vmulq_f32( x1, c1 ) ),
+				vaddq_f32( vmulq_f32( x2, c2 ), vmulq_f32( x3, c3 ) ) );
+			sums[i] = vadd_f32( vget_low_f32( v ), vget_high_f32( v ) );
+		}
+		vst1q_f32( output + k * 2, vmulq_f32( vcombine_f32( sums[0], sums[1] ), scale ) );
+	}
+#endif
+
+	resample_sinc_stereo_scalar( output, samples, begin, end, position, step, k, frames );
+}
+
+
+void SysAudio::mix_accumulate( float *output, const float *input, const u32 count )
+{
+	u32 i = 0;
+#if SIMD_AVX2
+	for( ; i + 8 <= count; i += 8 )
+	{
+		_mm256_storeu_ps( output + i, _mm256_add_ps( _mm256_loadu_ps( output + i ), _mm256_loadu_ps( input + i ) ) );
+	}
+#elif SIMD_SSE2
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const __m128 a = _mm_add_ps( _mm_loadu_ps( output + i + 0 ), _mm_loadu_ps( input + i + 0 ) );
+		const __m128 b = _mm_add_ps( _mm_loadu_ps( output + i + 4 ), _mm_loadu_ps( input + i + 4 ) );
+		_mm_storeu_ps( output + i + 0, a );
+		_mm_storeu_ps( output + i + 4, b );
+	}
+#elif SIMD_NEON
+	for( ; i + 4 <= count; i += 4 )
+	{
+		vst1q_f32( output + i, vaddq_f32( vld1q_f32( output + i ), vld1q_f32( input + i ) ) );
+	}
+#endif
+	for( ; i < count; i++ ) { output[i] += input[i]; }
+}
+
+
+void SysAudio::mix_gain( float *samples, const u32 count, const float gain )
+{
+	u32 i = 0;
+#if SIMD_AVX2
+	const __m256 g = _mm256_set1_ps( gain );
+	for( ; i + 8 <= count; i += 8 ) { _mm256_storeu_ps( samples + i, _mm256_mul_ps( _mm256_loadu_ps( samples + i ), g ) ); }
+#elif SIMD_SSE2
+	const __m128 g = _mm_set1_ps( gain );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		_mm_storeu_ps( samples + i + 0, _mm_mul_ps( _mm_loadu_ps( samples + i + 0 ), g ) );
+		_mm_storeu_ps( samples + i + 4, _mm_mul_ps( _mm_loadu_ps( samples + i + 4 ), g ) );
+	}
+#elif SIMD_NEON
+	const float32x4_t g = vdupq_n_f32( gain );
+	for( ; i + 4 <= count; i += 4 ) { vst1q_f32( samples + i, vmulq_f32( vld1q_f32( samples + i ), g ) ); }
+#endif
+	for( ; i < count; i++ ) { samples[i] *= gain; }
+}
+
+
+void SysAudio::mix_gain_ramp( float *samples, const u32 frames, const float gain, const float step )
+{
+	// Frame indices are exact in float, so 'gain + k * step' matches the scalar reference
+	u32 k = 0;
+#if SIMD_AVX2
+	const __m256 g = _mm256_set1_ps( gain );
+	const __m256 s = _mm256_set1_ps( step );
+	__m256 index = _mm256_setr_ps( 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f );
+	const __m256 four = _mm256_set1_ps( 4.0f );
+	for( ; k + 4 <= frames; k += 4 )
+	{
+		const __m256 ramp = _mm256_add_ps( g, _mm256_mul_ps( index, s ) );
+		_mm256_storeu_ps( samples + k * 2, _mm256_mul_ps( _mm256_loadu_ps( samples + k * 2 ), ramp ) );
+		index = _mm256_add_ps( index, four );
+	}
+#elif SIMD_SSE2
+	const __m128 g = _mm_set1_ps( gain );
+	const __m128 s = _mm_set1_ps( step );
+	__m128 index = _mm_setr_ps( 0.0f, 0.0f, 1.0f, 1.0f );
+	const __m128 two = _mm_set1_ps( 2.0f );
+	for( ; k + 2 <= frames; k += 2 )
+	{
+		const __m128 ramp = _mm_add_ps( g, _mm_mul_ps( index, s ) );
+		_mm_storeu_ps( samples + k * 2, _mm_mul_ps( _mm_loadu_ps( samples + k * 2 ), ramp ) );
+		index = _mm_add_ps( index, two );
+	}
+#elif SIMD_NEON
+	const float32x4_t g = vdupq_n_f32( gain );
+	const float32x4_t s = vdupq_n_f32( step );
+	static const float indices[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+	float32x4_t index = vld1q_f32( indices );
+	const float32x4_t two = vdupq_n_f32( 2.0f );
+	for( ; k + 2 <= frames; k += 2 )
+	{
+		const float32x4_t ramp = vaddq_f32( g, vmulq_f32( index, s ) );
+		vst1q_f32( samples + k * 2, vmulq_f32( vld1q_f32( samples + k * 2 ), ramp ) );
+		index = vaddq_f32( index, two );
+	}
+#endif
+	for( ; k < frames; k++ )
+	{
+		const float ramp = gain + static_cast<float>( k ) * step;
+		samples[k * 2 + 0] *= ramp;
+		samples[k * 2 + 1] *= ramp;
+	}
+}
+
+
+void SysAudio::mix_float_to_i16( i16 *output, const float *input, const u32 count )
+{
+	u32 i = 0;
+#if SIMD_AVX2
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	const __m256 minusOne = _mm256_set1_ps( -1.0f );
+	const __m256 scale = _mm256_set1_ps( SCALE_FLOAT_TO_I16 );
+	for( ; i + 16 <= count; i += 16 )
+	{
+		const __m256 a = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( input + i + 0 ), minusOne ), one );
+		const __m256 b = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( input + i + 8 ), minusOne ), one );
+		const __m256i packed = _mm256_packs_epi32( _mm256_cvttps_epi32( _mm256_mul_ps( a, scale ) ),
+			_mm256_cvttps_epi32( _mm256_mul_ps( b, scale ) ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>( output + i ), _mm256_permute4x64_epi64( packed, 0xD8 ) );
+	}
+#elif SIMD_SSE2
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 minusOne = _mm_set1_ps( -1.0f );
+	const __m128 scale = _mm_set1_ps( SCALE_FLOAT_TO_I16 );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const __m128 a = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( input + i + 0 ), minusOne ), one );
+		const __m128 b = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( input + i + 4 ), minusOne ), one );
+		const __m128i packed = _mm_packs_epi32( _mm_cvttps_epi32( _mm_mul_ps( a, scale ) ),
+			_mm_cvttps_epi32( _mm_mul_ps( b, scale ) ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i *>( output + i ), packed );
+	}
+#elif SIMD_NEON
+	const float32x4_t one = vdupq_n_f32( 1.0f );
+	const float32x4_t minusOne = vdupq_n_f32( -1.0f );
+	const float32x4_t scale = vdupq_n_f32( SCALE_FLOAT_TO_I16 );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const float32x4_t a = vminq_f32( vmaxq_f32( vld1q_f32( input + i + 0 ), minusOne ), one );
+		const float32x4_t b = vminq_f32( vmaxq_f32( vld1q_f32( input + i + 4 ), minusOne ), one );
+		const int16x4_t lo = vqmovn_s32( vcvtq_s32_f32( vmulq_f32( a, scale ) ) );
+		const int16x4_t hi = vqmovn_s32( vcvtq_s32_f32( vmulq_f32( b, scale ) ) );
+		vst1q_s16( output + i, vcombine_s16( lo, hi ) );
+	}
+#endif
+	for( ; i < count; i++ )
+	{
+		const float sample = input[i] < -1.0f ? -1.0f : ( input[i] > 1.0f ? 1.0f : input[i] );
+		output[i] = static_cast<i16>( sample * SCALE_FLOAT_TO_I16 );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Mixer kernels (SysAudio::audio_mixer). Buffers are interleaved stereo floats; 'count' is in samples, 'frames' in
+// stereo frames. Each kernel dispatches to AVX2, SSE2, or NEON (see vendor/simd.hpp) with a scalar fallback -- the
+// *_scalar variants are the reference implementations
+//
+// Resampling is windowed-sinc, MIX_SINC_TAPS taps (see core/resample.hpp): frame k filters source frames index - 3 ..
+// index + 4 around 'position + k * step' (mono: samples, stereo: frames), with the coefficients interpolated between
+// MIX_SINC_PHASES phases. Reads outside [begin, end) are silent, so callers holding history before the first frame
+// (ADPCM blocks, stream windows) pass a negative 'begin'. A unit step from a whole frame copies the source
+//
+// Gain ramps scale frame k by 'gain + k * step' (parameter automation, see SysAudio::Effect::parameter_ramp)
+
+#define MIX_SINC_TAPS ( 8 )
+#define MIX_SINC_PHASES ( 64 )
+
+namespace SysAudio
+{
+	extern void mix_i16_to_float( float *output, const i16 *input, const u32 count );
+	extern void mix_resample_sinc_mono( float *output, const i16 *samples, const i32 begin, const i32 end,
+		const float position, const float step, const u32 frames );
+	extern void mix_resample_sinc_stereo( float *output, const i16 *samples, const i32 begin, const i32 end,
+		const float position, const float step, const u32 frames );
+	extern void mix_accumulate( float *output, const float *input, const u32 count );
+	extern void mix_gain( float *samples, const u32 count, const float gain );
+	extern void mix_gain_ramp( float *samples, const u32 frames, const float gain, const float step );
+	extern void mix_float_to_i16( i16 *output, const float *input, const u32 count );
+
+	extern void mix_i16_to_float_scalar( float *output, const i16 *input, const u32 count );
+	extern void mix_resample_sinc_mono_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+		const float position, const float step, const u32 frames );
+	extern void mix_resample_sinc_stereo_scalar( float *output, const i16 *samples, const i32 begin, const i32 end,
+		const float position, const float step, const u32 frames );
+	extern void mix_accumulate_scalar( float *output, const float *input, const u32 count );
+	extern void mix_gain_scalar( float *samples, const u32 count, const float gain );
+	extern void mix_gain_ramp_scalar( float *samples, const u32 frames, const float gain, const float step );
+	extern void mix_float_to_i16_scalar( i16 *output, const float *input, const u32 count );
+
+	// Number of frames k in [0, frames) with 'position + k * step < limit' (step > 0)
+	extern u32 mix_frames_before( const float position, const float step, const float limit, const u32 frames );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -24,10 +24,14 @@ namespace SysAudioTuning
 	constexpr float freezeMode = 0.5f;
 	constexpr int stereoSpread = 23;
 
-	// These values assume 44.1KHz sample rate
-	// they will probably be OK for 48KHz sample rate
-	// but would need scaling for 96KHz (or other) sample rates.
+	// These values assume 44.1KHz sample rate (tuningRate) and are scaled to the device rate (see scaled()).
 	// The values were obtained by listening tests.
+	constexpr unsigned int tuningRate = 44100;
+	constexpr int scaled( const int length, const unsigned int rate )
+	{
+		return static_cast<int>( ( static_cast<unsigned long long>( length ) * rate + tuningRate / 2 ) / tuningRate );
+	}
+
 	constexpr int combTuningL1 = 1116;
 	constexpr int combTuningR1 = 1116 + stereoSpread;
 	constexpr int combTuningL2 = 1188;
@@ -12,31 +12,88 @@
 // The number of channels to output.
 #define CHANNELS 2
 
-// The number of samples per second to output.
-#define SAMPLE_RATE 44100
+// Device rates tried in order (run natively, the mixer resamples to them)
+static const unsigned int SAMPLE_RATES[] = { AUDIO_SAMPLE_RATE, 48000 };
 
 // The minimum acceptable sound latency in milliseconds.
 #define LATENCY_MS 30
 
 // The minimum size of the shared buffer between us and ALSA.
-#define BUFFER_SIZE static_cast<int>( LATENCY_MS * ( SAMPLE_RATE / 1000.0 ) )
+#define BUFFER_SIZE( rate ) static_cast<snd_pcm_uframes_t>( LATENCY_MS * ( ( rate ) / 1000.0 ) )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static bool alsa_set_rate( snd_pcm_t *device, snd_pcm_hw_params_t *hw_params, unsigned int &rate )
+{
+	// Prefer a native rate with ALSA's plugin resampler disabled
+	if( snd_pcm_hw_params_set_rate_resample( device, hw_params, 0 ) >= 0 )
+	{
+		for( const unsigned int candidate : SAMPLE_RATES )
+		{
+			if( candidate > AUDIO_SAMPLE_RATE_MAX || candidate * 2 < AUDIO_SAMPLE_RATE ) { continue; }
+			if( snd_pcm_hw_params_test_rate( device, hw_params, candidate, 0 ) < 0 ) { continue; }
+			if( snd_pcm_hw_params_set_rate( device, hw_params, candidate, 0 ) < 0 ) { continue; }
+			rate = candidate;
+			return true;
+		}
+	}
+
+	// Otherwise let ALSA resample AUDIO_SAMPLE_RATE
+	rate = AUDIO_SAMPLE_RATE;
+	return snd_pcm_hw_params_set_rate_resample( device, hw_params, 1 ) >= 0 &&
+		snd_pcm_hw_params_set_rate( device, hw_params, rate, 0 ) >= 0;
+}
+
+
+static struct
+{
+	snd_pcm_t *device = nullptr;
+	snd_pcm_uframes_t bufferSize = 0;
+	i16 *buffer = nullptr;
+} g_alsa;
+
+
 static THREAD_FUNCTION ( audio_mixer_thread )
 {
-    snd_pcm_t *device;
+    // Mixer Loop
+    for( ;; )
+    {
+        // Wait until the interface is ready for data.
+        if( snd_pcm_wait( g_alsa.device, -1 ) < 0 ) { break; }
+
+        // Find out how much space is available for playback data.
+        snd_pcm_sframes_t frames;
+        if( ( frames = snd_pcm_avail_update( g_alsa.device ) ) < 0 ) { break; }
+
+        if( frames > static_cast<snd_pcm_sframes_t>( g_alsa.bufferSize ) )
+		{
+			frames = static_cast<snd_pcm_sframes_t>( g_alsa.bufferSize );
+		}
+
+		// Mix Audio
+        SysAudio::audio_mixer( g_alsa.buffer, static_cast<u32>( frames ) );
+
+        if( snd_pcm_writei( g_alsa.device, g_alsa.buffer, frames ) < 0 ) { break; }
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SysAudio::init_backend()
+{
+    // The device is configured here, before the mixer thread starts, so SysAudio::sampleRate is final by the time
+    // init_backend() returns (effects & parameters created on the game thread read it)
     snd_pcm_hw_params_t *hw_params;
     snd_pcm_sw_params_t *sw_params;
 
 	const char *errorMessage = "";
-    unsigned int sample_rate = SAMPLE_RATE;
-    snd_pcm_uframes_t buffer_size = BUFFER_SIZE;
+    unsigned int sample_rate = AUDIO_SAMPLE_RATE;
     snd_pcm_uframes_t period_size;
-    i16 *buffer;
 
     // Open Default Playback Device
-    if( snd_pcm_open( &device, "default", SND_PCM_STREAM_PLAYBACK, 0 ) < 0 )
+    if( snd_pcm_open( &g_alsa.device, "default", SND_PCM_STREAM_PLAYBACK, 0 ) < 0 )
 	{
 		errorMessage = "ALSA: Failed to open sound playback device";
 		goto error;
@@ -49,51 +106,45 @@ static THREAD_FUNCTION ( audio_mixer_thread )
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_any( device, hw_params ) < 0 )
+    if( snd_pcm_hw_params_any( g_alsa.device, hw_params ) < 0 )
 	{
 		errorMessage = "ALSA: Failed snd_pcm_hw_params_any";
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_set_access( device, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED ) < 0 )
+    if( snd_pcm_hw_params_set_access( g_alsa.device, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED ) < 0 )
 	{
 		errorMessage = "ALSA: Failed set hw params access";
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_set_format( device, hw_params, SND_PCM_FORMAT_S16_LE ) < 0 )
+    if( snd_pcm_hw_params_set_format( g_alsa.device, hw_params, SND_PCM_FORMAT_S16_LE ) < 0 )
 	{
 		errorMessage = "ALSA: Failed set hw params format";
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_set_channels( device, hw_params, CHANNELS ) < 0 )
+    if( snd_pcm_hw_params_set_channels( g_alsa.device, hw_params, CHANNELS ) < 0 )
 	{
 		errorMessage = "ALSA: Failed set hw params channels";
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_set_rate_near( device, hw_params, &sample_rate, nullptr ) < 0 )
+    if( !alsa_set_rate( g_alsa.device, hw_params, sample_rate ) )
 	{
 		errorMessage = "ALSA: Failed set hw params sample rate";
 		goto error;
 	}
 
-    if( snd_pcm_hw_params_set_buffer_size_near( device, hw_params, &buffer_size ) < 0 )
+    g_alsa.bufferSize = BUFFER_SIZE( sample_rate );
+    if( snd_pcm_hw_params_set_buffer_size_near( g_alsa.device, hw_params, &g_alsa.bufferSize ) < 0 )
 	{
 		errorMessage = "ALSA: Failed set hw params buffer size";
 		goto error;
 	}
 
-    // TODO: set_rate_near might change the sample rate
-    if( sample_rate != 44100 )
-	{
-		errorMessage = "ALSA: Failed to get requested sample rate of 44100";
-		goto error;
-	}
-
     // Apply Hardware Paramters
-    if( snd_pcm_hw_params( device, hw_params ) < 0 )
+    if( snd_pcm_hw_params( g_alsa.device, hw_params ) < 0 )
     {
 		errorMessage = "ALSA: Failed apply hw params";
 		goto error;
@@ -106,14 +157,15 @@ static THREAD_FUNCTION ( audio_mixer_thread )
 	}
 
 #if COMPILE_DEBUG && true
-    PrintLn( "PCM name: %s\n", snd_pcm_name( device ) );
+    PrintLn( "PCM name: %s\n", snd_pcm_name( g_alsa.device ) );
+    PrintLn( "PCM sample rate: %u\n", sample_rate );
     PrintLn( "PCM period size: %llu\n", period_size );
-    PrintLn( "PCM buffer size: %llu\n", buffer_size );
+    PrintLn( "PCM buffer size: %llu\n", g_alsa.bufferSize );
 #endif
 
     // Allocate buffer
-    buffer = reinterpret_cast<i16 *>( memory_alloc( buffer_size * CHANNELS * sizeof( i16 ) ) );
-	if( buffer == nullptr )
+    g_alsa.buffer = reinterpret_cast<i16 *>( memory_alloc( g_alsa.bufferSize * CHANNELS * sizeof( i16 ) ) );
+	if( g_alsa.buffer == nullptr )
 	{
 		errorMessage = "ALSA: Failed to allocate buffer";
 		goto error;
@@ -126,26 +178,26 @@ static THREAD_FUNCTION ( audio_mixer_thread )
 		goto error;
 	}
 
-    if( snd_pcm_sw_params_current( device, sw_params ) < 0 )
+    if( snd_pcm_sw_params_current( g_alsa.device, sw_params ) < 0 )
 	{
 		errorMessage = "ALSA: Failed snd_pcm_sw_params_current";
 		goto error;
 	}
 
-    if( snd_pcm_sw_params_set_avail_min( device, sw_params, period_size ) < 0 )
+    if( snd_pcm_sw_params_set_avail_min( g_alsa.device, sw_params, period_size ) < 0 )
 	{
 		errorMessage = "ALSA: Failed to set sw params period size";
 		goto error;
 	}
 
-    if( snd_pcm_sw_params_set_start_threshold( device, sw_params, buffer_size - period_size ) < 0 )
+    if( snd_pcm_sw_params_set_start_threshold( g_alsa.device, sw_params, g_alsa.bufferSize - period_size ) < 0 )
 	{
 		errorMessage = "ALSA: Failed to set sw params start threshold";
 		goto error;
 	}
 
     // Apply Software Parameters
-    if( snd_pcm_sw_params( device, sw_params ) < 0 )
+    if( snd_pcm_sw_params( g_alsa.device, sw_params ) < 0 )
     {
 			errorMessage = "ALSA: Failed to apply sw params";
 			goto error;
@@ -156,47 +208,27 @@ static THREAD_FUNCTION ( audio_mixer_thread )
     snd_pcm_sw_params_free( sw_params );
 
     // Prepare Device
-    if( snd_pcm_prepare( device ) < 0 )
+    if( snd_pcm_prepare( g_alsa.device ) < 0 )
     {
 		errorMessage = "ALSA: Failed to prepare device";
 		goto error;
 	}
 
-    // Mixer Loop
-    for( ;; )
-    {
-        // Wait until the interface is ready for data.
-        if( snd_pcm_wait( device, -1 ) < 0 ) { break; }
-
-        // Find out how much space is available for playback data.
-        snd_pcm_sframes_t frames;
-        if( ( frames = snd_pcm_avail_update( device ) ) < 0 ) { break; }
-
-        if( frames > static_cast<snd_pcm_sframes_t>( buffer_size ) )
-		{
-			frames = static_cast<snd_pcm_sframes_t>( buffer_size );
-		}
-
-		// Mix Audio
-        SysAudio::audio_mixer( buffer, static_cast<u32>( frames ) );
-
-        if( snd_pcm_writei( device, buffer, frames ) < 0 ) { break; }
-    }
-
-error:
-    return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // The mixer runs at the device rate
+    SysAudio::sampleRate = sample_rate;
 
-bool SysAudio::init_backend()
-{
 	// Start Mixer Thread
-	bool failure = Thread::create( audio_mixer_thread ) == nullptr;
-	ErrorReturnIf( failure, false, "ALSA: failed to create mixer thread" );
+	{
+		const bool failure = Thread::create( audio_mixer_thread ) == nullptr;
+		ErrorReturnIf( failure, false, "ALSA: failed to create mixer thread" );
+	}
 
     // Success
 	return true;
+
+error:
+	// No playback device: run without audio output
+	return true;
 }
 
 
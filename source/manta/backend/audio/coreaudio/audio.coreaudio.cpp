@@ -14,7 +14,7 @@
 #define CHANNELS 2
 
 // The number of samples per second to output.
-#define SAMPLE_RATE 44100
+#define SAMPLE_RATE AUDIO_SAMPLE_RATE
 
 // The number of bytes in a 16-bit stereo audio frame.
 #define FRAME_SIZE 4
@@ -50,6 +50,9 @@ bool SysAudio::init_backend()
 	AudioQueueRef queue;
     AudioQueueBufferRef buffers[BUFFERS];
 
+	// The queue converts to the device rate
+	SysAudio::sampleRate = SAMPLE_RATE;
+
 	// Setup Stream Description
 	desc.mSampleRate = static_cast<Float64>( SAMPLE_RATE );
 	desc.mFormatID = kAudioFormatLinearPCM;
@@ -0,0 +1,200 @@
+#include <manta/audio.hpp>
+
+#include <vendor/stdio.hpp>
+#include <core/debug.hpp>
+#include <core/types.hpp>
+#include <core/memory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The number of channels to output.
+#define CHANNELS 2
+
+// RIFF/WAVE header size in bytes (PCM, no extra chunks)
+#define WAV_HEADER_SIZE 44
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum_type( OfflineSink, u8 )
+{
+	OfflineSink_Discard,
+	OfflineSink_Memory,
+	OfflineSink_Wav,
+};
+
+
+static struct
+{
+	OfflineSink sink = OfflineSink_Discard;
+	u64 frames = 0; // Frames written to the current sink
+
+	// OfflineSink_Memory
+	i16 *memory = nullptr;
+	u32 memoryFrames = 0;
+
+	// OfflineSink_Wav
+	FILE *wav = nullptr;
+
+	i16 period[AUDIO_OFFLINE_PERIOD_FRAMES * CHANNELS];
+} g_offline;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void wav_u16( u8 *&cursor, const u16 value )
+{
+	*cursor++ = static_cast<u8>( value );
+	*cursor++ = static_cast<u8>( value >> 8 );
+}
+
+
+static void wav_u32( u8 *&cursor, const u32 value )
+{
+	wav_u16( cursor, static_cast<u16>( value ) );
+	wav_u16( cursor, static_cast<u16>( value >> 16 ) );
+}
+
+
+static bool wav_header( FILE *file, const u64 frames )
+{
+	// RIFF sizes are 32-bit: longer renders are clamped (the samples are still written)
+	const u64 dataBytes = frames * CHANNELS * sizeof( i16 );
+	const u32 dataSize = dataBytes > U32_MAX - WAV_HEADER_SIZE ? U32_MAX - WAV_HEADER_SIZE : static_cast<u32>( dataBytes );
+
+	u8 header[WAV_HEADER_SIZE];
+	u8 *cursor = header;
+	memory_copy( cursor, "RIFF", 4 ); cursor += 4;
+	wav_u32( cursor, dataSize + WAV_HEADER_SIZE - 8 );
+	memory_copy( cursor, "WAVE", 4 ); cursor += 4;
+	memory_copy( cursor, "fmt ", 4 ); cursor += 4;
+	wav_u32( cursor, 16 );                                       // Chunk size
+	wav_u16( cursor, 1 );                                        // PCM
+	wav_u16( cursor, CHANNELS );
+	wav_u32( cursor, SysAudio::sampleRate );
+	wav_u32( cursor, SysAudio::sampleRate * CHANNELS * sizeof( i16 ) ); // Bytes per second
+	wav_u16( cursor, CHANNELS * sizeof( i16 ) );                 // Block align
+	wav_u16( cursor, 16 );                                       // Bits per sample
+	memory_copy( cursor, "data", 4 ); cursor += 4;
+	wav_u32( cursor, dataSize );
+
+	return fseek( file, 0, SEEK_SET ) == 0 && fwrite( header, sizeof( header ), 1, file ) == 1;
+}
+
+
+static void wav_close()
+{
+	if( g_offline.wav == nullptr ) { return; }
+
+	// Patch the header sizes now that the length is known
+	const bool written = wav_header( g_offline.wav, g_offline.frames );
+	fclose( g_offline.wav );
+	g_offline.wav = nullptr;
+	ErrorIf( !written, "Offline: failed to finalize WAV header" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SysAudio::offline_sink_discard()
+{
+	wav_close();
+	g_offline.sink = OfflineSink_Discard;
+	g_offline.frames = 0;
+}
+
+
+void SysAudio::offline_sink_memory( i16 *buffer, const u32 frames )
+{
+	wav_close();
+	g_offline.sink = OfflineSink_Memory;
+	g_offline.frames = 0;
+	g_offline.memory = buffer;
+	g_offline.memoryFrames = frames;
+}
+
+
+bool SysAudio::offline_sink_wav( const char *path )
+{
+	offline_sink_discard();
+
+	FILE *file = fopen( path, "wb" );
+	if( file == nullptr ) { return false; }
+
+	// Placeholder header (sizes are patched when the sink closes)
+	if( !wav_header( file, 0 ) ) { fclose( file ); return false; }
+
+	g_offline.sink = OfflineSink_Wav;
+	g_offline.wav = file;
+	return true;
+}
+
+
+u64 SysAudio::offline_sink_frames()
+{
+	return g_offline.frames;
+}
+
+
+void SysAudio::offline_sample_rate( const u32 rate )
+{
+	// Same range a device backend accepts
+	ErrorIf( rate > AUDIO_SAMPLE_RATE_MAX || rate * 2 < AUDIO_SAMPLE_RATE, "Offline: unsupported sample rate %u", rate );
+	SysAudio::sampleRate = rate;
+}
+
+
+void SysAudio::offline_render( const u32 frames )
+{
+	// Runs the mixer on the calling thread as fast as it can, in fixed periods so output is deterministic
+	for( u32 rendered = 0; rendered < frames; )
+	{
+		const u32 period = frames - rendered < AUDIO_OFFLINE_PERIOD_FRAMES ?
+			frames - rendered : AUDIO_OFFLINE_PERIOD_FRAMES;
+		audio_mixer( g_offline.period, period );
+		rendered += period;
+
+		switch( g_offline.sink )
+		{
+			case OfflineSink_Discard:
+				g_offline.frames += period;
+			break;
+
+			case OfflineSink_Memory:
+			{
+				// Output past the end of the buffer is dropped
+				const u64 available = g_offline.frames < g_offline.memoryFrames ? g_offline.memoryFrames - g_offline.frames : 0;
+				const u32 copy = available < period ? static_cast<u32>( available ) : period;
+				memory_copy( &g_offline.memory[g_offline.frames * CHANNELS], g_offline.period, copy * CHANNELS * sizeof( i16 ) );
+				g_offline.frames += copy;
+			}
+			break;
+
+			case OfflineSink_Wav:
+			{
+				// WAV samples are little-endian, as are all supported targets
+				const usize written = fwrite( g_offline.period, CHANNELS * sizeof( i16 ), period, g_offline.wav );
+				g_offline.frames += written;
+				ErrorIf( written != period, "Offline: failed to write WAV samples" );
+			}
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SysAudio::init_backend()
+{
+	// Nothing to open: the mixer only runs inside offline_render()
+	g_offline.sink = OfflineSink_Discard;
+	g_offline.frames = 0;
+	SysAudio::sampleRate = AUDIO_SAMPLE_RATE;
+	return true;
+}
+
+
+bool SysAudio::free_backend()
+{
+	offline_sink_discard();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
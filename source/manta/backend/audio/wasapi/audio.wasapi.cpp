@@ -23,7 +23,7 @@ static const GUID _IID_IAudioRenderClient
 #define CHANNELS 2
 
 // The number of samples per second to output.
-#define SAMPLE_RATE 44100
+#define SAMPLE_RATE AUDIO_SAMPLE_RATE
 
 // The minimum acceptable sound latency in milliseconds.
 #define LATENCY_MS 30
@@ -115,6 +115,9 @@ bool SysAudio::init_backend()
 	IMMDeviceEnumerator *enumerator;
 	IMMDevice *device;
 
+	// The shared mode stream is converted to the device mix format by WASAPI
+	SysAudio::sampleRate = SAMPLE_RATE;
+
 	// Initialize COM
 	bool failure = FAILED( CoInitializeEx( nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE ) );
 	ErrorReturnIf( failure, false, "WASAPI: Failed to initialize COM" );
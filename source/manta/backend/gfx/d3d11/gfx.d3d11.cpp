@@ -44,6 +44,7 @@ static ID3D11RenderTargetView *renderTargetColor = nullptr;
 static ID3D11DepthStencilView *renderTargetDepth = nullptr;
 
 static ID3D11ShaderResourceView *textureSlots[255];
+static ID3D11Buffer *constantBufferSlots[3][14]; // Bound per stage (vertex, fragment, compute) & slot
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -399,6 +400,7 @@ bool GfxCore::rb_init()
 
 	// Internal
 	for( u32 i = 0; i < ARRAY_LENGTH( textureSlots ); i++ ) { textureSlots[i] = nullptr; }
+	memory_set( constantBufferSlots, 0, sizeof( constantBufferSlots ) );
 
 	// Resources
 	ErrorReturnIf( !resources_init(), false, "%s: Failed to create gfx resources", __FUNCTION__ );
@@ -1079,6 +1081,18 @@ bool GfxCore::rb_vertex_buffer_write( GfxVertexBufferResource *&resource, const
 }
 
 
+void *GfxCore::rb_vertex_buffer_reserve( GfxVertexBufferResource *&resource, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->mapped );
+	Assert( resource->current + size <= resource->size );
+
+	byte *data = resource->data + resource->current;
+	resource->current += size;
+	return data;
+}
+
+
 u32 GfxCore::rb_vertex_buffer_current( GfxVertexBufferResource *&resource )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
@@ -1122,6 +1136,14 @@ bool GfxCore::rb_constant_buffer_free( GfxConstantBufferResource *&resource )
 
 	PROFILE_GFX( Gfx::stats.gpuMemoryConstantBuffers -= resource->size );
 
+	for( u32 stage = 0; stage < ARRAY_LENGTH( constantBufferSlots ); stage++ )
+	{
+		for( u32 slot = 0; slot < ARRAY_LENGTH( constantBufferSlots[stage] ); slot++ )
+		{
+			if( constantBufferSlots[stage][slot] == resource->buffer ) { constantBufferSlots[stage][slot] = nullptr; }
+		}
+	}
+
 	resource->buffer->Release();
 	resource->buffer = nullptr;
 	constantBufferResources.remove( resource->id );
@@ -1167,7 +1189,9 @@ bool GfxCore::rb_constant_buffer_write( GfxConstantBufferResource *&resource, co
 
 bool GfxCore::rb_constant_buffer_bind_vertex( GfxConstantBufferResource *&resource, const int slot )
 {
-	Assert( slot >= 0 );
+	Assert( slot >= 0 && slot < static_cast<int>( ARRAY_LENGTH( constantBufferSlots[0] ) ) );
+	if( constantBufferSlots[0][slot] == resource->buffer ) { return true; }
+	constantBufferSlots[0][slot] = resource->buffer;
 	context->VSSetConstantBuffers( static_cast<UINT>( slot ), 1, &resource->buffer );
 
 	// Success
@@ -1177,7 +1201,9 @@ bool GfxCore::rb_constant_buffer_bind_vertex( GfxConstantBufferResource *&resour
 
 bool GfxCore::rb_constant_buffer_bind_fragment( GfxConstantBufferResource *&resource, const int slot )
 {
-	Assert( slot >= 0 );
+	Assert( slot >= 0 && slot < static_cast<int>( ARRAY_LENGTH( constantBufferSlots[1] ) ) );
+	if( constantBufferSlots[1][slot] == resource->buffer ) { return true; }
+	constantBufferSlots[1][slot] = resource->buffer;
 	context->PSSetConstantBuffers( static_cast<UINT>( slot ), 1, &resource->buffer );
 
 	// Success
@@ -1187,7 +1213,9 @@ bool GfxCore::rb_constant_buffer_bind_fragment( GfxConstantBufferResource *&reso
 
 bool GfxCore::rb_constant_buffer_bind_compute( GfxConstantBufferResource *&resource, const int slot )
 {
-	Assert( slot >= 0 );
+	Assert( slot >= 0 && slot < static_cast<int>( ARRAY_LENGTH( constantBufferSlots[2] ) ) );
+	if( constantBufferSlots[2][slot] == resource->buffer ) { return true; }
+	constantBufferSlots[2][slot] = resource->buffer;
 	context->CSSetConstantBuffers( static_cast<UINT>( slot ), 1, &resource->buffer );
 
 	// Success
@@ -4,6 +4,8 @@
 
 #include <core/memory.hpp>
 
+#include <vendor/new.hpp>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T, u32 Capacity>
@@ -1,90 +1,972 @@
 #include <manta/gfx.hpp>
+
+#include <manta/backend/gfx/gfxfactory.hpp>
+
 #include <config.hpp>
 
+#include <core/memory.hpp>
+#include <core/checksum.hpp>
+
+#include <manta/window.hpp>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-namespace GfxCore
+// Headless backend: GPU resources live in CPU memory and every call is logged to a per-frame command list (see
+// GfxHeadlessCommandType). Draws run the same state & batching logic as the GPU backends but rasterize nothing.
+
+struct GfxVertexBufferResource : public GfxResource
 {
-	bool init()
-	{
-		return true;
-	}
+	GfxCPUAccessMode accessMode;
+	bool mapped = false;
+	byte *data = nullptr;
+	u32 size = 0;
+	u32 stride = 0; // vertex size
+	u32 current = 0;
+	u32 vertexFormat = 0;
+};
 
 
-	bool free()
-	{
-		return true;
-	}
+struct GfxIndexBufferResource : public GfxResource
+{
+	GfxCPUAccessMode accessMode = GfxCPUAccessMode_NONE;
+	GfxIndexBufferFormat format = GfxIndexBufferFormat_U32;
+	double indToVertRatio = 1.0;
+	byte *data = nullptr;
+	u32 size = 0;
+};
 
 
-	void update()
-	{
-		// ...
-	}
+struct GfxConstantBufferResource : public GfxResource
+{
+	bool mapped = false;
+	byte *data = nullptr;
+	const char *name = "";
+	int index = 0;
+	u32 size = 0; // buffer size in bytes
+};
+
+
+struct GfxTexture2DResource : public GfxResource
+{
+	GfxColorFormat colorFormat;
+	byte *data = nullptr;
+	u32 size = 0;
+	u32 width = 0;
+	u32 height = 0;
+};
+
 
+struct GfxRenderTarget2DResource : public GfxResource
+{
+	GfxRenderTargetDescription desc = { };
+	GfxTexture2DResource *textureColor = nullptr;
+	GfxTexture2DResource *textureDepth = nullptr;
+	u16 width = 0;
+	u16 height = 0;
+};
+
+
+struct GfxShaderResource : public GfxResource
+{
+	u32 sizeVS, sizePS;
+	u32 shaderID;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void viewport_set_size( const int width, const int height, const bool fullscreen )
+static GfxResourceFactory<GfxVertexBufferResource, GFX_RESOURCE_COUNT_VERTEX_BUFFER> vertexBufferResources;
+static GfxResourceFactory<GfxIndexBufferResource, GFX_RESOURCE_COUNT_INDEX_BUFFER> indexBufferResources;
+static GfxResourceFactory<GfxConstantBufferResource, GFX_RESOURCE_COUNT_CONSTANT_BUFFER> constantBufferResources;
+static GfxResourceFactory<GfxShaderResource, GFX_RESOURCE_COUNT_SHADER> shaderResources;
+static GfxResourceFactory<GfxTexture2DResource, GFX_RESOURCE_COUNT_TEXTURE_2D> texture2DResources;
+static GfxResourceFactory<GfxRenderTarget2DResource, GFX_RESOURCE_COUNT_RENDER_TARGET_2D> renderTarget2DResources;
+
+
+static bool resources_init()
+{
+	vertexBufferResources.init();
+	indexBufferResources.init();
+	constantBufferResources.init();
+	texture2DResources.init();
+	renderTarget2DResources.init();
+	shaderResources.init();
+
+	// Success
+	return true;
+}
+
+
+static bool resources_free()
+{
+	// CPU copies of resources still alive
+	for( GfxVertexBufferResource &resource : vertexBufferResources ) { memory_free( resource.data ); }
+	for( GfxIndexBufferResource &resource : indexBufferResources ) { memory_free( resource.data ); }
+	for( GfxConstantBufferResource &resource : constantBufferResources ) { memory_free( resource.data ); }
+	for( GfxTexture2DResource &resource : texture2DResources ) { memory_free( resource.data ); }
+
+	vertexBufferResources.free();
+	indexBufferResources.free();
+	constantBufferResources.free();
+	texture2DResources.free();
+	renderTarget2DResources.free();
+	shaderResources.free();
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char *HEADLESS_COMMAND_NAMES[] =
+{
+	"clear_color",
+	"clear_depth",
+	"swapchain_resize",
+	"viewport_resize",
+	"raster_state",
+	"sampler_state",
+	"blend_state",
+	"depth_state",
+	"shader_bind",
+	"constant_buffer_write",
+	"constant_buffer_bind",
+	"texture_bind",
+	"texture_release",
+	"render_target_bind",
+	"render_target_release",
+	"vertex_buffer_map",
+	"vertex_buffer_unmap",
+	"draw",
+	"draw_indexed",
+};
+static_assert( ARRAY_LENGTH( HEADLESS_COMMAND_NAMES ) == GFXHEADLESSCOMMANDTYPE_COUNT, "Missing GfxHeadlessCommandType!" );
+
+
+static struct
+{
+	// Command logs: one records while the other holds the last finished frame
+	GfxHeadlessCommand *logs[2] = { nullptr, nullptr };
+	u32 log = 0;
+	GfxHeadlessFrame recording;
+	GfxHeadlessFrame finished;
+
+	const GfxRenderTarget2DResource *renderTarget = nullptr;
+	const GfxConstantBufferResource *constantBufferSlots[3][64] = { }; // Bound per stage & slot (as D3D11 caches them)
+} g_headless;
+
+
+static void headless_record( const GfxHeadlessCommandType type, const u8 slot, const u32 resource, const u32 value )
+{
+	GfxHeadlessCommand command;
+	command.type = type;
+	command.slot = slot;
+	command.reserved = 0;
+	command.resource = resource;
+	command.value = value;
+
+	// Dropped commands still count towards the checksum
+	GfxHeadlessFrame &frame = g_headless.recording;
+	frame.checksum = checksum_xcrc32( reinterpret_cast<const char *>( &command ), sizeof( command ), frame.checksum );
+	if( UNLIKELY( frame.count == RENDER_HEADLESS_COMMANDS ) ) { frame.dropped++; return; }
+	g_headless.logs[g_headless.log][frame.count++] = command;
+}
+
+
+static void headless_draw( const u32 resource, const u32 vertexCount, const bool indexed )
+{
+	SysGfx::state_apply();
+	headless_record( indexed ? GfxHeadlessCommandType_DRAW_INDEXED : GfxHeadlessCommandType_DRAW, 0,
+		resource, vertexCount );
+	g_headless.recording.drawCalls++;
+	g_headless.recording.vertexCount += vertexCount;
+	PROFILE_GFX( Gfx::stats.frame.drawCalls++ );
+	PROFILE_GFX( Gfx::stats.frame.vertexCount += vertexCount );
+}
+
+
+static u32 headless_size( const u16 width, const u16 height )
+{
+	return static_cast<u32>( width ) | static_cast<u32>( height ) << 16;
+}
+
+
+static bool headless_texture_2d_alloc( GfxTexture2DResource *resource, const u32 size, const void *data )
+{
+	resource->size = size;
+	resource->data = reinterpret_cast<byte *>( memory_alloc( size > 0 ? size : 1 ) );
+	ErrorReturnIf( resource->data == nullptr, false, "%s: Failed to allocate texture memory", __FUNCTION__ );
+	if( data != nullptr ) { memory_copy( resource->data, data, size ); } else { memory_set( resource->data, 0, size ); }
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GfxHeadlessFrame Gfx::headless_frame()
+{
+	return g_headless.finished;
+}
+
+
+const char *Gfx::headless_command_name( const GfxHeadlessCommandType type )
+{
+	Assert( type < GFXHEADLESSCOMMANDTYPE_COUNT );
+	return HEADLESS_COMMAND_NAMES[type];
+}
+
+
+const void *Gfx::headless_vertex_buffer_data( const GfxVertexBufferResource *resource, u32 &size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	size = resource->current;
+	return resource->data;
+}
+
+
+const void *Gfx::headless_texture_2d_data( const GfxTexture2DResource *resource, u32 &size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	size = resource->size;
+	return resource->data;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_init()
+{
+	// Resources
+	resources_init();
+
+	// Command Logs
+	for( GfxHeadlessCommand *&log : g_headless.logs )
 	{
-		// ...
+		log = reinterpret_cast<GfxHeadlessCommand *>(
+			memory_alloc( RENDER_HEADLESS_COMMANDS * sizeof( GfxHeadlessCommand ) ) );
+		ErrorReturnIf( log == nullptr, false, "%s: Failed to allocate command log", __FUNCTION__ );
 	}
+	g_headless.log = 0;
+	g_headless.recording = { };
+	g_headless.recording.commands = g_headless.logs[0];
+	g_headless.finished = { };
+	g_headless.renderTarget = nullptr;
+	memory_set( g_headless.constantBufferSlots, 0, sizeof( g_headless.constantBufferSlots ) );
+
+	// Success
+	return true;
+}
 
 
-	void swapchain_resize( const int width, const int height, const bool fullscreen )
+bool GfxCore::rb_free()
+{
+	// Command Logs
+	for( GfxHeadlessCommand *&log : g_headless.logs )
 	{
-		// ...
+		if( log != nullptr ) { memory_free( log ); }
+		log = nullptr;
 	}
+	g_headless.recording = { };
+	g_headless.finished = { };
+
+	// Resources
+	resources_free();
+
+	// Success
+	return true;
+}
+
+
+void GfxCore::rb_frame_begin()
+{
+	// Headless does nothing (the log starts at the previous rb_frame_end, so state resets are included)
+}
+
+
+void GfxCore::rb_frame_end()
+{
+	// Finish the frame & record the next one into the other log
+	g_headless.finished = g_headless.recording;
+	g_headless.log = !g_headless.log;
+	g_headless.recording = { };
+	g_headless.recording.commands = g_headless.logs[g_headless.log];
+	g_headless.recording.frame = g_headless.finished.frame + 1;
+}
+
+
+void GfxCore::rb_clear_color( const Color color )
+{
+	const u32 rgba = static_cast<u32>( color.r ) | static_cast<u32>( color.g ) << 8 |
+	                 static_cast<u32>( color.b ) << 16 | static_cast<u32>( color.a ) << 24;
+	headless_record( GfxHeadlessCommandType_CLEAR_COLOR, 0, 0, rgba );
+
+	// Render target copies are readable, so clear them (the swapchain has no CPU copy)
+	const GfxRenderTarget2DResource *const target = g_headless.renderTarget;
+	if( target == nullptr || target->desc.colorFormat != GfxColorFormat_R8G8B8A8 ) { return; }
+	u32 *pixels = reinterpret_cast<u32 *>( target->textureColor->data );
+	const u32 count = target->textureColor->size / sizeof( u32 );
+	for( u32 i = 0; i < count; i++ ) { pixels[i] = rgba; }
+}
+
+
+void GfxCore::rb_clear_depth( const float depth )
+{
+	u32 bits;
+	memory_copy( &bits, &depth, sizeof( bits ) );
+	headless_record( GfxHeadlessCommandType_CLEAR_DEPTH, 0, 0, bits );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-namespace Gfx
+bool GfxCore::rb_swapchain_init( const u16 width, const u16 height, const bool fullscreen )
 {
-	void frame_begin()
-	{
-		// ...
-	}
+	PROFILE_GFX( Gfx::stats.gpuMemoryFramebuffer =
+		GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, GfxColorFormat_R8G8B8A8 ) );
+	return true;
+}
 
 
-	void frame_end()
+bool GfxCore::rb_swapchain_free()
+{
+	return true;
+}
+
+
+bool GfxCore::rb_swapchain_resize( const u16 width, const u16 height, const bool fullscreen )
+{
+	PROFILE_GFX( Gfx::stats.gpuMemoryFramebuffer =
+		GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, GfxColorFormat_R8G8B8A8 ) );
+	headless_record( GfxHeadlessCommandType_SWAPCHAIN_RESIZE, fullscreen, 0, headless_size( width, height ) );
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_viewport_init( const u16 width, const u16 height, const bool fullscreen )
+{
+	return true;
+}
+
+
+bool GfxCore::rb_viewport_free()
+{
+	return true;
+}
+
+
+bool GfxCore::rb_viewport_resize( const u16 width, const u16 height, const bool fullscreen )
+{
+	headless_record( GfxHeadlessCommandType_VIEWPORT_RESIZE, fullscreen, 0, headless_size( width, height ) );
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_set_raster_state( const GfxRasterState &state )
+{
+	const u32 fields[] =
 	{
-		// ...
-	}
+		static_cast<u32>( state.fillMode ) | static_cast<u32>( state.cullMode ) << 8 |
+			static_cast<u32>( state.scissor ) << 16,
+		static_cast<u32>( state.scissorX1 ), static_cast<u32>( state.scissorY1 ),
+		static_cast<u32>( state.scissorX2 ), static_cast<u32>( state.scissorY2 ),
+	};
+	headless_record( GfxHeadlessCommandType_RASTER_STATE, 0, 0,
+		checksum_xcrc32( reinterpret_cast<const char *>( fields ), sizeof( fields ), 0 ) );
+	return true;
+}
+
+
+bool GfxCore::rb_set_sampler_state( const GfxSamplerState &state )
+{
+	headless_record( GfxHeadlessCommandType_SAMPLER_STATE, 0, 0, state.id() );
+	return true;
+}
+
+
+bool GfxCore::rb_set_blend_state( const GfxBlendState &state )
+{
+	headless_record( GfxHeadlessCommandType_BLEND_STATE, 0, 0, state.id() );
+	return true;
+}
+
+
+bool GfxCore::rb_set_depth_state( const GfxDepthState &state )
+{
+	headless_record( GfxHeadlessCommandType_DEPTH_STATE, 0, 0, state.id() );
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_index_buffer_init( GfxIndexBufferResource *&resource, void *data, const u32 size,
+                                    const double indToVertRatio,
+                                    const GfxIndexBufferFormat format, const GfxCPUAccessMode accessMode )
+{
+	Assert( format != GfxIndexBufferFormat_NONE );
+	Assert( format < GFXINDEXBUFFERFORMAT_COUNT );
+
+	// Register IndexBuffer
+	Assert( resource == nullptr );
+	resource = indexBufferResources.make_new();
+	resource->accessMode = accessMode;
+	resource->format = format;
+	resource->indToVertRatio = indToVertRatio;
+	resource->size = size;
+
+	// Copy Index Data
+	resource->data = reinterpret_cast<byte *>( memory_alloc( size ) );
+	ErrorReturnIf( resource->data == nullptr, false, "%s: Failed to allocate index buffer", __FUNCTION__ );
+	if( data != nullptr ) { memory_copy( resource->data, data, size ); }
+
+	PROFILE_GFX( Gfx::stats.gpuMemoryIndexBuffers += size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_index_buffer_free( GfxIndexBufferResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	PROFILE_GFX( Gfx::stats.gpuMemoryIndexBuffers -= resource->size );
+
+	memory_free( resource->data );
+	resource->data = nullptr;
+	indexBufferResources.remove( resource->id );
+	resource = nullptr;
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_vertex_buffer_init_dynamic( GfxVertexBufferResource *&resource, const u32 vertexFormatID,
+                                             const GfxCPUAccessMode accessMode, const u32 size, const u32 stride )
+{
+	// Register VertexBuffer
+	Assert( accessMode == GfxCPUAccessMode_WRITE_DISCARD || accessMode == GfxCPUAccessMode_WRITE_NO_OVERWRITE );
+	Assert( resource == nullptr );
+	resource = vertexBufferResources.make_new();
+	resource->size = size;
+	resource->stride = stride;
+	resource->accessMode = accessMode;
+	resource->vertexFormat = vertexFormatID;
+
+	resource->data = reinterpret_cast<byte *>( memory_alloc( size ) );
+	ErrorReturnIf( resource->data == nullptr, false, "%s: Failed to allocate vertex buffer", __FUNCTION__ );
+
+	PROFILE_GFX( Gfx::stats.gpuMemoryVertexBuffers += size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_vertex_buffer_init_static( GfxVertexBufferResource *&resource, const u32 vertexFormatID,
+                                            const GfxCPUAccessMode accessMode, const void *const data,
+                                            const u32 size, const u32 stride )
+{
+	// Register VertexBuffer
+	Assert( resource == nullptr );
+	resource = vertexBufferResources.make_new();
+	resource->size = size;
+	resource->stride = stride;
+	resource->accessMode = accessMode;
+	resource->vertexFormat = vertexFormatID;
+
+	// Static buffers are drawn whole
+	resource->data = reinterpret_cast<byte *>( memory_alloc( size ) );
+	ErrorReturnIf( resource->data == nullptr, false, "%s: Failed to allocate vertex buffer", __FUNCTION__ );
+	if( data != nullptr ) { memory_copy( resource->data, data, size ); }
+	resource->current = size;
+
+	PROFILE_GFX( Gfx::stats.gpuMemoryVertexBuffers += size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_vertex_buffer_free( GfxVertexBufferResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	PROFILE_GFX( Gfx::stats.gpuMemoryVertexBuffers -= resource->size );
+
+	memory_free( resource->data );
+	resource->data = nullptr;
+	vertexBufferResources.remove( resource->id );
+	resource = nullptr;
 
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_vertex_buffer_draw( GfxVertexBufferResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	// Submit Draw
+	ErrorIf( resource->mapped, "Attempting to draw vertex buffer that is mapped! (resource: %u)", resource->id );
+	const u32 count = resource->current / resource->stride;
+	headless_draw( resource->id, count, false );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_vertex_buffer_draw_indexed( GfxVertexBufferResource *&resource,
+                                             GfxIndexBufferResource *&resourceIndexBuffer )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceIndexBuffer != nullptr && resourceIndexBuffer->id != GFX_RESOURCE_ID_NULL );
+
+	// Submit Draw
+	ErrorIf( resource->mapped, "Attempting to draw vertex buffer that is mapped! (resource: %u)", resource->id );
+	const u32 count = static_cast<u32>( resource->current / resource->stride * resourceIndexBuffer->indToVertRatio );
+	headless_draw( resource->id, count, true );
+
+	// Success
+	return true;
+}
+
+
+void GfxCore::rb_vertex_buffer_write_begin( GfxVertexBufferResource *&resource )
+{
+	if( resource->mapped == true ) { return; }
+
+	headless_record( GfxHeadlessCommandType_VERTEX_BUFFER_MAP, 0, resource->id, 0 );
+	PROFILE_GFX( Gfx::stats.frame.bufferMaps++ );
+
+	resource->mapped = true;
+	resource->current = 0;
+}
+
+
+void GfxCore::rb_vertex_buffer_write_end( GfxVertexBufferResource *&resource )
+{
+	if( resource->mapped == false ) { return; }
+
+	headless_record( GfxHeadlessCommandType_VERTEX_BUFFER_UNMAP, 0, resource->id, resource->current );
+	resource->mapped = false;
+}
+
+
+bool GfxCore::rb_vertex_buffer_write( GfxVertexBufferResource *&resource, const void *const data, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->mapped );
+	Assert( resource->current + size <= resource->size );
+
+	memory_copy( resource->data + resource->current, data, size );
+	resource->current += size;
+
+	// Success
+	return true;
+}
+
+
+void *GfxCore::rb_vertex_buffer_reserve( GfxVertexBufferResource *&resource, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->mapped );
+	Assert( resource->current + size <= resource->size );
+
+	byte *data = resource->data + resource->current;
+	resource->current += size;
+	return data;
+}
+
+
+u32 GfxCore::rb_vertex_buffer_current( GfxVertexBufferResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	return resource->current;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_constant_buffer_init( GfxConstantBufferResource *&resource, const char *name,
+                                       const int index, const u32 size )
+{
+	// Register Constant Buffer
+	Assert( resource == nullptr );
+	resource = constantBufferResources.make_new();
+	resource->name = name;
+	resource->index = index;
+	resource->size = size;
+
+	resource->data = reinterpret_cast<byte *>( memory_alloc( size ) );
+	ErrorReturnIf( resource->data == nullptr, false, "%s: Failed to allocate constant buffer", __FUNCTION__ );
+	memory_set( resource->data, 0, size );
+
+	PROFILE_GFX( Gfx::stats.gpuMemoryConstantBuffers += size );
 
-	void clear_color( Color color )
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_constant_buffer_free( GfxConstantBufferResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	PROFILE_GFX( Gfx::stats.gpuMemoryConstantBuffers -= resource->size );
+
+	for( auto &slots : g_headless.constantBufferSlots )
 	{
-		// ...
+		for( const GfxConstantBufferResource *&slot : slots ) { if( slot == resource ) { slot = nullptr; } }
 	}
 
+	memory_free( resource->data );
+	resource->data = nullptr;
+	constantBufferResources.remove( resource->id );
+	resource = nullptr;
+
+	// Success
+	return true;
+}
+
+
+void GfxCore::rb_constant_buffer_write_begin( GfxConstantBufferResource *&resource )
+{
+	if( resource->mapped == true ) { return; }
+	resource->mapped = true;
+}
+
+
+void GfxCore::rb_constant_buffer_write_end( GfxConstantBufferResource *&resource )
+{
+	if( resource->mapped == false ) { return; }
+	resource->mapped = false;
+}
+
+
+bool GfxCore::rb_constant_buffer_write( GfxConstantBufferResource *&resource, const void *data )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->mapped );
+
+	memory_copy( resource->data, data, resource->size );
+	headless_record( GfxHeadlessCommandType_CONSTANT_BUFFER_WRITE, 0, static_cast<u32>( resource->index ),
+		checksum_xcrc32( reinterpret_cast<const char *>( resource->data ), resource->size, 0 ) );
+
+	// Success
+	return true;
+}
+
 
-	void clear_depth()
+static bool headless_constant_buffer_bind( GfxConstantBufferResource *&resource, const int slot, const u8 stage )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( slot >= 0 && slot < 64 );
+	if( g_headless.constantBufferSlots[stage][slot] == resource ) { return true; }
+	g_headless.constantBufferSlots[stage][slot] = resource;
+
+	headless_record( GfxHeadlessCommandType_CONSTANT_BUFFER_BIND, static_cast<u8>( slot | stage << 6 ),
+		static_cast<u32>( resource->index ), 0 );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_constant_buffer_bind_vertex( GfxConstantBufferResource *&resource, const int slot )
+{
+	return headless_constant_buffer_bind( resource, slot, 0 );
+}
+
+
+bool GfxCore::rb_constant_buffer_bind_fragment( GfxConstantBufferResource *&resource, const int slot )
+{
+	return headless_constant_buffer_bind( resource, slot, 1 );
+}
+
+
+bool GfxCore::rb_constant_buffer_bind_compute( GfxConstantBufferResource *&resource, const int slot )
+{
+	return headless_constant_buffer_bind( resource, slot, 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels,
+                                  const u16 width, const u16 height, const GfxColorFormat &format )
+{
+	// Register Texture2D
+	Assert( resource == nullptr );
+	resource = texture2DResources.make_new();
+	resource->colorFormat = format;
+	resource->width = width;
+	resource->height = height;
+
+	// Copy Pixels
+	if( !headless_texture_2d_alloc( resource, GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, format ), pixels ) )
 	{
-		// ...
+		ErrorReturnMsg( false, "%s: Failed to init texture", __FUNCTION__ );
 	}
 
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures += resource->size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_texture_2d_free( GfxTexture2DResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures -= resource->size );
+
+	memory_free( resource->data );
+	resource->data = nullptr;
+	texture2DResources.remove( resource->id );
+	resource = nullptr;
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_texture_2d_bind( const GfxTexture2DResource *const &resource, const int slot )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	headless_record( GfxHeadlessCommandType_TEXTURE_BIND, static_cast<u8>( slot ), resource->id, 0 );
+	PROFILE_GFX( Gfx::stats.frame.textureBinds++ );
 
-	void quad_batch_begin()
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_texture_2d_release( const int slot )
+{
+	headless_record( GfxHeadlessCommandType_TEXTURE_RELEASE, static_cast<u8>( slot ), 0, 0 );
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_render_target_2d_init( GfxRenderTarget2DResource *&resource,
+                                        GfxTexture2DResource *&resourceColor, GfxTexture2DResource *&resourceDepth,
+                                        const u16 width, const u16 height,
+                                        const GfxRenderTargetDescription &desc )
+{
+	// Register RenderTarget2D
+	Assert( resource == nullptr );
+	resource = renderTarget2DResources.make_new();
+	resource->width = width;
+	resource->height = height;
+	resource->desc = desc;
+
+	// Color Texture
 	{
-		// ...
-	}
+		resourceColor = texture2DResources.make_new();
+		resourceColor->colorFormat = desc.colorFormat;
+		resourceColor->width = width;
+		resourceColor->height = height;
+		if( !headless_texture_2d_alloc( resourceColor,
+			GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, desc.colorFormat ), nullptr ) )
+		{
+			ErrorReturnMsg( false, "%s: RenderTarget2D: Failed to init texture", __FUNCTION__ );
+		}
+		resource->textureColor = resourceColor;
 
+		PROFILE_GFX( Gfx::stats.gpuMemoryTextures += resourceColor->size );
+	}
 
-	void quad_batch_end()
+	// Depth Texture
+	if( desc.depthFormat != GfxDepthFormat_NONE )
 	{
-		// ...
+		resourceDepth = texture2DResources.make_new();
+		resourceDepth->colorFormat = GfxColorFormat_NONE;
+		resourceDepth->width = width;
+		resourceDepth->height = height;
+		if( !headless_texture_2d_alloc( resourceDepth,
+			GFX_SIZE_IMAGE_DEPTH_BYTES( width, height, 1, desc.depthFormat ), nullptr ) )
+		{
+			ErrorReturnMsg( false, "%s: RenderTarget2D: Failed to init depth texture", __FUNCTION__ );
+		}
+		resource->textureDepth = resourceDepth;
+
+		PROFILE_GFX( Gfx::stats.gpuMemoryTextures += resourceDepth->size );
 	}
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_free( GfxRenderTarget2DResource *&resource,
+                                        GfxTexture2DResource *&resourceColor, GfxTexture2DResource *&resourceDepth )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	if( g_headless.renderTarget == resource ) { g_headless.renderTarget = nullptr; }
+
+	if( resourceColor != nullptr ) { rb_texture_2d_free( resourceColor ); }
+	if( resourceDepth != nullptr ) { rb_texture_2d_free( resourceDepth ); }
+	renderTarget2DResources.remove( resource->id );
+	resource = nullptr;
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_buffer_read_color( GfxRenderTarget2DResource *&resource,
+                                                     GfxTexture2DResource *&resourceColor,
+                                                     void *buffer, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceColor != nullptr );
+	ErrorReturnIf( size < resourceColor->size, false, "%s: Buffer too small (%u < %u)",
+		__FUNCTION__, size, resourceColor->size );
+
+	memory_copy( buffer, resourceColor->data, resourceColor->size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_buffer_read_depth( GfxRenderTarget2DResource *&resource,
+                                                     GfxTexture2DResource *&resourceDepth,
+                                                     void *buffer, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	ErrorReturnIf( resourceDepth == nullptr, false, "%s: Render target has no depth buffer", __FUNCTION__ );
+	ErrorReturnIf( size < resourceDepth->size, false, "%s: Buffer too small (%u < %u)",
+		__FUNCTION__, size, resourceDepth->size );
+
+	memory_copy( buffer, resourceDepth->data, resourceDepth->size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_buffer_write_color( GfxRenderTarget2DResource *&resource,
+                                                      GfxTexture2DResource *&resourceColor,
+                                                      const void *const buffer, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceColor != nullptr );
+	ErrorReturnIf( size > resourceColor->size, false, "%s: Buffer too large (%u > %u)",
+		__FUNCTION__, size, resourceColor->size );
+
+	memory_copy( resourceColor->data, buffer, size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_buffer_write_depth( GfxRenderTarget2DResource *&resource,
+                                                      GfxTexture2DResource *&resourceDepth,
+                                                      const void *const buffer, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	ErrorReturnIf( resourceDepth == nullptr, false, "%s: Render target has no depth buffer", __FUNCTION__ );
+	ErrorReturnIf( size > resourceDepth->size, false, "%s: Buffer too large (%u > %u)",
+		__FUNCTION__, size, resourceDepth->size );
+
+	memory_copy( resourceDepth->data, buffer, size );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_bind( const GfxRenderTarget2DResource *const &resource, const int slot )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	g_headless.renderTarget = resource;
+	headless_record( GfxHeadlessCommandType_RENDER_TARGET_BIND, static_cast<u8>( slot ), resource->id, 0 );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_render_target_2d_release()
+{
+	g_headless.renderTarget = nullptr;
+	headless_record( GfxHeadlessCommandType_RENDER_TARGET_RELEASE, 0, 0, 0 );
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GfxCore::rb_shader_init( GfxShaderResource *&resource, const u32 shaderID, const struct DiskShader &diskShader )
+{
+	// Register Shader
+	Assert( resource == nullptr );
+	resource = shaderResources.make_new();
+	resource->shaderID = shaderID;
+
+	// Nothing to compile: keep the sizes for statistics
+	resource->sizeVS = diskShader.sizeVertex;
+	resource->sizePS = diskShader.sizeFragment;
+	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms += resource->sizeVS );
+	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms += resource->sizePS );
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_shader_free( GfxShaderResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms -= resource->sizeVS );
+	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms -= resource->sizePS );
+
+	shaderResources.remove( resource->id );
+	resource = nullptr;
+
+	// Success
+	return true;
+}
+
+
+bool GfxCore::rb_shader_bind( GfxShaderResource *&resource )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	headless_record( GfxHeadlessCommandType_SHADER_BIND, 0, resource->shaderID, 0 );
+	PROFILE_GFX( Gfx::stats.frame.shaderBinds++ );
+
+	// Success
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #if WINDOW_X11
 
-	#include <manta/window.hpp>
 	#include <manta/backend/window/x11/window.x11.hpp>
 
-	XVisualInfo * SysWindow::x11_create_visual()
+	XVisualInfo *SysWindow::x11_create_visual()
 	{
-		return nullptr;
+		// Any true color visual: nothing is presented, the window only receives input
+		static XVisualInfo visual;
+		const int screen = DefaultScreen( SysWindow::display );
+		if( !XMatchVisualInfo( SysWindow::display, screen, DefaultDepth( SysWindow::display, screen ),
+		                       TrueColor, &visual ) )
+		{
+			return nullptr;
+		}
+		return &visual;
 	}
 
-#endif
\ No newline at end of file
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@ static bool OpenGLErrorDetected = false;
 static GfxShaderResource *boundShaderResource = nullptr;
 
 static HashMap<u32, GLuint> constantBufferUniformBlockIndices;
+static GLuint uniformBufferBindings[GfxCore::constantBufferCount]; // Buffer bound to each cbuffer's binding point
 static HashMap<u32, GLint> texture2DUniformLocations;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -340,23 +341,24 @@ static void opengl_draw_indexed( const GLsizei vertexCount, const GLuint startVe
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static GLuint opengl_constant_buffer_uniform_block_index( GfxConstantBufferResource *&resource, const int slot )
+// Uniform block bindings & sampler uniforms are program state: they are set once, the first time a program uses
+// a cbuffer or texture slot, and skipped on every later bind
+
+static bool opengl_constant_buffer_uniform_block_bind( GfxConstantBufferResource *&resource, const int slot )
 {
 	// Get hash "key" from cbuffer index, slot, and shader program
-	char buffer[64];
-	const u32 a = static_cast<u32>( resource->index );
-	const u32 b = static_cast<u32>( boundShaderResource->program );
-	const u32 c = static_cast<u32>( slot );
-	snprintf( buffer, sizeof( buffer ), "%u_%u_%u", a, b, c ); // TODO: Refactor this?
-	const u32 key = checksum_xcrc32( buffer, strlen( buffer ), 0 );
-
-	// Block index already found?
-	if( constantBufferUniformBlockIndices.contains( key ) )
+	const u32 fields[] =
 	{
-		return constantBufferUniformBlockIndices.get( key );
-	}
+		static_cast<u32>( resource->index ),
+		static_cast<u32>( boundShaderResource->program ),
+		static_cast<u32>( slot ),
+	};
+	const u32 key = checksum_xcrc32( reinterpret_cast<const char *>( fields ), sizeof( fields ), 0 );
+
+	// Block already bound?
+	if( constantBufferUniformBlockIndices.contains( key ) ) { return true; }
 
-	// Find & cache block index
+	// Find & bind block index
 	const GLuint index = nglGetUniformBlockIndex( boundShaderResource->program,
 	                                              static_cast<const GLchar *>( resource->name ) );
 
@@ -368,27 +370,26 @@ static GLuint opengl_constant_buffer_uniform_block_index( GfxConstantBufferResou
 		"OpenGL: Unable to get uniform block index (Invalid index) (%s) %d",
 		resource->name, boundShaderResource->program );
 
+	nglUniformBlockBinding( boundShaderResource->program, index, static_cast<GLuint>( resource->index ) );
 	constantBufferUniformBlockIndices.add( key, index );
-	return index;
+	return true;
 }
 
 
-static GLint opengl_texture_uniform_location( HashMap<u32, GLint> &cache, const int slot )
+static bool opengl_texture_uniform_bind( HashMap<u32, GLint> &cache, const int slot )
 {
-	// Get hash "key" from cbuffer index, slot, and shader program
-	char buffer[64];
-	const u32 a = static_cast<u32>( boundShaderResource->program );
-	const u32 b = static_cast<u32>( slot );
-	snprintf( buffer, sizeof( buffer ), "%u_%u", a, b ); // TODO: Refactor this?
-	const u32 key = checksum_xcrc32( buffer, strlen( buffer ), 0 );
-
-	// Uniform index already found?
-	if( cache.contains( key ) )
+	// Get hash "key" from slot and shader program
+	const u32 fields[] =
 	{
-		return cache.get( key );
-	}
+		static_cast<u32>( boundShaderResource->program ),
+		static_cast<u32>( slot ),
+	};
+	const u32 key = checksum_xcrc32( reinterpret_cast<const char *>( fields ), sizeof( fields ), 0 );
+
+	// Sampler uniform already set?
+	if( cache.contains( key ) ) { return true; }
 
-	// Find & cache uniform index
+	// Find & set sampler uniform
 	char name[64];
 	snprintf( name, sizeof( name ), "u_texture%d", slot );
 	const GLint location = nglGetUniformLocation( boundShaderResource->program,
@@ -400,8 +401,9 @@ static GLint opengl_texture_uniform_location( HashMap<u32, GLint> &cache, const
 	ErrorReturnIf( location == GL_INVALID_VALUE, false,
 		"OpenGL: Unable to get texture uniform index (Invalid value)" );
 
+	nglUniform1i( location, slot );
 	cache.add( key, location );
-	return location;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -865,6 +867,18 @@ bool GfxCore::rb_vertex_buffer_write( GfxVertexBufferResource *&resource, const
 }
 
 
+void *GfxCore::rb_vertex_buffer_reserve( GfxVertexBufferResource *&resource, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->mapped );
+	Assert( resource->current + size <= resource->size );
+
+	byte *data = resource->data + resource->current;
+	resource->current += size;
+	return data;
+}
+
+
 u32 GfxCore::rb_vertex_buffer_current( GfxVertexBufferResource *&resource )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
@@ -878,6 +892,8 @@ bool GfxCore::rb_constant_buffer_init( GfxConstantBufferResource *&resource, con
 {
 	// Register Constant Buffer
 	Assert( resource == nullptr );
+	ErrorReturnIf( index < 0 || index >= static_cast<int>( GfxCore::constantBufferCount ), false,
+		"OpenGL: constant buffer index out of range (%d)", index );
 	resource = constantBufferResources.make_new();
 	resource->name = name;
 	resource->index = index;
@@ -902,6 +918,7 @@ bool GfxCore::rb_constant_buffer_free( GfxConstantBufferResource *&resource )
 	PROFILE_GFX( Gfx::stats.gpuMemoryConstantBuffers -= resource->size );
 
 	nglDeleteBuffers( 1, &resource->ubo );
+	uniformBufferBindings[resource->index] = GL_NULL;
 	resource->ubo = GL_NULL;
 	constantBufferResources.remove( resource->id );
 	resource = nullptr;
@@ -939,19 +956,27 @@ bool GfxCore::rb_constant_buffer_write( GfxConstantBufferResource *&resource, co
 }
 
 
+static bool opengl_constant_buffer_bind( GfxConstantBufferResource *&resource, const int slot )
+{
+	// Binding points are global (one per cbuffer): rebind only if another buffer took this one
+	const GLuint binding = static_cast<GLuint>( resource->index );
+	Assert( binding < ARRAY_LENGTH( uniformBufferBindings ) );
+	if( uniformBufferBindings[binding] != resource->ubo )
+	{
+		nglBindBufferBase( GL_UNIFORM_BUFFER, binding, resource->ubo );
+		uniformBufferBindings[binding] = resource->ubo;
+	}
+
+	return opengl_constant_buffer_uniform_block_bind( resource, slot );
+}
+
+
 bool GfxCore::rb_constant_buffer_bind_vertex( GfxConstantBufferResource *&resource, const int slot )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 	Assert( slot >= 0 );
 
-	nglBindBuffer( GL_UNIFORM_BUFFER, resource->ubo );
-	nglBindBufferBase( GL_UNIFORM_BUFFER, static_cast<GLuint>( resource->index ), resource->ubo );
-
-	const GLuint blockIndex = opengl_constant_buffer_uniform_block_index( resource, slot );
-	nglUniformBlockBinding( boundShaderResource->program, blockIndex, static_cast<GLuint>( resource->index ) );
-
-	// Success
-	return true;
+	return opengl_constant_buffer_bind( resource, slot );
 }
 
 
@@ -960,14 +985,7 @@ bool GfxCore::rb_constant_buffer_bind_fragment( GfxConstantBufferResource *&reso
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 	Assert( slot >= 0 );
 
-	nglBindBuffer( GL_UNIFORM_BUFFER, resource->ubo );
-	nglBindBufferBase( GL_UNIFORM_BUFFER, static_cast<GLuint>( resource->index ), resource->ubo );
-
-	const GLuint blockIndex = opengl_constant_buffer_uniform_block_index( resource, slot );
-	nglUniformBlockBinding( boundShaderResource->program, blockIndex, static_cast<GLuint>( resource->index ) );
-
-	// Success
-	return true;
+	return opengl_constant_buffer_bind( resource, slot );
 }
 
 
@@ -976,14 +994,7 @@ bool GfxCore::rb_constant_buffer_bind_compute( GfxConstantBufferResource *&resou
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 	Assert( slot >= 0 );
 
-	nglBindBuffer( GL_UNIFORM_BUFFER, resource->ubo );
-	nglBindBufferBase( GL_UNIFORM_BUFFER, static_cast<GLuint>( resource->index ), resource->ubo );
-
-	const GLuint blockIndex = opengl_constant_buffer_uniform_block_index( resource, slot );
-	nglUniformBlockBinding( boundShaderResource->program, blockIndex, static_cast<GLuint>( resource->index ) );
-
-	// Success
-	return true;
+	return opengl_constant_buffer_bind( resource, slot );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1048,8 +1059,7 @@ bool GfxCore::rb_texture_2d_bind( const GfxTexture2DResource *const &resource, c
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 
 	// Bind Texture2D
-	const GLint location = opengl_texture_uniform_location( texture2DUniformLocations, slot );
-	nglUniform1i( location, slot );
+	if( !opengl_texture_uniform_bind( texture2DUniformLocations, slot ) ) { return false; }
 	nglActiveTexture( GL_TEXTURE0 + slot );
 	glBindTexture( GL_TEXTURE_2D, resource->texture );
 
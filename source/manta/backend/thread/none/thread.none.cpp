@@ -7,17 +7,34 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID { };
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *userdata )
 {
 	return nullptr;
 }
 
+
+bool Thread::pin( void *thread, u32 core )
+{
+	return false;
+}
+
+
+u32 Thread::hardware_threads()
+{
+	return 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Mutex::init()
@@ -2,6 +2,7 @@
 
 #include <vendor/pthread.hpp>
 #include <vendor/posix.hpp>
+#include <vendor/string.hpp>
 
 #include <core/debug.hpp>
 
@@ -13,76 +14,103 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+	sched_yield();
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID( pthread_self() );
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *userdata )
 {
 	// Create the thread
 	void *handle;
-	int result = pthread_create( reinterpret_cast<pthread_t *>( &handle ), nullptr, function, nullptr );
+	int result = pthread_create( reinterpret_cast<pthread_t *>( &handle ), nullptr, function, userdata );
 	ErrorIf( result != 0, "POSIX: Failed to create thread!" );
 	return handle;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool Thread::pin( void *thread, u32 core )
+{
+#if OS_LINUX || OS_ANDROID
+	if( core >= sizeof( cpu_set_t ) * 8 ) { return false; }
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	CPU_SET( core, &set );
+	return pthread_setaffinity_np( reinterpret_cast<pthread_t>( thread ), sizeof( cpu_set_t ), &set ) == 0;
+#else
+	// macOS/iOS have no hard affinity API (thread_policy_set is only a hint)
+	return false;
+#endif
+}
+
+
+u32 Thread::hardware_threads()
+{
+	const long count = sysconf( _SC_NPROCESSORS_ONLN );
+	return count > 0 ? static_cast<u32>( count ) : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Mutex::init()
 {
-	//pthread_mutex_init( &mutex, nullptr );
+	pthread_mutex_init( &mutex, nullptr );
 }
 
 
 void Mutex::free()
 {
-	//pthread_mutex_destroy( &mutex );
+	pthread_mutex_destroy( &mutex );
 }
 
 
 void Mutex::lock()
 {
-	//pthread_mutex_lock( &mutex );
+	pthread_mutex_lock( &mutex );
 }
 
 
 void Mutex::unlock()
 {
-	//pthread_mutex_unlock( &mutex );
+	pthread_mutex_unlock( &mutex );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Condition::init()
 {
-	//pthread_cond_init( &condition, nullptr );
+	pthread_cond_init( &condition, nullptr );
 }
 
 
 void Condition::free()
 {
-	//pthread_cond_destroy( &condition );
+	pthread_cond_destroy( &condition );
 }
 
 
 void Condition::sleep( Mutex &mutex )
 {
-	//pthread_cond_wait( &condition, &mutex.mutex );
+	pthread_cond_wait( &condition, &mutex.mutex );
 }
 
 
 void Condition::wake()
 {
-	//pthread_cond_signal( &condition );
+	pthread_cond_signal( &condition );
 }
 
 
 void Condition::wake_all()
 {
-	//pthread_cond_broadcast( &condition );
+	pthread_cond_broadcast( &condition );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
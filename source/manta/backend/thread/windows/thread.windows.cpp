@@ -12,20 +12,41 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+	SwitchToThread();
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID( GetCurrentThreadId() );
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *userdata )
 {
 	// Create the thread
-	void *handle = CreateThread( nullptr, 0, reinterpret_cast<LPTHREAD_START_ROUTINE>( function ), nullptr, 0, nullptr );
+	void *handle = CreateThread( nullptr, 0, reinterpret_cast<LPTHREAD_START_ROUTINE>( function ), userdata, 0, nullptr );
 	ErrorIf( handle == nullptr, "WIN: Failed to create thread!" );
 	return handle;
 }
 
+
+bool Thread::pin( void *thread, u32 core )
+{
+	if( core >= sizeof( UINT_PTR ) * 8 ) { return false; }
+	return SetThreadAffinityMask( thread, static_cast<UINT_PTR>( 1 ) << core ) != 0;
+}
+
+
+u32 Thread::hardware_threads()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	return info.dwNumberOfProcessors > 0 ? static_cast<u32>( info.dwNumberOfProcessors ) : 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
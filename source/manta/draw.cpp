@@ -47,40 +47,32 @@ Align draw_get_valign()
 
 void draw_quad( const float x1, const float y1, const float x2, const float y2, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, 0, 0, 0xFFFF, 0xFFFF, color, nullptr, depth );
-#endif
 }
 
 
 void draw_quad_color( const float x1, const float y1, const float x2, const float y2,
                       const Color c1, const Color c2, const Color c3, const Color c4, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, 0, 0, 0xFFFF, 0xFFFF, c1, c2, c3, c4, nullptr, depth );
-#endif
 }
 
 
 void draw_quad_uv( const float x1, const float y1, const float x2, const float y2,
                    const float u1, const float v1, const float u2, const float v2, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const u16 U1 = static_cast<u16>( u1 * 65535.0 );
 	const u16 V1 = static_cast<u16>( v1 * 65535.0 );
 	const u16 U2 = static_cast<u16>( u2 * 65535.0 );
 	const u16 V2 = static_cast<u16>( v2 * 65535.0 );
 	Gfx::quad_batch_write( x1, y1, x2, y2, U1, V1, U2, V2, color, nullptr, depth );
-#endif
 }
 
 
 void draw_quad_uv( const float  x1, const float  y1, const float  x2, const float  y2,
                    const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, u1, v1, u2, v2, color, nullptr, depth );
-#endif
 }
 
 
@@ -88,13 +80,11 @@ void draw_quad_uv( const float x1, const float y1, const float x2, const float y
                    const float x3, const float y3, const float x4, const float y4,
                    const float u1, const float v1, const float u2, const float v2, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const u16 U1 = static_cast<u16>( u1 * 65535.0 );
 	const u16 V1 = static_cast<u16>( v1 * 65535.0 );
 	const u16 U2 = static_cast<u16>( u2 * 65535.0 );
 	const u16 V2 = static_cast<u16>( v2 * 65535.0 );
 	Gfx::quad_batch_write( x1, y1, x2, y2, x3, y3, x4, y4, U1, V1, U2, V2, color, nullptr, depth );
-#endif
 }
 
 
@@ -102,9 +92,7 @@ void draw_quad_uv( const float x1, const float y1, const float x2, const float y
                    const float x3, const float y3, const float x4, const float y4,
                    const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, x3, y3, x4, y4, u1, v1, u2, v2, color, nullptr, depth );
-#endif
 }
 
 
@@ -112,13 +100,11 @@ void draw_quad_uv( const float x1, const float y1, const float x2, const float y
                          const float u1, const float v1, const float u2, const float v2,
                          const Color c1, const Color c2, const Color c3, const Color c4, const float depth )
 {
-#if !RENDER_NONE
 	const u16 U1 = static_cast<u16>( u1 * 65535.0 );
 	const u16 V1 = static_cast<u16>( v1 * 65535.0 );
 	const u16 U2 = static_cast<u16>( u2 * 65535.0 );
 	const u16 V2 = static_cast<u16>( v2 * 65535.0 );
 	Gfx::quad_batch_write( x1, y1, x2, y2, U1, V1, U2, V2, c1, c2, c3, c4, nullptr, depth );
-#endif
 }*/
 
 
@@ -126,9 +112,7 @@ void draw_quad_uv_color( const float x1, const float y1, const float x2, const f
                          const u16 u1, const u16 v1, const u16 u2, const u16 v2,
                          const Color c1, const Color c2, const Color c3, const Color c4, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, u1, v1, u2, v2, c1, c2, c3, c4, nullptr, depth );
-#endif
 }
 
 
@@ -137,13 +121,11 @@ void draw_quad_uv_color( const float x1, const float y1, const float x2, const f
                          const float u1, const float v1, const float u2, const float v2,
                          const Color c1, const Color c2, const Color c3, const Color c4, const float depth )
 {
-#if !RENDER_NONE
 	const u16 U1 = static_cast<u16>( u1 * 65535.0 );
 	const u16 V1 = static_cast<u16>( v1 * 65535.0 );
 	const u16 U2 = static_cast<u16>( u2 * 65535.0 );
 	const u16 V2 = static_cast<u16>( v2 * 65535.0 );
 	Gfx::quad_batch_write( x1, y1, x2, y2, x3, y3, x4, y4, U1, V1, U2, V2, c1, c2, c3, c4, nullptr, depth );
-#endif
 }
 
 
@@ -152,9 +134,7 @@ void draw_quad_uv_color( const float x1, const float y1, const float x2, const f
                          const u16 u1, const u16 v1, const u16 u2, const u16 v2,
                          const Color c1, const Color c2, const Color c3, const Color c4, const float depth )
 {
-#if !RENDER_NONE
 	Gfx::quad_batch_write( x1, y1, x2, y2, x3, y3, x4, y4, u1, v1, u2, v2, c1, c2, c3, c4, nullptr, depth );
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -162,7 +142,6 @@ void draw_quad_uv_color( const float x1, const float y1, const float x2, const f
 void draw_sprite( const u32 sprite, const u16 subimg, float x, float y, const float xscale, const float yscale,
                   const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const DiskSprite &dSprite = Assets::sprites[sprite];
 	const DiskGlyph &dGlyph = Assets::glyphs[dSprite.glyph + ( subimg % Assets::sprites[sprite].count )];
 	GfxTexture2D *texture = &GfxCore::textures[dSprite.texture];
@@ -175,7 +154,6 @@ void draw_sprite( const u32 sprite, const u16 subimg, float x, float y, const fl
 
 	Gfx::quad_batch_write( x, y, x + width, y + height,
 	                       dGlyph.u1, dGlyph.v1, dGlyph.u2, dGlyph.v2, color, texture, depth );
-#endif
 }
 
 
@@ -183,7 +161,6 @@ void draw_sprite_part( const u32 sprite, const u16 subimg, float x, float y,
                        const float u1, const float v1, const float u2, const float v2,
                        const float xscale, const float yscale, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const DiskSprite &dSprite = Assets::sprites[sprite];
 	const DiskGlyph &dGlyph = Assets::glyphs[dSprite.glyph + subimg];
 	const GfxTexture2D *const texture = &GfxCore::textures[dSprite.texture];
@@ -200,14 +177,12 @@ void draw_sprite_part( const u32 sprite, const u16 subimg, float x, float y,
 	                       dGlyph.u1 + static_cast<u16>( u1 * u ), dGlyph.v1 + static_cast<u16>( v1 * v ),
 	                       dGlyph.u1 + static_cast<u16>( u2 * v ), dGlyph.v1 + static_cast<u16>( v2 * v ),
 	                       color, texture, depth );
-#endif
 }
 
 
 void draw_sprite_angle( const u32 sprite, const u16 subimg, float x, float y, const float angle,
                         const float xscale, const float yscale, const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const DiskSprite &dSprite = Assets::sprites[sprite];
 	const DiskGlyph &dGlyph = Assets::glyphs[dSprite.glyph + subimg];
 	const GfxTexture2D *const texture = &GfxCore::textures[dSprite.texture];
@@ -236,13 +211,11 @@ void draw_sprite_angle( const u32 sprite, const u16 subimg, float x, float y, co
 
 	Gfx::quad_batch_write( x1, y1, x2, y2, x3, y3, x4, y4,
 	                       dGlyph.u1, dGlyph.v1, dGlyph.u2, dGlyph.v2, color, texture, depth );
-#endif
 }
 
 
 void draw_sprite_fast( const u32 sprite, const u16 subimg, float x, float y, const Color color )
 {
-#if !RENDER_NONE
 	const DiskSprite &dSprite = Assets::sprites[sprite];
 	const DiskGlyph &dGlyph = Assets::glyphs[dSprite.glyph + subimg];
 	const GfxTexture2D *const texture = &GfxCore::textures[dSprite.texture];
@@ -252,7 +225,6 @@ void draw_sprite_fast( const u32 sprite, const u16 subimg, float x, float y, con
 
 	Gfx::quad_batch_write( x, y, x + width, y + height,
 	                       dGlyph.u1, dGlyph.v1, dGlyph.u2, dGlyph.v2, color, texture, 0.0f );
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -261,7 +233,6 @@ void draw_render_target_2d( const GfxRenderTarget2D &surface, float x, float y,
                             const float xscale, const float yscale,
                             const Color color, const float depth )
 {
-#if !RENDER_NONE
 	const float x1 = x;
 	const float x2 = x + surface.width * xscale;
 
@@ -280,7 +251,6 @@ void draw_render_target_2d( const GfxRenderTarget2D &surface, float x, float y,
 
 	Assert( surface.textureColor.resource != nullptr );
 	Gfx::quad_batch_write( x1, y1, x2, y2, u1, v1, u2, v2, color, &surface.textureColor, depth );
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -288,7 +258,6 @@ void draw_render_target_2d( const GfxRenderTarget2D &surface, float x, float y,
 void draw_rectangle( const float x1, const float y1, const float x2, const float y2, const Color color,
                      const bool outline, const float depth )
 {
-#if !RENDER_NONE
 	if( outline )
 	{
 		const floatv2 q1[] = { { x1, y1 }, { x1 + 1.0f, y2 } }; // Left
@@ -306,14 +275,12 @@ void draw_rectangle( const float x1, const float y1, const float x2, const float
 		const DiskGlyph &g = nullGlyph;
 		Gfx::quad_batch_write( x1, y1, x2, y2, g.u1, g.v1, g.u2, g.v2, color, nullTexture, depth );
 	}
-#endif
 }
 
 
 void draw_rectangle_angle( const float x1, const float y1, const float x2, const float y2, const float angle,
                            const Color color, const bool outline, const float depth )
 {
-#if !RENDER_NONE
 	if( outline )
 	{
 		if( angle != 0.0f )
@@ -361,7 +328,6 @@ void draw_rectangle_angle( const float x1, const float y1, const float x2, const
 			Gfx::quad_batch_write( x1, y1, x2, y2, g.u1, g.v1, g.u2, g.v2, color, nullTexture, depth );
 		}
 	}
-#endif
 }
 
 
@@ -369,7 +335,6 @@ void draw_rectangle_gradient( const float x1, const float y1, const float x2, co
                               const Color c1, const Color c2, const Color c3, const Color c4,
                               const bool outline, const float depth )
 {
-#if !RENDER_NONE
 	if( outline )
 	{
 		const floatv2 q1[] = { { x1, y1 }, { x1 + 1.0f, y2 } }; // Left
@@ -387,7 +352,6 @@ void draw_rectangle_gradient( const float x1, const float y1, const float x2, co
 		const DiskGlyph &g = nullGlyph;
 		Gfx::quad_batch_write( x1, y1, x2, y2, g.u1, g.v1, g.u2, g.v2, c1, c2, c3, c4, nullTexture, depth );
 	}
-#endif
 }
 
 
@@ -395,7 +359,6 @@ void draw_rectangle_gradient_angle( const float x1, const float y1, const float
                                     const Color c1, const Color c2, const Color c3, const Color c4, const bool outline,
                                     const float depth )
 {
-#if !RENDER_NONE
 	if( outline )
 	{
 		if( angle != 0.0f )
@@ -444,7 +407,6 @@ void draw_rectangle_gradient_angle( const float x1, const float y1, const float
 			Gfx::quad_batch_write( x1, y1, x2, y2, g.u1, g.v1, g.u2, g.v2, c1, c2, c3, c4, nullTexture, depth );
 		}
 	}
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -452,7 +414,6 @@ void draw_rectangle_gradient_angle( const float x1, const float y1, const float
 void draw_line( const float x1, const float y1, const float x2, const float y2,
                 const Color color, const float thickness, const float depth )
 {
-#if !RENDER_NONE
 	if ( x1 == x2 )
 	// X-axis aligned line
 	{
@@ -470,7 +431,6 @@ void draw_line( const float x1, const float y1, const float x2, const float y2,
 		const float length = floatv2_distance( { x1, y1 }, { x2, y2 } );
 		draw_rectangle_angle( x1, y1, x1 + length, y1 + thickness, radtodeg( angle ), color, false, depth );
 	}
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -537,7 +497,6 @@ void draw_circle_outline_gradient( float x, float y, float radius, float thickne
 
 void draw_text( const Font font, const u16 size, const float x, const float y, Color color, const char *string )
 {
-#if !RENDER_NONE
 	Assert( font < Assets::fontsCount );
 	Assert( size > 0 );
 
@@ -591,14 +550,12 @@ void draw_text( const Font font, const u16 size, const float x, const float y, C
 		// Advance Character
 		offsetX += glyphInfo.advance;
 	}
-#endif
 }
 
 
 void draw_text_f( const Font font, const u16 size, const float x, const float y,
                   Color color, const char *format, ... )
 {
-#if !RENDER_NONE
 	va_list args;
 	va_start( args, format );
 	char buffer[1024];
@@ -606,7 +563,6 @@ void draw_text_f( const Font font, const u16 size, const float x, const float y,
 	va_end( args );
 
 	draw_text( font, size, x, y, color, buffer );
-#endif
 }
 
 
@@ -649,7 +605,6 @@ intv2 text_dimensions( const Font font, const u16 size, const char *string )
 
 intv2 text_dimensions_f( const Font font, const u16 size, const char *format, ... )
 {
-#if !RENDER_NONE
 	va_list args;
 	va_start( args, format );
 	char buffer[1024];
@@ -657,7 +612,6 @@ intv2 text_dimensions_f( const Font font, const u16 size, const char *format, ..
 	va_end( args );
 
 	return text_dimensions( font, size, buffer );
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include <manta/assets.hpp>
 #include <manta/time.hpp>
+#include <manta/thread.hpp>
 #include <manta/window.hpp>
 #include <manta/gfx.hpp>
 #include <manta/audio.hpp>
@@ -36,6 +37,9 @@ namespace Engine
 		// Time
 		ErrorReturnIf( !SysTime::init(), false, "Engine: failed to initialize timer" );
 
+		// Jobs
+		ErrorReturnIf( !SysJobs::init(), false, "Engine: failed to initialize job system" );
+
 		// Window
 		ErrorReturnIf( !SysWindow::init(), false, "Engine: failed to initialize window" );
 
@@ -57,6 +61,11 @@ namespace Engine
 		// Console
 		ErrorReturnIf( !SysConsole::init(), false, "Engine: failed to initialize console system" );
 
+#if OBJECT_PROFILER
+		// Object Profiler
+		ErrorReturnIf( !ObjectProfiler::init(), false, "Engine: failed to initialize object profiler" );
+#endif
+
 		// Success
 		return true;
 	}
@@ -84,6 +93,9 @@ namespace Engine
 		// Window
 		ErrorReturnIf( !SysWindow::free(), false, "Engine: failed to free window" );
 
+		// Jobs
+		ErrorReturnIf( !SysJobs::free(), false, "Engine: failed to free job system" );
+
 		// Time
 		ErrorReturnIf( !SysTime::free(), false, "Engine: failed to free timer" );
 
@@ -151,6 +163,11 @@ namespace Engine
 					{
 						// Text Editor
 						TextEditor::listen();
+
+					#if OBJECT_PROFILER
+						// Object Profiler
+						ObjectProfiler::frame();
+					#endif
 					}
 
 					// Show the window after at least 1 frame has been rendered
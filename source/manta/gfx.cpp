@@ -1,4 +1,5 @@
 #include <manta/gfx.hpp>
+#include <manta/gfx.simd.hpp>
 
 #include <vendor/vendor.hpp>
 
@@ -10,9 +11,16 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static bool RENDER_TARGET_BOUND = false;
+static bool QUAD_DEFERRED_ACTIVE = false; // Gfx::quad_batch_deferred_begin()
+static bool QUAD_DEFERRED_DIRTY = false; // Render state changed since the last deferred sort key
+
+
 static inline void draw_call()
 {
 	// TODO: Refactor this
+	if( !GfxCore::rendering ) { return; } // Between frames the batch was already drawn by Gfx::frame_end()
+	if( QUAD_DEFERRED_ACTIVE ) { QUAD_DEFERRED_DIRTY = true; return; } // State goes into the next sort key
 	Gfx::quad_batch_break(); // Break the quad batch
 	// TODO ... break any other batch?
 }
@@ -114,6 +122,16 @@ void debug_overlay_gfx( const float x, const float y )
 		"Shader Binds: %d", stats.frame.shaderBinds );
 	drawY += 20.0f;
 
+	draw_text_f( fnt_iosevka, 14, drawX, drawY, c_white,
+		"Skipped Binds: %d shader, %d texture, %d state", stats.frame.shaderBindsSkipped,
+		stats.frame.textureBindsSkipped, stats.frame.stateBindsSkipped );
+	drawY += 20.0f;
+
+	draw_text_f( fnt_iosevka, 14, drawX, drawY, c_white,
+		"Deferred Quads: %d (batches %d -> %d)", stats.frame.quadsDeferred,
+		stats.frame.batchesUnsorted, stats.frame.batchesSorted );
+	drawY += 20.0f;
+
 	drawY += 20.0f;
 	draw_text_f( fnt_iosevka, 14, drawX, drawY, c_yellow,
 		"GPU Memory Total: %.2f mb", MB( stats.total_memory() ) );
@@ -246,6 +264,59 @@ bool SysGfx::free_shaders()
 }
 
 
+// Raster states carry scissor rects, so their IDs are interned rather than packed: ( generation << 16 ) | index
+// A full table starts a new generation, so stale IDs never match a new state
+
+#define GFX_RASTER_STATE_IDS ( 1024 )
+
+static struct
+{
+	GfxRasterState states[GFX_RASTER_STATE_IDS];
+	u16 table[GFX_RASTER_STATE_IDS * 2]; // Open addressing: index + 1 (0: empty)
+	u32 count = 0;
+	u32 generation = 1;
+} g_rasterStates;
+
+
+static u32 raster_state_id( const GfxRasterState &state )
+{
+	auto &g = g_rasterStates;
+	if( state == GfxRasterState { } ) { return 0; }
+
+	u32 hash = static_cast<u32>( state.fillMode ) | static_cast<u32>( state.cullMode ) << 8 |
+	           static_cast<u32>( state.scissor ) << 16;
+	hash = hash * 31 + static_cast<u32>( state.scissorX1 );
+	hash = hash * 31 + static_cast<u32>( state.scissorY1 );
+	hash = hash * 31 + static_cast<u32>( state.scissorX2 );
+	hash = hash * 31 + static_cast<u32>( state.scissorY2 );
+	hash ^= hash >> 16;
+	hash *= 0x7FEB352D;
+	hash ^= hash >> 15;
+
+	constexpr u32 mask = GFX_RASTER_STATE_IDS * 2 - 1;
+	u32 slot = hash & mask;
+	for( ; g.table[slot] != 0; slot = ( slot + 1 ) & mask )
+	{
+		const u32 index = g.table[slot] - 1;
+		if( g.states[index] == state ) { return g.generation << 16 | index; }
+	}
+
+	// New generation
+	if( UNLIKELY( g.count == GFX_RASTER_STATE_IDS ) )
+	{
+		memory_set( g.table, 0, sizeof( g.table ) );
+		g.count = 0;
+		g.generation = g.generation == 0xFFFF ? 1 : g.generation + 1;
+		slot = hash & mask;
+	}
+
+	const u32 index = g.count++;
+	g.states[index] = state;
+	g.table[slot] = static_cast<u16>( index + 1 );
+	return g.generation << 16 | index;
+}
+
+
 void SysGfx::state_reset()
 {
 	GfxCore::states[0] = { };
@@ -270,22 +341,26 @@ void SysGfx::state_apply( const bool dirty )
 	GfxState &previous = GfxCore::states[!GfxCore::flip];
 
 	// Raster State
-	if( dirty || GFX_STATE_CHECK( current.raster != previous.raster ) )
+	if( dirty || GFX_STATE_CHECK( current.rasterID != previous.rasterID ) )
 		{ GfxCore::rb_set_raster_state( current.raster ); }
+	else { PROFILE_GFX( Gfx::stats.frame.stateBindsSkipped++ ); }
 
 	// Sampler State
-	if( dirty || GFX_STATE_CHECK( current.sampler != previous.sampler ) )
+	if( dirty || GFX_STATE_CHECK( current.samplerID != previous.samplerID ) )
 		{ GfxCore::rb_set_sampler_state( current.sampler ); }
+	else { PROFILE_GFX( Gfx::stats.frame.stateBindsSkipped++ ); }
 
 	// Blend State
-	if( dirty || GFX_STATE_CHECK( current.blend != previous.blend ) )
+	if( dirty || GFX_STATE_CHECK( current.blendID != previous.blendID ) )
 		{ GfxCore::rb_set_blend_state( current.blend ); }
+	else { PROFILE_GFX( Gfx::stats.frame.stateBindsSkipped++ ); }
 
 	// Depth State
-	if( dirty || GFX_STATE_CHECK( current.depth != previous.depth ) )
+	if( dirty || GFX_STATE_CHECK( current.depthID != previous.depthID ) )
 		{ GfxCore::rb_set_depth_state( current.depth ); }
+	else { PROFILE_GFX( Gfx::stats.frame.stateBindsSkipped++ ); }
 
-	// Texture 2D Binding
+	// Texture 2D Binding (slot 0 is only bound here, see GfxTexture2D::bind)
 	if( GFX_STATE_CHECK( current.textureResource[0] != previous.textureResource[0] &&
 	                     current.textureResource[0] != nullptr ) )
 		{ GfxCore::rb_texture_2d_bind( current.textureResource[0], 0 ); }
@@ -297,6 +372,11 @@ void SysGfx::state_apply( const bool dirty )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static void quad_deferred_record( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture );
+static GfxBuiltInQuad *quad_deferred_reserve( const u32 count, const GfxTexture2D *const texture );
+static void quad_deferred_free();
+
+
 namespace SysGfx
 {
 	GfxIndexBuffer quadBatchIndexBuffer;
@@ -340,6 +420,9 @@ bool SysGfx::quad_batch_init()
 
 bool SysGfx::quad_batch_free()
 {
+	quad_deferred_free();
+	quadBatchVertexBuffer.free();
+	quadBatchIndexBuffer.free();
 	return true;
 }
 
@@ -386,8 +469,11 @@ void Gfx::quad_batch_break_check()
 }
 
 
-void Gfx::quad_batch_write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+static inline void quad_batch_submit( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
 {
+	// Deferred: record the quad with its sort key
+	if( UNLIKELY( QUAD_DEFERRED_ACTIVE ) ) { quad_deferred_record( quad, texture ); return; }
+
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
@@ -399,17 +485,17 @@ void Gfx::quad_batch_write( const GfxBuiltInQuad &quad, const GfxTexture2D *cons
 }
 
 
+void Gfx::quad_batch_write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+{
+	quad_batch_submit( quad, texture );
+}
+
+
 void Gfx::quad_batch_write( const float x1, const float y1, const float x2, const float y2,
                             const u16 u1, const u16 v1, const u16 u2, const u16 v2,
                             const Color c1, const Color c2, const Color c3, const Color c4,
                             const GfxTexture2D *const texture, const float depth )
 {
-	// Bind Texture
-	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
-
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -419,7 +505,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x2, y2, depth }, { u2, v2 }, { c4.r, c4.g, c4.b, c4.a } },
 	};
 
-	SysGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_submit( quad, texture );
 }
 
 
@@ -429,12 +515,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
                             const Color c1, const Color c2, const Color c3, const Color c4,
                             const GfxTexture2D *const texture, const float depth )
 {
-	// Bind Texture
-	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
-
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -444,7 +524,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x4, y4, depth }, { u2, v2 }, { c4.r, c4.g, c4.b, c4.a } },
 	};
 
-	SysGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_submit( quad, texture );
 }
 
 
@@ -452,12 +532,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
                             const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
                             const GfxTexture2D *const texture, const float depth )
 {
-	// Bind Texture
-	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
-
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -467,7 +541,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x2, y2, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
 	};
 
-	SysGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_submit( quad, texture );
 }
 
 
@@ -476,13 +550,574 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
                             const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
                             const GfxTexture2D *const texture, const float depth )
 {
+	// Write Quad
+	const GfxBuiltInQuad quad =
+	{
+		{ { x1, y1, depth }, { u1, v1 }, { color.r, color.g, color.b, color.a } },
+		{ { x2, y2, depth }, { u2, v1 }, { color.r, color.g, color.b, color.a } },
+		{ { x3, y3, depth }, { u1, v2 }, { color.r, color.g, color.b, color.a } },
+		{ { x4, y4, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
+	};
+
+	quad_batch_submit( quad, texture );
+}
+
+
+GfxQuadSpan Gfx::quad_batch_reserve( const u32 count, const GfxTexture2D *const texture )
+{
+	// Deferred: the whole span at once, keyed like Gfx::quad_batch_write
+	if( UNLIKELY( QUAD_DEFERRED_ACTIVE ) ) { return { quad_deferred_reserve( count, texture ), count }; }
+
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
 	// Break Batch
-	quad_batch_break_check();
+	Gfx::quad_batch_break_check();
+
+	// Reserve up to the end of the batch
+	const u32 used = SysGfx::quadBatchVertexBuffer.current() / sizeof( GfxBuiltInQuad );
+	const u32 reserve = min( count, static_cast<u32>( RENDER_QUAD_BATCH_SIZE ) - used );
+	void *quads = SysGfx::quadBatchVertexBuffer.reserve( reserve * sizeof( GfxBuiltInQuad ) );
+	return { reinterpret_cast<GfxBuiltInQuad *>( quads ), reserve };
+}
+
+
+// Quad fill kernels see GfxBuiltInQuads, GfxQuadUVs & Colors as 32-bit words (see manta/gfx.simd.hpp)
+static_assert( sizeof( GfxBuiltInQuad ) == sizeof( QuadFillQuad ), "GfxBuiltInQuad does not match QuadFillQuad" );
+static_assert( sizeof( GfxQuadUV ) == 2 * sizeof( u32 ), "GfxQuadUV is not two words" );
+static_assert( sizeof( Color ) == sizeof( u32 ), "Color is not one word" );
+
+
+static inline u32 quad_fill_word( const void *data )
+{
+	u32 word;
+	memory_copy( &word, data, sizeof( word ) );
+	return word;
+}
+
+
+static QuadFillKernel quad_fill_kernel( const GfxQuadFill &fill )
+{
+	// ( u, v ) pairs in memory order, like GfxVertex::BuiltinVertex::uv
+	const u16 uv11[2] = { fill.uv.u1, fill.uv.v1 };
+	const u16 uv21[2] = { fill.uv.u2, fill.uv.v1 };
+	const u16 uv12[2] = { fill.uv.u1, fill.uv.v2 };
+	const u16 uv22[2] = { fill.uv.u2, fill.uv.v2 };
+
+	QuadFillKernel kernel;
+	kernel.x = fill.x;
+	kernel.y = fill.y;
+	kernel.sin = fill.sin;
+	kernel.cos = fill.cos;
+	kernel.uvs = reinterpret_cast<const u32 *>( fill.uvs );
+	kernel.colors = reinterpret_cast<const u32 *>( fill.colors );
+	kernel.width = fill.width;
+	kernel.height = fill.height;
+	kernel.xorigin = fill.xorigin;
+	kernel.yorigin = fill.yorigin;
+	kernel.depth = fill.depth;
+	kernel.uv11 = quad_fill_word( uv11 );
+	kernel.uv21 = quad_fill_word( uv21 );
+	kernel.uv12 = quad_fill_word( uv12 );
+	kernel.uv22 = quad_fill_word( uv22 );
+	kernel.color = quad_fill_word( &fill.color );
+	return kernel;
+}
+
+
+void Gfx::quad_fill( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count )
+{
+	SysGfx::quad_fill( reinterpret_cast<QuadFillQuad *>( quads ), quad_fill_kernel( fill ), first, count );
+}
+
+
+void Gfx::quad_fill_rotated( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count )
+{
+	SysGfx::quad_fill_rotated( reinterpret_cast<QuadFillQuad *>( quads ), quad_fill_kernel( fill ), first, count );
+}
+
+
+void Gfx::quad_fill_scalar( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count )
+{
+	SysGfx::quad_fill_scalar( reinterpret_cast<QuadFillQuad *>( quads ), quad_fill_kernel( fill ), first, count );
+}
+
+
+void Gfx::quad_fill_rotated_scalar( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first,
+	const u32 count )
+{
+	SysGfx::quad_fill_rotated_scalar( reinterpret_cast<QuadFillQuad *>( quads ), quad_fill_kernel( fill ), first,
+		count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Deferred quad batch: every quad is recorded with a 64-bit sort key
+//   layer (16) | blend (8) | shader (8) | raster, sampler, depth & shader globals (16) | texture (16)
+// where all but the layer are indices into per-pass intern tables. quad_batch_deferred_end() radix sorts the keys
+// (stable, so equal keys keep their submission order) and draws each run of equal state as one batch
+
+#define QUAD_DEFERRED_BLENDS ( 256 )
+#define QUAD_DEFERRED_SHADERS ( 256 )
+#define QUAD_DEFERRED_STATES ( 512 )
+#define QUAD_DEFERRED_TEXTURES ( 1024 )
+#define QUAD_DEFERRED_KEY_LAYER ( 48 )
+#define QUAD_DEFERRED_KEY_STATE ( U64_MAX >> 16 ) // Every key bit but the layer
+
+struct QuadDeferredState
+{
+	GfxRasterState raster;
+	GfxSamplerState sampler;
+	GfxDepthState depth;
+	GfxCoreCBuffer::ShaderGlobals_t globals;
+	u32 rasterID;
+	u32 samplerID;
+	u32 depthID;
+};
+
+
+static struct
+{
+	GfxBuiltInQuad *quads = nullptr;
+	u64 *keys = nullptr;
+	u64 *keysTemp = nullptr;
+	u32 *indices = nullptr;
+	u32 *indicesTemp = nullptr;
+	u32 count = 0;
+	u32 capacity = 0;
+
+	u16 layer = 0;
+	u64 keyState = 0; // blend | shader | state bits of the current render state
+	u64 keyTexture = 0;
+	const GfxTexture2DResource *texture = nullptr;
+	bool textureValid = false;
+
+	GfxBlendState blends[QUAD_DEFERRED_BLENDS];
+	u32 blendIDs[QUAD_DEFERRED_BLENDS];
+	GfxShader *shaders[QUAD_DEFERRED_SHADERS];
+	QuadDeferredState states[QUAD_DEFERRED_STATES];
+	GfxTexture2DResource *textures[QUAD_DEFERRED_TEXTURES];
+	u32 blendsCount = 0;
+	u32 shadersCount = 0;
+	u32 statesCount = 0;
+	u32 texturesCount = 0;
+} g_quadDeferred;
+
+
+static void radix_sort_u64( u64 *keys, u32 *values, u64 *keysTemp, u32 *valuesTemp, const u32 count )
+{
+	// Histograms of all eight digits in one pass
+	u32 offsets[8][256] = { { 0 } };
+	for( u32 i = 0; i < count; i++ )
+	{
+		const u64 key = keys[i];
+		for( u32 digit = 0; digit < 8; digit++ ) { offsets[digit][( key >> ( digit * 8 ) ) & 0xFF]++; }
+	}
+
+	u64 *srcKeys = keys, *dstKeys = keysTemp;
+	u32 *srcValues = values, *dstValues = valuesTemp;
+
+	for( u32 digit = 0; digit < 8; digit++ )
+	{
+		const u32 shift = digit * 8;
+		u32 *offset = offsets[digit];
+		if( offset[( srcKeys[0] >> shift ) & 0xFF] == count ) { continue; } // every key shares this byte
+
+		// Prefix sum
+		u32 total = 0;
+		for( u32 i = 0; i < 256; i++ ) { const u32 n = offset[i]; offset[i] = total; total += n; }
+
+		// Scatter (stable)
+		for( u32 i = 0; i < count; i++ )
+		{
+			const u32 slot = offset[( srcKeys[i] >> shift ) & 0xFF]++;
+			dstKeys[slot] = srcKeys[i];
+			dstValues[slot] = srcValues[i];
+		}
+
+		u64 *swapKeys = srcKeys; srcKeys = dstKeys; dstKeys = swapKeys;
+		u32 *swapValues = srcValues; srcValues = dstValues; dstValues = swapValues;
+	}
+
+	// Result must end up in keys/values
+	if( srcKeys != keys )
+	{
+		memory_copy( keys, srcKeys, count * sizeof( u64 ) );
+		memory_copy( values, srcValues, count * sizeof( u32 ) );
+	}
+}
+
+
+static bool radix_sorted_u64( const u64 *keys, const u32 count )
+{
+	for( u32 i = 1; i < count; i++ ) { if( keys[i - 1] > keys[i] ) { return false; } }
+	return true;
+}
+
+
+static GfxShader *quad_deferred_shader( const GfxShaderResource *resource )
+{
+	for( u32 i = 0; i < Gfx::shadersCount; i++ )
+	{
+		if( GfxCore::shaders[i].resource == resource ) { return &GfxCore::shaders[i]; }
+	}
+
+	AssertMsg( false, "Deferred quad batch: bound shader is not a GfxCore shader" );
+	return &GfxCore::shaders[SHADER_DEFAULT];
+}
+
+
+static void quad_deferred_apply( const GfxBlendState &blend, GfxShader *shader, const QuadDeferredState &state,
+	GfxTexture2DResource *texture )
+{
+	// Regular state setters: each one only breaks the batch when its state actually changes
+	Gfx::set_blend_state( blend );
+	if( Gfx::state().shader.resource != shader->resource ) { shader->bind(); }
+	Gfx::set_raster_state( state.raster );
+	Gfx::set_sampler_state( state.sampler );
+	Gfx::set_depth_state( state.depth );
+	Gfx::set_shader_globals( state.globals );
+
+	// Runs recorded before any texture was bound draw with the default sprite's texture (see draw.cpp 'nullTexture');
+	// skipping the bind would leave the previous run's texture on slot 0
+	if( texture == nullptr )
+	{
+		GfxCore::textures[Assets::sprites[SPRITE_DEFAULT].texture].bind( 0 );
+		return;
+	}
+
+	GfxTexture2D texture2D;
+	texture2D.resource = texture;
+	texture2D.bind( 0 );
+}
+
+
+static void quad_deferred_flush()
+{
+	auto &d = g_quadDeferred;
+	const u32 count = d.count;
+
+	// Intern tables (and therefore cached keys) are per flush
+	d.count = 0;
+	d.blendsCount = 0;
+	d.shadersCount = 0;
+	d.statesCount = 0;
+	d.texturesCount = 0;
+	d.textureValid = false;
+	QUAD_DEFERRED_DIRTY = true;
+	if( count == 0 ) { return; }
+
+#if PROFILING_GFX
+	u32 batchesUnsorted = 1;
+	for( u32 i = 1; i < count; i++ )
+	{
+		batchesUnsorted += ( d.keys[i] & QUAD_DEFERRED_KEY_STATE ) != ( d.keys[i - 1] & QUAD_DEFERRED_KEY_STATE );
+	}
+	PROFILE_GFX( Gfx::stats.frame.quadsDeferred += count );
+	PROFILE_GFX( Gfx::stats.frame.batchesUnsorted += batchesUnsorted );
+#endif
+
+	// Sort
+	for( u32 i = 0; i < count; i++ ) { d.indices[i] = i; }
+	if( !radix_sorted_u64( d.keys, count ) ) { radix_sort_u64( d.keys, d.indices, d.keysTemp, d.indicesTemp, count ); }
+
+	// Draw (immediate mode; state setters break the batch between runs)
+	QUAD_DEFERRED_ACTIVE = false;
+	const GfxState cache = Gfx::state();
+
+	u64 keyPrevious = U64_MAX; // Masked keys never have the layer bits set
+	for( u32 i = 0; i < count; i++ )
+	{
+		const u64 key = d.keys[i] & QUAD_DEFERRED_KEY_STATE;
+		if( key != keyPrevious )
+		{
+			keyPrevious = key;
+			quad_deferred_apply( d.blends[( key >> 40 ) & 0xFF], d.shaders[( key >> 32 ) & 0xFF],
+				d.states[( key >> 16 ) & 0xFFFF], d.textures[key & 0xFFFF] );
+			PROFILE_GFX( Gfx::stats.frame.batchesSorted++ );
+		}
+
+		Gfx::quad_batch_break_check();
+		SysGfx::quadBatchVertexBuffer.write( d.quads[d.indices[i]] );
+	}
+
+	// Restore the render state the caller set last
+	const QuadDeferredState state = { cache.raster, cache.sampler, cache.depth, cache.shader.globals,
+	                                  cache.rasterID, cache.samplerID, cache.depthID };
+	quad_deferred_apply( cache.blend, quad_deferred_shader( cache.shader.resource ), state, cache.textureResource[0] );
+	QUAD_DEFERRED_ACTIVE = true;
+}
+
+
+static bool quad_deferred_key_state()
+{
+	auto &d = g_quadDeferred;
+	const GfxState &current = Gfx::state();
+
+	// Blend
+	u32 blend = d.blendsCount;
+	while( blend > 0 && d.blendIDs[blend - 1] != current.blendID ) { blend--; }
+	if( blend-- == 0 )
+	{
+		if( d.blendsCount == QUAD_DEFERRED_BLENDS ) { return false; }
+		blend = d.blendsCount++;
+		d.blends[blend] = current.blend;
+		d.blendIDs[blend] = current.blendID;
+	}
+
+	// Shader
+	GfxShader *const shader = quad_deferred_shader( current.shader.resource );
+	u32 shaderIndex = d.shadersCount;
+	while( shaderIndex > 0 && d.shaders[shaderIndex - 1] != shader ) { shaderIndex--; }
+	if( shaderIndex-- == 0 )
+	{
+		if( d.shadersCount == QUAD_DEFERRED_SHADERS ) { return false; }
+		shaderIndex = d.shadersCount++;
+		d.shaders[shaderIndex] = shader;
+	}
+
+	// Raster, Sampler, Depth & Shader Globals (most recent first)
+	u32 state = d.statesCount;
+	while( state > 0 )
+	{
+		QuadDeferredState &other = d.states[state - 1];
+		if( other.rasterID == current.rasterID && other.samplerID == current.samplerID &&
+		    other.depthID == current.depthID && other.globals == current.shader.globals ) { break; }
+		state--;
+	}
+	if( state-- == 0 )
+	{
+		if( d.statesCount == QUAD_DEFERRED_STATES ) { return false; }
+		state = d.statesCount++;
+		d.states[state] = { current.raster, current.sampler, current.depth, current.shader.globals,
+		                    current.rasterID, current.samplerID, current.depthID };
+	}
+
+	d.keyState = ( static_cast<u64>( blend ) << 40 ) | ( static_cast<u64>( shaderIndex ) << 32 ) |
+	             ( static_cast<u64>( state ) << 16 );
+	return true;
+}
+
+
+static bool quad_deferred_key_texture( GfxTexture2DResource *texture )
+{
+	auto &d = g_quadDeferred;
+
+	u32 index = d.texturesCount;
+	while( index > 0 && d.textures[index - 1] != texture ) { index--; }
+	if( index-- == 0 )
+	{
+		if( d.texturesCount == QUAD_DEFERRED_TEXTURES ) { return false; }
+		index = d.texturesCount++;
+		d.textures[index] = texture;
+	}
+
+	d.keyTexture = index;
+	d.texture = texture;
+	d.textureValid = true;
+	return true;
+}
+
+
+static GfxBuiltInQuad *quad_deferred_reserve( const u32 count, const GfxTexture2D *const texture )
+{
+	auto &d = g_quadDeferred;
+	GfxTexture2DResource *resource = texture != nullptr ? texture->resource : Gfx::state().textureResource[0];
+
+	// Sort key (a full intern table draws what is recorded so far and starts over)
+	for( ;; )
+	{
+		if( UNLIKELY( QUAD_DEFERRED_DIRTY ) )
+		{
+			if( !quad_deferred_key_state() ) { quad_deferred_flush(); continue; }
+			QUAD_DEFERRED_DIRTY = false;
+		}
+
+		if( UNLIKELY( !d.textureValid || d.texture != resource ) )
+		{
+			if( !quad_deferred_key_texture( resource ) ) { quad_deferred_flush(); continue; }
+		}
+
+		break;
+	}
+
+	// Grow
+	if( UNLIKELY( d.count + count > d.capacity ) )
+	{
+		u32 capacity = d.capacity == 0 ? RENDER_QUAD_BATCH_SIZE : d.capacity * 2;
+		while( capacity < d.count + count ) { capacity *= 2; }
+		#define QUAD_DEFERRED_GROW( array, type ) array = reinterpret_cast<type *>( array == nullptr ? \
+			memory_alloc( capacity * sizeof( type ) ) : memory_realloc( array, capacity * sizeof( type ) ) );
+		QUAD_DEFERRED_GROW( d.quads, GfxBuiltInQuad );
+		QUAD_DEFERRED_GROW( d.keys, u64 );
+		QUAD_DEFERRED_GROW( d.keysTemp, u64 );
+		QUAD_DEFERRED_GROW( d.indices, u32 );
+		QUAD_DEFERRED_GROW( d.indicesTemp, u32 );
+		#undef QUAD_DEFERRED_GROW
+		ErrorIf( d.quads == nullptr || d.keys == nullptr || d.keysTemp == nullptr ||
+		         d.indices == nullptr || d.indicesTemp == nullptr,
+			"%s: failed to grow deferred quad batch to %u quads", __FUNCTION__, capacity );
+		d.capacity = capacity;
+	}
+
+	// Keys (the caller writes the quads)
+	const u64 key = ( static_cast<u64>( d.layer ) << QUAD_DEFERRED_KEY_LAYER ) | d.keyState | d.keyTexture;
+	for( u32 i = 0; i < count; i++ ) { d.keys[d.count + i] = key; }
+	GfxBuiltInQuad *quads = &d.quads[d.count];
+	d.count += count;
+	return quads;
+}
+
+
+static void quad_deferred_record( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+{
+	*quad_deferred_reserve( 1, texture ) = quad;
+}
+
+
+static void quad_deferred_free()
+{
+	auto &d = g_quadDeferred;
+	if( d.quads != nullptr ) { memory_free( d.quads ); d.quads = nullptr; }
+	if( d.keys != nullptr ) { memory_free( d.keys ); d.keys = nullptr; }
+	if( d.keysTemp != nullptr ) { memory_free( d.keysTemp ); d.keysTemp = nullptr; }
+	if( d.indices != nullptr ) { memory_free( d.indices ); d.indices = nullptr; }
+	if( d.indicesTemp != nullptr ) { memory_free( d.indicesTemp ); d.indicesTemp = nullptr; }
+	d.count = 0;
+	d.capacity = 0;
+}
+
+
+void Gfx::quad_batch_deferred_begin()
+{
+	AssertMsg( GfxCore::rendering, "Deferred quad batch must begin between Gfx::frame_begin() & Gfx::frame_end()" );
+	AssertMsg( !QUAD_DEFERRED_ACTIVE, "Deferred quad batch already began" );
+	AssertMsg( !RENDER_TARGET_BOUND, "Deferred quad batch can't begin while a render target is bound" );
+
+	QUAD_DEFERRED_ACTIVE = true;
+	QUAD_DEFERRED_DIRTY = true;
+	g_quadDeferred.layer = 0;
+	g_quadDeferred.textureValid = false;
+}
+
+
+void Gfx::quad_batch_deferred_end()
+{
+	AssertMsg( QUAD_DEFERRED_ACTIVE, "Deferred quad batch did not begin" );
+	quad_deferred_flush();
+	QUAD_DEFERRED_ACTIVE = false;
+}
+
+
+void Gfx::quad_batch_deferred_layer( const u16 layer )
+{
+	g_quadDeferred.layer = layer;
+}
+
+
+bool Gfx::quad_batch_deferred()
+{
+	return QUAD_DEFERRED_ACTIVE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GfxQuadArena::init( const u32 reserve )
+{
+	Assert( quads == nullptr && ranges == nullptr );
+	capacity = reserve > 0 ? reserve : 1;
+	rangesCapacity = 64;
+	quads = reinterpret_cast<GfxBuiltInQuad *>( memory_alloc( capacity * sizeof( GfxBuiltInQuad ) ) );
+	ranges = reinterpret_cast<GfxQuadArenaRange *>( memory_alloc( rangesCapacity * sizeof( GfxQuadArenaRange ) ) );
+	ErrorIf( quads == nullptr || ranges == nullptr, "%s: failed to allocate quad arena (%u quads)",
+		__FUNCTION__, capacity );
+	clear();
+}
+
+
+void GfxQuadArena::free()
+{
+	if( quads != nullptr ) { memory_free( quads ); quads = nullptr; }
+	if( ranges != nullptr ) { memory_free( ranges ); ranges = nullptr; }
+	count = 0;
+	capacity = 0;
+	rangesCount = 0;
+	rangesCapacity = 0;
+}
+
+
+void GfxQuadArena::clear()
+{
+	count = 0;
+	rangesCount = 0;
+	shader = SHADER_DEFAULT;
+}
+
+
+void GfxQuadArena::range_begin( GfxTexture2DResource *texture )
+{
+	if( UNLIKELY( rangesCount == rangesCapacity ) )
+	{
+		rangesCapacity *= 2;
+		ranges = reinterpret_cast<GfxQuadArenaRange *>(
+			memory_realloc( ranges, rangesCapacity * sizeof( GfxQuadArenaRange ) ) );
+		ErrorIf( ranges == nullptr, "%s: failed to grow quad arena ranges (%u)", __FUNCTION__, rangesCapacity );
+	}
+
+	ranges[rangesCount++] = { texture, shader, count, 0 };
+}
+
+
+void GfxQuadArena::grow()
+{
+	capacity *= 2;
+	quads = reinterpret_cast<GfxBuiltInQuad *>( memory_realloc( quads, capacity * sizeof( GfxBuiltInQuad ) ) );
+	ErrorIf( quads == nullptr, "%s: failed to grow quad arena (%u quads)", __FUNCTION__, capacity );
+}
+
+
+void GfxQuadArena::write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+{
+	Assert( quads != nullptr );
+
+	// Range (nullptr continues the current texture, like Gfx::quad_batch_write)
+	GfxQuadArenaRange *range = rangesCount > 0 ? &ranges[rangesCount - 1] : nullptr;
+	GfxTexture2DResource *resource = texture != nullptr ? texture->resource :
+		( range != nullptr ? range->texture : nullptr );
+	if( UNLIKELY( range == nullptr || range->texture != resource || range->shader != shader ) )
+	{
+		range_begin( resource );
+		range = &ranges[rangesCount - 1];
+	}
 
 	// Write Quad
+	if( UNLIKELY( count == capacity ) ) { grow(); }
+	quads[count++] = quad;
+	range->count++;
+}
+
+
+void GfxQuadArena::write( const float x1, const float y1, const float x2, const float y2,
+                          const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
+                          const GfxTexture2D *const texture, const float depth )
+{
+	const GfxBuiltInQuad quad =
+	{
+		{ { x1, y1, depth }, { u1, v1 }, { color.r, color.g, color.b, color.a } },
+		{ { x2, y1, depth }, { u2, v1 }, { color.r, color.g, color.b, color.a } },
+		{ { x1, y2, depth }, { u1, v2 }, { color.r, color.g, color.b, color.a } },
+		{ { x2, y2, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
+	};
+
+	write( quad, texture );
+}
+
+
+void GfxQuadArena::write( const float x1, const float y1, const float x2, const float y2,
+                          const float x3, const float y3, const float x4, const float y4,
+                          const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
+                          const GfxTexture2D *const texture, const float depth )
+{
 	const GfxBuiltInQuad quad =
 	{
 		{ { x1, y1, depth }, { u1, v1 }, { color.r, color.g, color.b, color.a } },
@@ -491,7 +1126,50 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x4, y4, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
 	};
 
-	SysGfx::quadBatchVertexBuffer.write( quad );
+	write( quad, texture );
+}
+
+
+void Gfx::quad_arena_submit( const GfxQuadArena &arena )
+{
+	AssertMsg( GfxCore::rendering, "Quad arenas must be submitted between Gfx::frame_begin() & Gfx::frame_end()" );
+	GfxShader *const shaderCache = quad_deferred_shader( Gfx::state().shader.resource );
+
+	for( u32 i = 0; i < arena.rangesCount; i++ )
+	{
+		const GfxQuadArenaRange &range = arena.ranges[i];
+		if( range.count == 0 ) { continue; }
+
+		// State
+		GfxTexture2D texture;
+		texture.resource = range.texture;
+		GfxCore::shaders[range.shader].bind();
+
+		// Deferred: the range shares one sort key, so it is reserved & copied in bulk
+		if( QUAD_DEFERRED_ACTIVE )
+		{
+			GfxBuiltInQuad *quads = quad_deferred_reserve( range.count, range.texture != nullptr ? &texture : nullptr );
+			memory_copy( quads, &arena.quads[range.start], range.count * sizeof( GfxBuiltInQuad ) );
+			continue;
+		}
+
+		if( range.texture != nullptr ) { texture.bind( 0 ); }
+
+		// Bulk copy, split where the quad batch fills up
+		const GfxBuiltInQuad *quads = &arena.quads[range.start];
+		u32 remaining = range.count;
+		while( remaining > 0 )
+		{
+			Gfx::quad_batch_break_check();
+			const u32 used = SysGfx::quadBatchVertexBuffer.current() / sizeof( GfxBuiltInQuad );
+			const u32 copy = min( remaining, static_cast<u32>( RENDER_QUAD_BATCH_SIZE ) - used );
+			SysGfx::quadBatchVertexBuffer.write( quads, copy * sizeof( GfxBuiltInQuad ) );
+			quads += copy;
+			remaining -= copy;
+		}
+	}
+
+	shaderCache->bind();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -514,10 +1192,12 @@ void GfxTexture2D::free()
 void GfxTexture2D::bind( const int slot ) const
 {
 	// Texture binding forces a batch break
-	if( Gfx::state().textureResource[slot] == resource ) { return; }
+	if( Gfx::state().textureResource[slot] == resource ) { PROFILE_GFX( Gfx::stats.frame.textureBindsSkipped++ ); return; }
 	draw_call();
 
+	// Slot 0 is bound by SysGfx::state_apply() at the next draw
 	Gfx::state().textureResource[slot] = resource;
+	if( slot == 0 ) { return; }
 	ErrorIf( !GfxCore::rb_texture_2d_bind( resource, slot ),
 		"Failed to bind Texture2D to slot %d!", slot );
 }
@@ -530,7 +1210,6 @@ void GfxTexture2D::release() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static bool RENDER_TARGET_BOUND = false;
 static Matrix RT_CACHE_MATRIX_MODEL;
 static Matrix RT_CACHE_MATRIX_VIEW;
 static Matrix RT_CACHE_MATRIX_PERSPECTIVE;
@@ -561,6 +1240,8 @@ void GfxRenderTarget2D::bind( const int slot ) const
 {
 	AssertMsg( !RENDER_TARGET_BOUND,
 		"Trying to bind render target to slot that is already bound!" );
+	AssertMsg( !QUAD_DEFERRED_ACTIVE,
+		"Trying to bind render target during a deferred quad batch!" );
 	RENDER_TARGET_BOUND = true;
 
 	// Render target binding forces draw call
@@ -643,14 +1324,21 @@ void GfxShader::free()
 
 void GfxShader::bind()
 {
+	// Rebinding the bound shader skips the program bind & batch break; its cbuffer slots are always rebound (user code
+	// may have bound another cbuffer to one of them) and the backend slot caches drop the redundant ones
 	if( Gfx::state().shader.resource != resource )
 	{
 		draw_call(); // Shader changes force batch break
 		Gfx::state().shader.resource = resource;
+
+		ErrorIf( !GfxCore::rb_shader_bind( resource ),
+			"Failed to bind shader!" );
+	}
+	else
+	{
+		PROFILE_GFX( Gfx::stats.frame.shaderBindsSkipped++ );
 	}
 
-	ErrorIf( !GfxCore::rb_shader_bind( resource ),
-		"Failed to bind shader!" );
 	ErrorIf( !GfxCore::rb_shader_bind_constant_buffers_vertex[shaderID](),
 		"Failed to bind vertex shader cbuffers! (%u)", this->shaderID );
 	ErrorIf( !GfxCore::rb_shader_bind_constant_buffers_fragment[shaderID](),
@@ -703,6 +1391,9 @@ void Gfx::frame_begin()
 
 void Gfx::frame_end()
 {
+	// Deferred Quad Batch
+	if( QUAD_DEFERRED_ACTIVE ) { Gfx::quad_batch_deferred_end(); }
+
 	// Stop Rendering
 	GfxCore::rendering = false;
 
@@ -855,6 +1546,7 @@ void Gfx::set_raster_state( const GfxRasterState &state )
 	if( Gfx::state().raster == state ) { return; }
 	draw_call();
 	Gfx::state().raster = state;
+	Gfx::state().rasterID = raster_state_id( state );
 }
 
 
@@ -914,9 +1606,11 @@ void Gfx::reset_scissor()
 void Gfx::set_sampler_state( const GfxSamplerState &state )
 {
 	// Sampler state changes force a batch break
-	if( Gfx::state().sampler == state ) { return; }
+	const u32 id = state.id();
+	if( Gfx::state().samplerID == id ) { return; }
 	draw_call();
 	Gfx::state().sampler = state;
+	Gfx::state().samplerID = id;
 }
 
 
@@ -939,9 +1633,11 @@ void Gfx::set_uv_wrap_mode( const GfxUVWrapMode &mode )
 void Gfx::set_blend_state( const GfxBlendState &state )
 {
 	// Blend state changes force a batch break
-	if( Gfx::state().blend == state ) { return; }
+	const u32 id = state.id();
+	if( Gfx::state().blendID == id ) { return; }
 	draw_call();
 	Gfx::state().blend = state;
+	Gfx::state().blendID = id;
 }
 
 
@@ -984,9 +1680,11 @@ void Gfx::set_color_write_mask( const GfxColorWriteFlag &mask )
 void Gfx::set_depth_state( const GfxDepthState &state )
 {
 	// Depth state changes force a batch break
-	if( Gfx::state().depth == state ) { return; }
+	const u32 id = state.id();
+	if( Gfx::state().depthID == id ) { return; }
 	draw_call();
 	Gfx::state().depth = state;
+	Gfx::state().depthID = id;
 }
 
 
@@ -27,6 +27,12 @@ struct GfxStatisticsFrame
 	u32 bufferMaps = 0;
 	u32 textureBinds = 0;
 	u32 shaderBinds = 0;
+	u32 shaderBindsSkipped = 0; // Shader (and its cbuffer slots) already bound
+	u32 textureBindsSkipped = 0; // Texture already bound to the slot
+	u32 stateBindsSkipped = 0; // Raster/sampler/blend/depth state IDs unchanged at a draw
+	u32 quadsDeferred = 0;
+	u32 batchesUnsorted = 0; // Deferred quad batches in submission order
+	u32 batchesSorted = 0; // Deferred quad batches drawn (sorted by key & merged)
 };
 
 struct GfxStatistics
@@ -110,6 +116,13 @@ struct GfxBuiltInQuad
 	GfxVertex::BuiltinVertex v1, v2, v3, v4;
 };
 
+
+struct GfxQuadSpan
+{
+	GfxBuiltInQuad *quads;
+	u32 count;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 enum_type( GfxColorFormat, u8 )
@@ -369,6 +382,11 @@ struct GfxSamplerState // TODO: Per texture?
 	{
 		return filterMode == other.filterMode && wrapMode == other.wrapMode;
 	}
+
+	u32 id() const
+	{
+		return static_cast<u32>( filterMode ) | static_cast<u32>( wrapMode ) << 8;
+	}
 };
 
 
@@ -394,6 +412,19 @@ struct GfxBlendState
 			   blendOperationAlpha == other.blendOperationAlpha &&
 			   colorWriteMask == other.colorWriteMask;
 	}
+
+	u32 id() const
+	{
+		static_assert( GFXBLENDFACTOR_COUNT <= 16 && GFXBLENDOPERATION_COUNT <= 8, "GfxBlendState::id() overflow" );
+		return static_cast<u32>( blendEnable ) |
+		       static_cast<u32>( srcFactorColor ) << 1 |
+		       static_cast<u32>( dstFactorColor ) << 5 |
+		       static_cast<u32>( blendOperationColor ) << 9 |
+		       static_cast<u32>( srcFactorAlpha ) << 12 |
+		       static_cast<u32>( dstFactorAlpha ) << 16 |
+		       static_cast<u32>( blendOperationAlpha ) << 20 |
+		       static_cast<u32>( colorWriteMask ) << 23;
+	}
 };
 
 
@@ -406,6 +437,11 @@ struct GfxDepthState
 	{
 		return depthTestMode == other.depthTestMode && depthWriteMask == other.depthWriteMask;
 	}
+
+	u32 id() const
+	{
+		return static_cast<u32>( depthTestMode ) | static_cast<u32>( depthWriteMask ) << 8;
+	}
 };
 
 
@@ -479,6 +515,7 @@ namespace GfxCore
 	extern void rb_vertex_buffer_write_begin( GfxVertexBufferResource *&resource );
 	extern void rb_vertex_buffer_write_end( GfxVertexBufferResource *&resource );
 	extern bool rb_vertex_buffer_write( GfxVertexBufferResource *&resource, const void *const data, const u32 size );
+	extern void *rb_vertex_buffer_reserve( GfxVertexBufferResource *&resource, const u32 size );
 
 	extern u32 rb_vertex_buffer_current( GfxVertexBufferResource *&resource );
 }
@@ -533,10 +570,16 @@ struct GfxVertexBuffer
 		GfxCore::rb_vertex_buffer_write( resource, &element, sizeof( element ) );
 	}
 
-	void write( void *data, const usize size )
+	void write( const void *data, const usize size )
 	{
 		GfxCore::rb_vertex_buffer_write( resource, data, size );
 	}
+
+	// Advances the write position by 'size' bytes and returns the mapped memory behind it (written by the caller)
+	void *reserve( const usize size )
+	{
+		return GfxCore::rb_vertex_buffer_reserve( resource, size );
+	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -786,6 +829,12 @@ struct GfxState
 	GfxDepthState depth;
 	GfxShaderState shader;
 
+	// 32-bit state IDs (equal IDs mean equal states), compared by SysGfx::state_apply()
+	u32 rasterID = 0; // Interned (0: default GfxRasterState)
+	u32 samplerID = GfxSamplerState { }.id();
+	u32 blendID = GfxBlendState { }.id();
+	u32 depthID = GfxDepthState { }.id();
+
 	GfxTexture2DResource *textureResource[32];
 };
 
@@ -820,6 +869,72 @@ namespace GfxCore
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if RENDER_NONE
+// Headless backend (-gfx=none): no GPU work, buffers & textures are kept in CPU memory and every backend call is
+// logged per frame, so the CPU side of rendering can be measured and command streams diffed without a GPU
+
+enum_type( GfxHeadlessCommandType, u8 )
+{
+	GfxHeadlessCommandType_CLEAR_COLOR = 0,        // value: rgba
+	GfxHeadlessCommandType_CLEAR_DEPTH,            // value: depth (float bits)
+	GfxHeadlessCommandType_SWAPCHAIN_RESIZE,       // value: width | height << 16, slot: fullscreen
+	GfxHeadlessCommandType_VIEWPORT_RESIZE,        // value: width | height << 16, slot: fullscreen
+	GfxHeadlessCommandType_RASTER_STATE,           // value: state hash
+	GfxHeadlessCommandType_SAMPLER_STATE,          // value: filter | wrap << 8
+	GfxHeadlessCommandType_BLEND_STATE,            // value: packed state
+	GfxHeadlessCommandType_DEPTH_STATE,            // value: test | write << 8
+	GfxHeadlessCommandType_SHADER_BIND,            // resource: shader ID
+	GfxHeadlessCommandType_CONSTANT_BUFFER_WRITE,  // resource: cbuffer index, value: data checksum
+	GfxHeadlessCommandType_CONSTANT_BUFFER_BIND,   // resource: cbuffer index, slot: slot | stage << 6
+	GfxHeadlessCommandType_TEXTURE_BIND,           // resource: texture, slot: slot
+	GfxHeadlessCommandType_TEXTURE_RELEASE,        // slot: slot
+	GfxHeadlessCommandType_RENDER_TARGET_BIND,     // resource: render target
+	GfxHeadlessCommandType_RENDER_TARGET_RELEASE,
+	GfxHeadlessCommandType_VERTEX_BUFFER_MAP,      // resource: vertex buffer
+	GfxHeadlessCommandType_VERTEX_BUFFER_UNMAP,    // resource: vertex buffer, value: bytes written
+	GfxHeadlessCommandType_DRAW,                   // resource: vertex buffer, value: vertices
+	GfxHeadlessCommandType_DRAW_INDEXED,           // resource: vertex buffer, value: vertices
+	GFXHEADLESSCOMMANDTYPE_COUNT,
+};
+
+
+struct GfxHeadlessCommand
+{
+	GfxHeadlessCommandType type;
+	u8 slot;
+	u16 reserved; // Zero (commands are checksummed as bytes)
+	u32 resource;
+	u32 value;
+};
+static_assert( sizeof( GfxHeadlessCommand ) == 12, "GfxHeadlessCommand must stay packed" );
+
+
+struct GfxHeadlessFrame
+{
+	const GfxHeadlessCommand *commands = nullptr;
+	u32 count = 0;
+	u32 dropped = 0; // Commands past RENDER_HEADLESS_COMMANDS (not logged, still checksummed)
+	u32 frame = 0;
+	u32 checksum = 0;
+	u32 drawCalls = 0;
+	u32 vertexCount = 0;
+};
+
+
+namespace Gfx
+{
+	// Last finished frame (valid until the next Gfx::frame_end)
+	extern GfxHeadlessFrame headless_frame();
+	extern const char *headless_command_name( const GfxHeadlessCommandType type );
+
+	// CPU copies of GPU resources
+	extern const void *headless_vertex_buffer_data( const GfxVertexBufferResource *resource, u32 &size );
+	extern const void *headless_texture_2d_data( const GfxTexture2DResource *resource, u32 &size );
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 namespace SysGfx
 {
 	extern bool init();
@@ -939,6 +1054,121 @@ namespace Gfx
 	                              const float x3, const float y3, const float x4, const float y4,
 	                              const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
 	                              const GfxTexture2D *const texture = nullptr, const float depth = 0.0f );
+
+	// Reserves up to 'count' quads in place: the span points into the mapped quad batch (or the deferred quads) and
+	// ends where the batch fills up, so callers loop until every quad is reserved. The span must be filled before the
+	// next Gfx call (see Gfx::quad_fill)
+	extern GfxQuadSpan quad_batch_reserve( const u32 count, const GfxTexture2D *const texture = nullptr );
+
+	// Deferred Quad Batch (opt-in): quads written between begin & end are keyed by layer, blend state, shader,
+	// other render state & texture, then radix-sorted and merged into as few batches as possible at end
+	// Within a layer, overlapping quads with different states may draw in any order (use layers to order them)
+	// Render targets must not be bound while deferring; Gfx::frame_end() ends an open deferred batch
+	extern void quad_batch_deferred_begin();
+	extern void quad_batch_deferred_end();
+	extern void quad_batch_deferred_layer( const u16 layer );
+	extern bool quad_batch_deferred();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quad Fills: bulk writes of many quads from per-quad arrays (particles, tilemaps), typically straight into a
+// Gfx::quad_batch_reserve() span. Quad k reads element 'first + k' of each array; a nullptr array repeats the shared
+// value. Axis-aligned quads span ( x, y ) to ( x + width, y + height ) like draw_sprite_fast(); rotated quads match
+// draw_sprite_angle() with the origin at ( x, y ) and per-quad sin & cos (see fast_sin_cos). Rotated fills use SIMD
+// (see manta/gfx.simd.hpp); axis-aligned fills are store-bound and stay scalar
+
+struct GfxQuadUV
+{
+	u16 u1, v1, u2, v2;
+};
+
+
+struct GfxQuadFill
+{
+	const float *x = nullptr;
+	const float *y = nullptr;
+	const float *sin = nullptr; // Rotated only
+	const float *cos = nullptr; // Rotated only
+	const GfxQuadUV *uvs = nullptr; // nullptr: 'uv'
+	const Color *colors = nullptr; // nullptr: 'color'
+
+	float width = 0.0f;
+	float height = 0.0f;
+	float xorigin = 0.0f; // Rotated only
+	float yorigin = 0.0f; // Rotated only
+	float depth = 0.0f;
+	GfxQuadUV uv = { 0, 0, 0, 0 };
+	Color color = c_white;
 };
 
+
+namespace Gfx
+{
+	extern void quad_fill( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count );
+	extern void quad_fill_rotated( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count );
+
+	// Scalar references
+	extern void quad_fill_scalar( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first, const u32 count );
+	extern void quad_fill_rotated_scalar( GfxBuiltInQuad *quads, const GfxQuadFill &fill, const u32 first,
+		const u32 count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quad Arena: CPU-side quad recording for worker threads (one arena per thread, no Gfx calls while recording)
+// Consecutive quads with the same texture & shader form a range. Gfx::quad_arena_submit() (rendering thread) binds each
+// range's state and copies its quads into the quad batch in bulk: one copy per batch the range spans
+//
+// Arenas are a threading convenience, not an optimization: the submit copy is extra work on top of recording, so a
+// frame only gets cheaper when recording overlaps other work on separate cores. With one job thread the 'arenas'
+// benchmark measures 0.7-0.8x of drawing on the rendering thread directly
+
+struct GfxQuadArenaRange
+{
+	GfxTexture2DResource *texture; // nullptr: texture bound at submit
+	u32 shader;
+	u32 start;
+	u32 count;
+};
+
+
+struct GfxQuadArena
+{
+	GfxBuiltInQuad *quads = nullptr;
+	GfxQuadArenaRange *ranges = nullptr;
+	u32 count = 0;
+	u32 capacity = 0;
+	u32 rangesCount = 0;
+	u32 rangesCapacity = 0;
+	u32 shader = SHADER_DEFAULT;
+
+	void init( const u32 reserve = RENDER_QUAD_BATCH_SIZE );
+	void free();
+	void clear();
+
+	void shader_bind( const u32 shader ) { this->shader = shader; }
+
+	void write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture = nullptr );
+
+	void write( const float x1, const float y1, const float x2, const float y2,
+	            const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
+	            const GfxTexture2D *const texture = nullptr, const float depth = 0.0f );
+
+	void write( const float x1, const float y1, const float x2, const float y2,
+	            const float x3, const float y3, const float x4, const float y4,
+	            const u16 u1, const u16 v1, const u16 u2, const u16 v2, const Color color,
+	            const GfxTexture2D *const texture = nullptr, const float depth = 0.0f );
+
+	void range_begin( GfxTexture2DResource *texture );
+	void grow();
+};
+
+
+namespace Gfx
+{
+	// Draws the arena's quads in recording order (the shader bound before the call is restored)
+	extern void quad_arena_submit( const GfxQuadArena &arena );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -0,0 +1,365 @@
+#include <manta/gfx.simd.hpp>
+
+#include <vendor/simd.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static_assert( sizeof( QuadFillVertex ) == 20, "QuadFillVertex is not 5 words" );
+static_assert( sizeof( QuadFillQuad ) == 80, "QuadFillQuad is not 20 words" );
+
+
+static inline void quad_write( QuadFillQuad &quad, const float x1, const float y1, const float x2, const float y2,
+	const float x3, const float y3, const float x4, const float y4, const QuadFillKernel &fill, const u32 i )
+{
+	const u32 uv11 = fill.uvs != nullptr ? fill.uvs[i * 2 + 0] : fill.uv11;
+	const u32 uv22 = fill.uvs != nullptr ? fill.uvs[i * 2 + 1] : fill.uv22;
+	const u32 uv21 = fill.uvs != nullptr ? ( uv22 & 0x0000FFFF ) | ( uv11 & 0xFFFF0000 ) : fill.uv21;
+	const u32 uv12 = fill.uvs != nullptr ? ( uv11 & 0x0000FFFF ) | ( uv22 & 0xFFFF0000 ) : fill.uv12;
+	const u32 color = fill.colors != nullptr ? fill.colors[i] : fill.color;
+
+	quad.v1 = { x1, y1, fill.depth, uv11, color };
+	quad.v2 = { x2, y2, fill.depth, uv21, color };
+	quad.v3 = { x3, y3, fill.depth, uv12, color };
+	quad.v4 = { x4, y4, fill.depth, uv22, color };
+}
+
+
+static void fill_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 begin,
+	const u32 end )
+{
+	for( u32 k = begin; k < end; k++ )
+	{
+		const u32 i = first + k;
+		const float x1 = fill.x[i];
+		const float y1 = fill.y[i];
+		const float x2 = x1 + fill.width;
+		const float y2 = y1 + fill.height;
+		quad_write( quads[k], x1, y1, x2, y1, x1, y2, x2, y2, fill, i );
+	}
+}
+
+
+static void fill_rotated_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 begin,
+	const u32 end )
+{
+	// Corner offsets from the origin (see draw_sprite_angle)
+	const float a1 = -fill.xorigin;
+	const float a2 = fill.width - fill.xorigin;
+	const float b1 = -fill.yorigin;
+	const float b2 = fill.height - fill.yorigin;
+
+	for( u32 k = begin; k < end; k++ )
+	{
+		const u32 i = first + k;
+		const float x = fill.x[i];
+		const float y = fill.y[i];
+		const float s = fill.sin[i];
+		const float c = fill.cos[i];
+		quad_write( quads[k],
+			x + a1 * c - b1 * s, y + a1 * s + b1 * c,
+			x + a2 * c - b1 * s, y + a2 * s + b1 * c,
+			x + a1 * c - b2 * s, y + a1 * s + b2 * c,
+			x + a2 * c - b2 * s, y + a2 * s + b2 * c,
+			fill, i );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Four quads at a time: the vertex attributes are built as 20 rows of four lanes (row r holds word r of each quad) and
+// transposed in 4x4 blocks, so every quad is written with five 128-bit stores. The 80-byte quad stride keeps the stores
+// 128-bit wide with AVX2 too; AVX2 only widens the rotation math to eight quads. Only the rotated fill uses this: its
+// rotation math pays for the transposes
+
+#if SIMD_AVX2 || SIMD_SSE2
+struct QuadLanesSSE
+{
+	__m128 depth;
+	__m128 uv11, uv21, uv12, uv22;
+	__m128 color;
+};
+
+
+static inline QuadLanesSSE quad_lanes_sse( const QuadFillKernel &fill )
+{
+	QuadLanesSSE lanes;
+	lanes.depth = _mm_set1_ps( fill.depth );
+	lanes.uv11 = _mm_castsi128_ps( _mm_set1_epi32( static_cast<int>( fill.uv11 ) ) );
+	lanes.uv21 = _mm_castsi128_ps( _mm_set1_epi32( static_cast<int>( fill.uv21 ) ) );
+	lanes.uv12 = _mm_castsi128_ps( _mm_set1_epi32( static_cast<int>( fill.uv12 ) ) );
+	lanes.uv22 = _mm_castsi128_ps( _mm_set1_epi32( static_cast<int>( fill.uv22 ) ) );
+	lanes.color = _mm_castsi128_ps( _mm_set1_epi32( static_cast<int>( fill.color ) ) );
+	return lanes;
+}
+
+
+static inline void quad_lanes_load_sse( const QuadFillKernel &fill, const u32 i, QuadLanesSSE &lanes )
+{
+	if( fill.uvs != nullptr )
+	{
+		// ( u1, v1 ) & ( u2, v2 ) words of four quads, recombined into the other two corners
+		const __m128 a = _mm_loadu_ps( reinterpret_cast<const float *>( fill.uvs + i * 2 + 0 ) );
+		const __m128 b = _mm_loadu_ps( reinterpret_cast<const float *>( fill.uvs + i * 2 + 4 ) );
+		const __m128i lo = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		const __m128i hi = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+		const __m128i maskU = _mm_set1_epi32( 0x0000FFFF );
+		lanes.uv11 = _mm_castsi128_ps( lo );
+		lanes.uv21 = _mm_castsi128_ps( _mm_or_si128( _mm_and_si128( maskU, hi ), _mm_andnot_si128( maskU, lo ) ) );
+		lanes.uv12 = _mm_castsi128_ps( _mm_or_si128( _mm_and_si128( maskU, lo ), _mm_andnot_si128( maskU, hi ) ) );
+		lanes.uv22 = _mm_castsi128_ps( hi );
+	}
+
+	if( fill.colors != nullptr )
+	{
+		lanes.color = _mm_castsi128_ps( _mm_loadu_si128( reinterpret_cast<const __m128i *>( fill.colors + i ) ) );
+	}
+}
+
+
+static inline void quad_store4_sse( QuadFillQuad *quads, __m128 rows[20] )
+{
+	float *q0 = reinterpret_cast<float *>( quads + 0 );
+	float *q1 = reinterpret_cast<float *>( quads + 1 );
+	float *q2 = reinterpret_cast<float *>( quads + 2 );
+	float *q3 = reinterpret_cast<float *>( quads + 3 );
+
+	for( u32 word = 0; word < 20; word += 4 )
+	{
+		_MM_TRANSPOSE4_PS( rows[word + 0], rows[word + 1], rows[word + 2], rows[word + 3] );
+		_mm_storeu_ps( q0 + word, rows[word + 0] );
+		_mm_storeu_ps( q1 + word, rows[word + 1] );
+		_mm_storeu_ps( q2 + word, rows[word + 2] );
+		_mm_storeu_ps( q3 + word, rows[word + 3] );
+	}
+}
+
+
+static inline void quad_write4_sse( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 i,
+	const QuadLanesSSE &shared, const __m128 x1, const __m128 y1, const __m128 x2, const __m128 y2,
+	const __m128 x3, const __m128 y3, const __m128 x4, const __m128 y4 )
+{
+	QuadLanesSSE l = shared;
+	quad_lanes_load_sse( fill, i, l );
+
+	__m128 rows[20] =
+	{
+		x1, y1, l.depth, l.uv11, l.color,
+		x2, y2, l.depth, l.uv21, l.color,
+		x3, y3, l.depth, l.uv12, l.color,
+		x4, y4, l.depth, l.uv22, l.color,
+	};
+	quad_store4_sse( quads, rows );
+}
+#endif
+
+
+#if SIMD_NEON
+struct QuadLanesNEON
+{
+	float32x4_t depth;
+	float32x4_t uv11, uv21, uv12, uv22;
+	float32x4_t color;
+};
+
+
+static inline QuadLanesNEON quad_lanes_neon( const QuadFillKernel &fill )
+{
+	QuadLanesNEON lanes;
+	lanes.depth = vdupq_n_f32( fill.depth );
+	lanes.uv11 = vreinterpretq_f32_u32( vdupq_n_u32( fill.uv11 ) );
+	lanes.uv21 = vreinterpretq_f32_u32( vdupq_n_u32( fill.uv21 ) );
+	lanes.uv12 = vreinterpretq_f32_u32( vdupq_n_u32( fill.uv12 ) );
+	lanes.uv22 = vreinterpretq_f32_u32( vdupq_n_u32( fill.uv22 ) );
+	lanes.color = vreinterpretq_f32_u32( vdupq_n_u32( fill.color ) );
+	return lanes;
+}
+
+
+static inline void quad_lanes_load_neon( const QuadFillKernel &fill, const u32 i, QuadLanesNEON &lanes )
+{
+	if( fill.uvs != nullptr )
+	{
+		// ( u1, v1 ) & ( u2, v2 ) words of four quads, recombined into the other two corners
+		const uint32x4x2_t words = vld2q_u32( fill.uvs + i * 2 );
+		const uint32x4_t maskU = vdupq_n_u32( 0x0000FFFF );
+		lanes.uv11 = vreinterpretq_f32_u32( words.val[0] );
+		lanes.uv21 = vreinterpretq_f32_u32( vbslq_u32( maskU, words.val[1], words.val[0] ) );
+		lanes.uv12 = vreinterpretq_f32_u32( vbslq_u32( maskU, words.val[0], words.val[1] ) );
+		lanes.uv22 = vreinterpretq_f32_u32( words.val[1] );
+	}
+
+	if( fill.colors != nullptr )
+	{
+		lanes.color = vreinterpretq_f32_u32( vld1q_u32( fill.colors + i ) );
+	}
+}
+
+
+static inline void quad_store4_neon( QuadFillQuad *quads, const float32x4_t rows[20] )
+{
+	float *q0 = reinterpret_cast<float *>( quads + 0 );
+	float *q1 = reinterpret_cast<float *>( quads + 1 );
+	float *q2 = reinterpret_cast<float *>( quads + 2 );
+	float *q3 = reinterpret_cast<float *>( quads + 3 );
+
+	for( u32 word = 0; word < 20; word += 4 )
+	{
+		const float32x4x2_t t01 = vtrnq_f32( rows[word + 0], rows[word + 1] );
+		const float32x4x2_t t23 = vtrnq_f32( rows[word + 2], rows[word + 3] );
+		vst1q_f32( q0 + word, vcombine_f32( vget_low_f32( t01.val[0] ), vget_low_f32( t23.val[0] ) ) );
+		vst1q_f32( q1 + word, vcombine_f32( vget_low_f32( t01.val[1] ), vget_low_f32( t23.val[1] ) ) );
+		vst1q_f32( q2 + word, vcombine_f32( vget_high_f32( t01.val[0] ), vget_high_f32( t23.val[0] ) ) );
+		vst1q_f32( q3 + word, vcombine_f32( vget_high_f32( t01.val[1] ), vget_high_f32( t23.val[1] ) ) );
+	}
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SysGfx::quad_fill_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 count )
+{
+	fill_scalar( quads, fill, first, 0, count );
+}
+
+
+void SysGfx::quad_fill_rotated_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first,
+	const u32 count )
+{
+	fill_rotated_scalar( quads, fill, first, 0, count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SysGfx::quad_fill( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 count )
+{
+	// Scalar: with only two adds per quad the fill is store-bound, and the transposes of the 4-wide path measured
+	// slower than the compiler's scalar loop (see the 'quads' benchmark)
+	fill_scalar( quads, fill, first, 0, count );
+}
+
+
+void SysGfx::quad_fill_rotated( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 count )
+{
+	u32 k = 0;
+	const float a1 = -fill.xorigin;
+	const float a2 = fill.width - fill.xorigin;
+	const float b1 = -fill.yorigin;
+	const float b2 = fill.height - fill.yorigin;
+
+#if SIMD_AVX2 || SIMD_SSE2
+	const QuadLanesSSE shared = quad_lanes_sse( fill );
+#endif
+
+#if SIMD_AVX2
+	const __m256 a18 = _mm256_set1_ps( a1 );
+	const __m256 a28 = _mm256_set1_ps( a2 );
+	const __m256 b18 = _mm256_set1_ps( b1 );
+	const __m256 b28 = _mm256_set1_ps( b2 );
+	for( ; k + 8 <= count; k += 8 )
+	{
+		const u32 i = first + k;
+		const __m256 x = _mm256_loadu_ps( fill.x + i );
+		const __m256 y = _mm256_loadu_ps( fill.y + i );
+		const __m256 s = _mm256_loadu_ps( fill.sin + i );
+		const __m256 c = _mm256_loadu_ps( fill.cos + i );
+
+		const __m256 xa1 = _mm256_add_ps( x, _mm256_mul_ps( a18, c ) );
+		const __m256 xa2 = _mm256_add_ps( x, _mm256_mul_ps( a28, c ) );
+		const __m256 ya1 = _mm256_add_ps( y, _mm256_mul_ps( a18, s ) );
+		const __m256 ya2 = _mm256_add_ps( y, _mm256_mul_ps( a28, s ) );
+		const __m256 b1s = _mm256_mul_ps( b18, s );
+		const __m256 b2s = _mm256_mul_ps( b28, s );
+		const __m256 b1c = _mm256_mul_ps( b18, c );
+		const __m256 b2c = _mm256_mul_ps( b28, c );
+
+		const __m256 x1 = _mm256_sub_ps( xa1, b1s );
+		const __m256 y1 = _mm256_add_ps( ya1, b1c );
+		const __m256 x2 = _mm256_sub_ps( xa2, b1s );
+		const __m256 y2 = _mm256_add_ps( ya2, b1c );
+		const __m256 x3 = _mm256_sub_ps( xa1, b2s );
+		const __m256 y3 = _mm256_add_ps( ya1, b2c );
+		const __m256 x4 = _mm256_sub_ps( xa2, b2s );
+		const __m256 y4 = _mm256_add_ps( ya2, b2c );
+
+		quad_write4_sse( quads + k + 0, fill, i + 0, shared,
+			_mm256_castps256_ps128( x1 ), _mm256_castps256_ps128( y1 ),
+			_mm256_castps256_ps128( x2 ), _mm256_castps256_ps128( y2 ),
+			_mm256_castps256_ps128( x3 ), _mm256_castps256_ps128( y3 ),
+			_mm256_castps256_ps128( x4 ), _mm256_castps256_ps128( y4 ) );
+		quad_write4_sse( quads + k + 4, fill, i + 4, shared,
+			_mm256_extractf128_ps( x1, 1 ), _mm256_extractf128_ps( y1, 1 ),
+			_mm256_extractf128_ps( x2, 1 ), _mm256_extractf128_ps( y2, 1 ),
+			_mm256_extractf128_ps( x3, 1 ), _mm256_extractf128_ps( y3, 1 ),
+			_mm256_extractf128_ps( x4, 1 ), _mm256_extractf128_ps( y4, 1 ) );
+	}
+#endif
+
+#if SIMD_AVX2 || SIMD_SSE2
+	const __m128 a1v = _mm_set1_ps( a1 );
+	const __m128 a2v = _mm_set1_ps( a2 );
+	const __m128 b1v = _mm_set1_ps( b1 );
+	const __m128 b2v = _mm_set1_ps( b2 );
+	for( ; k + 4 <= count; k += 4 )
+	{
+		const u32 i = first + k;
+		const __m128 x = _mm_loadu_ps( fill.x + i );
+		const __m128 y = _mm_loadu_ps( fill.y + i );
+		const __m128 s = _mm_loadu_ps( fill.sin + i );
+		const __m128 c = _mm_loadu_ps( fill.cos + i );
+
+		const __m128 xa1 = _mm_add_ps( x, _mm_mul_ps( a1v, c ) );
+		const __m128 xa2 = _mm_add_ps( x, _mm_mul_ps( a2v, c ) );
+		const __m128 ya1 = _mm_add_ps( y, _mm_mul_ps( a1v, s ) );
+		const __m128 ya2 = _mm_add_ps( y, _mm_mul_ps( a2v, s ) );
+		const __m128 b1sin = _mm_mul_ps( b1v, s );
+		const __m128 b2sin = _mm_mul_ps( b2v, s );
+		const __m128 b1cos = _mm_mul_ps( b1v, c );
+		const __m128 b2cos = _mm_mul_ps( b2v, c );
+
+		quad_write4_sse( quads + k, fill, i, shared,
+			_mm_sub_ps( xa1, b1sin ), _mm_add_ps( ya1, b1cos ),
+			_mm_sub_ps( xa2, b1sin ), _mm_add_ps( ya2, b1cos ),
+			_mm_sub_ps( xa1, b2sin ), _mm_add_ps( ya1, b2cos ),
+			_mm_sub_ps( xa2, b2sin ), _mm_add_ps( ya2, b2cos ) );
+	}
+#elif SIMD_NEON
+	const QuadLanesNEON shared = quad_lanes_neon( fill );
+	const float32x4_t a1v = vdupq_n_f32( a1 );
+	const float32x4_t a2v = vdupq_n_f32( a2 );
+	const float32x4_t b1v = vdupq_n_f32( b1 );
+	const float32x4_t b2v = vdupq_n_f32( b2 );
+	for( ; k + 4 <= count; k += 4 )
+	{
+		const u32 i = first + k;
+		QuadLanesNEON l = shared;
+		quad_lanes_load_neon( fill, i, l );
+
+		const float32x4_t x = vld1q_f32( fill.x + i );
+		const float32x4_t y = vld1q_f32( fill.y + i );
+		const float32x4_t s = vld1q_f32( fill.sin + i );
+		const float32x4_t c = vld1q_f32( fill.cos + i );
+
+		const float32x4_t xa1 = vaddq_f32( x, vmulq_f32( a1v, c ) );
+		const float32x4_t xa2 = vaddq_f32( x, vmulq_f32( a2v, c ) );
+		const float32x4_t ya1 = vaddq_f32( y, vmulq_f32( a1v, s ) );
+		const float32x4_t ya2 = vaddq_f32( y, vmulq_f32( a2v, s ) );
+		const float32x4_t b1sin = vmulq_f32( b1v, s );
+		const float32x4_t b2sin = vmulq_f32( b2v, s );
+		const float32x4_t b1cos = vmulq_f32( b1v, c );
+		const float32x4_t b2cos = vmulq_f32( b2v, c );
+
+		const float32x4_t rows[20] =
+		{
+			vsubq_f32( xa1, b1sin ), vaddq_f32( ya1, b1cos ), l.depth, l.uv11, l.color,
+			vsubq_f32( xa2, b1sin ), vaddq_f32( ya2, b1cos ), l.depth, l.uv21, l.color,
+			vsubq_f32( xa1, b2sin ), vaddq_f32( ya1, b2cos ), l.depth, l.uv12, l.color,
+			vsubq_f32( xa2, b2sin ), vaddq_f32( ya2, b2cos ), l.depth, l.uv22, l.color,
+		};
+		quad_store4_neon( quads + k, rows );
+	}
+#endif
+
+	fill_rotated_scalar( quads, fill, first, k, count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
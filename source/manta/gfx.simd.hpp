@@ -0,0 +1,58 @@
+#pragma once
+
+#include <core/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Quad fill kernels (Gfx::quad_fill, Gfx::quad_fill_rotated). Quads are GfxBuiltInQuads seen as 20 32-bit words: per
+// vertex x, y, depth, uv ( u | v << 16 ) and color (RGBA bytes). Quad k reads element 'first + k' of every per-quad
+// array. quad_fill_rotated dispatches to AVX2, SSE2, or NEON (see vendor/simd.hpp) with a scalar fallback; quad_fill
+// is scalar (store-bound, a 4-wide transpose measured slower). The *_scalar variants are the reference implementations
+//
+// Axis-aligned quads span ( x, y ) to ( x + width, y + height ). Rotated quads turn the width x height rectangle about
+// the origin ( xorigin, yorigin ), placed at ( x, y ), with the corners of draw_sprite_angle()
+
+struct QuadFillVertex
+{
+	float x, y, depth;
+	u32 uv;
+	u32 color;
+};
+
+
+struct QuadFillQuad
+{
+	QuadFillVertex v1, v2, v3, v4;
+};
+
+
+struct QuadFillKernel
+{
+	const float *x;
+	const float *y;
+	const float *sin; // Rotated only
+	const float *cos; // Rotated only
+	const u32 *uvs; // Per quad ( u1, v1 ) & ( u2, v2 ) words, or nullptr
+	const u32 *colors; // Per quad, or nullptr
+
+	float width, height;
+	float xorigin, yorigin; // Rotated only
+	float depth;
+	u32 uv11, uv21, uv12, uv22; // Without 'uvs' (uvXY: uX & vY)
+	u32 color; // Without 'colors'
+};
+
+
+namespace SysGfx
+{
+	extern void quad_fill( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first, const u32 count );
+	extern void quad_fill_rotated( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first,
+		const u32 count );
+
+	extern void quad_fill_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first,
+		const u32 count );
+	extern void quad_fill_rotated_scalar( QuadFillQuad *quads, const QuadFillKernel &fill, const u32 first,
+		const u32 count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
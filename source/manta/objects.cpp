@@ -1,10 +1,15 @@
 #include <manta/objects.hpp>
 
+#include <core/atomics.hpp>
+#include <core/bits.hpp>
 #include <core/debug.hpp>
 #include <core/memory.hpp>
 #include <core/buffer.hpp>
 #include <core/serializer.hpp>
 
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
 #include <vendor/vendor.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -139,11 +144,10 @@ void Object::Serialization::prepare( const ObjectContext &activeContext )
 			if( UNLIKELY( bucket->type != type ) ) { break; }
 
 			// Loop over live objects in the bucket and cache them
-			for( u16 index = bucket->bottom; index < bucket->top; index++ )
+			for( u32 index = bucket->find_alive( bucket->bottom ); index < bucket->top;
+			     index = bucket->find_alive( index + 1 ) )
 			{
-				const Object &object = bucket->get_object_id( index );
-				if( !object.alive ) { continue; }
-				const u32 key = ( ( object.bucketID & 0xFFFF ) << 16 ) | ( object.index & 0xFFFF );
+				const u32 key = ( ( bucket->bucketID & 0xFFFF ) << 16 ) | ( index & 0xFFFF );
 				instances[type].add( key );
 			}
 
@@ -259,14 +263,24 @@ bool ObjectContext::init()
 	capacity = SysObjects::CATEGORY_TYPE_COUNT[category];
 	current = SysObjects::CATEGORY_TYPE_COUNT[category];
 	disableEvents = false;
+	deferCommands = false;
+	updateTime = 0.0;
+	updateDelta = 0.0;
+	updateFrame = 0;
+	bucketsFree = NULL_BUCKET;
+	bucketsRetired = NULL_BUCKET;
+	bucketsRetiredTail = NULL_BUCKET;
+	compactPass = 0;
+	compactStats = { };
 
 	// Allocate Memory
 	buckets = reinterpret_cast<ObjectBucket *>( memory_alloc( capacity * sizeof( ObjectBucket ) ) );
 	objectCount = reinterpret_cast<u32 *>( memory_alloc( capacity * sizeof( u32 ) ) );
 	bucketCache = reinterpret_cast<u16 *>( memory_alloc( capacity * sizeof( u16 ) ) );
+	spatial = reinterpret_cast<SpatialIndex *>( memory_alloc( capacity * sizeof( SpatialIndex ) ) );
 
 	// Allocation failure?
-	if( buckets == nullptr || objectCount == nullptr || bucketCache == nullptr )
+	if( buckets == nullptr || objectCount == nullptr || bucketCache == nullptr || spatial == nullptr )
 	{
 		memory_free( buckets );
 		buckets = nullptr;
@@ -274,12 +288,15 @@ bool ObjectContext::init()
 		objectCount = nullptr;
 		memory_free( bucketCache );
 		bucketCache = nullptr;
+		memory_free( spatial );
+		spatial = nullptr;
 		return false;
 	}
 
 	// Zero memory
 	memory_set( objectCount, 0, capacity * sizeof( u32 ) );
 	memory_set( bucketCache, 0, capacity * sizeof( u16 ) );
+	for( u16 i = 0; i < capacity; i++ ) { new ( &spatial[i] ) SpatialIndex { }; }
 
 	// Default-initialize ObjectBuckets for every object type
 	for( u16 i = capacity; i > 0; i-- )
@@ -329,9 +346,19 @@ bool ObjectContext::free()
 		bucketCache = nullptr;
 	}
 
+	if( spatial != nullptr )
+	{
+		for( u16 i = 0; i < SysObjects::CATEGORY_TYPE_COUNT[category]; i++ ) { spatial[i].free(); }
+		memory_free( spatial );
+		spatial = nullptr;
+	}
+
 	// Reset state
 	capacity = 0;
 	current = 0;
+	bucketsFree = NULL_BUCKET;
+	bucketsRetired = NULL_BUCKET;
+	bucketsRetiredTail = NULL_BUCKET;
 
 	// Success
 	return true;
@@ -365,6 +392,17 @@ bool ObjectContext::grow()
 
 u16 ObjectContext::new_bucket( const u16 type )
 {
+	// Reuse a bucket recycled by compact()
+	if( bucketsFree != NULL_BUCKET )
+	{
+		const u16 bucketID = bucketsFree;
+		ObjectBucket &bucket = buckets[bucketID];
+		if( !bucket.init( type ) ) { return NULL_BUCKET; }
+		bucketsFree = bucket.bucketIDNext;
+		bucket.bucketIDNext = NULL_BUCKET;
+		return bucketID;
+	}
+
 	// Grow buffer?
 	if( current == capacity )
 	{
@@ -395,8 +433,11 @@ ObjectContext::ObjectBucket *ObjectContext::new_object( const u16 type )
 	// Find first bucket with room
 	for( ;; )
 	{
-		// Early out if the bucket still has capacity
-		if( LIKELY( bucket->current < SysObjects::TYPE_BUCKET_CAPACITY[type] ) ) { break; }
+		// Early out if the bucket still has capacity (buckets draining in compact() take no new objects)
+		if( LIKELY( bucket->current < SysObjects::TYPE_BUCKET_CAPACITY[type] ) && LIKELY( bucket->relocation == nullptr ) )
+		{
+			break;
+		}
 
 		// This bucket is full, but a 'next' bucket of our type already exists
 		if( bucket->bucketIDNext != NULL_BUCKET && buckets[bucket->bucketIDNext].type == bucket->type )
@@ -432,10 +473,15 @@ byte *ObjectContext::get_object_pointer( const Object &object ) const
 	if( UNLIKELY( object.bucketID >= current ) ) { return nullptr; }
 	ObjectBucket *bucket = &buckets[object.bucketID];
 	if( UNLIKELY( bucket->type != object.type ) ) { return nullptr; }
-	if( UNLIKELY( bucket->data == nullptr ) ) { return nullptr; }
 
 	// Get Object Pointer
-	return bucket->get_object_pointer( object.index, object.generation );
+	byte *const objectPtr = bucket->data == nullptr ? nullptr :
+		bucket->get_object_pointer( object.index, object.generation );
+	if( LIKELY( objectPtr != nullptr ) || LIKELY( bucket->relocation == nullptr ) ) { return objectPtr; }
+
+	// Moved by compact()
+	Object relocated = object;
+	return relocate( relocated ) ? get_object_pointer( relocated ) : nullptr;
 }
 
 
@@ -443,24 +489,44 @@ Object ObjectContext::create( const u16 type )
 {
 	Assert( type < OBJECT_TYPE_COUNT );
 
+	// Inside a PARALLEL event (of any context): construct into the deferred buffer (returns a null Object)
+	if( UNLIKELY( SysObjects::parallelEvent ) )
+	{
+		void *const object = deferred_create_begin( type );
+		if( UNLIKELY( object == nullptr ) ) { return Object { }; }
+		SysObjects::TYPE_CONSTRUCT[type]( object ); // Constructor
+		return deferred_create_end();
+	}
+
 	// Find Available Bucket
 	ObjectBucket *bucket = new_object( type );
 	if( UNLIKELY( bucket == nullptr ) ) { return Object { }; }
 
-	// Create Object
+	// Create Object (the constructor resets 'id': read the slot's generation first)
 	void *const object = bucket->data + ( bucket->current * SysObjects::TYPE_SIZE[type] );
+	const u16 generation = bucket->slot_generation( bucket->current );
 	SysObjects::TYPE_CONSTRUCT[type]( object ); // Constructor
-	return bucket->new_object( object );
+	return bucket->new_object( object, generation );
 }
 
 
 bool ObjectContext::destroy( Object &object )
 {
+	// Inside a PARALLEL event (of any context): queue for after the dispatch
+	if( UNLIKELY( SysObjects::parallelEvent ) ) { return deferred_destroy( object ); }
+
 	// Fetch Bucket
 	if( UNLIKELY( object.bucketID >= current ) ) { return false; }
 	ObjectBucket *bucket = &buckets[object.bucketID];
 	if( TYPE_INVALID( category, object.type ) ) { return false; }
 	if( UNLIKELY( bucket->type != object.type ) ) { return false; }
+
+	// Moved by compact()
+	if( UNLIKELY( bucket->relocation != nullptr ) )
+	{
+		Object relocated = object;
+		if( relocate( relocated ) ) { return destroy( relocated ); }
+	}
 	if( UNLIKELY( bucket->data == nullptr ) ) { return false; }
 
 	// Remove Object
@@ -479,8 +545,11 @@ void ObjectContext::destroy_all()
 		bucket->free();
 	}
 
-	// Reset current
+	// Reset current (retired & recycled buckets were freed above)
 	current = SysObjects::CATEGORY_TYPE_COUNT[category];
+	bucketsFree = NULL_BUCKET;
+	bucketsRetired = NULL_BUCKET;
+	bucketsRetiredTail = NULL_BUCKET;
 
 	// Default-initialize ObjectBuckets for every object type
 	for( u16 i = current; i > 0; i-- )
@@ -515,6 +584,11 @@ bool ObjectContext::activate( Object &object, const bool setActive )
 	if( instance == nullptr ) { return false; }
 	instance->id.deactivated = !setActive;
 	object.deactivated = !setActive;
+
+	// Update bucket activity mask (instance id: the handle may predate a compact() move)
+	ObjectBucket &bucket = buckets[instance->id.bucketID];
+	if( setActive ) { bits_set( bucket.maskActive, instance->id.index ); }
+	else { bits_clear( bucket.maskActive, instance->id.index ); }
 	return true;
 }
 
@@ -539,12 +613,19 @@ void ObjectContext::activate_all_type( const u16 type, const bool setActive )
 		// Ensure the bucket is our type
 		if( UNLIKELY( bucket->type != type ) ) { break; }
 
-		// Loop over live objects in the bucket and cache them
-		for( u16 i = bucket->bottom; i < bucket->top; i++ )
+		// Loop over live objects in the bucket and set their 'deactivated' flag
+		if( bucket->data != nullptr )
 		{
-			byte *objectPtr = bucket->data + i * SysObjects::TYPE_SIZE[type];
-			SysObjects::OBJECT_TYPE_DEFAULT_t &object = *reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
-			object.id.deactivated = !setActive;
+			for( u32 i = bucket->find_alive( bucket->bottom ); i < bucket->top; i = bucket->find_alive( i + 1 ) )
+			{
+				byte *objectPtr = bucket->data + i * SysObjects::TYPE_SIZE[type];
+				SysObjects::OBJECT_TYPE_DEFAULT_t &object = *reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+				object.id.deactivated = !setActive;
+			}
+
+			// Activity mask mirrors the alive mask (or is cleared)
+			const u32 words = BITS_WORDS_U64( SysObjects::TYPE_BUCKET_CAPACITY[type] );
+			for( u32 w = 0; w < words; w++ ) { bucket->maskActive[w] = setActive ? bucket->maskAlive[w] : 0; }
 		}
 
 		// Move to next bucket
@@ -570,333 +651,2250 @@ u32 ObjectContext::count_all() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void ObjectContext::write( Buffer &buffer, const ObjectContext &context )
-{
-	// TODO
-}
-
+// PARALLEL object events split a type's buckets into chunks of OBJECT_PARALLEL_CHUNK_SIZE slots which are handed
+// to the job system (Jobs::parallel_for) -- the dispatching thread participates and returns once every chunk is done
 
-void ObjectContext::read( Buffer &buffer, ObjectContext &context )
+struct ObjectParallelChunk
 {
-	// TODO
-}
-
+	byte *data;       // ObjectBucket data
+	const u64 *mask;  // ObjectBucket activity mask
+	u32 start;        // first slot
+	u32 end;          // one past last slot
+	u32 stride;       // TYPE_SIZE
+};
 
-void ObjectContext::serialize( Buffer &buffer, const ObjectContext &context )
+struct ObjectParallelDispatch
 {
-	Assert( context.initialized() );
-
-	Serializer serializer;
-	serializer.begin( buffer, 0 );
-	SysObjects::serialize( serializer, context );
-	serializer.end();
-}
-
+	const ObjectParallelChunk *chunks;
+	void ( *function )( void *, void * );
+	void *userdata;
+};
 
-void ObjectContext::deserialize( Buffer &buffer, ObjectContext &context )
+static struct
 {
-	if( context.initialized() ) { context.free(); context.init(); }
+	SpinLock lock;
+	ObjectParallelChunk *chunks = nullptr;
+	u32 chunksCapacity = 0;
+} g_parallel;
+
+// create() & destroy() deferred by PARALLEL events, per target context. Deferral is keyed on the calling thread rather
+// than the dispatching context, so events that mutate another ObjectContext are deferred (and flushed) too
+struct ObjectParallelCommands
+{
+	ObjectContext *context;
+	ObjectContext::Commands commands;
+};
 
-	context.disableEvents = true;
-	Deserializer deserializer;
-	deserializer.begin( buffer, 0 );
-	SysObjects::deserialize( deserializer, context );
-	deserializer.end();
-	context.disableEvents = false;
-}
+static struct
+{
+	SpinLock lock;
+	ObjectParallelCommands contexts[OBJECT_PARALLEL_CONTEXTS];
+	u32 count = 0;
+} g_commands;
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+thread_local bool SysObjects::parallelEvent = false;
 
-bool ObjectContext::ObjectBucket::init( const u16 type )
+static void parallel_run_chunk( const ObjectParallelChunk &chunk, void ( *function )( void *, void * ), void *userdata )
 {
-	// State
-	this->type = type;
-	this->current = 0;
-	this->top = 0;
-	this->bottom = 0;
-
-	// Allocate Memory
-	data = reinterpret_cast<byte *>( memory_alloc( SysObjects::TYPE_BUCKET_CAPACITY[type] * SysObjects::TYPE_SIZE[type] ) );
-	if( data != nullptr ) { memory_set( data, 0, SysObjects::TYPE_BUCKET_CAPACITY[type] * SysObjects::TYPE_SIZE[type] ); return true; }
-	return false;
+	for( u32 i = bits_find_set( chunk.mask, chunk.start, chunk.end ); i < chunk.end;
+	     i = bits_find_set( chunk.mask, i + 1, chunk.end ) )
+	{
+		function( chunk.data + i * chunk.stride, userdata );
+	}
 }
 
 
-void ObjectContext::ObjectBucket::free()
+static void parallel_run_chunks( void *userdata, u32 start, u32 end )
 {
-	// Free memory
-	if( data == nullptr ) { return; }
-	memory_free( data );
-	data = nullptr;
+	const ObjectParallelDispatch &dispatch = *reinterpret_cast<const ObjectParallelDispatch *>( userdata );
+	const bool parallelEvent = SysObjects::parallelEvent;
+	SysObjects::parallelEvent = true;
+	for( u32 i = start; i < end; i++ ) { parallel_run_chunk( dispatch.chunks[i], dispatch.function, dispatch.userdata ); }
+	SysObjects::parallelEvent = parallelEvent;
 }
 
 
-void ObjectContext::ObjectBucket::clear()
+static ObjectContext::Commands *parallel_commands( ObjectContext *context )
 {
-	// Destroy objects
-	if( data == nullptr ) { return; }
-	for( u32 i = 0; i < top; i++ )
+	g_commands.lock.lock();
+	u32 i = 0;
+	while( i < g_commands.count && g_commands.contexts[i].context != context ) { i++; }
+	if( i == g_commands.count )
 	{
-		byte *const objectPtr = data + i * SysObjects::TYPE_SIZE[type];
-		delete_object( i, reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr )->id.generation );
+		ErrorIf( i == OBJECT_PARALLEL_CONTEXTS, "PARALLEL events mutated more than %d object contexts",
+			OBJECT_PARALLEL_CONTEXTS );
+		g_commands.contexts[g_commands.count++].context = context;
 	}
+	g_commands.lock.unlock();
+	return &g_commands.contexts[i].commands;
 }
 
 
-void *ObjectContext::ObjectBucket::new_object_pointer()
+bool SysObjects::parallel_init()
 {
-	// At capacity?
-	//MemoryAssert( data != nullptr );
-	//if( UNLIKELY( current == SysObjects::TYPE_BUCKET_CAPACITY[type] ) ) { return nullptr; }
-
-	// Return Pointer
-	return data + current * SysObjects::TYPE_SIZE[type];
+	return true;
 }
 
 
-Object ObjectContext::ObjectBucket::new_object( void *ptr )
+bool SysObjects::parallel_free()
 {
-	// Object
-	SysObjects::OBJECT_TYPE_DEFAULT_t *object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( ptr );
-
-	// Set Object
-	const u16 generation = object->id.generation + 1;
-	object->id = { type, generation, bucketID, current };
-	object->id.alive = true;
-
-	// Update bottom, current, & top
-	bottom = current < bottom ? current : bottom;
-	while( ++current < SysObjects::TYPE_BUCKET_CAPACITY[type] )
+	// Free memory
+	if( g_parallel.chunks != nullptr )
 	{
-		const byte *const objectPtr = data + current * SysObjects::TYPE_SIZE[type];
-		if( reinterpret_cast<const SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr )->id.alive == false ) { break; }
+		memory_free( g_parallel.chunks );
+		g_parallel.chunks = nullptr;
+		g_parallel.chunksCapacity = 0;
 	}
-	top = current > top ? current : top;
-
-	// Increment Object Count
-	context.objectCount[TYPE_BUCKET( context.category, type )]++;
-	context.objectCount[NULL_TYPE]++; // total object count
-	Object::Serialization::dirty |= ( Object::Serialization::context == &context );
-
-	// Cache bucket
-	context.bucketCache[TYPE_BUCKET( context.category, type )] = bucketID;
 
-	// Create Event
-	if( LIKELY( !context.disableEvents ) ) { object->event_create(); }
-
-	// Success
-	return object->id;
+	for( ObjectParallelCommands &commands : g_commands.contexts ) { commands.commands.free(); }
+	g_commands.count = 0;
+	return true;
 }
 
 
-bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 generation )
+void ObjectContext::parallel_dispatch( const u16 type, void ( *function )( void *, void * ), void *userdata )
 {
-	// Verify alive
-	MemoryAssert( data != nullptr );
-	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
-	byte *const objectPtr = data + index * SysObjects::TYPE_SIZE[type];
-	SysObjects::OBJECT_TYPE_DEFAULT_t *object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
-	if( UNLIKELY( object->id.alive == false ) ) { return false; } // object isn't alive
-	if( UNLIKELY( object->id.generation != generation ) ) { return false; } // object doesn't match current object's generation
-
-	// Destroy event
-	object->event_destroy();
-
-	// Destructor
-	SysObjects::TYPE_DESTRUCT[type]( object );
-
-	// Mark dead
-	object->id.alive = false;
-
-	// Update current
-	if( index < current ) { current = index; }
+	MemoryAssert( buckets != nullptr );
+	if( TYPE_INVALID( category, type ) ) { return; }
 
-	// Update bottom
-	if( index == bottom )
+	// Nested or concurrent dispatch: run serially on this thread
+	if( deferCommands || SysObjects::parallelEvent || !g_parallel.lock.try_lock() )
 	{
-		SysObjects::OBJECT_TYPE_DEFAULT_t *objectBottom =
-			reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + bottom * SysObjects::TYPE_SIZE[type] );
-		while( bottom < SysObjects::TYPE_BUCKET_CAPACITY[type] && objectBottom->id.alive == false )
+		for( ObjectBucket *bucket = &buckets[TYPE_BUCKET( category, type )]; bucket->type == type; )
 		{
-			bottom++;
-			objectBottom = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + bottom * SysObjects::TYPE_SIZE[type] );
+			if( bucket->data != nullptr )
+			{
+				const ObjectParallelChunk chunk { bucket->data, bucket->maskActive, bucket->bottom, bucket->top,
+					SysObjects::TYPE_SIZE[type] };
+				parallel_run_chunk( chunk, function, userdata );
+			}
+			if( bucket->bucketIDNext == NULL_BUCKET ) { break; }
+			bucket = &buckets[bucket->bucketIDNext];
 		}
-		if( bottom == SysObjects::TYPE_BUCKET_CAPACITY[type] ) { bottom = 0; }
+		return;
 	}
 
-	// Update top
-	if( index == ( top - 1 ) )
+	// Split buckets into chunks
+	u32 count = 0;
+	for( ObjectBucket *bucket = &buckets[TYPE_BUCKET( category, type )]; bucket->type == type; )
 	{
-		SysObjects::OBJECT_TYPE_DEFAULT_t *objectTop =
-			reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + ( top - 1 ) * SysObjects::TYPE_SIZE[type] );
-		while( top > 0 && objectTop->id.alive == false )
+		for( u32 start = bucket->bottom; bucket->data != nullptr && start < bucket->top; start += OBJECT_PARALLEL_CHUNK_SIZE )
 		{
-			top--;
-			objectTop = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + ( top - 1 ) * SysObjects::TYPE_SIZE[type] );
+			if( count == g_parallel.chunksCapacity )
+			{
+				g_parallel.chunksCapacity = g_parallel.chunksCapacity == 0 ? 64 : g_parallel.chunksCapacity * 2;
+				const usize size = g_parallel.chunksCapacity * sizeof( ObjectParallelChunk );
+				g_parallel.chunks = reinterpret_cast<ObjectParallelChunk *>( g_parallel.chunks == nullptr ?
+					memory_alloc( size ) : memory_realloc( g_parallel.chunks, size ) );
+				ErrorIf( g_parallel.chunks == nullptr, "Failed to allocate memory for PARALLEL object chunks" );
+			}
+
+			const u32 end = start + OBJECT_PARALLEL_CHUNK_SIZE;
+			g_parallel.chunks[count++] = { bucket->data, bucket->maskActive, start, end < bucket->top ? end : bucket->top,
+				SysObjects::TYPE_SIZE[type] };
 		}
+		if( bucket->bucketIDNext == NULL_BUCKET ) { break; }
+		bucket = &buckets[bucket->bucketIDNext];
 	}
 
-	// Cache bucket
-	context.bucketCache[TYPE_BUCKET( context.category, type )] =
-		context.bucketCache[TYPE_BUCKET( context.category, type )] > bucketID ?
-			bucketID : context.bucketCache[TYPE_BUCKET( context.category, type )];
+	// Run chunks (structural changes are deferred until every chunk completes)
+	deferCommands = true;
+	ObjectParallelDispatch dispatch { g_parallel.chunks, function, userdata };
+	Jobs::parallel_for( 0, count, 1, parallel_run_chunks, &dispatch );
+	deferCommands = false;
+	g_parallel.lock.unlock();
 
-	// Decerement Object Count
-	context.objectCount[TYPE_BUCKET( context.category, type )]--;
-	context.objectCount[NULL_TYPE]--; // total object count
-	Object::Serialization::dirty |= ( Object::Serialization::context == &context );
+	// Barrier: apply deferred create() & destroy() (to every context the events touched)
+	deferred_flush();
 
-	// Success
-	return true;
+	// SPATIAL types moved during the dispatch: resync so later events this frame query current positions
+	spatial_update( type );
 }
 
 
-byte *ObjectContext::ObjectBucket::get_object_pointer( const u16 index, const u16 generation ) const
+void *ObjectContext::deferred_create_begin( const u16 type )
 {
-	// Get Object Pointer
-	MemoryAssert( data != nullptr );
-	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
-	byte *objectPtr = data + index * SysObjects::TYPE_SIZE[type];
-	const SysObjects::OBJECT_TYPE_DEFAULT_t *const object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+	if( TYPE_INVALID( category, type ) ) { return nullptr; }
+	return parallel_commands( this )->create_begin( type );
+}
 
-	// Error cases
-	if( UNLIKELY( object->id.alive == false ) ) { return nullptr; } // object slot isn't alive
-	if( UNLIKELY( object->id.generation != generation ) ) { return nullptr; } // object doesn't match slot generation
 
-	// Return Object Pointer
-	return objectPtr;
+Object ObjectContext::deferred_create_end()
+{
+	return Object { };
 }
 
 
-const Object &ObjectContext::ObjectBucket::get_object_id( const u16 index ) const
+bool ObjectContext::deferred_destroy( const Object &object )
 {
-	// Get Object Pointer
-	MemoryAssert( data != nullptr );
-	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
-	byte *objectPtr = data + index * SysObjects::TYPE_SIZE[type];
-	const SysObjects::OBJECT_TYPE_DEFAULT_t *const object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+	if( !exists( object ) ) { return false; }
+	parallel_commands( this )->destroy( object );
+	return true;
+}
 
-	// Return Object ID
-	return object->id;
+
+void ObjectContext::deferred_flush()
+{
+	Assert( !SysObjects::parallelEvent );
+	for( u32 i = 0; i < g_commands.count; i++ )
+	{
+		ObjectParallelCommands &commands = g_commands.contexts[i];
+		if( commands.commands.count() != 0 ) { commands.commands.flush( *commands.context ); }
+	}
+	g_commands.count = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool ObjectContext::ObjectIteratorAll::find_object_ptr( ObjectIterator &itr,
-                                                        const ObjectBucket *const bucket,
-                                                        const u16 start )
+// Commands::flush() groups recorded commands by bucket (destroys) and type (creates) with an LSD radix sort, so
+// ObjectBucket bottom/top/current, bucketCache, and objectCount are updated once per bucket rather than per object
+
+static void radix_sort_u32( u32 *keys, u32 *values, u32 *keysTemp, u32 *valuesTemp, const u32 count )
 {
-	// Bucket Verification
-	if( bucket->data == nullptr ) { return false; }
+	u32 *srcKeys = keys, *srcValues = values;
+	u32 *dstKeys = keysTemp, *dstValues = valuesTemp;
 
-	// Loop over the bucket's instances & check if they're alive
-	for( u32 i = start; i < bucket->top; i++ )
+	for( u32 shift = 0; shift < 32; shift += 8 )
 	{
-		byte *const objectPtr = bucket->data + i * SysObjects::TYPE_SIZE[bucket->type];
-		const SysObjects::OBJECT_TYPE_DEFAULT_t *const object =
-			reinterpret_cast<const SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+		// Histogram
+		u32 offsets[256] = { 0 };
+		for( u32 i = 0; i < count; i++ ) { offsets[( srcKeys[i] >> shift ) & 0xFF]++; }
+		if( offsets[( srcKeys[0] >> shift ) & 0xFF] == count ) { continue; } // every key shares this byte
 
-		// Skip dead or deactivated objects
-		if( !object->id.alive ) { continue; }
+		// Prefix sum
+		u32 total = 0;
+		for( u32 i = 0; i < 256; i++ ) { const u32 n = offsets[i]; offsets[i] = total; total += n; }
 
-		// Success
-		itr.ptr = objectPtr;
-		itr.bucketID = bucket->bucketID;
-		itr.index = static_cast<u16>( i );
-		return true;
+		// Scatter (stable)
+		for( u32 i = 0; i < count; i++ )
+		{
+			const u32 slot = offsets[( srcKeys[i] >> shift ) & 0xFF]++;
+			dstKeys[slot] = srcKeys[i];
+			dstValues[slot] = srcValues[i];
+		}
+
+		u32 *swapKeys = srcKeys; srcKeys = dstKeys; dstKeys = swapKeys;
+		u32 *swapValues = srcValues; srcValues = dstValues; dstValues = swapValues;
 	}
 
-	// Failure
-	return false;
+	// Result must end up in keys/values
+	if( srcKeys != keys )
+	{
+		memory_copy( keys, srcKeys, count * sizeof( u32 ) );
+		memory_copy( values, srcValues, count * sizeof( u32 ) );
+	}
 }
 
 
-bool ObjectContext::ObjectIteratorActive::find_object_ptr( ObjectIterator &itr,
-                                                           const ObjectBucket *const bucket,
-                                                           const u16 start )
+static bool radix_sorted_u32( const u32 *keys, const u32 count )
 {
-	// Bucket Verification
-	if( bucket->data == nullptr ) { return false; }
+	for( u32 i = 1; i < count; i++ ) { if( keys[i - 1] > keys[i] ) { return false; } }
+	return true;
+}
+
+
+void ObjectContext::Commands::init()
+{
+	destroysCount = 0;
+	createsCount = 0;
+	stagingPages = 0;
+	stagingSize = 0;
+	stats = Statistics { };
+}
+
 
-	// Loop over the bucket's instances & check if they're alive
-	for( u32 i = start; i < bucket->top; i++ )
+void ObjectContext::Commands::free()
+{
+	if( destroys != nullptr ) { memory_free( destroys ); destroys = nullptr; }
+	if( creates != nullptr ) { memory_free( creates ); creates = nullptr; }
+	if( staging != nullptr )
 	{
-		byte *const objectPtr = bucket->data + i * SysObjects::TYPE_SIZE[bucket->type];
-		const SysObjects::OBJECT_TYPE_DEFAULT_t *const object =
-			reinterpret_cast<const SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+		for( u32 i = 0; i < stagingCount; i++ ) { memory_free( staging[i] ); }
+		memory_free( staging );
+		staging = nullptr;
+	}
+	if( scratch != nullptr ) { memory_free( scratch ); scratch = nullptr; }
+
+	destroysCount = 0;
+	destroysCapacity = 0;
+	createsCount = 0;
+	createsCapacity = 0;
+	stagingPages = 0;
+	stagingCount = 0;
+	stagingCapacity = 0;
+	stagingSize = 0;
+	scratchCapacity = 0;
+}
 
-		// Skip dead or deactivated objects
-		if( !object->id.alive || object->id.deactivated ) { continue; }
 
-		// Success
-		itr.ptr = objectPtr;
-		itr.bucketID = bucket->bucketID;
-		itr.index = static_cast<u16>( i );
-		return true;
+void ObjectContext::Commands::clear()
+{
+	// Destruct staged objects that were never flushed
+	for( u32 i = 0; i < createsCount; i++ )
+	{
+		SysObjects::TYPE_DESTRUCT[creates[i].type]( creates[i].object );
 	}
 
-	// Failure
-	return false;
+	destroysCount = 0;
+	createsCount = 0;
+	stagingPages = 0;
+	stagingSize = 0;
 }
 
 
-void ObjectContext::ObjectIterator::find_object( u32 startIndex )
+void ObjectContext::Commands::create( const u16 type )
 {
-	// Begin iteration from our bucket id
-	if( TYPE_INVALID( context.category, this->type ) ) { this->ptr = nullptr; return; }
-	if( UNLIKELY( this->bucketID == NULL_BUCKET ) ) { this->ptr = nullptr; return; }
-	ObjectBucket *bucket = &context.buckets[this->bucketID];
-
-	// Loop over ObjectBuckets until we find a live object of our type
-	for( ;; )
-	{
-		// Find object
-		if( find_object_ptr( *this, bucket, startIndex ) ) { return; }
+	Assert( type < OBJECT_TYPE_COUNT );
+	void *const object = create_begin( type );
+	if( UNLIKELY( object == nullptr ) ) { return; }
+	SysObjects::TYPE_CONSTRUCT[type]( object ); // Constructor
+}
 
-		// Move to the next bucket
-		if( bucket->bucketIDNext == NULL_BUCKET ) { break; }
-		bucket = &context.buckets[bucket->bucketIDNext];
-		startIndex = bucket->bottom;
 
-		// Check if the bucket is still our type
-		if( bucket->type == this->type ) { continue; }
+void *ObjectContext::Commands::create_begin( const u16 type )
+{
+	lock.lock();
 
-		// Are we iterating polymorphically (allow children types too)?
-		if( !polymorphic ) { break; }
+	// Grow command list
+	if( createsCount == createsCapacity )
+	{
+		const u32 capacity = createsCapacity == 0 ? 64 : createsCapacity * 2;
+		void *commands = creates == nullptr ? memory_alloc( capacity * sizeof( CreateCommand ) ) :
+			memory_realloc( creates, capacity * sizeof( CreateCommand ) );
+		if( UNLIKELY( commands == nullptr ) ) { lock.unlock(); return nullptr; }
+		creates = reinterpret_cast<CreateCommand *>( commands );
+		createsCapacity = capacity;
+	}
 
-		// If so, check if the bucket is one of our child types
-		const u16 targetTypeDepth = SysObjects::TYPE_INHERITANCE_DEPTH[this->type];
-		const u16 bucketTypeDepth = SysObjects::TYPE_INHERITANCE_DEPTH[bucket->type];
-		if( bucketTypeDepth > targetTypeDepth ) { continue; }
+	// Staging slot (next page when the current one is full)
+	const usize size = SysObjects::TYPE_SIZE[type];
+	usize offset = ( stagingSize + 15 ) & ~static_cast<usize>( 15 );
+	if( stagingPages == 0 || offset + size > STAGING_PAGE_SIZE )
+	{
+		if( stagingPages == stagingCount )
+		{
+			if( stagingCount == stagingCapacity )
+			{
+				const u32 capacity = stagingCapacity == 0 ? 8 : stagingCapacity * 2;
+				void *pages = staging == nullptr ? memory_alloc( capacity * sizeof( byte * ) ) :
+					memory_realloc( staging, capacity * sizeof( byte * ) );
+				if( UNLIKELY( pages == nullptr ) ) { lock.unlock(); return nullptr; }
+				staging = reinterpret_cast<byte **>( pages );
+				stagingCapacity = capacity;
+			}
 
-		// We must be at the end of valid buckets
-		break;
+			void *page = memory_alloc( STAGING_PAGE_SIZE );
+			if( UNLIKELY( page == nullptr ) ) { lock.unlock(); return nullptr; }
+			staging[stagingCount++] = reinterpret_cast<byte *>( page );
+		}
+		stagingPages++;
+		offset = 0;
 	}
+	stagingSize = offset + size;
 
-	// If we've made it this far, there are no live objects of our type
-	ptr = nullptr;
+	// Record command, then construct outside the lock: constructors may create() themselves, and parallel events
+	// must not serialize on each other's constructors
+	byte *const object = staging[stagingPages - 1] + offset;
+	creates[createsCount++] = { object, type };
+	lock.unlock();
+
+	memory_set( object, 0, size );
+	return object;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#if COMPILE_DEBUG
-#include <core/string.hpp>
-#include <manta/draw.hpp>
-#include <manta/input.hpp>
+void ObjectContext::Commands::destroy( const Object &object )
+{
+	lock.lock();
 
+	// Grow command list
+	if( destroysCount == destroysCapacity )
+	{
+		const u32 capacity = destroysCapacity == 0 ? 64 : destroysCapacity * 2;
+		void *commands = destroys == nullptr ? memory_alloc( capacity * sizeof( Object ) ) :
+			memory_realloc( destroys, capacity * sizeof( Object ) );
+		if( UNLIKELY( commands == nullptr ) ) { lock.unlock(); return; }
+		destroys = reinterpret_cast<Object *>( commands );
+		destroysCapacity = capacity;
+	}
 
-const Color colors[] =
-{
-	c_white,
-	c_red,
-	c_aqua,
-	c_yellow,
-	c_green,
-	c_orange,
-};
+	destroys[destroysCount++] = object;
+	lock.unlock();
+}
 
 
-void ObjectContext::ObjectBucket::draw( String &label, float x, float y )
+bool ObjectContext::Commands::reserve_scratch( const u32 count )
+{
+	if( count <= scratchCapacity ) { return true; }
+
+	u32 capacity = scratchCapacity == 0 ? 256 : scratchCapacity;
+	while( capacity < count ) { capacity *= 2; }
+	void *buffer = scratch == nullptr ? memory_alloc( capacity * 4 * sizeof( u32 ) ) :
+		memory_realloc( scratch, capacity * 4 * sizeof( u32 ) );
+	if( UNLIKELY( buffer == nullptr ) ) { return false; }
+	scratch = reinterpret_cast<u32 *>( buffer );
+	scratchCapacity = capacity;
+	return true;
+}
+
+
+void ObjectContext::Commands::flush( ObjectContext &context )
+{
+	Assert( !context.deferCommands );
+	Timer timer;
+	timer.start();
+
+	// Events fired during the flush create & destroy immediately on the context (they must not record into this buffer)
+	const u32 destroysTotal = destroysCount;
+	const u32 createsTotal = createsCount;
+	ErrorIf( !reserve_scratch( destroysTotal > createsTotal ? destroysTotal : createsTotal ),
+		"Failed to allocate memory for ObjectContext::Commands scratch" );
+	u32 *const keys = scratch;
+	u32 *const values = scratch + scratchCapacity;
+	u32 *const keysTemp = scratch + scratchCapacity * 2;
+	u32 *const valuesTemp = scratch + scratchCapacity * 3;
+
+	Statistics frame { };
+
+	// Destroys: sort by (bucketID, index)
+	for( u32 i = 0; i < destroysTotal; i++ )
+	{
+		Object &object = destroys[i];
+		context.relocate( object ); // handles recorded before a compact() move
+		keys[i] = ( static_cast<u32>( object.bucketID ) << 16 ) | object.index;
+		values[i] = ( static_cast<u32>( object.type ) << 16 ) | object.generation;
+	}
+	if( !radix_sorted_u32( keys, destroysTotal ) ) { radix_sort_u32( keys, values, keysTemp, valuesTemp, destroysTotal ); }
+	destroysCount = 0;
+
+	for( u32 i = 0; i < destroysTotal; )
+	{
+		const u16 bucketID = static_cast<u16>( keys[i] >> 16 );
+		u32 end = i + 1;
+		while( end < destroysTotal && ( keys[end] >> 16 ) == bucketID ) { end++; }
+
+		// Validate bucket (see ObjectContext::destroy())
+		if( UNLIKELY( bucketID >= context.current || context.buckets[bucketID].data == nullptr ) ) { i = end; continue; }
+		const u16 type = context.buckets[bucketID].type;
+
+		// Release objects (bucket pointer refetched: destroy events may create buckets)
+		u32 removed = 0;
+		u16 lowest = U16_MAX;
+		for( ; i < end; i++ )
+		{
+			const u16 index = static_cast<u16>( keys[i] & 0xFFFF );
+			if( UNLIKELY( ( values[i] >> 16 ) != type ) ) { continue; }
+			if( !context.buckets[bucketID].release_object( index, static_cast<u16>( values[i] & 0xFFFF ) ) ) { continue; }
+			lowest = index < lowest ? index : lowest;
+			removed++;
+		}
+		if( removed == 0 ) { continue; }
+
+		// Bookkeeping (once per bucket)
+		context.buckets[bucketID].update_removed( lowest, removed );
+		frame.bookkeepingSaved += removed - 1;
+		frame.destroys += removed;
+		frame.buckets++;
+	}
+
+	// Creates: stable sort by type
+	for( u32 i = 0; i < createsTotal; i++ ) { keys[i] = creates[i].type; values[i] = i; }
+	if( !radix_sorted_u32( keys, createsTotal ) ) { radix_sort_u32( keys, values, keysTemp, valuesTemp, createsTotal ); }
+
+	for( u32 i = 0; i < createsTotal; )
+	{
+		const u16 type = static_cast<u16>( keys[i] );
+		u32 end = i + 1;
+		while( end < createsTotal && keys[end] == type ) { end++; }
+
+		while( i < end )
+		{
+			// Find bucket with room
+			ObjectBucket *bucket = context.new_object( type );
+			if( UNLIKELY( bucket == nullptr ) )
+			{
+				for( ; i < end; i++ ) { SysObjects::TYPE_DESTRUCT[type]( creates[values[i]].object ); }
+				break;
+			}
+
+			// Relocate staged objects into free slots
+			const u16 bucketID = bucket->bucketID;
+			const u32 capacity = SysObjects::TYPE_BUCKET_CAPACITY[type];
+			const u32 room = SysObjects::TYPE_MAX_COUNT[type] - context.count( type );
+			const u16 lowest = bucket->current;
+			u16 highest = bucket->current;
+			u32 added = 0;
+			for( ; i < end && bucket->current < capacity && added < room; i++ )
+			{
+				void *const object = bucket->data + bucket->current * SysObjects::TYPE_SIZE[type];
+				const u16 generation = bucket->slot_generation( bucket->current );
+				// Raw move out of staging, same assumption as compact(): instances must not point into themselves
+				memory_copy( object, creates[values[i]].object, SysObjects::TYPE_SIZE[type] );
+				const Object id = bucket->place_object( object, generation );
+				keysTemp[added] = id.index;
+				valuesTemp[added] = id.generation;
+				highest = id.index;
+				added++;
+			}
+
+			// Bookkeeping (once per bucket)
+			bucket->update_added( lowest, highest, added );
+			frame.bookkeepingSaved += added - 1;
+			frame.creates += added;
+			frame.buckets++;
+
+			// Create events (bucket pointer refetched: create events may create buckets)
+			if( LIKELY( !context.disableEvents ) )
+			{
+				for( u32 j = 0; j < added; j++ )
+				{
+					const u16 index = static_cast<u16>( keysTemp[j] );
+					byte *const ptr = context.buckets[bucketID].get_object_pointer( index, static_cast<u16>( valuesTemp[j] ) );
+					if( ptr != nullptr ) { reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( ptr )->event_create(); }
+				}
+			}
+		}
+	}
+	createsCount = 0;
+	stagingPages = 0;
+	stagingSize = 0;
+
+	// Statistics
+	timer.stop();
+	frame.flushMs = timer.elapsed_ms();
+	stats = frame;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ObjectContext::write( Buffer &buffer, const ObjectContext &context )
+{
+	// TODO
+}
+
+
+void ObjectContext::read( Buffer &buffer, ObjectContext &context )
+{
+	// TODO
+}
+
+
+void ObjectContext::serialize( Buffer &buffer, const ObjectContext &context )
+{
+	Assert( context.initialized() );
+
+	Serializer serializer;
+	serializer.begin( buffer, 0 );
+	SysObjects::serialize( serializer, context );
+	serializer.end();
+}
+
+
+void ObjectContext::deserialize( Buffer &buffer, ObjectContext &context )
+{
+	if( context.initialized() ) { context.free(); context.init(); }
+
+	context.disableEvents = true;
+	Deserializer deserializer;
+	deserializer.begin( buffer, 0 );
+	SysObjects::deserialize( deserializer, context );
+	deserializer.end();
+	context.disableEvents = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ObjectContext::ObjectBucket::init( const u16 type )
+{
+	// State
+	this->type = type;
+	this->current = 0;
+	this->top = 0;
+	this->bottom = 0;
+
+	// Allocate Memory (object data followed by the alive & active bitmasks, and SPATIAL records)
+	const usize sizeData = ALIGN_TYPE_OFFSET( u64, SysObjects::TYPE_BUCKET_CAPACITY[type] * SysObjects::TYPE_SIZE[type] );
+	const usize sizeMask = BITS_WORDS_U64( SysObjects::TYPE_BUCKET_CAPACITY[type] ) * sizeof( u64 );
+	const usize sizeSpatial = SysObjects::TYPE_SPATIAL[type] == nullptr ? 0 :
+		SysObjects::TYPE_BUCKET_CAPACITY[type] * sizeof( SpatialSlot );
+	const usize size = sizeData + sizeMask * 2 + sizeSpatial;
+	data = reinterpret_cast<byte *>( memory_alloc( size ) );
+	if( data == nullptr ) { return false; }
+	memory_set( data, 0, sizeData + sizeMask * 2 );
+
+	// Recycled bucket ID: continue past the generations its previous life handed out (stale handles must not match)
+	if( generationBase != 0 )
+	{
+		for( u32 i = 0; i < SysObjects::TYPE_BUCKET_CAPACITY[type]; i++ )
+		{
+			reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + i * SysObjects::TYPE_SIZE[type] )->id.generation =
+				generationBase;
+		}
+	}
+
+	// Bitmasks
+	maskAlive = reinterpret_cast<u64 *>( data + sizeData );
+	maskActive = reinterpret_cast<u64 *>( data + sizeData + sizeMask );
+
+	// SPATIAL records (0xFF: not indexed)
+	spatial = sizeSpatial == 0 ? nullptr : reinterpret_cast<SpatialSlot *>( data + sizeData + sizeMask * 2 );
+	if( spatial != nullptr ) { memory_set( spatial, 0xFF, sizeSpatial ); }
+	return true;
+}
+
+
+void ObjectContext::ObjectBucket::free()
+{
+	// Free memory
+	if( relocation != nullptr )
+	{
+		memory_free( relocation );
+		relocation = nullptr;
+	}
+
+	if( data == nullptr ) { return; }
+	memory_free( data );
+	data = nullptr;
+	maskAlive = nullptr;
+	maskActive = nullptr;
+	spatial = nullptr;
+}
+
+
+void ObjectContext::ObjectBucket::clear()
+{
+	// Destroy objects
+	if( data == nullptr ) { return; }
+	for( u32 i = find_alive( 0 ); i < top; i = find_alive( i + 1 ) )
+	{
+		byte *const objectPtr = data + i * SysObjects::TYPE_SIZE[type];
+		delete_object( i, reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr )->id.generation );
+	}
+}
+
+
+void *ObjectContext::ObjectBucket::new_object_pointer()
+{
+	// At capacity?
+	//MemoryAssert( data != nullptr );
+	//if( UNLIKELY( current == SysObjects::TYPE_BUCKET_CAPACITY[type] ) ) { return nullptr; }
+
+	// Return Pointer
+	return data + current * SysObjects::TYPE_SIZE[type];
+}
+
+
+Object ObjectContext::ObjectBucket::new_object( void *ptr, const u16 generation )
+{
+	// Set Object
+	const u16 index = current;
+	SysObjects::OBJECT_TYPE_DEFAULT_t *object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( ptr );
+	place_object( ptr, generation );
+
+	// Update bottom, top, counts, & cache
+	update_added( index, index, 1 );
+
+	// Create Event
+	if( LIKELY( !context.disableEvents ) ) { object->event_create(); }
+
+	// Success
+	return object->id;
+}
+
+
+Object ObjectContext::ObjectBucket::place_object( void *ptr, const u16 generation )
+{
+	// Object
+	SysObjects::OBJECT_TYPE_DEFAULT_t *object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( ptr );
+	Assert( ptr == data + current * SysObjects::TYPE_SIZE[type] );
+
+	// Set Object (next generation of the slot)
+	object->id = { type, static_cast<u16>( generation + 1 ), bucketID, current };
+	object->id.alive = true;
+	bits_set( maskAlive, current );
+	bits_set( maskActive, current );
+
+	// Advance to the next free slot
+	current = static_cast<u16>( find_free( current + 1 ) );
+	return object->id;
+}
+
+
+void ObjectContext::ObjectBucket::update_added( const u16 lowest, const u16 highest, const u32 added )
+{
+	// Update bottom & top
+	bottom = lowest < bottom ? lowest : bottom;
+	top = highest + 1 > top ? highest + 1 : top;
+
+	// Increment Object Count
+	context.objectCount[TYPE_BUCKET( context.category, type )] += added;
+	context.objectCount[NULL_TYPE] += added; // total object count
+	Object::Serialization::dirty |= ( Object::Serialization::context == &context );
+
+	// Cache bucket
+	context.bucketCache[TYPE_BUCKET( context.category, type )] = bucketID;
+}
+
+
+bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 generation )
+{
+	// Destroy object
+	if( !release_object( index, generation ) ) { return false; }
+
+	// Update current, bottom, top, counts, & cache
+	update_removed( index, 1 );
+
+	// Success
+	return true;
+}
+
+
+bool ObjectContext::ObjectBucket::release_object( const u16 index, const u16 generation )
+{
+	// Verify alive
+	MemoryAssert( data != nullptr );
+	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
+	byte *const objectPtr = data + index * SysObjects::TYPE_SIZE[type];
+	SysObjects::OBJECT_TYPE_DEFAULT_t *object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+	if( UNLIKELY( object->id.alive == false ) ) { return false; } // object isn't alive
+	if( UNLIKELY( object->id.generation != generation ) ) { return false; } // object doesn't match current object's generation
+
+	// Destroy event
+	if( LIKELY( !context.disableEvents ) ) { object->event_destroy(); }
+
+	// Destructor
+	SysObjects::TYPE_DESTRUCT[type]( object );
+
+	// Mark dead
+	object->id.alive = false;
+	bits_clear( maskAlive, index );
+	bits_clear( maskActive, index );
+
+	// Remove from SPATIAL index
+	if( spatial != nullptr && spatial[index].cell != U32_MAX )
+	{
+		context.spatial_remove( context.spatial[TYPE_BUCKET( context.category, type )], *this, index );
+	}
+
+	// Success
+	return true;
+}
+
+
+void ObjectContext::ObjectBucket::update_removed( const u16 lowest, const u32 removed )
+{
+	// Update current (event_destroy() may have created objects in freed slots)
+	current = static_cast<u16>( find_free( lowest < current ? lowest : current ) );
+
+	// Update bottom
+	if( lowest <= bottom )
+	{
+		const u32 next = find_alive( bottom );
+		bottom = next < top ? static_cast<u16>( next ) : 0;
+	}
+
+	// Update top
+	if( top > 0 && !bits_test( maskAlive, top - 1 ) )
+	{
+		top = static_cast<u16>( bits_find_set_reverse( maskAlive, top ) );
+	}
+
+	// Cache bucket
+	context.bucketCache[TYPE_BUCKET( context.category, type )] =
+		context.bucketCache[TYPE_BUCKET( context.category, type )] > bucketID ?
+			bucketID : context.bucketCache[TYPE_BUCKET( context.category, type )];
+
+	// Decerement Object Count
+	context.objectCount[TYPE_BUCKET( context.category, type )] -= removed;
+	context.objectCount[NULL_TYPE] -= removed; // total object count
+	Object::Serialization::dirty |= ( Object::Serialization::context == &context );
+}
+
+
+byte *ObjectContext::ObjectBucket::get_object_pointer( const u16 index, const u16 generation ) const
+{
+	// Get Object Pointer
+	MemoryAssert( data != nullptr );
+	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
+	byte *objectPtr = data + index * SysObjects::TYPE_SIZE[type];
+	const SysObjects::OBJECT_TYPE_DEFAULT_t *const object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+
+	// Error cases
+	if( UNLIKELY( object->id.alive == false ) ) { return nullptr; } // object slot isn't alive
+	if( UNLIKELY( object->id.generation != generation ) ) { return nullptr; } // object doesn't match slot generation
+
+	// Return Object Pointer
+	return objectPtr;
+}
+
+
+u16 ObjectContext::ObjectBucket::slot_generation( const u16 index ) const
+{
+	// Generation of the slot's last occupant (persists after destruction; see init() for recycled buckets)
+	MemoryAssert( data != nullptr );
+	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
+	return reinterpret_cast<const SysObjects::OBJECT_TYPE_DEFAULT_t *>( data + index * SysObjects::TYPE_SIZE[type] )->
+		id.generation;
+}
+
+
+const Object &ObjectContext::ObjectBucket::get_object_id( const u16 index ) const
+{
+	// Get Object Pointer
+	MemoryAssert( data != nullptr );
+	Assert( index < SysObjects::TYPE_BUCKET_CAPACITY[type] );
+	byte *objectPtr = data + index * SysObjects::TYPE_SIZE[type];
+	const SysObjects::OBJECT_TYPE_DEFAULT_t *const object = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
+
+	// Return Object ID
+	return object->id;
+}
+
+
+u32 ObjectContext::ObjectBucket::find_alive( const u32 start ) const
+{
+	MemoryAssert( maskAlive != nullptr );
+	return bits_find_set( maskAlive, start, top );
+}
+
+
+u32 ObjectContext::ObjectBucket::find_active( const u32 start ) const
+{
+	MemoryAssert( maskActive != nullptr );
+	return bits_find_set( maskActive, start, top );
+}
+
+
+u32 ObjectContext::ObjectBucket::find_free( const u32 start ) const
+{
+	MemoryAssert( maskAlive != nullptr );
+	return bits_find_clear( maskAlive, start, SysObjects::TYPE_BUCKET_CAPACITY[type] );
+}
+
+
+u32 ObjectContext::ObjectBucket::count_alive() const
+{
+	if( maskAlive == nullptr ) { return 0; }
+	return bits_count( maskAlive, top );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ObjectContext::ObjectIteratorAll::find_object_ptr( ObjectIterator &itr,
+                                                        const ObjectBucket *const bucket,
+                                                        const u16 start )
+{
+	// Bucket Verification
+	if( bucket->data == nullptr ) { return false; }
+
+	// Find the next alive instance from the bucket's occupancy mask
+	const u32 i = bucket->find_alive( start );
+	if( i >= bucket->top ) { return false; }
+
+	// Success
+	itr.ptr = bucket->data + i * SysObjects::TYPE_SIZE[bucket->type];
+	itr.bucketID = bucket->bucketID;
+	itr.index = static_cast<u16>( i );
+	return true;
+}
+
+
+bool ObjectContext::ObjectIteratorActive::find_object_ptr( ObjectIterator &itr,
+                                                           const ObjectBucket *const bucket,
+                                                           const u16 start )
+{
+	// Bucket Verification
+	if( bucket->data == nullptr ) { return false; }
+
+	// Find the next alive & active instance from the bucket's activity mask
+	const u32 i = bucket->find_active( start );
+	if( i >= bucket->top ) { return false; }
+
+	// Success
+	itr.ptr = bucket->data + i * SysObjects::TYPE_SIZE[bucket->type];
+	itr.bucketID = bucket->bucketID;
+	itr.index = static_cast<u16>( i );
+	return true;
+}
+
+
+void ObjectContext::ObjectIterator::find_object( u32 startIndex )
+{
+	// Begin iteration from our bucket id
+	if( TYPE_INVALID( context.category, this->type ) ) { this->ptr = nullptr; return; }
+	if( UNLIKELY( this->bucketID == NULL_BUCKET ) ) { this->ptr = nullptr; return; }
+	ObjectBucket *bucket = &context.buckets[this->bucketID];
+
+	// Loop over ObjectBuckets until we find a live object of our type
+	for( ;; )
+	{
+		// Find object
+		if( find_object_ptr( *this, bucket, startIndex ) ) { return; }
+
+		// Move to the next bucket
+		if( bucket->bucketIDNext == NULL_BUCKET ) { break; }
+		bucket = &context.buckets[bucket->bucketIDNext];
+		startIndex = bucket->bottom;
+
+		// Check if the bucket is still our type
+		if( bucket->type == this->type ) { continue; }
+
+		// Are we iterating polymorphically (allow children types too)?
+		if( !polymorphic ) { break; }
+
+		// If so, check if the bucket is one of our child types
+		const u16 targetTypeDepth = SysObjects::TYPE_INHERITANCE_DEPTH[this->type];
+		const u16 bucketTypeDepth = SysObjects::TYPE_INHERITANCE_DEPTH[bucket->type];
+		if( bucketTypeDepth > targetTypeDepth ) { continue; }
+
+		// We must be at the end of valid buckets
+		break;
+	}
+
+	// If we've made it this far, there are no live objects of our type
+	ptr = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPATIAL objects are indexed by a hash of uniform grid cells. Each instance lives in the cell containing its center
+// (queries expand by the largest indexed radius), so spatial_update() only touches the cells of instances that moved
+// across a cell boundary. Destroyed instances are removed from the index immediately (ObjectBucket::release_object)
+
+#define SPATIAL_NONE ( U32_MAX )
+#define SPATIAL_CELL_LIMIT ( 1 << 30 )
+#define SPATIAL_PRUNE_MIN ( 64 ) // empty cells tolerated before spatial_update() prunes
+
+static u32 spatial_hash( const i32 cx, const i32 cy )
+{
+	u32 h = static_cast<u32>( cx ) * 0x9E3779B1u ^ static_cast<u32>( cy ) * 0x85EBCA77u;
+	h ^= h >> 15;
+	h *= 0x2C1B3C6Du;
+	h ^= h >> 12;
+	return h;
+}
+
+
+static i32 spatial_cell( const float value, const float cellSizeInv )
+{
+	// Clamp (NaN fails both comparisons and lands in the lowest cell, +/-inf in the outermost cells)
+	float cell = value * cellSizeInv;
+	cell = cell > -SPATIAL_CELL_LIMIT ? cell : -SPATIAL_CELL_LIMIT;
+	cell = cell < SPATIAL_CELL_LIMIT ? cell : SPATIAL_CELL_LIMIT;
+	const i32 truncated = static_cast<i32>( cell );
+	return static_cast<float>( truncated ) > cell ? truncated - 1 : truncated; // floor
+}
+
+
+void ObjectContext::SpatialIndex::free()
+{
+	for( u32 i = 0; i < cellsCount; i++ )
+	{
+		if( cells[i].items != nullptr ) { memory_free( cells[i].items ); }
+	}
+
+	if( cells != nullptr ) { memory_free( cells ); cells = nullptr; }
+	if( table != nullptr ) { memory_free( table ); table = nullptr; }
+	cellsCount = 0;
+	cellsCapacity = 0;
+	cellsEmpty = 0;
+	tableCapacity = 0;
+	radiusMax = 0.0f;
+}
+
+
+u32 ObjectContext::SpatialIndex::find( const i32 cx, const i32 cy ) const
+{
+	if( tableCapacity == 0 ) { return SPATIAL_NONE; }
+
+	// Linear probe
+	const u32 mask = tableCapacity - 1;
+	for( u32 slot = spatial_hash( cx, cy ) & mask; table[slot] != 0; slot = ( slot + 1 ) & mask )
+	{
+		const SpatialCell &cell = cells[table[slot] - 1];
+		if( cell.cx == cx && cell.cy == cy ) { return table[slot] - 1; }
+	}
+
+	return SPATIAL_NONE;
+}
+
+
+u32 ObjectContext::SpatialIndex::find_or_add( const i32 cx, const i32 cy )
+{
+	const u32 existing = find( cx, cy );
+	if( existing != SPATIAL_NONE ) { return existing; }
+
+	// Grow cells
+	if( cellsCount == cellsCapacity )
+	{
+		cellsCapacity = cellsCapacity == 0 ? 64 : cellsCapacity * 2;
+		const usize size = cellsCapacity * sizeof( SpatialCell );
+		cells = reinterpret_cast<SpatialCell *>( cells == nullptr ? memory_alloc( size ) : memory_realloc( cells, size ) );
+		ErrorIf( cells == nullptr, "Failed to allocate memory for SPATIAL cells" );
+	}
+
+	// Grow & rehash table (load factor <= 0.5)
+	if( ( cellsCount + 1 ) * 2 > tableCapacity )
+	{
+		if( table != nullptr ) { memory_free( table ); }
+		tableCapacity = tableCapacity == 0 ? 128 : tableCapacity * 2;
+		table = reinterpret_cast<u32 *>( memory_alloc( tableCapacity * sizeof( u32 ) ) );
+		ErrorIf( table == nullptr, "Failed to allocate memory for SPATIAL table" );
+		memory_set( table, 0, tableCapacity * sizeof( u32 ) );
+
+		const u32 mask = tableCapacity - 1;
+		for( u32 i = 0; i < cellsCount; i++ )
+		{
+			u32 slot = spatial_hash( cells[i].cx, cells[i].cy ) & mask;
+			while( table[slot] != 0 ) { slot = ( slot + 1 ) & mask; }
+			table[slot] = i + 1;
+		}
+	}
+
+	// Add cell
+	const u32 mask = tableCapacity - 1;
+	u32 slot = spatial_hash( cx, cy ) & mask;
+	while( table[slot] != 0 ) { slot = ( slot + 1 ) & mask; }
+	table[slot] = cellsCount + 1;
+	cells[cellsCount] = { cx, cy, nullptr, 0, 0 };
+	cellsEmpty++;
+	return cellsCount++;
+}
+
+
+void ObjectContext::spatial_insert( SpatialIndex &index, ObjectBucket &bucket, const u16 slot,
+	const ObjectSpatialBounds &bounds, const i32 cx, const i32 cy )
+{
+	const u32 cellIndex = index.find_or_add( cx, cy ); // may reallocate index.cells
+	SpatialCell &cell = index.cells[cellIndex];
+
+	// Grow items
+	if( cell.count == cell.capacity )
+	{
+		cell.capacity = cell.capacity == 0 ? 8 : cell.capacity * 2;
+		const usize size = cell.capacity * sizeof( SpatialItem );
+		cell.items = reinterpret_cast<SpatialItem *>( cell.items == nullptr ? memory_alloc( size ) :
+			memory_realloc( cell.items, size ) );
+		ErrorIf( cell.items == nullptr, "Failed to allocate memory for SPATIAL cell" );
+	}
+
+	// Add item
+	index.cellsEmpty -= cell.count == 0;
+	cell.items[cell.count] = { bounds.x, bounds.y, bounds.radius, bucket.bucketID, slot };
+	bucket.spatial[slot] = { cellIndex, cell.count };
+	cell.count++;
+}
+
+
+void ObjectContext::spatial_remove( SpatialIndex &index, ObjectBucket &bucket, const u16 slot )
+{
+	SpatialSlot &record = bucket.spatial[slot];
+	Assert( record.cell < index.cellsCount );
+	SpatialCell &cell = index.cells[record.cell];
+	Assert( record.item < cell.count );
+
+	// Swap remove (patch the record of the moved item)
+	const SpatialItem &last = cell.items[--cell.count];
+	if( record.item != cell.count )
+	{
+		cell.items[record.item] = last;
+		buckets[last.bucketID].spatial[last.index].item = record.item;
+	}
+
+	index.cellsEmpty += cell.count == 0;
+	record = { SPATIAL_NONE, 0 };
+}
+
+
+void ObjectContext::spatial_prune( SpatialIndex &index )
+{
+	// Drop empty cells (keeping the order of the rest) & patch the records of items in cells that moved
+	u32 count = 0;
+	for( u32 i = 0; i < index.cellsCount; i++ )
+	{
+		SpatialCell &cell = index.cells[i];
+		if( cell.count == 0 )
+		{
+			if( cell.items != nullptr ) { memory_free( cell.items ); }
+			continue;
+		}
+
+		if( count != i )
+		{
+			index.cells[count] = cell;
+			for( u32 j = 0; j < cell.count; j++ )
+			{
+				const SpatialItem &item = cell.items[j];
+				buckets[item.bucketID].spatial[item.index].cell = count;
+			}
+		}
+		count++;
+	}
+	index.cellsCount = count;
+	index.cellsEmpty = 0;
+
+	// Rehash
+	memory_set( index.table, 0, index.tableCapacity * sizeof( u32 ) );
+	const u32 mask = index.tableCapacity - 1;
+	for( u32 i = 0; i < index.cellsCount; i++ )
+	{
+		u32 slot = spatial_hash( index.cells[i].cx, index.cells[i].cy ) & mask;
+		while( index.table[slot] != 0 ) { slot = ( slot + 1 ) & mask; }
+		index.table[slot] = i + 1;
+	}
+}
+
+
+void ObjectContext::spatial_update()
+{
+	MemoryAssert( buckets != nullptr );
+
+	for( u16 typeBucket = 1; typeBucket < SysObjects::CATEGORY_TYPE_COUNT[category]; typeBucket++ )
+	{
+		const u16 type = SysObjects::CATEGORY_TYPES[category][typeBucket];
+		if( SysObjects::TYPE_SPATIAL[type] == nullptr ) { continue; }
+		spatial_update( type );
+	}
+}
+
+
+void ObjectContext::spatial_update( const u16 type )
+{
+	MemoryAssert( buckets != nullptr );
+	if( TYPE_INVALID( category, type ) ) { return; }
+	if( SysObjects::TYPE_SPATIAL[type] == nullptr ) { return; }
+	const u16 typeBucket = TYPE_BUCKET( category, type );
+
+	// Lazy initialize index
+	SpatialIndex &index = spatial[typeBucket];
+	if( index.cellSize == 0.0f )
+	{
+		Assert( SysObjects::TYPE_SPATIAL_CELL_SIZE[type] > 0.0f );
+		index.cellSize = SysObjects::TYPE_SPATIAL_CELL_SIZE[type];
+		index.cellSizeInv = 1.0f / index.cellSize;
+	}
+
+	// Sync instances (only cell changes touch the hash table)
+	float radiusMax = 0.0f;
+	for( ObjectBucket *bucket = &buckets[typeBucket]; bucket->type == type; )
+	{
+		if( bucket->data != nullptr )
+		{
+			for( u32 i = bucket->find_alive( bucket->bottom ); i < bucket->top; i = bucket->find_alive( i + 1 ) )
+			{
+				ObjectSpatialBounds bounds;
+				SysObjects::TYPE_SPATIAL[type]( bucket->data + i * SysObjects::TYPE_SIZE[type], bounds );
+				const i32 cx = spatial_cell( bounds.x, index.cellSizeInv );
+				const i32 cy = spatial_cell( bounds.y, index.cellSizeInv );
+				radiusMax = bounds.radius > radiusMax ? bounds.radius : radiusMax;
+
+				const SpatialSlot &record = bucket->spatial[i];
+				if( record.cell != SPATIAL_NONE )
+				{
+					SpatialCell &cell = index.cells[record.cell];
+					if( cell.cx == cx && cell.cy == cy )
+					{
+						SpatialItem &item = cell.items[record.item];
+						item.x = bounds.x;
+						item.y = bounds.y;
+						item.radius = bounds.radius;
+						continue;
+					}
+					spatial_remove( index, *bucket, static_cast<u16>( i ) );
+				}
+				spatial_insert( index, *bucket, static_cast<u16>( i ), bounds, cx, cy );
+			}
+		}
+
+		if( bucket->bucketIDNext == NULL_BUCKET ) { break; }
+		bucket = &buckets[bucket->bucketIDNext];
+	}
+	index.radiusMax = radiusMax;
+
+	// Cells left behind by moving instances (amortized: pruned once they outnumber the occupied cells)
+	if( index.cellsEmpty > SPATIAL_PRUNE_MIN && index.cellsEmpty * 2 > index.cellsCount ) { spatial_prune( index ); }
+}
+
+
+ObjectContext::ObjectIteratorSpatial::ObjectIteratorSpatial( const ObjectContext &context, u16 type,
+	float x1, float y1, float x2, float y2, float radius, bool circle ) :
+	context{ context }, index{ nullptr }, ptr{ nullptr }, x1{ x1 }, y1{ y1 }, x2{ x2 }, y2{ y2 },
+	qx{ ( x1 + x2 ) * 0.5f }, qy{ ( y1 + y2 ) * 0.5f }, qr{ radius }, cx1{ 0 }, cy1{ 0 }, cx2{ 0 }, cy2{ 0 },
+	cell{ 0 }, item{ 0 }, type{ type }, circle{ circle }, dense{ 0 }
+{
+	find_first();
+}
+
+
+void ObjectContext::ObjectIteratorSpatial::find_first()
+{
+	ptr = nullptr;
+	if( TYPE_INVALID( context.category, type ) ) { return; }
+	index = &context.spatial[TYPE_BUCKET( context.category, type )];
+	if( index->cellsCount == 0 ) { return; }
+
+	// Cell range (expanded by the largest indexed radius)
+	const float pad = index->radiusMax;
+	cx1 = spatial_cell( x1 - pad, index->cellSizeInv );
+	cy1 = spatial_cell( y1 - pad, index->cellSizeInv );
+	cx2 = spatial_cell( x2 + pad, index->cellSizeInv );
+	cy2 = spatial_cell( y2 + pad, index->cellSizeInv );
+	if( cx2 < cx1 || cy2 < cy1 ) { return; }
+
+	// Large queries walk the occupied cells instead of probing every cell in range
+	const u64 range = static_cast<u64>( cx2 - cx1 + 1 ) * static_cast<u64>( cy2 - cy1 + 1 );
+	dense = range > index->cellsCount;
+
+	find_object( dense ? 0 : index->find( cx1, cy1 ), 0 );
+}
+
+
+void ObjectContext::ObjectIteratorSpatial::find_next()
+{
+	// The current instance may have been destroyed (swap removed) since it was returned: revisit its item
+	const SpatialCell &c = index->cells[cell];
+	if( item < c.count )
+	{
+		const SpatialItem &i = c.items[item];
+		const ObjectBucket &bucket = context.buckets[i.bucketID];
+		if( bucket.data + i.index * SysObjects::TYPE_SIZE[bucket.type] != ptr ) { find_object( cell, item ); return; }
+	}
+
+	find_object( cell, item + 1 );
+}
+
+
+void ObjectContext::ObjectIteratorSpatial::find_object( u32 cell, u32 item )
+{
+	i32 cx = cx1;
+	i32 cy = cy1;
+	if( !dense && cell != SPATIAL_NONE ) { cx = index->cells[cell].cx; cy = index->cells[cell].cy; }
+
+	for( ;; )
+	{
+		// Test items in the current cell
+		if( cell != SPATIAL_NONE && cell < index->cellsCount )
+		{
+			const SpatialCell &c = index->cells[cell];
+			const bool inRange = c.cx >= cx1 && c.cx <= cx2 && c.cy >= cy1 && c.cy <= cy2;
+			for( ; inRange && item < c.count; item++ )
+			{
+				const SpatialItem &i = c.items[item];
+				if( circle )
+				{
+					const float dx = i.x - qx;
+					const float dy = i.y - qy;
+					const float r = i.radius + qr;
+					if( dx * dx + dy * dy > r * r ) { continue; }
+				}
+				else
+				{
+					const float nx = i.x < x1 ? x1 : ( i.x > x2 ? x2 : i.x );
+					const float ny = i.y < y1 ? y1 : ( i.y > y2 ? y2 : i.y );
+					const float dx = i.x - nx;
+					const float dy = i.y - ny;
+					if( dx * dx + dy * dy > i.radius * i.radius ) { continue; }
+				}
+
+				// Skip deactivated instances
+				const ObjectBucket &bucket = context.buckets[i.bucketID];
+				if( !bits_test( bucket.maskActive, i.index ) ) { continue; }
+
+				this->cell = cell;
+				this->item = item;
+				ptr = bucket.data + i.index * SysObjects::TYPE_SIZE[bucket.type];
+				return;
+			}
+		}
+
+		// Advance to the next cell
+		item = 0;
+		if( dense )
+		{
+			if( ++cell >= index->cellsCount ) { break; }
+			continue;
+		}
+
+		if( ++cx > cx2 )
+		{
+			cx = cx1;
+			if( ++cy > cy2 ) { break; }
+		}
+		cell = index->find( cx, cy );
+	}
+
+	ptr = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ObjectContext::compact( const u32 budget )
+{
+	MemoryAssert( buckets != nullptr );
+	Assert( !deferCommands );
+	Timer timer;
+	timer.start();
+
+	CompactStatistics stats { };
+	stats.movedTotal = compactStats.movedTotal;
+	compactPass++;
+
+	// Recycle retired buckets whose relocation records have expired (oldest first)
+	while( bucketsRetired != NULL_BUCKET &&
+		static_cast<u16>( compactPass - buckets[bucketsRetired].retiredPass ) >= OBJECT_COMPACT_RELOCATION_PASSES )
+	{
+		ObjectBucket &bucket = buckets[bucketsRetired];
+		bucketsRetired = bucket.bucketIDNext;
+		bucket.free();
+		bucket.bucketIDNext = bucketsFree;
+		bucketsFree = bucket.bucketID;
+		stats.recycled++;
+	}
+	if( bucketsRetired == NULL_BUCKET ) { bucketsRetiredTail = NULL_BUCKET; }
+
+	u32 remaining = budget;
+	for( u16 typeBucket = 1; typeBucket < SysObjects::CATEGORY_TYPE_COUNT[category]; typeBucket++ )
+	{
+		const u16 type = SysObjects::CATEGORY_TYPES[category][typeBucket];
+		const u32 capacity = SysObjects::TYPE_BUCKET_CAPACITY[type];
+		if( buckets[typeBucket].data == nullptr ) { continue; }
+
+		// Retire empty overflow buckets & pick the drain source (the bucket already draining, else the sparsest)
+		u16 source = NULL_BUCKET;
+		u32 sourceAlive = U32_MAX;
+		bool sourceDraining = false;
+		u32 room = capacity - buckets[typeBucket].count_alive();
+		for( u16 bucketID = buckets[typeBucket].bucketIDNext; bucketID != NULL_BUCKET && buckets[bucketID].type == type; )
+		{
+			ObjectBucket &bucket = buckets[bucketID];
+			const u16 next = bucket.bucketIDNext;
+			const u32 alive = bucket.count_alive();
+			if( alive == 0 ) { compact_retire( bucketID ); stats.retired++; bucketID = next; continue; }
+
+			room += capacity - alive;
+			if( bucket.relocation != nullptr ) { source = bucketID; sourceAlive = alive; sourceDraining = true; }
+			else if( !sourceDraining && alive < sourceAlive && alive * 100 <= capacity * OBJECT_COMPACT_SPARSE )
+			{
+				source = bucketID;
+				sourceAlive = alive;
+			}
+			bucketID = next;
+		}
+
+		// Only start draining a bucket the other buckets can absorb
+		if( source == NULL_BUCKET || remaining == 0 ) { continue; }
+		if( !sourceDraining && room - ( capacity - sourceAlive ) < sourceAlive ) { continue; }
+
+		ObjectBucket &from = buckets[source];
+		if( from.relocation == nullptr )
+		{
+			from.relocation = reinterpret_cast<Relocation *>( memory_alloc( capacity * sizeof( Relocation ) ) );
+			ErrorIf( from.relocation == nullptr, "Failed to allocate memory for ObjectContext::compact() relocation" );
+			memory_set( from.relocation, 0, capacity * sizeof( Relocation ) );
+		}
+
+		// Move instances into free slots of the type's other buckets (head first)
+		const u16 size = SysObjects::TYPE_SIZE[type];
+		SpatialIndex &index = spatial[typeBucket];
+		u16 destination = typeBucket;
+		u16 lowest = U16_MAX;
+		u32 moved = 0;
+		for( u32 i = from.find_alive( from.bottom ); i < from.top && remaining > 0; i = from.find_alive( i + 1 ) )
+		{
+			while( destination != NULL_BUCKET && ( destination == source || buckets[destination].current >= capacity ) )
+			{
+				destination = buckets[destination].bucketIDNext;
+				if( destination != NULL_BUCKET && buckets[destination].type != type ) { destination = NULL_BUCKET; }
+			}
+			if( destination == NULL_BUCKET ) { break; }
+			ObjectBucket &to = buckets[destination];
+			const u16 slot = to.current;
+
+			// Relocate the instance bytes (no destructor or constructor: the instance lives on at the new slot, under the
+			// slot's next generation so stale handles to the slot's previous occupants stay invalid)
+			SysObjects::OBJECT_TYPE_DEFAULT_t *const object =
+				reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( to.data + slot * size );
+			const u16 slotGeneration = to.slot_generation( slot );
+			memory_copy( object, from.data + i * size, size );
+			const u16 generation = object->id.generation;
+			object->id.generation = static_cast<u16>( slotGeneration + 1 );
+			object->id.bucketID = destination;
+			object->id.index = slot;
+			bits_set( to.maskAlive, slot );
+			if( !object->id.deactivated ) { bits_set( to.maskActive, slot ); }
+			to.current = static_cast<u16>( to.find_free( slot + 1 ) );
+			to.update_added( slot, slot, 1 );
+
+			// SPATIAL: the index item follows the instance
+			if( from.spatial != nullptr )
+			{
+				SpatialSlot &record = from.spatial[i];
+				if( record.cell != SPATIAL_NONE )
+				{
+					SpatialItem &item = index.cells[record.cell].items[record.item];
+					item.bucketID = destination;
+					item.index = slot;
+				}
+				to.spatial[slot] = record;
+				record = { SPATIAL_NONE, 0 };
+			}
+
+			// Vacate the old slot & record the move
+			reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( from.data + i * size )->id.alive = false;
+			bits_clear( from.maskAlive, i );
+			bits_clear( from.maskActive, i );
+			from.relocation[i] = { object->id, generation };
+			lowest = i < lowest ? static_cast<u16>( i ) : lowest;
+			moved++;
+			remaining--;
+		}
+
+		// Bookkeeping (once per source bucket)
+		if( moved > 0 ) { from.update_removed( lowest, moved ); }
+		bucketCache[typeBucket] = typeBucket;
+		stats.moved += moved;
+
+		// Emptied: unlink & free
+		if( from.count_alive() == 0 ) { compact_retire( source ); stats.retired++; }
+	}
+
+	timer.stop();
+	stats.movedTotal += stats.moved;
+	stats.compactMs = timer.elapsed_ms();
+	compactStats = stats;
+}
+
+
+void ObjectContext::compact_retire( const u16 bucketID )
+{
+	ObjectBucket &bucket = buckets[bucketID];
+	const u16 typeBucket = TYPE_BUCKET( category, bucket.type );
+	Assert( bucketID != typeBucket ); // head buckets are never retired
+
+	// Unlink from the type's bucket chain
+	u16 previous = typeBucket;
+	while( buckets[previous].bucketIDNext != bucketID )
+	{
+		previous = buckets[previous].bucketIDNext;
+		Assert( previous != NULL_BUCKET );
+	}
+	buckets[previous].bucketIDNext = bucket.bucketIDNext;
+	bucketCache[typeBucket] = typeBucket;
+
+	// Generations handed out by this bucket ID: a recycled bucket starts past all of them
+	u16 generation = bucket.generationBase;
+	for( u32 i = 0; i < SysObjects::TYPE_BUCKET_CAPACITY[bucket.type]; i++ )
+	{
+		const u16 slotGeneration = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( bucket.data +
+			i * SysObjects::TYPE_SIZE[bucket.type] )->id.generation;
+		generation = slotGeneration > generation ? slotGeneration : generation;
+	}
+	bucket.generationBase = generation;
+
+	// Free instance memory (relocation records are kept until the bucket is recycled)
+	Relocation *const relocation = bucket.relocation;
+	bucket.relocation = nullptr;
+	bucket.free();
+	bucket.relocation = relocation;
+	bucket.current = 0;
+	bucket.bottom = 0;
+	bucket.top = 0;
+
+	// Append to the retired FIFO
+	bucket.retiredPass = compactPass;
+	bucket.bucketIDNext = NULL_BUCKET;
+	if( bucketsRetiredTail != NULL_BUCKET ) { buckets[bucketsRetiredTail].bucketIDNext = bucketID; }
+	else { bucketsRetired = bucketID; }
+	bucketsRetiredTail = bucketID;
+}
+
+
+bool ObjectContext::relocate( Object &object ) const
+{
+	MemoryAssert( buckets != nullptr );
+	bool relocated = false;
+
+	// Follow relocation records (an instance may have moved more than once)
+	while( object.bucketID < current )
+	{
+		const ObjectBucket &bucket = buckets[object.bucketID];
+		if( LIKELY( bucket.relocation == nullptr ) || bucket.type != object.type ) { break; }
+		if( object.index >= SysObjects::TYPE_BUCKET_CAPACITY[bucket.type] ) { break; }
+
+		const Relocation &record = bucket.relocation[object.index];
+		if( record.generation == 0 || record.generation != object.generation ) { break; }
+		object = record.object;
+		relocated = true;
+	}
+
+	return relocated;
+}
+
+
+ObjectContext::MemoryStatistics ObjectContext::memory_statistics() const
+{
+	MemoryAssert( buckets != nullptr );
+	MemoryStatistics stats { };
+
+	// Iteration chains
+	for( u16 typeBucket = 1; typeBucket < SysObjects::CATEGORY_TYPE_COUNT[category]; typeBucket++ )
+	{
+		const u16 type = SysObjects::CATEGORY_TYPES[category][typeBucket];
+		for( u16 bucketID = typeBucket; bucketID != NULL_BUCKET && buckets[bucketID].type == type;
+		     bucketID = buckets[bucketID].bucketIDNext )
+		{
+			stats.buckets++;
+			stats.slotsSpanned += buckets[bucketID].top - buckets[bucketID].bottom;
+		}
+	}
+
+	// Resident memory (see ObjectBucket::init())
+	stats.residentBytes = capacity * sizeof( ObjectBucket );
+	for( u16 bucketID = 0; bucketID < current; bucketID++ )
+	{
+		const ObjectBucket &bucket = buckets[bucketID];
+		const u16 type = bucket.type;
+		if( bucket.relocation != nullptr )
+		{
+			stats.residentBytes += SysObjects::TYPE_BUCKET_CAPACITY[type] * sizeof( Relocation );
+		}
+
+		if( bucket.data == nullptr )
+		{
+			stats.bucketsRetired += bucketID >= SysObjects::CATEGORY_TYPE_COUNT[category];
+			continue;
+		}
+
+		stats.bucketsResident++;
+		stats.residentBytes += ALIGN_TYPE_OFFSET( u64, SysObjects::TYPE_BUCKET_CAPACITY[type] * SysObjects::TYPE_SIZE[type] );
+		stats.residentBytes += BITS_WORDS_U64( SysObjects::TYPE_BUCKET_CAPACITY[type] ) * sizeof( u64 ) * 2;
+		if( bucket.spatial != nullptr )
+		{
+			stats.residentBytes += SysObjects::TYPE_BUCKET_CAPACITY[type] * sizeof( SpatialSlot );
+		}
+	}
+
+	// SPATIAL cells
+	for( u16 typeBucket = 1; typeBucket < SysObjects::CATEGORY_TYPE_COUNT[category]; typeBucket++ )
+	{
+		stats.spatialCells += spatial[typeBucket].cellsCount;
+	}
+
+	return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ObjectSnapshot records hold the trivially copyable fields of each type packed in declaration order (inherited
+// fields first). Records within a type are sorted by key (bucketID << 16 | index), so delta() is a merge-join
+//
+// Delta layout (per type with changes, terminated by a NULL_TYPE):
+//   u16 type, u32 destroyed, u32 created, u32 changed, u32 changed bytes
+//   destroyed records, created records (snapshot records)
+//   changed records: u32 key, u16 generation, field bitmask (bit 0: 'deactivated'), XOR bytes of each changed field
+
+#define SNAPSHOT_FLAG_DEACTIVATED ( 1 << 0 )
+#define SNAPSHOT_MASK_BYTES_MAX ( ( OBJECT_SNAPSHOT_FIELD_TOTAL + 8 ) / 8 )
+
+struct SnapshotRecord
+{
+	u32 key;
+	u16 generation;
+	u8 flags;
+	u8 padding;
+};
+static_assert( sizeof( SnapshotRecord ) == 8, "SnapshotRecord size changed!" );
+
+struct SnapshotLayout
+{
+	u32 first;     // first field in g_snapshotFields
+	u32 count;     // trivially copyable fields
+	u32 bytes;     // packed field bytes
+	u32 stride;    // record size
+	u32 maskBytes; // changed record bitmask size
+};
+
+static ObjectSnapshotField g_snapshotFields[OBJECT_SNAPSHOT_FIELD_TOTAL + 1];
+static SnapshotLayout g_snapshotLayout[OBJECT_TYPE_COUNT];
+static bool g_snapshotLayoutReady = false;
+
+
+static void snapshot_layout()
+{
+	if( g_snapshotLayoutReady ) { return; }
+
+	u32 first = 0;
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		const u32 fields = SysObjects::TYPE_SNAPSHOT_FIELDS[type]( &g_snapshotFields[first] );
+		Assert( first + fields <= OBJECT_SNAPSHOT_FIELD_TOTAL );
+
+		// Keep trivially copyable fields
+		SnapshotLayout &layout = g_snapshotLayout[type];
+		layout = { first, 0, 0, 0, 0 };
+		for( u32 i = 0; i < fields; i++ )
+		{
+			const ObjectSnapshotField field = g_snapshotFields[first + i];
+			if( !field.trivial ) { continue; }
+			g_snapshotFields[first + layout.count++] = field;
+			layout.bytes += field.size;
+		}
+
+		layout.stride = sizeof( SnapshotRecord ) + layout.bytes;
+		layout.maskBytes = ( layout.count + 8 ) / 8;
+		first += layout.count;
+	}
+
+	g_snapshotLayoutReady = true;
+}
+
+
+static SnapshotRecord snapshot_record( const byte *record )
+{
+	SnapshotRecord header;
+	memory_copy( &header, record, sizeof( SnapshotRecord ) );
+	return header;
+}
+
+
+// Calls visit( from, to ) for every instance in either record range (nullptr: not in that snapshot). An instance
+// whose slot was reused (generation mismatch) is visited as destroyed & created
+template <typename Visit> static void snapshot_merge( const byte *from, const u32 fromCount, const byte *to,
+	const u32 toCount, const u32 stride, Visit visit )
+{
+	u32 i = 0;
+	u32 j = 0;
+	while( i < fromCount || j < toCount )
+	{
+		const byte *a = from + static_cast<usize>( i ) * stride;
+		const byte *b = to + static_cast<usize>( j ) * stride;
+		if( j == toCount ) { visit( a, nullptr ); i++; continue; }
+		if( i == fromCount ) { visit( nullptr, b ); j++; continue; }
+
+		const SnapshotRecord recordA = snapshot_record( a );
+		const SnapshotRecord recordB = snapshot_record( b );
+		if( recordA.key < recordB.key ) { visit( a, nullptr ); i++; continue; }
+		if( recordA.key > recordB.key ) { visit( nullptr, b ); j++; continue; }
+		if( recordA.generation != recordB.generation ) { visit( a, nullptr ); visit( nullptr, b ); }
+		else { visit( a, b ); }
+		i++;
+		j++;
+	}
+}
+
+
+byte *ObjectContext::snapshot_place( const u16 type, const u16 bucketID, const u16 index, const u16 generation )
+{
+	const u16 typeBucket = TYPE_BUCKET( category, type );
+	if( index >= SysObjects::TYPE_BUCKET_CAPACITY[type] ) { return nullptr; }
+
+	// Grow until the bucket exists (skipped buckets join the free list)
+	while( current <= bucketID )
+	{
+		if( current == capacity && !grow() ) { return nullptr; }
+		buckets[current].bucketID = current;
+		if( current != bucketID ) { buckets[current].bucketIDNext = bucketsFree; bucketsFree = current; }
+		current++;
+	}
+
+	// Lazy initialize the head bucket
+	if( buckets[typeBucket].data == nullptr && !buckets[typeBucket].init( type ) ) { return nullptr; }
+
+	ObjectBucket *bucket = &buckets[bucketID];
+	if( bucketID != typeBucket && ( bucket->data == nullptr || bucket->type != type ) )
+	{
+		// Retired by compact() (relocation records still live)
+		if( bucket->data == nullptr && bucket->relocation != nullptr ) { return nullptr; }
+
+		// Empty overflow bucket of another type (recycled by compact()): unlink it from that type's chain
+		if( bucket->data != nullptr )
+		{
+			if( bucketID < SysObjects::CATEGORY_TYPE_COUNT[category] || bucket->count_alive() != 0 ) { return nullptr; }
+			u16 previous = TYPE_BUCKET( category, bucket->type );
+			while( buckets[previous].bucketIDNext != bucketID ) { previous = buckets[previous].bucketIDNext; }
+			buckets[previous].bucketIDNext = bucket->bucketIDNext;
+			bucketCache[TYPE_BUCKET( category, bucket->type )] = TYPE_BUCKET( category, bucket->type );
+			bucket->free();
+		}
+		else
+		{
+			// Unlink from the free list
+			u16 *link = &bucketsFree;
+			while( *link != NULL_BUCKET && *link != bucketID ) { link = &buckets[*link].bucketIDNext; }
+			if( *link == bucketID ) { *link = bucket->bucketIDNext; }
+		}
+
+		// Link after the type's head bucket
+		if( !bucket->init( type ) ) { return nullptr; }
+		bucket->bucketIDNext = buckets[typeBucket].bucketIDNext;
+		buckets[typeBucket].bucketIDNext = bucketID;
+	}
+
+	// Slot taken?
+	if( bits_test( bucket->maskAlive, index ) ) { return nullptr; }
+
+	// Construct at the exact slot & generation
+	byte *const object = bucket->data + index * SysObjects::TYPE_SIZE[type];
+	SysObjects::TYPE_CONSTRUCT[type]( object ); // Constructor
+	Object &id = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( object )->id;
+	id = { type, generation, bucketID, index };
+	id.alive = true;
+	bits_set( bucket->maskAlive, index );
+	bits_set( bucket->maskActive, index );
+	if( index == bucket->current ) { bucket->current = static_cast<u16>( bucket->find_free( index + 1 ) ); }
+	bucket->update_added( index, index, 1 );
+	return object;
+}
+
+
+bool ObjectContext::snapshot_remove( const u16 type, const u16 bucketID, const u16 index, const u16 generation )
+{
+	if( bucketID >= current || index >= SysObjects::TYPE_BUCKET_CAPACITY[type] ) { return false; }
+	ObjectBucket &bucket = buckets[bucketID];
+	if( bucket.data == nullptr || bucket.type != type ) { return false; }
+	return bucket.delete_object( index, generation );
+}
+
+
+bool ObjectSnapshot::init()
+{
+	snapshot_layout();
+	data = nullptr;
+	size = 0;
+	capacity = 0;
+	memory_set( typeOffset, 0, sizeof( typeOffset ) );
+	memory_set( typeCount, 0, sizeof( typeCount ) );
+	return true;
+}
+
+
+bool ObjectSnapshot::free()
+{
+	if( data != nullptr )
+	{
+		memory_free( data );
+		data = nullptr;
+	}
+
+	size = 0;
+	capacity = 0;
+	return true;
+}
+
+
+void ObjectSnapshot::clear()
+{
+	size = 0;
+	memory_set( typeOffset, 0, sizeof( typeOffset ) );
+	memory_set( typeCount, 0, sizeof( typeCount ) );
+}
+
+
+void ObjectSnapshot::capture( const ObjectContext &context )
+{
+	MemoryAssert( context.buckets != nullptr );
+	clear();
+
+	// Record ranges
+	usize offset = 0;
+	for( u16 type = 1; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		typeOffset[type] = offset;
+		if( !TYPE_VALID( context.category, type ) ) { continue; }
+		offset += static_cast<usize>( context.count( type ) ) * g_snapshotLayout[type].stride;
+	}
+
+	// Grow
+	if( offset > capacity )
+	{
+		capacity = offset + offset / 2;
+		data = reinterpret_cast<byte *>( data == nullptr ? memory_alloc( capacity ) : memory_realloc( data, capacity ) );
+		ErrorIf( data == nullptr, "Failed to allocate memory for ObjectSnapshot (%.2f kb)", KB( capacity ) );
+	}
+	size = offset;
+
+	// Records (buckets in ID order: keys come out sorted)
+	for( u16 bucketID = 0; bucketID < context.current; bucketID++ )
+	{
+		const ObjectContext::ObjectBucket &bucket = context.buckets[bucketID];
+		if( bucket.data == nullptr ) { continue; }
+
+		const u16 type = bucket.type;
+		const u16 typeSize = SysObjects::TYPE_SIZE[type];
+		const SnapshotLayout &layout = g_snapshotLayout[type];
+		const ObjectSnapshotField *const fields = &g_snapshotFields[layout.first];
+		byte *record = data + typeOffset[type] + static_cast<usize>( typeCount[type] ) * layout.stride;
+
+		for( u32 i = bucket.find_alive( bucket.bottom ); i < bucket.top; i = bucket.find_alive( i + 1 ) )
+		{
+			const byte *const object = bucket.data + i * typeSize;
+			const Object &id = reinterpret_cast<const SysObjects::OBJECT_TYPE_DEFAULT_t *>( object )->id;
+			const SnapshotRecord header { static_cast<u32>( bucketID ) << 16 | i, id.generation,
+				static_cast<u8>( id.deactivated ? SNAPSHOT_FLAG_DEACTIVATED : 0 ), 0 };
+			memory_copy( record, &header, sizeof( SnapshotRecord ) );
+
+			byte *bytes = record + sizeof( SnapshotRecord );
+			for( u32 f = 0; f < layout.count; f++ )
+			{
+				memory_copy( bytes, object + fields[f].offset, fields[f].size );
+				bytes += fields[f].size;
+			}
+
+			record += layout.stride;
+			typeCount[type]++;
+		}
+	}
+
+#if COMPILE_DEBUG
+	for( u16 type = 1; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		Assert( !TYPE_VALID( context.category, type ) || typeCount[type] == context.count( type ) );
+	}
+#endif
+}
+
+
+void ObjectSnapshot::delta( Buffer &buffer, const ObjectSnapshot &from, const ObjectSnapshot &to )
+{
+	for( u16 type = 1; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		if( from.typeCount[type] == 0 && to.typeCount[type] == 0 ) { continue; }
+
+		const SnapshotLayout &layout = g_snapshotLayout[type];
+		const ObjectSnapshotField *const fields = &g_snapshotFields[layout.first];
+		const byte *const recordsFrom = from.data + from.typeOffset[type];
+		const byte *const recordsTo = to.data + to.typeOffset[type];
+		const u32 countFrom = from.typeCount[type];
+		const u32 countTo = to.typeCount[type];
+
+		// Header (written before the first record; counts patched once known)
+		usize header = USIZE_MAX;
+		usize changedStart = 0;
+		auto write_header = [&]()
+		{
+			if( header != USIZE_MAX ) { return; }
+			buffer.write<u16>( type );
+			buffer.write<u32>( 0 );
+			header = buffer.tell - sizeof( u32 );
+			buffer.write<u32>( 0 );
+			buffer.write<u32>( 0 );
+			buffer.write<u32>( 0 );
+			changedStart = buffer.tell;
+		};
+
+		// Destroyed & created
+		u32 destroyed = 0;
+		u32 created = 0;
+		snapshot_merge( recordsFrom, countFrom, recordsTo, countTo, layout.stride,
+			[&]( const byte *a, const byte *b )
+			{
+				if( b != nullptr ) { return; }
+				write_header();
+				buffer.write( const_cast<byte *>( a ), layout.stride );
+				destroyed++;
+			} );
+		snapshot_merge( recordsFrom, countFrom, recordsTo, countTo, layout.stride,
+			[&]( const byte *a, const byte *b )
+			{
+				if( a != nullptr ) { return; }
+				write_header();
+				buffer.write( const_cast<byte *>( b ), layout.stride );
+				created++;
+			} );
+
+		// Changed: field bitmask, then the XOR of each changed field
+		u32 changed = 0;
+		changedStart = buffer.tell;
+		snapshot_merge( recordsFrom, countFrom, recordsTo, countTo, layout.stride,
+			[&]( const byte *a, const byte *b )
+			{
+				if( a == nullptr || b == nullptr ) { return; }
+				const SnapshotRecord recordA = snapshot_record( a );
+				const SnapshotRecord recordB = snapshot_record( b );
+
+				byte mask[SNAPSHOT_MASK_BYTES_MAX];
+				memory_set( mask, 0, layout.maskBytes );
+				bool dirty = recordA.flags != recordB.flags;
+				if( dirty ) { mask[0] |= 1; }
+
+				usize offset = sizeof( SnapshotRecord );
+				for( u32 f = 0; f < layout.count; f++ )
+				{
+					if( memory_compare( a + offset, b + offset, fields[f].size ) != 0 )
+					{
+						mask[( f + 1 ) >> 3] |= static_cast<byte>( 1 << ( ( f + 1 ) & 7 ) );
+						dirty = true;
+					}
+					offset += fields[f].size;
+				}
+				if( !dirty ) { return; }
+
+				write_header();
+				buffer.write( const_cast<u32 *>( &recordB.key ), sizeof( u32 ) );
+				buffer.write( const_cast<u16 *>( &recordB.generation ), sizeof( u16 ) );
+				buffer.write( mask, layout.maskBytes );
+
+				offset = sizeof( SnapshotRecord );
+				for( u32 f = 0; f < layout.count; f++ )
+				{
+					if( mask[( f + 1 ) >> 3] & ( 1 << ( ( f + 1 ) & 7 ) ) )
+					{
+						byte chunk[64];
+						for( u32 k = 0; k < fields[f].size; k += sizeof( chunk ) )
+						{
+							const u32 length = fields[f].size - k < sizeof( chunk ) ? fields[f].size - k : sizeof( chunk );
+							for( u32 c = 0; c < length; c++ ) { chunk[c] = a[offset + k + c] ^ b[offset + k + c]; }
+							buffer.write( chunk, length );
+						}
+					}
+					offset += fields[f].size;
+				}
+				changed++;
+			} );
+
+		if( header == USIZE_MAX ) { continue; }
+		buffer.poke<u32>( header, destroyed );
+		buffer.poke<u32>( header + sizeof( u32 ), created );
+		buffer.poke<u32>( header + sizeof( u32 ) * 2, changed );
+		buffer.poke<u32>( header + sizeof( u32 ) * 3, static_cast<u32>( buffer.tell - changedStart ) );
+	}
+
+	buffer.write<u16>( NULL_TYPE );
+}
+
+
+bool ObjectSnapshot::apply( Buffer &buffer, ObjectContext &context, const bool forward )
+{
+	MemoryAssert( context.buckets != nullptr );
+	Assert( !context.deferCommands );
+	snapshot_layout();
+
+	const bool disableEvents = context.disableEvents;
+	context.disableEvents = true;
+
+	// Removals first (a bucket recycled by compact() may change type between snapshots), then placements & changes
+	const usize start = buffer.tell;
+	bool success = true;
+	for( u16 type = buffer.read<u16>(); success && type != NULL_TYPE; type = buffer.read<u16>() )
+	{
+		success = apply_type( buffer, context, type, forward, true );
+	}
+
+	if( success ) { buffer.seek_to( start ); }
+	for( u16 type = success ? buffer.read<u16>() : NULL_TYPE; success && type != NULL_TYPE; type = buffer.read<u16>() )
+	{
+		success = apply_type( buffer, context, type, forward, false );
+	}
+
+	context.disableEvents = disableEvents;
+	return success;
+}
+
+
+bool ObjectSnapshot::apply_type( Buffer &buffer, ObjectContext &context, const u16 type, const bool forward,
+	const bool removals )
+{
+	ErrorReturnIf( type >= OBJECT_TYPE_COUNT || !TYPE_VALID( context.category, type ), false,
+		"ObjectSnapshot: invalid type in delta (%u)", type );
+
+	const SnapshotLayout &layout = g_snapshotLayout[type];
+	const ObjectSnapshotField *const fields = &g_snapshotFields[layout.first];
+	const u32 destroyed = buffer.read<u32>();
+	const u32 created = buffer.read<u32>();
+	const u32 changed = buffer.read<u32>();
+	const u32 changedBytes = buffer.read<u32>();
+	const byte *recordsDestroyed = reinterpret_cast<const byte *>( buffer.read_bytes( destroyed * layout.stride ) );
+	const byte *recordsCreated = reinterpret_cast<const byte *>( buffer.read_bytes( created * layout.stride ) );
+
+	// Forward: destroyed instances are removed & created instances placed (backward: the reverse)
+	const byte *const recordsRemoved = forward ? recordsDestroyed : recordsCreated;
+	const byte *const recordsPlaced = forward ? recordsCreated : recordsDestroyed;
+	const u32 removed = forward ? destroyed : created;
+	const u32 placed = forward ? created : destroyed;
+
+	if( removals )
+	{
+		for( u32 i = 0; i < removed; i++ )
+		{
+			const SnapshotRecord record = snapshot_record( recordsRemoved + static_cast<usize>( i ) * layout.stride );
+			ErrorReturnIf( !context.snapshot_remove( type, record.key >> 16, record.key & 0xFFFF, record.generation ),
+				false, "ObjectSnapshot: failed to remove instance (type: %u, key: %08x)", type, record.key );
+		}
+
+		buffer.read_bytes( changedBytes );
+		return true;
+	}
+
+	// Placed instances (constructed, then the snapshotted fields restored)
+	for( u32 i = 0; i < placed; i++ )
+	{
+		const byte *const bytesRecord = recordsPlaced + static_cast<usize>( i ) * layout.stride;
+		const SnapshotRecord record = snapshot_record( bytesRecord );
+		byte *const object = context.snapshot_place( type, record.key >> 16, record.key & 0xFFFF, record.generation );
+		ErrorReturnIf( object == nullptr, false, "ObjectSnapshot: failed to place instance (type: %u, key: %08x)",
+			type, record.key );
+
+		const byte *bytes = bytesRecord + sizeof( SnapshotRecord );
+		for( u32 f = 0; f < layout.count; f++ )
+		{
+			memory_copy( object + fields[f].offset, bytes, fields[f].size );
+			bytes += fields[f].size;
+		}
+
+		if( record.flags & SNAPSHOT_FLAG_DEACTIVATED )
+		{
+			Object &id = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( object )->id;
+			id.deactivated = true;
+			bits_clear( context.buckets[id.bucketID].maskActive, id.index );
+		}
+	}
+
+	// Changed instances (XOR: identical in both directions)
+	for( u32 i = 0; i < changed; i++ )
+	{
+		u32 key;
+		u16 generation;
+		memory_copy( &key, buffer.read_bytes( sizeof( u32 ) ), sizeof( u32 ) );
+		memory_copy( &generation, buffer.read_bytes( sizeof( u16 ) ), sizeof( u16 ) );
+		const byte *const mask = reinterpret_cast<const byte *>( buffer.read_bytes( layout.maskBytes ) );
+
+		const u16 bucketID = static_cast<u16>( key >> 16 );
+		const u16 index = static_cast<u16>( key & 0xFFFF );
+		const ObjectContext::ObjectBucket *const bucket = bucketID < context.current ? &context.buckets[bucketID] : nullptr;
+		const bool valid = bucket != nullptr && bucket->data != nullptr && bucket->type == type &&
+			index < SysObjects::TYPE_BUCKET_CAPACITY[type];
+		byte *const object = valid ? bucket->get_object_pointer( index, generation ) : nullptr;
+		ErrorReturnIf( object == nullptr, false, "ObjectSnapshot: missing changed instance (type: %u, key: %08x)",
+			type, key );
+
+		for( u32 f = 0; f < layout.count; f++ )
+		{
+			if( !( mask[( f + 1 ) >> 3] & ( 1 << ( ( f + 1 ) & 7 ) ) ) ) { continue; }
+			const byte *const bytes = reinterpret_cast<const byte *>( buffer.read_bytes( fields[f].size ) );
+			byte *const field = object + fields[f].offset;
+			for( u32 k = 0; k < fields[f].size; k++ ) { field[k] ^= bytes[k]; }
+		}
+
+		if( mask[0] & 1 )
+		{
+			Object &id = reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( object )->id;
+			id.deactivated = !id.deactivated;
+			if( id.deactivated ) { bits_clear( bucket->maskActive, index ); }
+			else { bits_set( bucket->maskActive, index ); }
+		}
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if OBJECT_PROFILER
+#include <core/string.hpp>
+#include <manta/console.hpp>
+
+#include <vendor/stdio.hpp>
+
+static ObjectProfilerEntry g_profiler[OBJECT_TYPE_COUNT][OBJECT_EVENT_COUNT];
+static u32 g_profilerHistory = 0; // next history slot
+
+
+ObjectProfilerScope::ObjectProfilerScope( const u16 type, const u16 event ) :
+	start { Time::value() }, instances { 0 }, type { type }, event { event } { }
+
+
+ObjectProfilerScope::~ObjectProfilerScope()
+{
+	ObjectProfiler::record( type, event, instances, ( Time::value() - start ) * 1000000.0 );
+}
+
+
+// Entries with at least one call, slowest (total time) first
+static u32 profiler_sorted( u32 *entries, const u32 capacity )
+{
+	u32 count = 0;
+	for( u32 i = 0; i < OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT && count < capacity; i++ )
+	{
+		const ObjectProfilerEntry &entry = g_profiler[i / OBJECT_EVENT_COUNT][i % OBJECT_EVENT_COUNT];
+		if( entry.calls == 0 ) { continue; }
+
+		u32 j = count++;
+		for( ; j > 0; j-- )
+		{
+			const ObjectProfilerEntry &other = g_profiler[entries[j - 1] / OBJECT_EVENT_COUNT][entries[j - 1] % OBJECT_EVENT_COUNT];
+			if( other.timeTotal >= entry.timeTotal ) { break; }
+			entries[j] = entries[j - 1];
+		}
+		entries[j] = i;
+	}
+	return count;
+}
+
+
+static double profiler_history_average( const ObjectProfilerEntry &entry )
+{
+	double total = 0.0;
+	for( u32 i = 0; i < OBJECT_PROFILER_HISTORY; i++ ) { total += entry.history[i]; }
+	return total / OBJECT_PROFILER_HISTORY;
+}
+
+
+bool ObjectProfiler::init()
+{
+	reset();
+
+	Console::command_register( "objects_profiler", "Lists per-type object event timings", CONSOLE_COMMAND_LAMBDA
+		{ ObjectProfiler::print(); } );
+	Console::command_register( "objects_profiler_reset", "Resets object event timings", CONSOLE_COMMAND_LAMBDA
+		{ ObjectProfiler::reset(); } );
+	Console::command_register( "objects_profiler_dump <path>", "Writes object event timings to a file (csv)",
+		CONSOLE_COMMAND_LAMBDA
+		{
+			const char *path = Console::get_parameter_string( 0, "objects_profiler.csv" );
+			if( ObjectProfiler::dump( path ) ) { Console::Log( path, c_white ); }
+		} );
+
+	return true;
+}
+
+
+void ObjectProfiler::frame()
+{
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		for( u16 event = 0; event < OBJECT_EVENT_COUNT; event++ )
+		{
+			ObjectProfilerEntry &entry = g_profiler[type][event];
+			entry.history[g_profilerHistory] = static_cast<float>( entry.frameTime );
+			entry.frameCalls = 0;
+			entry.frameInstances = 0;
+			entry.frameTime = 0.0;
+		}
+	}
+
+	g_profilerHistory = ( g_profilerHistory + 1 ) % OBJECT_PROFILER_HISTORY;
+}
+
+
+void ObjectProfiler::reset()
+{
+	memory_set( g_profiler, 0, sizeof( g_profiler ) );
+	g_profilerHistory = 0;
+}
+
+
+void ObjectProfiler::record( const u16 type, const u16 event, const u32 instances, const double microseconds )
+{
+	Assert( type < OBJECT_TYPE_COUNT && event < OBJECT_EVENT_COUNT );
+	ObjectProfilerEntry &entry = g_profiler[type][event];
+
+	entry.frameCalls++;
+	entry.frameInstances += instances;
+	entry.frameTime += microseconds;
+
+	entry.calls++;
+	entry.instances += instances;
+	entry.timeTotal += microseconds;
+	if( microseconds > entry.timeMax ) { entry.timeMax = microseconds; }
+}
+
+
+const ObjectProfilerEntry &ObjectProfiler::entry( const u16 type, const u16 event )
+{
+	Assert( type < OBJECT_TYPE_COUNT && event < OBJECT_EVENT_COUNT );
+	return g_profiler[type][event];
+}
+
+
+u32 ObjectProfiler::history_index()
+{
+	return g_profilerHistory;
+}
+
+
+void ObjectProfiler::print()
+{
+	u32 entries[OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT];
+	const u32 count = profiler_sorted( entries, OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT );
+	char buffer[256];
+
+	// Console log is drawn newest-first: rows, then the header
+	for( u32 i = count; i > 0; i-- )
+	{
+		const u16 type = static_cast<u16>( entries[i - 1] / OBJECT_EVENT_COUNT );
+		const u16 event = static_cast<u16>( entries[i - 1] % OBJECT_EVENT_COUNT );
+		const ObjectProfilerEntry &entry = g_profiler[type][event];
+
+		snprintf( buffer, sizeof( buffer ), "  %-24s %-20s %9llu %11llu %11.3f %9.2f %9.2f %9.2f",
+			SysObjects::TYPE_NAME[type], SysObjects::EVENT_NAME[event], entry.calls, entry.instances,
+			entry.timeTotal / 1000.0, entry.timeTotal / entry.calls, entry.timeMax, profiler_history_average( entry ) );
+		Console::Log( buffer, c_white );
+	}
+
+	snprintf( buffer, sizeof( buffer ), "  %-24s %-20s %9s %11s %11s %9s %9s %9s",
+		"type", "event", "calls", "instances", "total ms", "avg us", "max us", "frame us" );
+	Console::Log( buffer, c_gray );
+	Console::Log( "Object Profiler:", c_yellow );
+}
+
+
+bool ObjectProfiler::dump( const char *path )
+{
+	String output;
+	output.append( "type,event,calls,instances,total_us,avg_us,max_us" );
+	for( u32 i = 0; i < OBJECT_PROFILER_HISTORY; i++ ) { output.append( ",frame_" ).append( i ); }
+	output.append( "\n" );
+
+	u32 entries[OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT];
+	const u32 count = profiler_sorted( entries, OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT );
+	char buffer[256];
+
+	for( u32 i = 0; i < count; i++ )
+	{
+		const u16 type = static_cast<u16>( entries[i] / OBJECT_EVENT_COUNT );
+		const u16 event = static_cast<u16>( entries[i] % OBJECT_EVENT_COUNT );
+		const ObjectProfilerEntry &entry = g_profiler[type][event];
+
+		snprintf( buffer, sizeof( buffer ), "%s,%s,%llu,%llu,%.3f,%.3f,%.3f", SysObjects::TYPE_NAME[type],
+			SysObjects::EVENT_NAME[event], entry.calls, entry.instances, entry.timeTotal,
+			entry.timeTotal / entry.calls, entry.timeMax );
+		output.append( buffer );
+
+		// History (oldest first)
+		for( u32 j = 0; j < OBJECT_PROFILER_HISTORY; j++ )
+		{
+			snprintf( buffer, sizeof( buffer ), ",%.3f",
+				entry.history[( g_profilerHistory + j ) % OBJECT_PROFILER_HISTORY] );
+			output.append( buffer );
+		}
+		output.append( "\n" );
+	}
+
+	ErrorReturnIf( !output.save( path ), false, "ObjectProfiler: failed to write '%s'", path );
+	return true;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if COMPILE_DEBUG
+#include <core/string.hpp>
+#include <manta/draw.hpp>
+#include <manta/input.hpp>
+
+
+const Color colors[] =
+{
+	c_white,
+	c_red,
+	c_aqua,
+	c_yellow,
+	c_green,
+	c_orange,
+};
+
+
+void ObjectContext::ObjectBucket::draw( String &label, float x, float y )
 {
 	const u16 bCapacity = SysObjects::TYPE_BUCKET_CAPACITY[type];
 	const bool isCache = ( context.bucketCache[TYPE_BUCKET( context.category, type )] == bucketID );
@@ -915,12 +2913,13 @@ void ObjectContext::ObjectBucket::draw( String &label, float x, float y )
 		allocatedMemoryKb = KB( bCapacity * SysObjects::TYPE_SIZE[type] );
 
 		snprintf( info, sizeof( info ),
-			"bucket id: %d\n\ntype: %s (id: %d)\n\ninheritance depth: %d\n\ncapacity: %d\n\nmemory: %.2f kb (%d bytes/obj)",
+			"bucket id: %d\n\ntype: %s (id: %d)\n\ninheritance depth: %d\n\ncapacity: %d (alive: %u)\n\nmemory: %.2f kb (%d bytes/obj)",
 			bucketID,
 			SysObjects::TYPE_NAME[type],
 			type,
 			SysObjects::TYPE_INHERITANCE_DEPTH[type],
 			bCapacity,
+			count_alive(),
 			allocatedMemoryKb,
 			SysObjects::TYPE_SIZE[type] );
 
@@ -935,8 +2934,8 @@ void ObjectContext::ObjectBucket::draw( String &label, float x, float y )
 		{
 			byte *objectPtr = data + index * SysObjects::TYPE_SIZE[type];
 			SysObjects::OBJECT_TYPE_DEFAULT_t &object = *reinterpret_cast<SysObjects::OBJECT_TYPE_DEFAULT_t *>( objectPtr );
-			const bool alive = object.id.alive;
-			const bool active = object.id.deactivated;
+			const bool alive = bits_test( maskAlive, index );
+			const bool active = !bits_test( maskActive, index );
 
 			const u16 ix = index % bWidth;
 			const u16 iy = index / bWidth;
@@ -1055,6 +3054,54 @@ void ObjectContext::draw( const Delta delta, const float x, const float y )
 		draw_text( fnt_iosevka, size, mx + 8, my + 8, c_white, label.cstr() );
 	}
 }
+
+
+#if OBJECT_PROFILER
+void ObjectProfiler::draw( const float x, const float y )
+{
+	constexpr u32 ROWS = 16;
+	constexpr float ROW_HEIGHT = 20.0f;
+	constexpr float GRAPH_WIDTH = 240.0f;
+
+	u32 entries[OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT];
+	const u32 count = profiler_sorted( entries, OBJECT_TYPE_COUNT * OBJECT_EVENT_COUNT );
+	const u32 rows = count < ROWS ? count : ROWS;
+
+	// Background
+	draw_rectangle( x, y, x + 720.0f + GRAPH_WIDTH, y + ( rows + 1 ) * ROW_HEIGHT + 8.0f,
+		color_mix( c_black, c_dkgray, 0.25f ), false );
+	draw_text_f( fnt_iosevka, 14, x + 4.0f, y + 4.0f, c_yellow, "%-24s %-20s %9s %9s %9s %9s",
+		"type", "event", "instances", "avg us", "max us", "frame us" );
+
+	for( u32 i = 0; i < rows; i++ )
+	{
+		const u16 type = static_cast<u16>( entries[i] / OBJECT_EVENT_COUNT );
+		const u16 event = static_cast<u16>( entries[i] % OBJECT_EVENT_COUNT );
+		const ObjectProfilerEntry &entry = g_profiler[type][event];
+		const float rowY = y + ( i + 1 ) * ROW_HEIGHT + 4.0f;
+
+		// Text
+		draw_text_f( fnt_iosevka, 14, x + 4.0f, rowY, c_white, "%-24s %-20s %9u %9.2f %9.2f %9.2f",
+			SysObjects::TYPE_NAME[type], SysObjects::EVENT_NAME[event], entry.frameInstances,
+			entry.timeTotal / entry.calls, entry.timeMax, profiler_history_average( entry ) );
+
+		// History graph (oldest to newest, scaled to the slowest frame)
+		float peak = 0.0f;
+		for( u32 j = 0; j < OBJECT_PROFILER_HISTORY; j++ ) { peak = entry.history[j] > peak ? entry.history[j] : peak; }
+		if( peak <= 0.0f ) { continue; }
+
+		const float graphX = x + 720.0f;
+		const float barWidth = GRAPH_WIDTH / OBJECT_PROFILER_HISTORY;
+		for( u32 j = 0; j < OBJECT_PROFILER_HISTORY; j++ )
+		{
+			const float value = entry.history[( g_profilerHistory + j ) % OBJECT_PROFILER_HISTORY] / peak;
+			const float barX = graphX + j * barWidth;
+			draw_rectangle( barX, rowY + ( ROW_HEIGHT - 4.0f ) * ( 1.0f - value ), barX + barWidth, rowY + ROW_HEIGHT - 4.0f,
+				color_mix( c_green, c_red, value ), false );
+		}
+	}
+}
+#endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
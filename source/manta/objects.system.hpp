@@ -1,10 +1,12 @@
 #pragma once
 
 #include <vendor/vendor.hpp>
+#include <vendor/stddef.hpp>
 
 #include <core/types.hpp>
 #include <core/debug.hpp>
 #include <core/buffer.hpp>
+#include <core/atomics.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -15,6 +17,22 @@ template <int N> struct ObjectHandle;
 class Serializer; // <core/serializer.hpp>
 class Deserializer; // <core/serializer.hpp>
 
+// SPATIAL object bounds (see ObjectContext::query_radius() & ObjectContext::query_aabb())
+struct ObjectSpatialBounds
+{
+	float x;
+	float y;
+	float radius;
+};
+
+// ObjectSnapshot field record (see SysObjects::TYPE_SNAPSHOT_FIELDS, emitted as offsetof() tables by the build tool)
+struct ObjectSnapshotField
+{
+	u16 offset;   // byte offset within the instance
+	u16 size;     // byte size
+	bool trivial; // trivially copyable (snapshotted as raw bytes)
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Loop over all active instances of a specified object type
@@ -49,15 +67,26 @@ namespace SysObjects
 	extern const u16 CATEGORY_TYPE_BUCKET[OBJECT_CATEGORY_COUNT][OBJECT_TYPE_COUNT];
 	extern const u16 CATEGORY_TYPES[OBJECT_CATEGORY_COUNT][OBJECT_TYPE_COUNT];
 	extern const u16 CATEGORY_TYPE_COUNT[OBJECT_CATEGORY_COUNT];
-	DEBUG( extern const char *CATEGORY_NAME[OBJECT_CATEGORY_COUNT]; )
+#if COMPILE_DEBUG || OBJECT_PROFILER
+	extern const char *CATEGORY_NAME[OBJECT_CATEGORY_COUNT];
+#endif
 
 	extern const u16 TYPE_SIZE[OBJECT_TYPE_COUNT];
-	DEBUG( extern const char *TYPE_NAME[OBJECT_TYPE_COUNT]; )
+#if COMPILE_DEBUG || OBJECT_PROFILER
+	extern const char *TYPE_NAME[OBJECT_TYPE_COUNT];
+#endif
 	extern const u16 TYPE_BUCKET_CAPACITY[OBJECT_TYPE_COUNT];
 	extern const u32 TYPE_MAX_COUNT[OBJECT_TYPE_COUNT];
 	extern const u16 TYPE_INHERITANCE_DEPTH[OBJECT_TYPE_COUNT];
 	extern const u32 TYPE_HASH[OBJECT_TYPE_COUNT];
 	extern const bool TYPE_SERIALIZED[OBJECT_TYPE_COUNT];
+	extern void ( *const TYPE_SPATIAL[OBJECT_TYPE_COUNT] )( const void *object, ObjectSpatialBounds &bounds );
+	extern const float TYPE_SPATIAL_CELL_SIZE[OBJECT_TYPE_COUNT];
+	extern const u16 TYPE_UPDATE_RATE[OBJECT_TYPE_COUNT];
+	extern u32 ( *const TYPE_SNAPSHOT_FIELDS[OBJECT_TYPE_COUNT] )( ObjectSnapshotField *fields ); // inherited first
+#if OBJECT_PROFILER
+	extern const char *EVENT_NAME[OBJECT_EVENT_COUNT];
+#endif
 
 	template <int N, typename... Args> struct TYPE_CONSTRUCT_VARIADIC;
 	// constexpr void ( *TYPE_CONSTRUCT[] )( void * ) = { ... } // IMP: objects.generated.hpp
@@ -68,6 +97,10 @@ namespace SysObjects
 	extern bool init();
 	extern bool free();
 
+	extern bool parallel_init(); // impl: objects.cpp
+	extern bool parallel_free(); // impl: objects.cpp
+	extern thread_local bool parallelEvent; // This thread is running PARALLEL events (impl: objects.cpp)
+
 	extern void write( Buffer &buffer, const ObjectContext &context );
 	extern void read( Buffer &buffer, ObjectContext &context );
 	extern void serialize( Serializer &serializer, const ObjectContext &context );
@@ -166,6 +199,7 @@ class ObjectContext
 _PRIVATE:
 	friend Object;
 	friend Object::Serialization;
+	friend class ObjectSnapshot;
 
 _PUBLIC:
 	ObjectContext() : category { 0 } { };
@@ -184,14 +218,24 @@ _PUBLIC:
 	{
 		static_assert( N < OBJECT_TYPE_COUNT, "Invalid object type!" );
 
+		// Inside a PARALLEL event (of any context): construct into the deferred buffer (returns a null Object)
+		if( UNLIKELY( SysObjects::parallelEvent ) )
+		{
+			void *const object = deferred_create_begin( N );
+			if( UNLIKELY( object == nullptr ) ) { return Object { }; }
+			SysObjects::TYPE_CONSTRUCT_VARIADIC<N, Args...>::CONSTRUCT( object, args... );
+			return deferred_create_end();
+		}
+
 		// Find Available Bucket
 		ObjectBucket *bucket = new_object( N );
 		if( UNLIKELY( bucket == nullptr ) ) { return Object { }; }
 
-		// Create Object
+		// Create Object (the constructor resets 'id': read the slot's generation first)
 		void *const object = bucket->data + ( bucket->current * SysObjects::TYPE_SIZE[N] );
+		const u16 generation = bucket->slot_generation( bucket->current );
 		SysObjects::TYPE_CONSTRUCT_VARIADIC<N, Args...>::CONSTRUCT( object, args... );
-		return bucket->new_object( object );
+		return bucket->new_object( object, generation );
 	}
 
 	bool destroy( Object &object );
@@ -205,6 +249,40 @@ _PUBLIC:
 	u32 count( const u16 type ) const;
 	u32 count_all() const;
 
+	struct CompactStatistics
+	{
+		u32 moved = 0;          // instances moved by the last compact()
+		u32 retired = 0;        // buckets emptied & unlinked by the last compact()
+		u32 recycled = 0;       // retired buckets made reusable by the last compact()
+		u32 movedTotal = 0;     // cumulative instances moved since init()
+		double compactMs = 0.0; // duration of the last compact()
+	};
+
+	struct MemoryStatistics
+	{
+		u32 buckets = 0;         // buckets linked into the iteration chains
+		u32 bucketsResident = 0; // buckets with allocated data
+		u32 bucketsRetired = 0;  // buckets unlinked by compact() (relocation records live, or awaiting reuse)
+		u32 slotsSpanned = 0;    // sum of bucket (top - bottom): the slot range a full iteration scans
+		usize residentBytes = 0; // bucket data, bitmasks, SPATIAL & relocation records
+		u32 spatialCells = 0;    // SPATIAL cells of every type (occupied & empty, see spatial_update())
+	};
+
+	// Incremental compaction (call outside of events, e.g. once per frame after a population spike): moves up to
+	// 'budget' instances out of the sparsest overflow bucket of each type, then unlinks & frees emptied buckets.
+	// Handles to moved instances keep resolving for OBJECT_COMPACT_RELOCATION_PASSES passes (see relocate())
+	//
+	// Instances are moved with a raw memory_copy (no constructor, destructor, or event): raw pointers to instances
+	// (ObjectHandle, get_object_pointer()) held across a compact() call dangle, and instances must not point into
+	// themselves. Keep Object handles across frames and re-resolve them afterwards
+	void compact( const u32 budget = 1024 );
+
+	// Rewrites a handle to an instance moved by compact() to its current location (returns true if it moved)
+	bool relocate( Object &object ) const;
+
+	const CompactStatistics &compact_statistics() const { return compactStats; }
+	MemoryStatistics memory_statistics() const;
+
 	// impl: objects.generated.cpp
 	void event_create();
 	void event_destroy();
@@ -233,11 +311,62 @@ _PUBLIC:
 	static void serialize( Buffer &buffer, const ObjectContext &context );
 	static void deserialize( Buffer &buffer, ObjectContext &context );
 
+	// Incremental rebuild of the SPATIAL index (called by event_update(); call manually after moving objects elsewhere)
+	void spatial_update();
+	void spatial_update( const u16 type ); // Single SPATIAL type (also called after each PARALLEL dispatch)
+
 #if COMPILE_DEBUG
 	void draw( const Delta delta, const float x, const float y );
 #endif
 
 _PRIVATE:
+	struct SpatialSlot
+	{
+		u32 cell; // SpatialIndex cell (U32_MAX if not indexed)
+		u32 item; // index within cell
+	};
+
+	struct SpatialItem
+	{
+		float x;
+		float y;
+		float radius;
+		u16 bucketID;
+		u16 index;
+	};
+
+	struct SpatialCell
+	{
+		i32 cx;
+		i32 cy;
+		SpatialItem *items;
+		u32 count;
+		u32 capacity;
+	};
+
+	struct SpatialIndex
+	{
+		SpatialCell *cells = nullptr; // cells (dense; empty cells are pruned by spatial_update())
+		u32 cellsCount = 0;
+		u32 cellsCapacity = 0;
+		u32 cellsEmpty = 0;           // cells with no items
+		u32 *table = nullptr;         // hash table: cell + 1 (0 = empty)
+		u32 tableCapacity = 0;
+		float cellSize = 0.0f;
+		float cellSizeInv = 0.0f;
+		float radiusMax = 0.0f;       // largest radius at the last spatial_update()
+
+		void free();
+		u32 find( const i32 cx, const i32 cy ) const;
+		u32 find_or_add( const i32 cx, const i32 cy );
+	};
+
+	struct Relocation
+	{
+		Object object;  // new location
+		u16 generation; // generation at the old location (0: not moved)
+	};
+
 	struct ObjectBucket
 	{
 		ObjectBucket() = delete;
@@ -251,15 +380,31 @@ _PRIVATE:
 		u16 type = 0;           // object type
 		u16 bottom = 0;         // lowest 'alive' index
 		u16 top = 0;            // highest 'alive' index
+		u64 *maskAlive = nullptr;  // occupancy bitmask: 1 bit per slot, set when 'alive' (allocated after data)
+		u64 *maskActive = nullptr; // occupancy bitmask: 1 bit per slot, set when 'alive' and not 'deactivated'
+		SpatialSlot *spatial = nullptr; // SPATIAL index record per slot (allocated after the bitmasks)
+		Relocation *relocation = nullptr; // compact() record per slot (draining or retired buckets only)
+		u16 retiredPass = 0;              // compact() pass that retired this bucket
+		u16 generationBase = 0;           // slot generations start here (raised when compact() retires this bucket ID)
 
 		void *new_object_pointer();
-		Object new_object( void *ptr );
+		Object new_object( void *ptr, const u16 generation ); // 'generation': the slot's previous generation
+		Object place_object( void *ptr, const u16 generation );
+		u16 slot_generation( const u16 index ) const;
+		void update_added( const u16 lowest, const u16 highest, const u32 added );
 
 		bool delete_object( const u16 index, const u16 generation );
+		bool release_object( const u16 index, const u16 generation );
+		void update_removed( const u16 lowest, const u32 removed );
 
 		byte *get_object_pointer( const u16 index, const u16 generation ) const;
 		const Object &get_object_id( const u16 index ) const;
 
+		u32 find_alive( const u32 start ) const;  // first 'alive' index >= start (top if none)
+		u32 find_active( const u32 start ) const; // first 'active' index >= start (top if none)
+		u32 find_free( const u32 start ) const;   // first free index >= start (capacity if none)
+		u32 count_alive() const;
+
 		bool init( const u16 type );
 		void free();
 		void clear();
@@ -304,8 +449,46 @@ _PRIVATE:
 		static bool find_object_ptr( ObjectIterator &itr, const ObjectBucket *const bucket, const u16 start );
 	};
 
+	struct ObjectIteratorSpatial
+	{
+		ObjectIteratorSpatial( const ObjectContext &context, u16 type, float x1, float y1, float x2, float y2,
+			float radius, bool circle );
+
+		void find_object( u32 cell, u32 item );
+		void find_first();
+		void find_next();
+
+		const ObjectContext &context; // parent ObjectContext
+		const SpatialIndex *index;    // SPATIAL index of the queried type
+		byte *ptr;                    // pointer to current object instance data
+		float x1, y1, x2, y2;         // query bounds
+		float qx, qy, qr;             // query circle
+		i32 cx1, cy1, cx2, cy2;       // query cell range
+		u32 cell;                     // current SpatialCell
+		u32 item;                     // current SpatialItem within cell
+		u16 type : 14;                // object type to query
+		u16 circle : 1;               // circle (query_radius) or rectangle (query_aabb)
+		u16 dense : 1;                // walk every cell rather than the query cell range
+	};
+
+	void spatial_insert( SpatialIndex &index, ObjectBucket &bucket, const u16 slot, const ObjectSpatialBounds &bounds,
+		const i32 cx, const i32 cy );
+	void spatial_remove( SpatialIndex &index, ObjectBucket &bucket, const u16 slot );
+	void spatial_prune( SpatialIndex &index );
+
+	void compact_retire( const u16 bucketID );
+
+	byte *snapshot_place( const u16 type, const u16 bucketID, const u16 index, const u16 generation );
+	bool snapshot_remove( const u16 type, const u16 bucketID, const u16 index, const u16 generation );
+
 	bool grow();
 
+	void parallel_dispatch( const u16 type, void ( *function )( void *, void * ), void *userdata );
+	void *deferred_create_begin( const u16 type );
+	Object deferred_create_end();
+	bool deferred_destroy( const Object &object );
+	void deferred_flush();
+
 	u16 new_bucket( const u16 type );
 	ObjectBucket *new_object( const u16 type );
 	Object create_object( const u16 type );
@@ -352,17 +535,157 @@ _PUBLIC:
 		return ObjectHandle<N>{ get_object_pointer( object ) };
 	}
 
+	template <int N> struct IteratorSpatial
+	{
+		IteratorSpatial() = delete;
+		IteratorSpatial( const ObjectIteratorSpatial &itr ) : itr{ itr } { }
+		IteratorSpatial<N> begin() { return *this; }
+		IteratorSpatial<N> end() { IteratorSpatial<N> end { itr }; end.itr.ptr = nullptr; return end; }
+		bool operator!=( const IteratorSpatial<N> &other ) const { return itr.ptr != other.itr.ptr; }
+		IteratorSpatial<N> &operator++() { itr.find_next(); return *this; }
+		ObjectHandle<N> operator*() const { return ObjectHandle<N>{ itr.ptr }; }
+		ObjectIteratorSpatial itr;
+	};
+
+	// Active SPATIAL instances of type N whose bounds overlap the circle (positions as of the last spatial_update())
+	template <int N> IteratorSpatial<N> query_radius( const float x, const float y, const float radius ) const
+	{
+		Assert( buckets != nullptr );
+		Assert( SysObjects::TYPE_SPATIAL[N] != nullptr );
+		return IteratorSpatial<N>{ { *this, N, x - radius, y - radius, x + radius, y + radius, radius, true } };
+	}
+
+	// Active SPATIAL instances of type N whose bounds overlap the rectangle (positions as of the last spatial_update())
+	template <int N> IteratorSpatial<N> query_aabb( const float x1, const float y1, const float x2, const float y2 ) const
+	{
+		Assert( buckets != nullptr );
+		Assert( SysObjects::TYPE_SPATIAL[N] != nullptr );
+		return IteratorSpatial<N>{ { *this, N, x1, y1, x2, y2, 0.0f, false } };
+	}
+
+	// Deferred create() & destroy() buffer. Commands may be recorded from any thread and are applied by flush():
+	// destroys grouped by bucket, then creates grouped by type, so bucket bookkeeping (current/bottom/top,
+	// bucketCache, objectCount) runs once per bucket rather than once per object. Objects are constructed in staging
+	// memory and moved into their bucket with a raw memory_copy (see compact())
+	class Commands
+	{
+	_PRIVATE:
+		friend ObjectContext;
+
+	_PUBLIC:
+		struct Statistics
+		{
+			u32 creates = 0;           // objects created by the last flush
+			u32 destroys = 0;          // objects destroyed by the last flush
+			u32 buckets = 0;           // bucket bookkeeping passes performed by the last flush
+			u32 bookkeepingSaved = 0;  // bucket bookkeeping passes avoided by the last flush
+			double flushMs = 0.0;      // duration of the last flush
+		};
+
+		void init();
+		void free();
+		void clear();
+
+		template <int N, typename... Args> void create( Args... args )
+		{
+			static_assert( N < OBJECT_TYPE_COUNT, "Invalid object type!" );
+			void *const object = create_begin( N );
+			if( UNLIKELY( object == nullptr ) ) { return; }
+			SysObjects::TYPE_CONSTRUCT_VARIADIC<N, Args...>::CONSTRUCT( object, args... );
+		}
+
+		void create( const u16 type );
+		void destroy( const Object &object );
+		void flush( ObjectContext &context );
+
+		u32 count() const { return createsCount + destroysCount; }
+		const Statistics &statistics() const { return stats; }
+
+	_PRIVATE:
+		struct CreateCommand
+		{
+			byte *object; // constructed object (staging page)
+			u16 type;
+		};
+
+		static constexpr usize STAGING_PAGE_SIZE = 64 * 1024; // >= any TYPE_SIZE
+
+		void *create_begin( const u16 type ); // zeroed staging slot, constructed in place after the lock is released
+		bool reserve_scratch( const u32 count );
+
+		SpinLock lock;
+		Object *destroys = nullptr;
+		u32 destroysCount = 0;
+		u32 destroysCapacity = 0;
+		CreateCommand *creates = nullptr;
+		u32 createsCount = 0;
+		u32 createsCapacity = 0;
+		byte **staging = nullptr; // pages never move, so objects stay put while other threads record
+		u32 stagingPages = 0;     // pages in use
+		u32 stagingCount = 0;     // pages allocated
+		u32 stagingCapacity = 0;
+		usize stagingSize = 0;    // bytes used in the last page in use
+		u32 *scratch = nullptr; // radix sort keys/values (4 x scratchCapacity)
+		u32 scratchCapacity = 0;
+		Statistics stats;
+	};
+
+	// Calls function( ObjectHandle<N> ) for every active instance of type N, split into chunks across the
+	// object worker pool. create() & destroy() calls made during the dispatch are deferred until it completes
+	template <int N, typename F> void parallel_foreach( F function )
+	{
+		static_assert( N < OBJECT_TYPE_COUNT, "Invalid object type!" );
+		parallel_dispatch( N, []( void *object, void *userdata )
+			{ ( *reinterpret_cast<F *>( userdata ) )( ObjectHandle<N>{ object } ); }, &function );
+	}
+
+	// UPDATE_RATE: advance the stagger frame & accumulated update time (called by event_update())
+	void update_rate_advance( const Delta delta )
+	{
+		updateFrame++;
+		updateTime += delta;
+		updateDelta = delta;
+	}
+
+	// UPDATE_RATE: true if the instance is due this frame (staggered by slot); outputs the delta since its last update
+	template <int N> bool update_rate_due( ObjectHandle<N> handle, Delta &outDelta )
+	{
+		const u32 rate = handle->updateRate > 0 ? handle->updateRate : SysObjects::TYPE_UPDATE_RATE[N];
+		if( rate > 1 && ( handle->id.index + handle->id.bucketID + updateFrame ) % rate != 0 ) { return false; }
+		outDelta = handle->updateStamp < 0.0 ? updateDelta : updateTime - handle->updateStamp;
+		handle->updateStamp = updateTime;
+		return true;
+	}
+
+	// UPDATE_RATE: calls function( ObjectHandle<N>, Delta ) for every active instance of type N due this frame
+	template <int N, typename F> void foreach_update_rate( F function )
+	{
+		static_assert( N < OBJECT_TYPE_COUNT, "Invalid object type!" );
+		Delta delta;
+		for( ObjectHandle<N> h : iterator_active<N>( false ) ) { if( update_rate_due<N>( h, delta ) ) { function( h, delta ); } }
+	}
+
 _PRIVATE:
 	ObjectBucket *buckets = nullptr; // ObjectBucket array (dynamic)
 	u16 *bucketCache = nullptr;      // Most recent buckets touched by object create/destroy
 	u32 *objectCount = nullptr;      // Instance count for each object type
+	SpatialIndex *spatial = nullptr; // SPATIAL index for each object type
+	Delta updateTime = 0.0;          // UPDATE_RATE: accumulated event_update() time
+	Delta updateDelta = 0.0;         // UPDATE_RATE: delta of the latest event_update()
+	u32 updateFrame = 0;             // UPDATE_RATE: event_update() frame counter (stagger phase)
 	u16 capacity = 0;                // Number of allocated ObjectBucket slots
 	u16 current = 0;                 // Current ObjectBucket insertion index
 	u16 disableEvents : 1;
-	u16 __unused : 15;
+	u16 deferCommands : 1;           // Defer create() & destroy() (set during PARALLEL dispatch)
+	u16 __unused : 14;
 	const u16 category;
+	u16 bucketsFree = 0;             // Recycled bucket list (linked through bucketIDNext)
+	u16 bucketsRetired = 0;          // Retired bucket FIFO, oldest first (linked through bucketIDNext)
+	u16 bucketsRetiredTail = 0;
+	u16 compactPass = 0;
+	CompactStatistics compactStats;
 };
-static_assert( sizeof( ObjectContext ) == 32, "ObjectContext size changed!" );
+static_assert( sizeof( ObjectContext ) == 96, "ObjectContext size changed!" );
 
 
 namespace SysObjects
@@ -396,9 +719,115 @@ namespace SysObjects
 		static void deserialize( Buffer &buffer, ObjectContextDeserializerB &d )
 		{
 			const u32 count = buffer.read<u32>();
-			foreach_object_all( d.context, N, h ) { ObjectHandle<N>::deserialize( buffer, h ); }
+			foreach_object_all( d.context, N, h )
+			{
+				ObjectHandle<N>::deserialize( buffer, h );
+				d.context.activate( h->id, !h->id.deactivated ); // Sync 'deactivated' with bucket activity mask
+			}
 		}
 	};
 };
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// OBJECT_PROFILER: generated event functions time every per-type loop (see OBJECT_PROFILE_SCOPE) and count the
+// instances whose event actually ran (OBJECT_PROFILE_INSTANCE: deactivated & UPDATE_RATE-skipped instances are not
+// counted). Results accumulate into a global type x event table; ObjectProfiler::frame() closes the current frame into
+// the rolling history
+
+#if OBJECT_PROFILER
+struct ObjectProfilerEntry
+{
+	u32 frameCalls;                               // dispatches (current frame)
+	u32 frameInstances;                           // instances run (current frame)
+	double frameTime;                             // microseconds (current frame)
+
+	u64 calls;                                    // dispatches (since reset)
+	u64 instances;                                // instances run (since reset)
+	double timeTotal;                             // microseconds (since reset)
+	double timeMax;                               // slowest single dispatch in microseconds (since reset)
+
+	float history[OBJECT_PROFILER_HISTORY];       // microseconds per frame (ring, see ObjectProfiler::history_index())
+};
+
+
+namespace ObjectProfiler
+{
+	extern bool init();
+	extern void frame();
+	extern void reset();
+
+	extern void record( const u16 type, const u16 event, const u32 instances, const double microseconds );
+	extern const ObjectProfilerEntry &entry( const u16 type, const u16 event );
+	extern u32 history_index();
+
+	extern void print();
+	extern bool dump( const char *path );
+#if COMPILE_DEBUG
+	extern void draw( const float x, const float y );
+#endif
+}
+
+
+struct ObjectProfilerScope
+{
+	ObjectProfilerScope( const u16 type, const u16 event );
+	~ObjectProfilerScope();
+
+	double start;
+	u32 instances;
+	u16 type;
+	u16 event;
+};
+
+#define OBJECT_PROFILE_SCOPE( type, event ) \
+	ObjectProfilerScope __objectProfilerScope { type, event }
+#define OBJECT_PROFILE_INSTANCE() \
+	__objectProfilerScope.instances++
+#define OBJECT_PROFILE_INSTANCE_PARALLEL() \
+	atomic_add<u32>( &__objectProfilerScope.instances, 1 )
+#else
+#define OBJECT_PROFILE_SCOPE( type, event )
+#define OBJECT_PROFILE_INSTANCE()
+#define OBJECT_PROFILE_INSTANCE_PARALLEL()
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ObjectSnapshot: captures the trivially copyable fields of every instance in an ObjectContext. delta() diffs two
+// snapshots per type & per field (created, destroyed, and changed instances -- changed fields are stored as XOR bytes
+// behind a field bitmask) so apply() can step a context forward or backward (replays & rollback). Instances keep their
+// exact bucket, index, and generation, so Object handles stay valid across apply(). Non-trivial fields (String, List,
+// ...) are not snapshotted: created instances get their default constructed values
+
+class ObjectSnapshot
+{
+_PUBLIC:
+	bool init();
+	bool free();
+	void clear();
+
+	void capture( const ObjectContext &context );
+
+	// Writes the changes from 'from' to 'to' into buffer (both snapshots must be captured from the same context)
+	static void delta( Buffer &buffer, const ObjectSnapshot &from, const ObjectSnapshot &to );
+
+	// Applies a delta written by delta() (forward: 'from' -> 'to', backward: 'to' -> 'from'). Events are not called
+	static bool apply( Buffer &buffer, ObjectContext &context, const bool forward );
+
+	usize size_bytes() const { return size; }
+	u32 count( const u16 type ) const { return typeCount[type]; }
+
+_PRIVATE:
+	static bool apply_type( Buffer &buffer, ObjectContext &context, const u16 type, const bool forward,
+		const bool removals );
+
+	// Record: u32 key (bucketID << 16 | index), u16 generation, u8 flags, u8 padding, then the packed field bytes
+	byte *data = nullptr;
+	usize size = 0;
+	usize capacity = 0;
+	usize typeOffset[OBJECT_TYPE_COUNT];
+	u32 typeCount[OBJECT_TYPE_COUNT];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
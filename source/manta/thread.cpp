@@ -0,0 +1,363 @@
+#include <manta/thread.hpp>
+
+#include <config.hpp>
+
+#include <core/debug.hpp>
+#include <core/atomics.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Thread
+{
+	// Implementations: manta/backend/thread/...
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define JOB_DEQUE_MASK ( JOB_QUEUE_SIZE - 1 )
+static_assert( ( JOB_QUEUE_SIZE & JOB_DEQUE_MASK ) == 0, "JOB_QUEUE_SIZE must be a power of two" );
+
+// Chase-Lev work-stealing deque (fixed capacity). The owning thread pushes & pops at 'bottom', thieves steal at 'top'
+struct alignas( THREAD_CACHE_LINE_SIZE ) JobDeque
+{
+	volatile i64 top = 0;
+	byte padding0[THREAD_CACHE_LINE_SIZE - sizeof( i64 )];
+	volatile i64 bottom = 0;
+	byte padding1[THREAD_CACHE_LINE_SIZE - sizeof( i64 )];
+	Job jobs[JOB_QUEUE_SIZE];
+
+	bool push( const Job &job );
+	bool pop( Job &outJob );
+	bool steal( Job &outJob );
+};
+
+
+bool JobDeque::push( const Job &job )
+{
+	// Owner only
+	const i64 b = bottom;
+	const i64 t = atomic_load( &top );
+	if( b - t >= JOB_QUEUE_SIZE ) { return false; }
+
+	jobs[b & JOB_DEQUE_MASK] = job;
+	atomic_store( &bottom, b + 1 );
+	return true;
+}
+
+
+bool JobDeque::pop( Job &outJob )
+{
+	// Owner only -- the exchange acts as the full fence between publishing 'bottom' and reading 'top'
+	const i64 b = bottom - 1;
+	atomic_exchange( &bottom, b );
+	i64 t = atomic_load( &top );
+
+	// Empty
+	if( t > b ) { atomic_store( &bottom, t ); return false; }
+
+	outJob = jobs[b & JOB_DEQUE_MASK];
+	if( t != b ) { return true; }
+
+	// Last job: race thieves for it
+	const bool won = atomic_compare_exchange( &top, t, t + 1 );
+	atomic_store( &bottom, t + 1 );
+	return won;
+}
+
+
+bool JobDeque::steal( Job &outJob )
+{
+	const i64 t = atomic_load( &top );
+	const i64 b = atomic_load( &bottom );
+	if( t >= b ) { return false; }
+
+	// The copy may race the owner wrapping around; it is discarded unless we win 'top'
+	outJob = jobs[t & JOB_DEQUE_MASK];
+	return atomic_compare_exchange( &top, t, t + 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Jobs submitted from threads without a deque
+struct JobInjectionQueue
+{
+	SpinLock lock;
+	u32 front = 0;
+	u32 count = 0;
+	Job jobs[JOB_QUEUE_SIZE];
+
+	bool push( const Job &job );
+	bool pop( Job &outJob );
+};
+
+
+bool JobInjectionQueue::push( const Job &job )
+{
+	lock.lock();
+	if( count == JOB_QUEUE_SIZE ) { lock.unlock(); return false; }
+	jobs[( front + count ) & JOB_DEQUE_MASK] = job;
+	atomic_add<u32>( &count, 1 );
+	lock.unlock();
+	return true;
+}
+
+
+bool JobInjectionQueue::pop( Job &outJob )
+{
+	if( atomic_load( &count ) == 0 ) { return false; }
+
+	lock.lock();
+	if( count == 0 ) { lock.unlock(); return false; }
+	outJob = jobs[front];
+	front = ( front + 1 ) & JOB_DEQUE_MASK;
+	atomic_sub<u32>( &count, 1 );
+	lock.unlock();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static struct
+{
+	JobDeque *deques = nullptr; // [0] belongs to the thread that called SysJobs::init, [1..N] to the workers
+	JobInjectionQueue *injection = nullptr;
+	u32 threadCount = 0;
+
+	volatile u32 running = 0;
+	volatile u32 workersAlive = 0;
+
+	// Idle workers park on 'parked' until submit() bumps 'epoch' (checked under 'parkMutex': no lost wake-ups)
+	Mutex parkMutex;
+	Condition parked;
+	volatile u32 epoch = 0;
+	volatile u32 parkedCount = 0;
+} g_jobs;
+
+static thread_local u32 g_jobsThreadIndex = U32_MAX;
+
+
+static void job_run( const Job &job )
+{
+	job.function( job.userdata );
+	if( job.counter != nullptr ) { atomic_sub<u32>( &job.counter->value, 1 ); }
+}
+
+
+static bool job_next( const u32 index, Job &outJob )
+{
+	// Own deque (LIFO, cache-warm)
+	if( index < g_jobs.threadCount && g_jobs.deques[index].pop( outJob ) ) { return true; }
+
+	// Injected jobs
+	if( g_jobs.injection->pop( outJob ) ) { return true; }
+
+	// Steal (FIFO) from the other threads, starting after our own
+	const u32 count = g_jobs.threadCount;
+	const u32 first = index < count ? index + 1 : 0;
+	for( u32 i = 0; i < count; i++ )
+	{
+		const u32 victim = ( first + i ) % count;
+		if( victim == index ) { continue; }
+		if( g_jobs.deques[victim].steal( outJob ) ) { return true; }
+	}
+
+	return false;
+}
+
+
+#if THREAD_POSIX || THREAD_WINDOWS
+static THREAD_FUNCTION( job_worker )
+{
+	const u32 index = static_cast<u32>( reinterpret_cast<usize>( userdata ) );
+	g_jobsThreadIndex = index;
+
+	u32 idle = 0;
+	Job job;
+	while( atomic_load( &g_jobs.running ) != 0 )
+	{
+		const u32 epoch = atomic_load( &g_jobs.epoch );
+		if( job_next( index, job ) ) { job_run( job ); idle = 0; continue; }
+
+		// Back off: spin, then yield, then park until the next submit()
+		if( ++idle < 1024 ) { atomic_pause(); continue; }
+		if( idle < 2048 ) { Thread::yield(); continue; }
+
+		g_jobs.parkMutex.lock();
+		atomic_add<u32>( &g_jobs.parkedCount, 1 );
+		while( atomic_load( &g_jobs.epoch ) == epoch && atomic_load( &g_jobs.running ) != 0 )
+		{
+			g_jobs.parked.sleep( g_jobs.parkMutex );
+		}
+		atomic_sub<u32>( &g_jobs.parkedCount, 1 );
+		g_jobs.parkMutex.unlock();
+		idle = 0;
+	}
+
+	atomic_sub<u32>( &g_jobs.workersAlive, 1 );
+	return 0;
+}
+#endif
+
+
+bool SysJobs::init()
+{
+	Assert( g_jobs.deques == nullptr );
+
+	// Worker count
+	const u32 hardwareThreads = Thread::hardware_threads();
+	u32 workers = JOB_WORKER_THREADS < 0 ? hardwareThreads - 1 : static_cast<u32>( JOB_WORKER_THREADS );
+#if !( THREAD_POSIX || THREAD_WINDOWS )
+	workers = 0;
+#endif
+	if( workers > JOB_WORKER_THREADS_MAX ) { workers = JOB_WORKER_THREADS_MAX; }
+
+	// Queues
+	g_jobs.threadCount = workers + 1;
+	g_jobs.deques = reinterpret_cast<JobDeque *>( memory_alloc( g_jobs.threadCount * sizeof( JobDeque ) ) );
+	ErrorReturnIf( g_jobs.deques == nullptr, false, "Jobs: failed to allocate worker deques" );
+	memory_set( g_jobs.deques, 0, g_jobs.threadCount * sizeof( JobDeque ) );
+
+	g_jobs.injection = reinterpret_cast<JobInjectionQueue *>( memory_alloc( sizeof( JobInjectionQueue ) ) );
+	ErrorReturnIf( g_jobs.injection == nullptr, false, "Jobs: failed to allocate injection queue" );
+	memory_set( g_jobs.injection, 0, sizeof( JobInjectionQueue ) );
+
+	// The initializing thread owns deque 0
+	g_jobsThreadIndex = 0;
+
+	// Workers (worker i runs on hardware thread i; the initializing thread is left to the OS scheduler)
+#if THREAD_POSIX || THREAD_WINDOWS
+	g_jobs.parkMutex.init();
+	g_jobs.parked.init();
+	atomic_store<u32>( &g_jobs.running, 1 );
+	atomic_store<u32>( &g_jobs.workersAlive, workers );
+	for( u32 i = 1; i <= workers; i++ )
+	{
+		void *thread = Thread::create( job_worker, reinterpret_cast<void *>( static_cast<usize>( i ) ) );
+		if( JOB_PIN_THREADS && hardwareThreads > 1 ) { Thread::pin( thread, i % hardwareThreads ); }
+	}
+#endif
+
+	return true;
+}
+
+
+bool SysJobs::free()
+{
+	if( g_jobs.deques == nullptr ) { return true; }
+
+	// Stop workers
+#if THREAD_POSIX || THREAD_WINDOWS
+	g_jobs.parkMutex.lock();
+	atomic_store<u32>( &g_jobs.running, 0 );
+	g_jobs.parked.wake_all();
+	g_jobs.parkMutex.unlock();
+	while( atomic_load( &g_jobs.workersAlive ) != 0 ) { Thread::sleep( 1 ); }
+	g_jobs.parked.free();
+	g_jobs.parkMutex.free();
+#endif
+
+	// Free memory
+	memory_free( g_jobs.deques );
+	g_jobs.deques = nullptr;
+	memory_free( g_jobs.injection );
+	g_jobs.injection = nullptr;
+	g_jobs.threadCount = 0;
+	g_jobsThreadIndex = U32_MAX;
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Jobs::submit( const Job &job )
+{
+	Assert( job.function != nullptr );
+	if( job.counter != nullptr ) { atomic_add<u32>( &job.counter->value, 1 ); }
+
+	// No pool: run inline
+	if( g_jobs.threadCount <= 1 ) { job_run( job ); return; }
+
+	const u32 index = g_jobsThreadIndex;
+	const bool queued = index < g_jobs.threadCount ? g_jobs.deques[index].push( job ) : g_jobs.injection->push( job );
+	if( !queued ) { job_run( job ); return; }
+
+	// Wake a parked worker
+	atomic_add<u32>( &g_jobs.epoch, 1 );
+	if( atomic_load( &g_jobs.parkedCount ) != 0 )
+	{
+		g_jobs.parkMutex.lock();
+		g_jobs.parked.wake();
+		g_jobs.parkMutex.unlock();
+	}
+}
+
+
+void Jobs::wait( JobCounter &counter )
+{
+	const u32 index = g_jobsThreadIndex;
+	Job job;
+	while( atomic_load( &counter.value ) != 0 )
+	{
+		if( g_jobs.threadCount > 1 && job_next( index, job ) ) { job_run( job ); continue; }
+		atomic_pause();
+	}
+}
+
+
+u32 Jobs::thread_count()
+{
+	return g_jobs.threadCount > 0 ? g_jobs.threadCount : 1;
+}
+
+
+u32 Jobs::thread_index()
+{
+	return g_jobsThreadIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct JobParallelFor
+{
+	volatile u64 cursor;
+	u64 end;
+	u32 grain;
+	JobRangeFunction function;
+	void *userdata;
+};
+
+
+static void job_parallel_for( void *userdata )
+{
+	JobParallelFor &range = *reinterpret_cast<JobParallelFor *>( userdata );
+	for( ;; )
+	{
+		const u64 start = atomic_add<u64>( &range.cursor, range.grain );
+		if( start >= range.end ) { return; }
+		const u64 end = start + range.grain < range.end ? start + range.grain : range.end;
+		range.function( range.userdata, static_cast<u32>( start ), static_cast<u32>( end ) );
+	}
+}
+
+
+void Jobs::parallel_for( const u32 start, const u32 end, const u32 grain, JobRangeFunction function, void *userdata )
+{
+	if( start >= end ) { return; }
+	const u32 size = grain > 0 ? grain : 1;
+	const u32 ranges = ( end - start - 1 ) / size + 1;
+
+	// Single range or no pool: run inline
+	if( ranges == 1 || g_jobs.threadCount <= 1 ) { function( userdata, start, end ); return; }
+
+	// One job per helping thread; each claims ranges until the cursor passes the end
+	JobParallelFor range { start, end, size, function, userdata };
+	JobCounter counter;
+	const u32 helpers = ( ranges < g_jobs.threadCount ? ranges : g_jobs.threadCount ) - 1;
+	for( u32 i = 0; i < helpers; i++ ) { submit( job_parallel_for, &range, &counter ); }
+
+	// Participate, then wait for helpers still finishing a range
+	job_parallel_for( &range );
+	wait( counter );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,7 @@
 
 #include <core/types.hpp>
 #include <core/memory.hpp>
+#include <core/atomics.hpp>
 
 #include <vendor/vendor.hpp>
 
@@ -11,14 +12,18 @@
 
 #if THREAD_WINDOWS
 	// Windows
-	#define THREAD_FUNCTION( name ) unsigned int STD_CALL name( void * )
+	#define THREAD_FUNCTION( name ) unsigned int STD_CALL name( void *userdata )
 	using ThreadFunction = unsigned int (STD_CALL *)( void * );
 	#include <vendor/windows.hpp>
 #elif THREAD_POSIX
 	// POSIX
-	#define THREAD_FUNCTION( name ) void * name( void * )
+	#define THREAD_FUNCTION( name ) void * name( void *userdata )
 	using ThreadFunction = void *(*)( void * );
 	#include <vendor/pthread.hpp>
+#else
+	// None
+	#define THREAD_FUNCTION( name ) void * name( void *userdata )
+	using ThreadFunction = void *(*)( void * );
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -34,7 +39,7 @@ struct ThreadID
 	ThreadID( const pthread_t id ) { this->id = id; }
 	bool operator==( const ThreadID &other ) const { return ( id == other.id ); }
 #else
-	ThreadID( const pthread_t id ) { this->id = id; }
+	ThreadID() { }
 	bool operator==( const ThreadID &other ) const { return true; }
 #endif
 };
@@ -44,8 +49,11 @@ struct ThreadID
 namespace Thread
 {
 	extern void sleep( u32 milliseconds );
+	extern void yield();
 	extern struct ThreadID id();
-	extern void *create( ThreadFunction function );
+	extern void *create( ThreadFunction function, void *userdata = nullptr );
+	extern bool pin( void *thread, u32 core );
+	extern u32 hardware_threads();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -232,4 +240,261 @@ template <typename T> bool ConcurrentQueue<T>::dequeue_unlock()
 	return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define THREAD_CACHE_LINE_SIZE ( 64 )
+
+// Lock-free single-producer single-consumer ring (N must be a power of two). 'head' (consumer) and 'tail' (producer)
+// live on separate cache lines, and each side caches the other's index so the shared line is only re-read when the
+// ring looks full or empty
+
+template <typename T, usize N> struct SpscRing
+{
+	static_assert( N > 0 && ( N & ( N - 1 ) ) == 0, "SpscRing: N must be a power of two" );
+
+	alignas( THREAD_CACHE_LINE_SIZE ) volatile usize head = 0;
+	usize tailCached = 0;
+	alignas( THREAD_CACHE_LINE_SIZE ) volatile usize tail = 0;
+	usize headCached = 0;
+	alignas( THREAD_CACHE_LINE_SIZE ) T data[N];
+
+	bool push( const T &element ); // producer
+	bool pop( T &outElement );     // consumer
+	usize count() const;
+	void clear();                  // not thread-safe
+};
+
+
+template <typename T, usize N> bool SpscRing<T, N>::push( const T &element )
+{
+	const usize t = tail;
+	if( t - headCached >= N )
+	{
+		headCached = atomic_load( &head );
+		if( t - headCached >= N ) { return false; }
+	}
+
+	data[t & ( N - 1 )] = element;
+	atomic_store( &tail, t + 1 );
+	return true;
+}
+
+
+template <typename T, usize N> bool SpscRing<T, N>::pop( T &outElement )
+{
+	const usize h = head;
+	if( h == tailCached )
+	{
+		tailCached = atomic_load( &tail );
+		if( h == tailCached ) { return false; }
+	}
+
+	outElement = data[h & ( N - 1 )];
+	atomic_store( &head, h + 1 );
+	return true;
+}
+
+
+template <typename T, usize N> usize SpscRing<T, N>::count() const
+{
+	return atomic_load( &tail ) - atomic_load( &head );
+}
+
+
+template <typename T, usize N> void SpscRing<T, N>::clear()
+{
+	head = 0;
+	tail = 0;
+	headCached = 0;
+	tailCached = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov). Every cell carries a sequence number that tells
+// producers and consumers whether it is free for the current lap, so push() and pop() each cost one CAS on their own
+// cache-line-padded cursor. Capacity is rounded up to a power of two
+
+template <typename T> struct MpmcQueue
+{
+	struct Cell
+	{
+		volatile usize sequence;
+		T element;
+	};
+
+	Cell *cells = nullptr;
+	usize mask = 0;
+	alignas( THREAD_CACHE_LINE_SIZE ) volatile usize enqueue = 0;
+	alignas( THREAD_CACHE_LINE_SIZE ) volatile usize dequeue = 0;
+
+	bool init( const usize reserve );
+	bool free();
+	bool push( const T &element );
+	bool pop( T &outElement );
+	usize count() const;
+};
+
+
+template <typename T> bool MpmcQueue<T>::init( const usize reserve )
+{
+	usize capacity = 2;
+	while( capacity < reserve ) { capacity <<= 1; }
+
+	Assert( cells == nullptr );
+	cells = reinterpret_cast<Cell *>( memory_alloc( capacity * sizeof( Cell ) ) );
+	ErrorIf( cells == nullptr, "Failed to allocate memory for MpmcQueue" );
+
+	for( usize i = 0; i < capacity; i++ ) { cells[i].sequence = i; }
+	mask = capacity - 1;
+	enqueue = 0;
+	dequeue = 0;
+
+	return true;
+}
+
+
+template <typename T> bool MpmcQueue<T>::free()
+{
+	if( cells == nullptr ) { return true; }
+
+	memory_free( cells );
+	cells = nullptr;
+	mask = 0;
+	return true;
+}
+
+
+template <typename T> bool MpmcQueue<T>::push( const T &element )
+{
+	Assert( cells != nullptr );
+
+	Cell *cell;
+	usize position = atomic_load( &enqueue );
+	for( ;; )
+	{
+		cell = &cells[position & mask];
+		const isize diff = static_cast<isize>( atomic_load( &cell->sequence ) ) - static_cast<isize>( position );
+
+		// Cell free for this lap: claim it
+		if( diff == 0 )
+		{
+			if( atomic_compare_exchange( &enqueue, position, position + 1 ) ) { break; }
+			position = atomic_load( &enqueue );
+		}
+		// Cell still holds an element from the previous lap: full
+		else if( diff < 0 ) { return false; }
+		// Another producer claimed it
+		else { position = atomic_load( &enqueue ); }
+	}
+
+	cell->element = element;
+	atomic_store( &cell->sequence, position + 1 );
+	return true;
+}
+
+
+template <typename T> bool MpmcQueue<T>::pop( T &outElement )
+{
+	Assert( cells != nullptr );
+
+	Cell *cell;
+	usize position = atomic_load( &dequeue );
+	for( ;; )
+	{
+		cell = &cells[position & mask];
+		const isize diff = static_cast<isize>( atomic_load( &cell->sequence ) ) - static_cast<isize>( position + 1 );
+
+		// Cell written for this lap: claim it
+		if( diff == 0 )
+		{
+			if( atomic_compare_exchange( &dequeue, position, position + 1 ) ) { break; }
+			position = atomic_load( &dequeue );
+		}
+		// Nothing written yet: empty
+		else if( diff < 0 ) { return false; }
+		// Another consumer claimed it
+		else { position = atomic_load( &dequeue ); }
+	}
+
+	outElement = cell->element;
+	atomic_store( &cell->sequence, position + mask + 1 );
+	return true;
+}
+
+
+template <typename T> usize MpmcQueue<T>::count() const
+{
+	const usize e = atomic_load( &enqueue );
+	const usize d = atomic_load( &dequeue );
+	return e > d ? e - d : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Job System
+//
+// A fixed pool of worker threads, each optionally pinned to a hardware thread, that own a Chase-Lev work-stealing
+// deque. Jobs submitted from a worker (or the thread that called SysJobs::init) are pushed onto its own deque; jobs
+// from any other thread go through a shared injection queue. Idle workers steal from the top of other deques
+//
+// Dependencies are expressed with JobCounter: submit() increments it, completion decrements it, and wait() runs
+// pending jobs on the calling thread until it reaches zero
+
+struct JobCounter
+{
+	volatile u32 value = 0;
+};
+
+using JobFunction = void (*)( void *userdata );
+using JobRangeFunction = void (*)( void *userdata, u32 start, u32 end );
+
+struct Job
+{
+	JobFunction function = nullptr;
+	void *userdata = nullptr;
+	JobCounter *counter = nullptr;
+};
+
+
+namespace SysJobs
+{
+	extern bool init();
+	extern bool free();
+}
+
+
+namespace Jobs
+{
+	// Queues a job (runs it inline when the pool is not running or the queue is full)
+	extern void submit( const Job &job );
+	inline void submit( JobFunction function, void *userdata, JobCounter *counter )
+	{
+		submit( Job { function, userdata, counter } );
+	}
+
+	// Runs pending jobs on the calling thread until 'counter' reaches zero
+	extern void wait( JobCounter &counter );
+	inline bool done( const JobCounter &counter ) { return atomic_load( &counter.value ) == 0; }
+
+	// Threads executing jobs: workers + the thread that called SysJobs::init
+	extern u32 thread_count();
+
+	// 0 for the thread that called SysJobs::init, 1..N for workers, U32_MAX for any other thread
+	extern u32 thread_index();
+
+	// Splits [start, end) into ranges of 'grain' indices claimed dynamically by the pool. The calling thread
+	// participates and returns once every range has completed
+	extern void parallel_for( const u32 start, const u32 end, const u32 grain, JobRangeFunction function,
+		void *userdata );
+
+	template <typename F> void parallel_for( const u32 start, const u32 end, const u32 grain, F function )
+	{
+		parallel_for( start, end, grain, []( void *userdata, u32 rangeStart, u32 rangeEnd )
+			{
+				( *reinterpret_cast<F *>( userdata ) )( rangeStart, rangeEnd );
+			}, reinterpret_cast<void *>( &function ) );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,6 +62,17 @@
 	// Enable networking events
 	#define NETWORKED( enable )
 
+	// Dispatch EVENT_UPDATE/EVENT_UPDATE_CUSTOM across worker threads (create/destroy are deferred until all finish)
+	#define PARALLEL( enable )
+
+	// Register instances in a spatial hash queried by ObjectContext::query_radius() & query_aabb()
+	// x, y, radius: member expressions (re-read each frame), cell_size: optional (default OBJECT_SPATIAL_CELL_SIZE)
+	#define SPATIAL( x, y, radius, ... )
+
+	// Run EVENT_UPDATE every N frames, staggered across instances by bucket slot; the event receives the delta
+	// accumulated since the instance's previous update. Override per instance with 'updateRate' (0: use N)
+	#define UPDATE_RATE( frames )
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 